@@ -108,6 +108,8 @@ protected:
   int alloc_max_space();
   int inner_rebuild();
   int update_champion_path(const int64_t idx);
+  // replay matches from leaf of player idx up to the root
+  int replay_path(const int64_t idx);
   int get_match_result(
       const int64_t offender,
       const int64_t defender,
@@ -460,7 +462,18 @@ int ObLoserTree<T, CompareFunctor, MAX_PLAYER_CNT>::update_champion_path(
   int64_t child = get_leaf(idx);
   matches_[child].winner_idx_ = INVALID_IDX;
   matches_[child].loser_idx_ = INVALID_IDX;
+  if (OB_FAIL(replay_path(idx))) {
+    LIB_LOG(WARN, "replay path fail", K(ret), K(idx));
+  }
+  return ret;
+}
 
+template <typename T, typename CompareFunctor, int64_t MAX_PLAYER_CNT>
+int ObLoserTree<T, CompareFunctor, MAX_PLAYER_CNT>::replay_path(
+    const int64_t idx)
+{
+  int ret = OB_SUCCESS;
+  int64_t child = get_leaf(idx);
   int64_t parent = get_parent(child);
   int64_t winner_idx = INVALID_IDX;
   int64_t loser_idx = INVALID_IDX;
@@ -543,8 +556,33 @@ int ObLoserTree<T, CompareFunctor, MAX_PLAYER_CNT>::push(const T &player)
 template <typename T, typename CompareFunctor, int64_t MAX_PLAYER_CNT>
 int ObLoserTree<T, CompareFunctor, MAX_PLAYER_CNT>::push_top(const T &player)
 {
-  UNUSED(player);
-  return OB_NOT_SUPPORTED;
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LIB_LOG(WARN, "not init", K(ret));
+  } else if (need_rebuild_) {
+    ret = OB_ERR_UNEXPECTED;
+    LIB_LOG(WARN, "new players has been push, please rebuild", K(ret));
+  } else if (empty()) {
+    ret = OB_EMPTY_RESULT;
+    LIB_LOG(WARN, "the tree is already empty", K(ret));
+  } else if (is_single_player()) {
+    players_[0] = player;
+  } else {
+    // replace the champion in place and replay only its path,
+    // cheaper than pop + push + rebuild
+    const int64_t champion = matches_[0].winner_idx_;
+    if (champion < 0 || champion >= player_cnt_) {
+      ret = OB_ERR_UNEXPECTED;
+      LIB_LOG(WARN, "champion is invalid", K(ret), K(matches_[0]));
+    } else if (FALSE_IT(players_[champion] = player)) {
+    } else if (OB_FAIL(replay_path(champion))) {
+      LIB_LOG(WARN, "replay path fail", K(ret), K(matches_[0]));
+    } else {
+      set_unique_champion();
+    }
+  }
+  return ret;
 }
 
 template <typename T, typename CompareFunctor, int64_t MAX_PLAYER_CNT>
@@ -339,6 +339,68 @@ TEST_F(ObLoserTreeTest, unique_champion)
   ASSERT_EQ(ret, OB_SUCCESS);
   ASSERT_FALSE(tree.is_unique_champion());
 }
+
+TEST_F(ObLoserTreeTest, push_top)
+{
+  int ret = 0;
+  TestMaxComp tc;
+  ObArenaAllocator allocator;
+  ObLoserTree<int64_t, TestMaxComp, 8> tree(tc);
+  const int64_t *top = nullptr;
+
+  // not init
+  ret = tree.push_top(1);
+  ASSERT_EQ(ret, OB_NOT_INIT);
+
+  const int64_t DATA_CNT = 5;
+  int64_t data[DATA_CNT] = {9, 3, 7, 1, 5};
+  ret = tree.init(DATA_CNT, allocator);
+  ASSERT_EQ(ret, OB_SUCCESS);
+  for (int64_t i = 0; i < DATA_CNT; ++i) {
+    ret = tree.push(data[i]);
+    ASSERT_EQ(ret, OB_SUCCESS);
+  }
+  // need rebuild
+  ret = tree.push_top(1);
+  ASSERT_EQ(ret, OB_ERR_UNEXPECTED);
+  ret = tree.rebuild();
+  ASSERT_EQ(ret, OB_SUCCESS);
+
+  // replace champion 9 with 6, {6, 3, 7, 1, 5}
+  ret = tree.push_top(6);
+  ASSERT_EQ(ret, OB_SUCCESS);
+  ret = tree.top(top);
+  ASSERT_EQ(ret, OB_SUCCESS);
+  ASSERT_EQ(7, *top);
+  ASSERT_EQ(DATA_CNT, tree.count());
+
+  // replace champion 7 with 6, {6, 3, 6, 1, 5}
+  ret = tree.push_top(6);
+  ASSERT_EQ(ret, OB_SUCCESS);
+  ret = tree.top(top);
+  ASSERT_EQ(ret, OB_SUCCESS);
+  ASSERT_EQ(6, *top);
+  ASSERT_FALSE(tree.is_unique_champion());
+
+  // replace champion with a larger one, {10, 3, 6, 1, 5}
+  ret = tree.push_top(10);
+  ASSERT_EQ(ret, OB_SUCCESS);
+  ret = tree.top(top);
+  ASSERT_EQ(ret, OB_SUCCESS);
+  ASSERT_EQ(10, *top);
+  ASSERT_TRUE(tree.is_unique_champion());
+
+  int64_t expect[DATA_CNT] = {10, 6, 5, 3, 1};
+  for (int64_t i = 0; i < DATA_CNT; ++i) {
+    ret = tree.top(top);
+    ASSERT_EQ(ret, OB_SUCCESS);
+    ASSERT_EQ(expect[i], *top);
+    ret = tree.pop();
+    ASSERT_EQ(ret, OB_SUCCESS);
+  }
+  ret = tree.push_top(1);
+  ASSERT_EQ(ret, OB_EMPTY_RESULT);
+}
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc,argv);
@@ -503,9 +503,9 @@ TEST_F(TestObSimpleLogClusterLogEngine, io_reducer_basic_func)
     wait_lsn_until_flushed(max_lsn, leader_1);
     EXPECT_EQ(OB_ITER_END, read_log(leader_1));
     // sw内部做了自适应freeze之后这个等式可能不成立, 因为上层可能基于写盘反馈触发提交下一个io_task
-//    EXPECT_EQ(log_id, log_io_worker->batch_io_task_mgr_.has_batched_size_);
+//    EXPECT_EQ(log_id, log_io_worker->shards_[0].batch_io_task_mgr_.has_batched_size_);
     prev_log_id_1 = log_id;
-    prev_has_batched_size = log_io_worker->batch_io_task_mgr_.has_batched_size_;
+    prev_has_batched_size = log_io_worker->shards_[0].batch_io_task_mgr_.has_batched_size_;
   }
   // 单日志流场景
   // 当聚合度为1的时候，应该走正常的提交流程，目前暂未实现，先通过has_batched_size不计算绕过
@@ -521,12 +521,12 @@ TEST_F(TestObSimpleLogClusterLogEngine, io_reducer_basic_func)
     LSN max_lsn = leader_1.palf_handle_impl_->sw_.get_max_lsn();
     io_task_cond_1.cond_.signal();
     wait_lsn_until_flushed(max_lsn, leader_1);
-//    EXPECT_EQ(log_id - 1, log_io_worker->batch_io_task_mgr_.has_batched_size_);
+//    EXPECT_EQ(log_id - 1, log_io_worker->shards_[0].batch_io_task_mgr_.has_batched_size_);
     EXPECT_EQ(2, io_task_verify_1.count_);
-//    EXPECT_EQ(log_io_worker->batch_io_task_mgr_.has_batched_size_ - prev_has_batched_size,
+//    EXPECT_EQ(log_io_worker->shards_[0].batch_io_task_mgr_.has_batched_size_ - prev_has_batched_size,
 //              log_id - prev_log_id_1 - 1);
     prev_log_id_1 = log_id;
-    prev_has_batched_size = log_io_worker->batch_io_task_mgr_.has_batched_size_;
+    prev_has_batched_size = log_io_worker->shards_[0].batch_io_task_mgr_.has_batched_size_;
   }
 
   // 多日志流场景
@@ -560,9 +560,9 @@ TEST_F(TestObSimpleLogClusterLogEngine, io_reducer_basic_func)
     EXPECT_EQ(1, io_task_verify_2.count_);
 
     // ls1已经有个一个log_id被忽略聚合了
-//    EXPECT_EQ(log_io_worker->batch_io_task_mgr_.has_batched_size_ - prev_has_batched_size,
+//    EXPECT_EQ(log_io_worker->shards_[0].batch_io_task_mgr_.has_batched_size_ - prev_has_batched_size,
 //              log_id_1 - 1 + log_id_2 -1 - prev_log_id_1);
-    prev_has_batched_size = log_io_worker->batch_io_task_mgr_.has_batched_size_;
+    prev_has_batched_size = log_io_worker->shards_[0].batch_io_task_mgr_.has_batched_size_;
     prev_log_id_2 = log_id_2;
     prev_log_id_1 = log_id_1;
   }
@@ -595,7 +595,7 @@ TEST_F(TestObSimpleLogClusterLogEngine, io_reducer_basic_func)
   //   wait_lsn_until_flushed(max_lsn_1, leader_1);
   //   wait_lsn_until_flushed(max_lsn_2, leader_2);
   //   wait_lsn_until_flushed(max_lsn_3, leader_3);
-  //   EXPECT_EQ(log_io_worker->batch_io_task_mgr_.has_batched_size_ - prev_has_batched_size, 0);
+  //   EXPECT_EQ(log_io_worker->shards_[0].batch_io_task_mgr_.has_batched_size_ - prev_has_batched_size, 0);
   // }
   // 验证切文件场景
   int64_t id_3 = ATOMIC_AAF(&palf_id_, 1);
@@ -623,7 +623,7 @@ TEST_F(TestObSimpleLogClusterLogEngine, io_reducer_basic_func)
     wait_lsn_until_flushed(max_lsn_1, leader_1);
     wait_lsn_until_flushed(max_lsn_2, leader_2);
     wait_lsn_until_flushed(max_lsn_3, leader_3);
-//  EXPECT_EQ(log_io_worker->batch_io_task_mgr_.has_batched_size_ - prev_has_batched_size, 2);
+//  EXPECT_EQ(log_io_worker->shards_[0].batch_io_task_mgr_.has_batched_size_ - prev_has_batched_size, 2);
     EXPECT_EQ(OB_SUCCESS, submit_log(leader_1, 31, leader_idx_1, MAX_LOG_BODY_SIZE));
     EXPECT_EQ(OB_SUCCESS, submit_log(leader_1, 2, leader_idx_1, 900 *1024));
     max_lsn_1 = leader_1.palf_handle_impl_->get_max_lsn();
@@ -764,14 +764,14 @@ TEST_F(TestObSimpleLogClusterLogEngine, io_reducer_basic_func)
 //  int64_t leader_idx = 0;
 //  PalfHandleImplGuard leader;
 //  EXPECT_EQ(OB_SUCCESS, create_paxos_group(id, leader_idx, leader));
-//  leader.palf_env_impl_->log_io_worker_.batch_io_task_mgr_.has_batched_size_ = 0;
-//  leader.palf_env_impl_->log_io_worker_.batch_io_task_mgr_.handle_count_ = 0;
+//  leader.palf_env_impl_->log_io_worker_.shards_[0].batch_io_task_mgr_.has_batched_size_ = 0;
+//  leader.palf_env_impl_->log_io_worker_.shards_[0].batch_io_task_mgr_.handle_count_ = 0;
 //  int64_t start_ts = ObTimeUtility::current_time();
 //  EXPECT_EQ(OB_SUCCESS, submit_log(leader, 40 * 10000, leader_idx, 100));
 //  const LSN max_lsn = leader.palf_handle_impl_->get_max_lsn();
 //  wait_lsn_until_flushed(max_lsn, leader);
-//  const int64_t has_batched_size = leader.palf_env_impl_->log_io_worker_.batch_io_task_mgr_.has_batched_size_;
-//  const int64_t handle_count = leader.palf_env_impl_->log_io_worker_.batch_io_task_mgr_.handle_count_;
+//  const int64_t has_batched_size = leader.palf_env_impl_->log_io_worker_.shards_[0].batch_io_task_mgr_.has_batched_size_;
+//  const int64_t handle_count = leader.palf_env_impl_->log_io_worker_.shards_[0].batch_io_task_mgr_.handle_count_;
 //  const int64_t log_id = leader.palf_handle_impl_->sw_.get_max_log_id();
 //  int64_t cost_ts = ObTimeUtility::current_time() - start_ts;
 //  PALF_LOG(ERROR, "runlin trace performance", K(cost_ts), K(log_id), K(max_lsn), K(has_batched_size), K(handle_count));
@@ -74,7 +74,7 @@ int ObLogService::mtl_init(ObLogService* &logservice)
   const int64_t tenant_id = MTL_ID();
   observer::ObSrvNetworkFrame *net_frame = GCTX.net_frame_;
   //log_disk_usage_limit_size无法主动从配置项获取, 需要在mtl初始化时作为入参传入
-  const palf::PalfOptions &palf_options = MTL_INIT_CTX()->palf_options_;
+  palf::PalfOptions palf_options = MTL_INIT_CTX()->palf_options_;
   const char *tenant_clog_dir = MTL_INIT_CTX()->tenant_clog_dir_;
   const char *clog_dir = OB_FILE_SYSTEM_ROUTER.get_clog_dir();
   ObLocationService *location_service = GCTX.location_service_;
@@ -84,6 +84,11 @@ int ObLogService::mtl_init(ObLogService* &logservice)
   common::ObMySQLProxy *mysql_proxy = GCTX.sql_proxy_;
   obrpc::ObNetKeepAlive *net_keepalive = &(obrpc::ObNetKeepAlive::get_instance());
   ObNetKeepAliveAdapter *net_keepalive_adapter = NULL;
+  omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id));
+  if (tenant_config.is_valid()) {
+    palf_options.log_writer_parallelism_ = tenant_config->_log_writer_parallelism;
+    palf_options.log_cache_size_ = tenant_config->_palf_log_cache_size;
+  }
   if (OB_FAIL(TMA_MGR_INSTANCE.get_tenant_log_allocator(tenant_id, alloc_mgr))) {
     CLOG_LOG(WARN, "get_tenant_log_allocator failed", K(ret));
   } else if (OB_ISNULL(net_keepalive_adapter = MTL_NEW(ObNetKeepAliveAdapter, "logservice", net_keepalive))) {
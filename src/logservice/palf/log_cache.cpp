@@ -0,0 +1,195 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include "log_cache.h"
+#include "share/rc/ob_tenant_base.h"
+#include "log_writer_utils.h"
+
+namespace oceanbase
+{
+using namespace share;
+namespace palf
+{
+bool LogCacheBudget::reserve(const int64_t size)
+{
+  bool bool_ret = false;
+  int64_t used = ATOMIC_LOAD(&used_);
+  while (!bool_ret && used + size <= ATOMIC_LOAD(&limit_)) {
+    const int64_t old_used = used;
+    if (old_used == (used = ATOMIC_VCAS(&used_, old_used, old_used + size))) {
+      bool_ret = true;
+    }
+  }
+  return bool_ret;
+}
+
+LogCache::LogCache()
+  : palf_id_(INVALID_PALF_ID),
+    seq_(0),
+    begin_lsn_(),
+    end_lsn_(),
+    capacity_(0),
+    data_buf_(NULL),
+    budget_(NULL),
+    is_inited_(false)
+{
+}
+
+LogCache::~LogCache()
+{
+  destroy();
+}
+
+int LogCache::init(const int64_t palf_id, const int64_t capacity, LogCacheBudget *budget)
+{
+  int ret = OB_SUCCESS;
+  ObMemAttr mem_attr(MTL_ID(), "PalfLogCache");
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+  } else if (false == is_valid_palf_id(palf_id) || 0 >= capacity) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(WARN, "invalid argument", K(ret), K(palf_id), K(capacity));
+  } else if (NULL != budget && !budget->reserve(capacity)) {
+    ret = OB_EXCEED_MEM_LIMIT;
+    PALF_LOG(INFO, "LogCache budget is not enough", K(ret), K(palf_id), K(capacity), KPC(budget));
+  } else if (NULL == (data_buf_ = static_cast<char *>(mtl_malloc(capacity, mem_attr)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    PALF_LOG(WARN, "alloc memory failed", K(ret), K(palf_id));
+    if (NULL != budget) {
+      budget->release(capacity);
+    }
+  } else {
+    budget_ = budget;
+    palf_id_ = palf_id;
+    seq_ = 0;
+    begin_lsn_.reset();
+    end_lsn_.reset();
+    capacity_ = capacity;
+    is_inited_ = true;
+    PALF_LOG(INFO, "LogCache init success", K(ret), KPC(this));
+  }
+  return ret;
+}
+
+void LogCache::destroy()
+{
+  is_inited_ = false;
+  if (NULL != data_buf_) {
+    mtl_free(data_buf_);
+    data_buf_ = NULL;
+    if (NULL != budget_) {
+      budget_->release(capacity_);
+    }
+  }
+  budget_ = NULL;
+  capacity_ = 0;
+  begin_lsn_.reset();
+  end_lsn_.reset();
+  seq_ = 0;
+  palf_id_ = INVALID_PALF_ID;
+}
+
+void LogCache::fill(const LSN &lsn, const LogWriteBuf &write_buf)
+{
+  const int64_t total_size = write_buf.get_total_size();
+  LSN end_lsn;
+  LSN begin_lsn;
+  get_end_lsn_(end_lsn);
+  get_begin_lsn_(begin_lsn);
+  if (IS_NOT_INIT || !lsn.is_valid() || 0 >= total_size) {
+  } else if (total_size > capacity_) {
+    reset(lsn + total_size);
+  } else {
+    if (!end_lsn.is_valid() || lsn != end_lsn) {
+      reset(lsn);
+      begin_lsn = lsn;
+    }
+    const LSN new_end_lsn = lsn + total_size;
+    // evict the log which will be overwritten
+    if (static_cast<int64_t>(new_end_lsn - begin_lsn) > capacity_) {
+      ATOMIC_STORE(&begin_lsn_.val_, (new_end_lsn - capacity_).val_);
+      MEM_BARRIER();
+    }
+    LSN curr_lsn = lsn;
+    for (int64_t i = 0; i < write_buf.get_buf_count(); i++) {
+      const char *buf = NULL;
+      int64_t buf_len = 0;
+      if (OB_SUCCESS == write_buf.get_write_buf(i, buf, buf_len)) {
+        copy_in_(curr_lsn, buf, buf_len);
+        curr_lsn = curr_lsn + buf_len;
+      }
+    }
+    ATOMIC_STORE(&end_lsn_.val_, new_end_lsn.val_);
+  }
+}
+
+void LogCache::reset(const LSN &lsn)
+{
+  if (IS_INIT) {
+    ATOMIC_INC(&seq_);
+    MEM_BARRIER();
+    ATOMIC_STORE(&begin_lsn_.val_, lsn.val_);
+    ATOMIC_STORE(&end_lsn_.val_, lsn.val_);
+    MEM_BARRIER();
+    ATOMIC_INC(&seq_);
+  }
+}
+
+int LogCache::read(const LSN &lsn, const int64_t size, char *buf) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t seq = ATOMIC_LOAD(&seq_);
+  LSN begin_lsn;
+  LSN end_lsn;
+  get_begin_lsn_(begin_lsn);
+  get_end_lsn_(end_lsn);
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+  } else if (!lsn.is_valid() || 0 >= size || NULL == buf) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(WARN, "invalid argument", K(ret), K(lsn), K(size), KP(buf));
+  } else if (0 != (seq & 1) || !begin_lsn.is_valid() || !end_lsn.is_valid()
+             || lsn < begin_lsn || lsn + size > end_lsn) {
+    ret = OB_ENTRY_NOT_EXIST;
+  } else {
+    copy_out_(lsn, size, buf);
+    MEM_BARRIER();
+    get_begin_lsn_(begin_lsn);
+    // the log may be overwritten during copy
+    if (seq != ATOMIC_LOAD(&seq_) || lsn < begin_lsn) {
+      ret = OB_ENTRY_NOT_EXIST;
+    }
+  }
+  return ret;
+}
+
+void LogCache::copy_in_(const LSN &lsn, const char *buf, const int64_t size)
+{
+  const int64_t pos = lsn.val_ % capacity_;
+  const int64_t first_part_len = MIN(capacity_ - pos, size);
+  MEMCPY(data_buf_ + pos, buf, first_part_len);
+  if (size > first_part_len) {
+    MEMCPY(data_buf_, buf + first_part_len, size - first_part_len);
+  }
+}
+
+void LogCache::copy_out_(const LSN &lsn, const int64_t size, char *buf) const
+{
+  const int64_t pos = lsn.val_ % capacity_;
+  const int64_t first_part_len = MIN(capacity_ - pos, size);
+  MEMCPY(buf, data_buf_ + pos, first_part_len);
+  if (size > first_part_len) {
+    MEMCPY(buf + first_part_len, data_buf_, size - first_part_len);
+  }
+}
+} // end namespace palf
+} // end namespace oceanbase
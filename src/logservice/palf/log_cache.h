@@ -0,0 +1,101 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_LOGSERVICE_LOG_CACHE_
+#define OCEANBASE_LOGSERVICE_LOG_CACHE_
+
+#include "lib/utility/ob_macro_utils.h"
+#include "lib/utility/ob_print_utils.h"
+#include "log_define.h"
+#include "lsn.h"
+
+namespace oceanbase
+{
+namespace palf
+{
+class LogWriteBuf;
+
+// LogCacheBudget bounds the memory of all LogCaches of one tenant, a LogCache
+// which can not get its capacity from the budget is turned off.
+class LogCacheBudget
+{
+public:
+  LogCacheBudget() : limit_(0), used_(0) {}
+  ~LogCacheBudget() {}
+public:
+  void set_limit(const int64_t limit) { ATOMIC_STORE(&limit_, limit); }
+  int64_t get_limit() const { return ATOMIC_LOAD(&limit_); }
+  int64_t get_used() const { return ATOMIC_LOAD(&used_); }
+  // @retval false, the budget left is less than 'size'
+  bool reserve(const int64_t size);
+  void release(const int64_t size) { (void)ATOMIC_SAF(&used_, size); }
+  TO_STRING_KV(K_(limit), K_(used));
+private:
+  int64_t limit_;
+  int64_t used_;
+private:
+  DISALLOW_COPY_AND_ASSIGN(LogCacheBudget);
+};
+
+// LogCache keeps the tail of flushed log of one palf in memory. The fetch log
+// engine, cdc and replay all read log by LogStorage::pread, and most of them
+// read the tail which has just been flushed, so they can be served by the
+// cache without reading the block file.
+//
+// The cache is a ring buffer of [begin_lsn_, end_lsn_), which is filled by the
+// log io worker only, and read concurrently without lock:
+// 1. before overwriting, the writer pushes begin_lsn_ over the evicted range;
+// 2. reset(truncate/flashback/rebuild) makes seq_ odd during the update;
+// 3. the reader copies data firstly, and then checks seq_ and begin_lsn_ again,
+//    the copied data is valid only if nothing has changed.
+class LogCache
+{
+public:
+  LogCache();
+  ~LogCache();
+public:
+  // @retval
+  //   OB_SUCCESS
+  //   OB_EXCEED_MEM_LIMIT, 'budget' is not enough for 'capacity'
+  int init(const int64_t palf_id, const int64_t capacity, LogCacheBudget *budget = NULL);
+  void destroy();
+  // fill the flushed log, the cache is reset to 'lsn' if it's not continous
+  // with the cached log.
+  void fill(const LSN &lsn, const LogWriteBuf &write_buf);
+  // drop all cached log, and the following log will be cached from 'lsn'.
+  void reset(const LSN &lsn);
+  // @retval
+  //   OB_SUCCESS
+  //   OB_ENTRY_NOT_EXIST, [lsn, lsn + size) is not in cache
+  int read(const LSN &lsn, const int64_t size, char *buf) const;
+  TO_STRING_KV(K_(palf_id), K_(seq), K_(begin_lsn), K_(end_lsn), K_(capacity), KP_(data_buf));
+private:
+  void get_begin_lsn_(LSN &lsn) const { lsn.val_ = ATOMIC_LOAD(&begin_lsn_.val_); }
+  void get_end_lsn_(LSN &lsn) const { lsn.val_ = ATOMIC_LOAD(&end_lsn_.val_); }
+  void copy_in_(const LSN &lsn, const char *buf, const int64_t size);
+  void copy_out_(const LSN &lsn, const int64_t size, char *buf) const;
+private:
+  int64_t palf_id_;
+  int64_t seq_;
+  LSN begin_lsn_;
+  LSN end_lsn_;
+  int64_t capacity_;
+  char *data_buf_;
+  LogCacheBudget *budget_;
+  bool is_inited_;
+private:
+  DISALLOW_COPY_AND_ASSIGN(LogCache);
+};
+} // end namespace palf
+} // end namespace oceanbase
+
+#endif // OCEANBASE_LOGSERVICE_LOG_CACHE_
@@ -153,6 +153,20 @@ int LogEngine::init(const int64_t palf_id,
   return ret;
 }
 
+int LogEngine::init_log_cache(const int64_t cache_size, LogCacheBudget *budget)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+  } else if (cache_size < 0) {
+    ret = OB_INVALID_ARGUMENT;
+    PALF_LOG(WARN, "invalid argument", K(ret), K_(palf_id), K(cache_size));
+  } else if (OB_FAIL(log_storage_.init_log_cache(cache_size, budget))) {
+    PALF_LOG(WARN, "LogStorage init_log_cache failed", K(ret), K_(palf_id), K(cache_size));
+  }
+  return ret;
+}
+
 void LogEngine::destroy()
 {
   if (IS_INIT) {
@@ -105,6 +105,8 @@ public:
            bool &is_integrity,
            const int64_t log_storage_size,
            const int64_t log_meta_storage_size);
+  // 'cache_size' is the size of LogCache, 0 means no cache.
+  int init_log_cache(const int64_t cache_size, LogCacheBudget *budget);
 
   // ==================== Submit async task start ================
   //
@@ -30,10 +30,7 @@ LogIOWorker::LogIOWorker()
     : log_io_worker_num_(-1),
       cb_thread_pool_tg_id_(-1),
       palf_env_impl_(NULL),
-      do_task_used_ts_(0),
-      do_task_count_(0),
-      print_log_interval_(OB_INVALID_TIMESTAMP),
-      last_working_time_(OB_INVALID_TIMESTAMP),
+      shards_(),
       is_inited_(false)
 {
 }
@@ -53,18 +50,26 @@ int LogIOWorker::init(const LogIOWorkerConfig &config,
   if (IS_INIT) {
     ret = OB_INIT_TWICE;
     PALF_LOG(ERROR, "LogIOWorker has been inited", K(ret));
-  } else if (false == config.is_valid() || 0 >= cb_thread_pool_tg_id || OB_ISNULL(allocator)
-      || OB_ISNULL(palf_env_impl)) {
+  } else if (false == config.is_valid() || MAX_THREAD_NUM < config.io_worker_num_
+      || 0 >= cb_thread_pool_tg_id || OB_ISNULL(allocator) || OB_ISNULL(palf_env_impl)) {
     ret = OB_INVALID_ARGUMENT;
     PALF_LOG(ERROR, "invalid argument!!!", K(ret), K(config), K(cb_thread_pool_tg_id), KP(allocator),
         KP(palf_env_impl));
-  } else if (OB_FAIL(queue_.init(config.io_queue_capcity_, "IOWorkerLQ", tenant_id))) {
-    PALF_LOG(ERROR, "io task queue init failed", K(ret), K(config));
-  } else if (OB_FAIL(batch_io_task_mgr_.init(config.batch_width_,
-                                             config.batch_depth_,
-                                             allocator))) {
-    PALF_LOG(ERROR, "BatchLogIOFlushLogTaskMgr init failed", K(ret), K(config));
+  } else if (OB_FAIL(set_thread_count(config.io_worker_num_))) {
+    PALF_LOG(ERROR, "set_thread_count failed", K(ret), K(config));
   } else {
+    for (int64_t i = 0; i < config.io_worker_num_ && OB_SUCC(ret); i++) {
+      LogIOWorkerShard &shard = shards_[i];
+      if (OB_FAIL(shard.queue_.init(config.io_queue_capcity_, "IOWorkerLQ", tenant_id))) {
+        PALF_LOG(ERROR, "io task queue init failed", K(ret), K(config), K(i));
+      } else if (OB_FAIL(shard.batch_io_task_mgr_.init(config.batch_width_,
+                                                       config.batch_depth_,
+                                                       allocator))) {
+        PALF_LOG(ERROR, "BatchLogIOFlushLogTaskMgr init failed", K(ret), K(config), K(i));
+      }
+    }
+  }
+  if (OB_SUCC(ret)) {
     share::ObThreadPool::set_run_wrapper(MTL_CTX());
     log_io_worker_num_ = config.io_worker_num_;
     cb_thread_pool_tg_id_ = cb_thread_pool_tg_id;
@@ -88,12 +93,17 @@ void LogIOWorker::destroy()
     PALF_LOG(INFO, "LogIOWorker destroy success", KPC(this), KPC(allocator));
   }
   is_inited_ = false;
-  last_working_time_ = OB_INVALID_TIMESTAMP;
   cb_thread_pool_tg_id_ = -1;
   palf_env_impl_ = NULL;
   log_io_worker_num_ = -1;
-  queue_.destroy();
-  batch_io_task_mgr_.destroy();
+  for (int64_t i = 0; i < MAX_THREAD_NUM; i++) {
+    LogIOWorkerShard &shard = shards_[i];
+    shard.last_working_time_ = OB_INVALID_TIMESTAMP;
+    shard.do_task_used_ts_ = 0;
+    shard.do_task_count_ = 0;
+    shard.queue_.destroy();
+    shard.batch_io_task_mgr_.destroy();
+  }
 }
 
 int LogIOWorker::submit_io_task(LogIOTask *io_task)
@@ -103,7 +113,7 @@ int LogIOWorker::submit_io_task(LogIOTask *io_task)
     ret = OB_NOT_INIT;
   } else if (OB_ISNULL(io_task)) {
     ret = OB_INVALID_ARGUMENT;
-	} else if (OB_FAIL(queue_.push(io_task))) {
+  } else if (OB_FAIL(get_shard_(io_task->get_palf_id()).queue_.push(io_task))) {
     PALF_LOG(WARN, "fail to push io task into queue", K(ret), KP(io_task));
   } else {
     PALF_LOG(TRACE, "submit_io_task success", KP(io_task));
@@ -111,13 +121,26 @@ int LogIOWorker::submit_io_task(LogIOTask *io_task)
   return ret;
 }
 
+int64_t LogIOWorker::get_last_working_time() const
+{
+  int64_t last_working_time = OB_INVALID_TIMESTAMP;
+  for (int64_t i = 0; i < log_io_worker_num_; i++) {
+    const int64_t curr_working_time = ATOMIC_LOAD(&shards_[i].last_working_time_);
+    if (OB_INVALID_TIMESTAMP != curr_working_time
+        && (OB_INVALID_TIMESTAMP == last_working_time || curr_working_time < last_working_time)) {
+      last_working_time = curr_working_time;
+    }
+  }
+  return last_working_time;
+}
+
 void LogIOWorker::run1()
 {
-  lib::set_thread_name("IOWorker");
-  (void) run_loop_();
+  lib::set_thread_name("IOWorker", get_thread_idx());
+  (void) run_loop_(shards_[get_thread_idx()]);
 }
 
-int LogIOWorker::handle_io_task_(LogIOTask *io_task)
+int LogIOWorker::handle_io_task_(LogIOWorkerShard &shard, LogIOTask *io_task)
 {
   int ret = OB_SUCCESS;
 	int64_t start_ts = ObTimeUtility::current_time();
@@ -130,19 +153,20 @@ int LogIOWorker::handle_io_task_(LogIOTask *io_task)
     io_task->free_this(palf_env_impl_);
   }
 	int64_t cost_ts = ObTimeUtility::current_time() - start_ts;
-	do_task_used_ts_ += cost_ts;
-	do_task_count_ ++;
-	if (palf_reach_time_interval(5 * 1000 * 1000, print_log_interval_)) {
-		PALF_EVENT("io statistics", 0, K_(do_task_used_ts), K_(do_task_count),
-				"average_cost_ts", do_task_used_ts_ / do_task_count_,
-				"io_queue_size", queue_.size());
-		do_task_count_ = 0;
-		do_task_used_ts_ = 0;
+	shard.do_task_used_ts_ += cost_ts;
+	shard.do_task_count_ ++;
+	if (palf_reach_time_interval(5 * 1000 * 1000, shard.print_log_interval_)) {
+		PALF_EVENT("io statistics", 0, "do_task_used_ts", shard.do_task_used_ts_,
+				"do_task_count", shard.do_task_count_,
+				"average_cost_ts", shard.do_task_used_ts_ / shard.do_task_count_,
+				"io_queue_size", shard.queue_.size(), "thread_idx", get_thread_idx());
+		shard.do_task_count_ = 0;
+		shard.do_task_used_ts_ = 0;
 	};
   return ret;
 }
 
-int LogIOWorker::run_loop_()
+int LogIOWorker::run_loop_(LogIOWorkerShard &shard)
 {
   int ret = OB_SUCCESS;
 
@@ -150,10 +174,10 @@ int LogIOWorker::run_loop_()
       && false == (OB_NOT_NULL(&lib::Thread::current()) ? lib::Thread::current().has_set_stop() : false)) {
 
     void *task = NULL;
-    if (OB_SUCC(queue_.pop(task, QUEUE_WAIT_TIME))) {
-      ATOMIC_STORE(&last_working_time_, common::ObTimeUtility::fast_current_time());
-      ret = reduce_io_task_(task);
-      ATOMIC_STORE(&last_working_time_, OB_INVALID_TIMESTAMP);
+    if (OB_SUCC(shard.queue_.pop(task, QUEUE_WAIT_TIME))) {
+      ATOMIC_STORE(&shard.last_working_time_, common::ObTimeUtility::fast_current_time());
+      ret = reduce_io_task_(shard, task);
+      ATOMIC_STORE(&shard.last_working_time_, OB_INVALID_TIMESTAMP);
     }
   }
 
@@ -162,11 +186,11 @@ int LogIOWorker::run_loop_()
     void *task = NULL;
     ObILogAllocator *allocator = palf_env_impl_->get_log_allocator();
     CLOG_LOG(INFO, "before LogIOWorker destory", KPC(this), KPC(allocator));
-    while (OB_SUCC(queue_.pop(task))) {
+    while (OB_SUCC(shard.queue_.pop(task))) {
       LogIOTask *io_task = reinterpret_cast<LogIOTask *>(task);
-      ATOMIC_STORE(&last_working_time_, common::ObTimeUtility::fast_current_time());
-      (void)handle_io_task_(io_task);
-      ATOMIC_STORE(&last_working_time_, OB_INVALID_TIMESTAMP);
+      ATOMIC_STORE(&shard.last_working_time_, common::ObTimeUtility::fast_current_time());
+      (void)handle_io_task_(shard, io_task);
+      ATOMIC_STORE(&shard.last_working_time_, OB_INVALID_TIMESTAMP);
     }
     CLOG_LOG(INFO, "after LogIOWorker destory", KPC(this), KPC(allocator));
   }
@@ -189,9 +213,10 @@ bool LogIOWorker::need_reduce_(LogIOTask *io_task)
   return bool_ret;
 }
 
-int LogIOWorker::reduce_io_task_(void *task)
+int LogIOWorker::reduce_io_task_(LogIOWorkerShard &shard, void *task)
 {
-  OB_ASSERT(true == batch_io_task_mgr_.empty());
+  BatchLogIOFlushLogTaskMgr &batch_io_task_mgr = shard.batch_io_task_mgr_;
+  OB_ASSERT(true == batch_io_task_mgr.empty());
   int ret = OB_SUCCESS;
   LogIOTask *io_task = NULL;
   bool last_io_task_has_been_reduced = true;
@@ -215,23 +240,23 @@ int LogIOWorker::reduce_io_task_(void *task)
       // stop aggreating.
       // 1. there is no available BatchLogIOFlushLogTask in 'batch_io_task_mgr_';
       // 2. there is full in each BatchLogIOFlushLogTask in 'batch_io_task_mgr_'.
-      if (OB_SUCCESS != (tmp_ret = batch_io_task_mgr_.insert(flush_log_task))) {
+      if (OB_SUCCESS != (tmp_ret = batch_io_task_mgr.insert(flush_log_task))) {
         last_io_task_has_been_reduced = false;
         PALF_LOG(WARN, "batch_io_task_mgr_ insert failed", K(tmp_ret));
-      } else if (OB_SUCCESS == (tmp_ret = queue_.pop(task))) {
+      } else if (OB_SUCCESS == (tmp_ret = shard.queue_.pop(task))) {
       // When 'queue_' is empty, stop aggreating.
       } else {
       }
     }
   }
 
-  if (OB_FAIL(batch_io_task_mgr_.handle(cb_thread_pool_tg_id_, palf_env_impl_))) {
-    PALF_LOG(WARN, "batch_io_task_mgr_ handle failed", K(ret), K(batch_io_task_mgr_));
+  if (OB_FAIL(batch_io_task_mgr.handle(cb_thread_pool_tg_id_, palf_env_impl_))) {
+    PALF_LOG(WARN, "batch_io_task_mgr_ handle failed", K(ret), K(batch_io_task_mgr));
   }
 
   if (false == last_io_task_has_been_reduced && OB_NOT_NULL(io_task)) {
     io_task = reinterpret_cast<LogIOFlushLogTask *>(io_task);
-    ret = handle_io_task_(io_task);
+    ret = handle_io_task_(shard, io_task);
   }
   PALF_LOG(TRACE, "reduce_io_task_ finished", K(ret), K(tmp_ret), KPC(this));
   return ret;
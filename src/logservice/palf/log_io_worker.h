@@ -76,15 +76,21 @@ public:
 
   void run1() override final;
   int submit_io_task(LogIOTask *io_task);
-  int64_t get_last_working_time() const { return ATOMIC_LOAD(&last_working_time_); }
-  static constexpr int64_t MAX_THREAD_NUM = 1;
+  // return the earliest working time of all threads, used to detect io hang.
+  int64_t get_last_working_time() const;
+  static constexpr int64_t MAX_THREAD_NUM = 8;
   TO_STRING_KV(K_(log_io_worker_num), K_(cb_thread_pool_tg_id));
 private:
+  struct LogIOWorkerShard;
 
   bool need_reduce_(LogIOTask *task);
-  int reduce_io_task_(void *task);
-  int handle_io_task_(LogIOTask *io_task);
-  int run_loop_();
+  int reduce_io_task_(LogIOWorkerShard &shard, void *task);
+  int handle_io_task_(LogIOWorkerShard &shard, LogIOTask *io_task);
+  int run_loop_(LogIOWorkerShard &shard);
+  LogIOWorkerShard &get_shard_(const int64_t palf_id)
+  {
+    return shards_[palf_id % log_io_worker_num_];
+  }
 private:
   static constexpr int64_t QUEUE_WAIT_TIME = 100 * 1000;
 private:
@@ -110,20 +116,28 @@ private:
     int64_t batch_width_;
   };
 
-  // TODO: io_task_queue used to store all LogIOTask objects, and the LogIOWorker
-  //       will consume it, at nowdays, the io_task_queue is single consumer and mutil
-  //       producers model.
+  // Each thread consumes its own io task queue, which is single consumer and mutil
+  // producers model. The LogIOTasks of one palf are always submitted to the same
+  // queue, therefore, they are executed in order, and the tasks of different palfs
+  // are flushed concurrently.
+  struct LogIOWorkerShard
+  {
+    LogIOWorkerShard()
+      : queue_(), batch_io_task_mgr_(), do_task_used_ts_(0), do_task_count_(0),
+        print_log_interval_(OB_INVALID_TIMESTAMP), last_working_time_(OB_INVALID_TIMESTAMP)
+    {}
+    ObLightyQueue queue_;
+    BatchLogIOFlushLogTaskMgr batch_io_task_mgr_;
+    int64_t do_task_used_ts_;
+    int64_t do_task_count_;
+    int64_t print_log_interval_;
+    int64_t last_working_time_;
+  };
 
-  // NB: at nowdays, the default 'log_io_worker_num_' is 1.
   int64_t log_io_worker_num_;
   int cb_thread_pool_tg_id_;
   IPalfEnvImpl *palf_env_impl_;
-  ObLightyQueue queue_;
-  BatchLogIOFlushLogTaskMgr batch_io_task_mgr_;
-  int64_t do_task_used_ts_;
-  int64_t do_task_count_;
-  int64_t print_log_interval_;
-  int64_t last_working_time_;
+  LogIOWorkerShard shards_[MAX_THREAD_NUM];
   bool is_inited_;
 };
 } // end namespace palf
@@ -21,14 +21,100 @@
 #include "log_rpc.h"                                   // ObLgRpc
 #include "log_meta_info.h"                             // LogPrepareMeta
 #include "log_writer_utils.h"                          // LogWriteBuf
+#include "lib/compress/ob_compressor_pool.h"           // ObCompressorPool
 
 namespace oceanbase
 {
 using namespace common;
 namespace palf
 {
+void LogCompressSampler::reset()
+{
+  last_sample_time_us_ = OB_INVALID_TIMESTAMP;
+  compress_ratio_ = 0;
+  is_compressible_ = true;
+  compressed_cnt_ = 0;
+  uncompressed_cnt_ = 0;
+  last_print_time_us_ = OB_INVALID_TIMESTAMP;
+}
+
+bool LogCompressSampler::need_compress(const int64_t palf_id,
+                                       const PalfTransportCompressOptions &options,
+                                       const LogWriteBuf &write_buf)
+{
+  bool bool_ret = false;
+  const ObCompressorType compress_func = options.transport_compress_func_;
+  if (!options.enable_transport_compress_) {
+    // compression is disabled, no need sample
+  } else {
+    const int64_t curr_time_us = ObClockGenerator::getClock();
+    const int64_t last_sample_time_us = ATOMIC_LOAD(&last_sample_time_us_);
+    int64_t ratio = 0;
+    // only one thread samples at a time, others use the last result
+    if (MIN_SAMPLE_SIZE <= write_buf.get_total_size()
+        && curr_time_us - last_sample_time_us >= SAMPLE_INTERVAL_US
+        && ATOMIC_BCAS(&last_sample_time_us_, last_sample_time_us, curr_time_us)) {
+      if (OB_SUCCESS == sample_(compress_func, write_buf, ratio)) {
+        update_compress_ratio_(ratio);
+      }
+    }
+    bool_ret = ATOMIC_LOAD(&is_compressible_);
+    if (bool_ret) {
+      ATOMIC_INC(&compressed_cnt_);
+    } else {
+      ATOMIC_INC(&uncompressed_cnt_);
+    }
+    if (palf_reach_time_interval(PRINT_STAT_INTERVAL_US, last_print_time_us_)) {
+      PALF_LOG(INFO, "[PALF STAT TRANSPORT COMPRESS]", K(palf_id), K(compress_func), KPC(this));
+    }
+  }
+  return bool_ret;
+}
+
+void LogCompressSampler::update_compress_ratio_(const int64_t ratio)
+{
+  const int64_t last_ratio = ATOMIC_LOAD(&compress_ratio_);
+  const int64_t new_ratio = (0 == last_ratio) ? ratio : (last_ratio * 3 + ratio) / 4;
+  ATOMIC_STORE(&compress_ratio_, new_ratio);
+  ATOMIC_STORE(&is_compressible_, new_ratio < COMPRESSIBLE_RATIO_THRESHOLD);
+}
+
+// compress the head of write_buf to estimate the compress ratio
+int LogCompressSampler::sample_(const ObCompressorType compress_func,
+                                const LogWriteBuf &write_buf,
+                                int64_t &ratio) const
+{
+  int ret = OB_SUCCESS;
+  ObCompressor *compressor = NULL;
+  const char *src_buf = NULL;
+  int64_t src_len = 0;
+  int64_t max_overflow_size = 0;
+  int64_t dst_len = 0;
+  char dst_buf[SAMPLE_BUF_SIZE];
+  if (OB_FAIL(write_buf.get_write_buf(0, src_buf, src_len))) {
+    PALF_LOG(WARN, "get_write_buf failed", K(ret), K(write_buf));
+  } else if (FALSE_IT(src_len = MIN(src_len, MAX_SAMPLE_SIZE))) {
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(compress_func, compressor))) {
+    PALF_LOG(WARN, "get_compressor failed", K(ret), K(compress_func));
+  } else if (OB_ISNULL(compressor)) {
+    ret = OB_ERR_UNEXPECTED;
+    PALF_LOG(WARN, "compressor is NULL", K(ret), K(compress_func));
+  } else if (OB_FAIL(compressor->get_max_overflow_size(src_len, max_overflow_size))) {
+    PALF_LOG(WARN, "get_max_overflow_size failed", K(ret), K(src_len));
+  } else if (src_len + max_overflow_size > SAMPLE_BUF_SIZE) {
+    ret = OB_BUF_NOT_ENOUGH;
+    PALF_LOG(WARN, "sample buffer is not enough", K(ret), K(src_len), K(max_overflow_size));
+  } else if (OB_FAIL(compressor->compress(src_buf, src_len, dst_buf, SAMPLE_BUF_SIZE, dst_len))) {
+    PALF_LOG(WARN, "compress failed", K(ret), K(src_len), K(compress_func));
+  } else {
+    ratio = dst_len * 100 / src_len;
+  }
+  return ret;
+}
+
 LogNetService::LogNetService() : palf_id_(),
                                  log_rpc_(NULL),
+                                 compress_sampler_(),
                                  is_inited_(false)
 {
 }
@@ -58,6 +144,7 @@ void LogNetService::destroy()
     PALF_LOG(INFO, "LogNetService destroy success", K(palf_id_));
     is_inited_ = false;
     log_rpc_ = NULL;
+    compress_sampler_.reset();
     palf_id_ = 0;;
   }
 }
@@ -89,7 +176,9 @@ int LogNetService::submit_push_log_req(
                             prev_lsn,
                             curr_lsn,
                             write_buf);
-    ret = post_request_to_server_(server, push_log_req);
+    PalfTransportCompressOptions options;
+    get_push_log_compress_opts_(write_buf, options);
+    ret = post_request_to_server_(server, push_log_req, options);
   }
   return ret;
 }
@@ -364,5 +453,14 @@ int LogNetService::submit_get_stat_req(const common::ObAddr &server,
   }
   return ret;
 }
+
+void LogNetService::get_push_log_compress_opts_(const LogWriteBuf &write_buf,
+                                                PalfTransportCompressOptions &options)
+{
+  log_rpc_->get_compress_opts(options);
+  if (!compress_sampler_.need_compress(palf_id_, options, write_buf)) {
+    options.enable_transport_compress_ = false;
+  }
+}
 } // end namespace palf
 } // end namespace oceanbase
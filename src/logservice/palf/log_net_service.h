@@ -35,6 +35,43 @@ class LogConfigMeta;
 class LogRpc;
 class LogWriteBuf;
 
+// LogCompressSampler samples the compressibility of logs pushed by a log
+// stream, the transport compression of push log is skipped while the sampled
+// ratio is poor, because compressing such logs only burns cpu.
+class LogCompressSampler
+{
+public:
+  LogCompressSampler() { reset(); }
+  ~LogCompressSampler() { reset(); }
+  void reset();
+  // return false if the push log is not worth compressing with @options
+  bool need_compress(const int64_t palf_id,
+                     const PalfTransportCompressOptions &options,
+                     const LogWriteBuf &write_buf);
+  TO_STRING_KV(K_(last_sample_time_us), K_(compress_ratio), K_(is_compressible),
+      K_(compressed_cnt), K_(uncompressed_cnt));
+private:
+  int sample_(const common::ObCompressorType compress_func,
+              const LogWriteBuf &write_buf,
+              int64_t &ratio) const;
+  void update_compress_ratio_(const int64_t ratio);
+private:
+  static const int64_t SAMPLE_INTERVAL_US = 1 * 1000 * 1000;
+  static const int64_t MIN_SAMPLE_SIZE = 1024;
+  // the sample is compressed by the pushing thread, keep it small
+  static const int64_t MAX_SAMPLE_SIZE = 4 * 1024;
+  static const int64_t SAMPLE_BUF_SIZE = 2 * MAX_SAMPLE_SIZE;
+  // percent of compressed size to original size
+  static const int64_t COMPRESSIBLE_RATIO_THRESHOLD = 90;
+  static const int64_t PRINT_STAT_INTERVAL_US = 10 * 1000 * 1000;
+  int64_t last_sample_time_us_;
+  int64_t compress_ratio_;
+  bool is_compressible_;
+  int64_t compressed_cnt_;
+  int64_t uncompressed_cnt_;
+  int64_t last_print_time_us_;
+};
+
 class LogNetService
 {
 public:
@@ -68,7 +105,9 @@ public:
                               prev_lsn,
                               curr_lsn,
                               write_buf);
-      ret = post_request_to_member_list_(member_list, push_log_req);
+      PalfTransportCompressOptions options;
+      get_push_log_compress_opts_(write_buf, options);
+      ret = post_request_to_member_list_(member_list, push_log_req, options);
     }
     return ret;
   }
@@ -225,17 +264,30 @@ public:
   template <class ReqType>
   int post_request_to_server_(const common::ObAddr &server,
                               const ReqType &req);
+  template <class ReqType>
+  int post_request_to_server_(const common::ObAddr &server,
+                              const ReqType &req,
+                              const PalfTransportCompressOptions &options);
   template <class ReqType, class List = common::ObMemberList>
   int post_request_to_member_list_(const List &member_list,
                                    const ReqType &req);
+  template <class ReqType, class List = common::ObMemberList>
+  int post_request_to_member_list_(const List &member_list,
+                                   const ReqType &req,
+                                   const PalfTransportCompressOptions &options);
   template <class ReqType, class RespType>
   int post_sync_request_to_server_(const common::ObAddr &server,
                                    const int64_t timeout_us,
                                    const ReqType &req,
                                    RespType &resp);
+private:
+  // the options are copied once, and shared by the sampler and the posted rpc.
+  void get_push_log_compress_opts_(const LogWriteBuf &write_buf,
+                                   PalfTransportCompressOptions &options);
 private:
   int64_t palf_id_;
   LogRpc *log_rpc_;
+  LogCompressSampler compress_sampler_;
   bool is_inited_;
 };
 
@@ -243,9 +295,20 @@ template <class ReqType>
 int LogNetService::post_request_to_server_(
     const common::ObAddr &server,
     const ReqType &req)
+{
+  PalfTransportCompressOptions options;
+  log_rpc_->get_compress_opts(options);
+  return post_request_to_server_(server, req, options);
+}
+
+template <class ReqType>
+int LogNetService::post_request_to_server_(
+    const common::ObAddr &server,
+    const ReqType &req,
+    const PalfTransportCompressOptions &options)
 {
   int ret = common::OB_SUCCESS;
-  if (OB_FAIL(log_rpc_->post_request(server, palf_id_, req))) {
+  if (OB_FAIL(log_rpc_->post_request(server, palf_id_, req, options))) {
     // PALF_LOG(WARN, "LogRpc post_request failed", K(ret), K(palf_id_),
     //     K(req), K(server));
   } else {
@@ -258,23 +321,23 @@ template <class ReqType, class List>
 int LogNetService::post_request_to_member_list_(
     const List &member_list,
     const ReqType &req)
+{
+  PalfTransportCompressOptions options;
+  log_rpc_->get_compress_opts(options);
+  return post_request_to_member_list_(member_list, req, options);
+}
+
+template <class ReqType, class List>
+int LogNetService::post_request_to_member_list_(
+    const List &member_list,
+    const ReqType &req,
+    const PalfTransportCompressOptions &options)
 {
   int ret = common::OB_SUCCESS;
-  int64_t member_number = member_list.get_member_number();
-  common::ObAddr server;
   if (!req.is_valid() || !member_list.is_valid()) {
     ret = OB_INVALID_ARGUMENT;
-  } else {
-    for (int64_t i = 0; i < member_number; i++) {
-      if (OB_FAIL(member_list.get_server_by_index(i, server))) {
-        PALF_LOG(WARN, "ObMemberList get_server_by_index failed", K(ret),
-            K(server), K(palf_id_), K(req));
-      } else if (OB_FAIL(post_request_to_server_(server, req))) {
-        // PALF_LOG(WARN, "post_request_to_server_ failed", K(ret),
-        //     K(server), K(palf_id_), K(server));
-      } else {
-      }
-    }
+  } else if (OB_FAIL(log_rpc_->post_request_to_member_list(member_list, palf_id_, req, options))) {
+    // failed destinations have been reported by LogRpc with rate limit
   }
   return ret;
 }
@@ -25,6 +25,7 @@ LogRpc::LogRpc() : rpc_proxy_(NULL),
                    opt_lock_(),
                    options_(),
                    tenant_id_(0),
+                   last_post_fail_warn_time_(OB_INVALID_TIMESTAMP),
                    is_inited_(false)
 {
 }
@@ -76,10 +77,10 @@ int LogRpc::update_transport_compress_options(const PalfTransportCompressOptions
   return ret;
 }
 
-const PalfTransportCompressOptions& LogRpc::get_compress_opts() const
+void LogRpc::get_compress_opts(PalfTransportCompressOptions &options) const
 {
   ObSpinLockGuard guard(opt_lock_);
-  return options_;
+  options = options_;
 }
 
 } // end namespace palf
@@ -16,6 +16,7 @@
 #include "lib/ob_errno.h"
 #include "lib/utility/ob_macro_utils.h"            // IS_NOT_INIT
 #include "lib/net/ob_addr.h"                       // ObAddr
+#include "lib/container/ob_se_array.h"             // ObSEArray
 #include "rpc/obrpc/ob_rpc_packet.h"               // ObRpcPacketCode
 #include "log_rpc_macros.h"                        // MACROS...
 #include "log_rpc_packet.h"                        // LogRpcPacketImpl
@@ -75,11 +76,24 @@ public:
            rpc::frame::ObReqTransport *transport);
   void destroy();
   int update_transport_compress_options(const PalfTransportCompressOptions &compress_opt);
-  const PalfTransportCompressOptions& get_compress_opts() const;
+  // copy the options under lock, they may be updated concurrently.
+  void get_compress_opts(PalfTransportCompressOptions &options) const;
   template<class ReqType>
   int post_request(const common::ObAddr &server,
                    const int64_t palf_id,
                    const ReqType &req)
+  {
+    PalfTransportCompressOptions options;
+    get_compress_opts(options);
+    return post_request(server, palf_id, req, options);
+  }
+
+  // post with the options which have been copied by get_compress_opts
+  template<class ReqType>
+  int post_request(const common::ObAddr &server,
+                   const int64_t palf_id,
+                   const ReqType &req,
+                   const PalfTransportCompressOptions &options)
   {
     int ret = common::OB_SUCCESS;
     if (IS_NOT_INIT) {
@@ -90,12 +104,86 @@ public:
       ret = OB_INVALID_ARGUMENT;
     } else {
       LogRpcPacketImpl<ReqType> packet(self_, palf_id, req);
-      ret = rpc_proxy_.post_packet(server, packet, tenant_id_, options_);
+      ret = rpc_proxy_.post_packet(server, packet, tenant_id_, options);
       PALF_LOG(TRACE, "post_packet finished", K(ret), K(server), K(tenant_id_));
     }
     return ret;
   }
 
+  // the packet is built once and shared by all destinations, only the
+  // destination address differs between the posted rpcs.
+  template<class ReqType, class List>
+  int post_request_to_member_list(const List &member_list,
+                                  const int64_t palf_id,
+                                  const ReqType &req)
+  {
+    PalfTransportCompressOptions options;
+    get_compress_opts(options);
+    return post_request_to_member_list(member_list, palf_id, req, options);
+  }
+
+  template<class ReqType, class List>
+  int post_request_to_member_list(const List &member_list,
+                                  const int64_t palf_id,
+                                  const ReqType &req,
+                                  const PalfTransportCompressOptions &options)
+  {
+    int ret = common::OB_SUCCESS;
+    if (IS_NOT_INIT) {
+      ret = OB_NOT_INIT;
+    } else if (false == member_list.is_valid()
+               || false == is_valid_palf_id(palf_id)
+               || false == req.is_valid()) {
+      ret = OB_INVALID_ARGUMENT;
+    } else {
+      const LogRpcPacketImpl<ReqType> packet(self_, palf_id, req);
+      common::ObSEArray<common::ObAddr, common::OB_MAX_MEMBER_NUMBER> failed_servers;
+      ret = post_packet_to_member_list(rpc_proxy_, member_list, packet, tenant_id_, options, failed_servers);
+      // push log is posted for every group log, do not flood the log when a member is unreachable
+      if (OB_FAIL(ret) && palf_reach_time_interval(POST_FAIL_WARN_INTERVAL_US, last_post_fail_warn_time_)) {
+        PALF_LOG(WARN, "post_packet to member list failed", K(ret), K(palf_id), K(tenant_id_),
+            K(failed_servers), K(member_list));
+      }
+    }
+    return ret;
+  }
+
+  // Post the packet to every valid member, failure of one destination does not affect
+  // others. The failed destinations are collected (an invalid address stands for a member
+  // which can not be fetched), and the first failure is returned after all destinations
+  // have been tried.
+  template<class Proxy, class Packet, class List>
+  static int post_packet_to_member_list(Proxy &proxy,
+                                        const List &member_list,
+                                        const Packet &packet,
+                                        const int64_t tenant_id,
+                                        const PalfTransportCompressOptions &options,
+                                        common::ObIArray<common::ObAddr> &failed_servers)
+  {
+    int ret = common::OB_SUCCESS;
+    const int64_t member_number = member_list.get_member_number();
+    common::ObAddr server;
+    for (int64_t i = 0; i < member_number; i++) {
+      int tmp_ret = OB_SUCCESS;
+      server.reset();
+      if (OB_SUCCESS != (tmp_ret = member_list.get_server_by_index(i, server))) {
+        server.reset();
+      } else if (false == server.is_valid()) {
+        // skip invalid server
+      } else if (OB_SUCCESS != (tmp_ret = proxy.post_packet(server, packet, tenant_id, options))) {
+      } else {
+        PALF_LOG(TRACE, "post_packet finished", K(tmp_ret), K(server), K(tenant_id));
+      }
+      if (OB_SUCCESS != tmp_ret) {
+        (void) failed_servers.push_back(server);
+        if (OB_SUCC(ret)) {
+          ret = tmp_ret;
+        }
+      }
+    }
+    return ret;
+  }
+
   template<class ReqType, class RespType>
   int post_sync_request(const common::ObAddr &server,
                         const int64_t palf_id,
@@ -111,9 +199,11 @@ public:
                || false == req.is_valid()) {
       ret = OB_INVALID_ARGUMENT;
     } else {
+      PalfTransportCompressOptions options;
+      get_compress_opts(options);
       LogRpcPacketImpl<ReqType> req_packet(self_, palf_id, req);
       LogRpcPacketImpl<RespType> resp_packet(server, palf_id, resp);
-      ret = rpc_proxy_.post_sync_packet(server, tenant_id_, options_, timeout_us, req_packet, resp_packet);
+      ret = rpc_proxy_.post_sync_packet(server, tenant_id_, options, timeout_us, req_packet, resp_packet);
       resp = resp_packet.req_;
       PALF_LOG(TRACE, "post_sync_request", K(tenant_id_), K(palf_id), K(req), K(resp));
     }
@@ -122,11 +212,13 @@ public:
 
   TO_STRING_KV(K_(self), K_(is_inited));
 private:
+  static const int64_t POST_FAIL_WARN_INTERVAL_US = 1 * 1000 * 1000;
   ObAddr self_;
   obrpc::LogRpcProxyV2 rpc_proxy_;
   mutable ObSpinLock opt_lock_;
   PalfTransportCompressOptions options_;
   int64_t tenant_id_;
+  int64_t last_post_fail_warn_time_;
   bool is_inited_;
 };
 } // end namespace palf
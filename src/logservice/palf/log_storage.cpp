@@ -26,6 +26,7 @@ class LogReader;
 LogStorage::LogStorage() :
     block_mgr_(),
     log_reader_(),
+    log_cache_(),
     log_tail_(),
     log_block_header_(),
     curr_block_writable_size_(0),
@@ -94,6 +95,29 @@ int LogStorage::load_manifest_for_meta_storage(block_id_t &expected_next_block_i
   return ret;
 }
 
+int LogStorage::init_log_cache(const int64_t cache_size, LogCacheBudget *budget)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+  } else if (0 == cache_size) {
+    // all reads fall through to block file when the cache is not inited.
+    PALF_LOG(INFO, "LogCache is turned off", K_(palf_id));
+  } else if (OB_FAIL(log_cache_.init(palf_id_, cache_size, budget))) {
+    if (OB_EXCEED_MEM_LIMIT == ret) {
+      // the tenant has too many log streams for its memory, go without the cache
+      PALF_LOG(INFO, "LogCache is turned off by tenant budget", K(ret), K_(palf_id), K(cache_size));
+      ret = OB_SUCCESS;
+    } else {
+      PALF_LOG(WARN, "LogCache init failed", K(ret), KPC(this));
+    }
+  } else {
+    // the log before log_tail_ has not been cached.
+    log_cache_.reset(log_tail_);
+  }
+  return ret;
+}
+
 void LogStorage::destroy()
 {
   is_inited_ = false;
@@ -104,6 +128,7 @@ void LogStorage::destroy()
   log_block_header_.reset();
   readable_log_tail_.reset();
   log_tail_.reset();
+  log_cache_.destroy();
   log_reader_.destroy();
   block_mgr_.destroy();
   PALF_LOG(INFO, "LogStorage destroy success");
@@ -142,6 +167,8 @@ int LogStorage::writev(const LSN &lsn, const LogWriteBuf &write_buf, const SCN &
     PALF_LOG(ERROR, "LogVirtualFileMgr writev failed", K(ret), K(write_buf), K(lsn));
   } else {
     curr_block_writable_size_ -= write_size;
+    // fill cache before log_tail_ is advanced, the reader always find the log in cache or block.
+    log_cache_.fill(lsn, write_buf);
     update_log_tail_guarded_by_lock_(write_size);
     PALF_LOG(TRACE, "LogStorage writev success", K(ret), K(log_block_header_), K(lsn),
              K(log_tail_), K(write_buf), KPC(this));
@@ -817,6 +844,11 @@ int LogStorage::inner_pread_(const LSN &read_lsn,
   if (read_lsn >= log_tail) {
     ret = OB_ERR_OUT_OF_UPPER_BOUND;
     PALF_LOG(WARN, "read something out of upper bound", K(ret), K(read_lsn), K(log_tail_));
+  } else if (real_read_offset == get_phy_offset_(read_lsn)
+             && log_tail == get_log_tail_guarded_by_lock_()
+             && OB_SUCCESS == log_cache_.read(read_lsn, real_in_read_size, read_buf.buf_)) {
+    // hit in cache, the block header and the log in flashback are never cached.
+    out_read_size = real_in_read_size;
   } else if (OB_FAIL(log_reader_.pread(read_block_id,
                                        real_read_offset,
                                        real_in_read_size,
@@ -849,6 +881,7 @@ void LogStorage::reset_log_tail_for_last_block_(const LSN &lsn, bool last_block_
   (void)truncate_block_header_(lsn);
   curr_block_writable_size_ = (true == last_block_exist) ? logical_block_size_ - logical_offset : 0;
   need_append_block_header_ = (curr_block_writable_size_ == logical_block_size_) ? true : false;
+  log_cache_.reset(lsn);
   log_tail_ = readable_log_tail_ = lsn;
 }
 } // end namespace palf
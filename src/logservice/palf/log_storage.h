@@ -17,6 +17,7 @@
 #include "share/ob_errno.h"        // errno
 #include "log_block_header.h"      // LogBlockHeader
 #include "log_block_mgr.h"         // LogBlockMgr
+#include "log_cache.h"             // LogCache
 #include "log_reader.h"            // LogReader
 #include "log_storage_interface.h" // ILogStorage
 #include "log_writer_utils.h"      // LogWriteBuf
@@ -66,6 +67,9 @@ public:
            LSN &lsn);
 
   int load_manifest_for_meta_storage(block_id_t &expected_next_block_id);
+  // only used for log storage, the meta storage is never read frequently.
+  // the cache is turned off if cache_size is 0.
+  int init_log_cache(const int64_t cache_size, LogCacheBudget *budget);
   void destroy();
 
   int writev(const LSNArray &lsn_array, const LogWriteBufArray &write_buf_array, const SCNArray &scn_array);
@@ -171,6 +175,8 @@ private:
   // Used to perform IO tasks in the background
   LogBlockMgr block_mgr_;
   LogReader log_reader_;
+  // cache the tail of flushed log for reading
+  LogCache log_cache_;
   LSN log_tail_;
   // always same as 'log_tail_' except in process of flashback.
   LSN readable_log_tail_;
@@ -12,6 +12,7 @@
 
 #include "palf_env_impl.h"
 #include <string.h>
+#include "lib/alloc/alloc_func.h"
 #include "lib/lock/ob_spin_lock.h"
 #include "lib/ob_define.h"
 #include "lib/ob_errno.h"
@@ -145,6 +146,8 @@ PalfEnvImpl::PalfEnvImpl() : palf_meta_lock_(common::ObLatchIds::PALF_ENV_LOCK),
                              self_(),
                              palf_handle_impl_map_(64),  // 指定min_size=64
                              last_palf_epoch_(0),
+                             log_cache_size_(0),
+                             log_cache_budget_(),
                              diskspace_enough_(true),
                              tenant_id_(0),
                              is_inited_(false),
@@ -170,8 +173,8 @@ int PalfEnvImpl::init(
 {
   int ret = OB_SUCCESS;
   int pret = 0;
-  // TODO by runlin: configurable
-  log_io_worker_config_.io_worker_num_ = 1;
+  // the log io tasks of one palf are always handled by the same io worker thread.
+  log_io_worker_config_.io_worker_num_ = options.log_writer_parallelism_;
   log_io_worker_config_.io_queue_capcity_ = 100 * 1024;
   log_io_worker_config_.batch_width_ = 8;
   log_io_worker_config_.batch_depth_ = PALF_SLIDING_WINDOW_SIZE;
@@ -223,6 +226,7 @@ int PalfEnvImpl::init(
     log_block_pool_ = log_block_pool;
     self_ = self;
     tenant_id_ = tenant_id;
+    log_cache_size_ = options.log_cache_size_;
     is_inited_ = true;
     is_running_ = true;
     PALF_LOG(INFO, "PalfEnvImpl init success", K(ret), K(self_), KPC(this));
@@ -809,7 +813,9 @@ int PalfEnvImpl::get_options(PalfOptions &options)
     ret = OB_NOT_INIT;
   } else {
     options.disk_options_ = disk_options_wrapper_.get_disk_opts_for_recycling_blocks();
-    options.compress_options_ = log_rpc_.get_compress_opts();
+    log_rpc_.get_compress_opts(options.compress_options_);
+    options.log_writer_parallelism_ = log_io_worker_config_.io_worker_num_;
+    options.log_cache_size_ = log_cache_size_;
   }
   return ret;
 }
@@ -1153,6 +1159,19 @@ int64_t PalfEnvImpl::get_tenant_id()
 {
   return tenant_id_;
 }
+
+int64_t PalfEnvImpl::get_log_cache_size()
+{
+  return log_cache_size_;
+}
+
+// the limit follows the tenant memory, which may be resized
+LogCacheBudget *PalfEnvImpl::get_log_cache_budget()
+{
+  const int64_t tenant_memory = lib::get_tenant_memory_limit(tenant_id_);
+  log_cache_budget_.set_limit(tenant_memory / 100 * PALF_LOG_CACHE_MEMORY_PERCENTAGE);
+  return &log_cache_budget_;
+}
 int PalfEnvImpl::update_replayable_point(const SCN &replayable_scn)
 {
   int ret = OB_SUCCESS;
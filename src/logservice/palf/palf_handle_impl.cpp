@@ -144,6 +144,9 @@ int PalfHandleImpl::init(const int64_t palf_id,
           log_io_worker, palf_epoch, PALF_BLOCK_SIZE, PALF_META_BLOCK_SIZE))) {
     PALF_LOG(WARN, "LogEngine init failed", K(ret), K(palf_id), K(log_dir), K(alloc_mgr),
         K(log_rpc), K(log_io_worker));
+  } else if (OB_FAIL(log_engine_.init_log_cache(palf_env_impl->get_log_cache_size(),
+                                                palf_env_impl->get_log_cache_budget()))) {
+    PALF_LOG(WARN, "LogEngine init_log_cache failed", K(ret), K(palf_id));
   } else if (OB_FAIL(do_init_mem_(palf_id, palf_base_info, log_meta, log_dir, self, fetch_log_engine,
           alloc_mgr, log_rpc, log_io_worker, palf_env_impl, election_timer))) {
     PALF_LOG(WARN, "PalfHandleImpl do_init_mem_ failed", K(ret), K(palf_id));
@@ -186,6 +189,7 @@ int PalfHandleImpl::load(const int64_t palf_id,
              || NULL == alloc_mgr
              || NULL == log_rpc
              || NULL == log_io_worker
+             || NULL == palf_env_impl
              || false == self.is_valid()) {
     ret = OB_INVALID_ARGUMENT;
     PALF_LOG(ERROR, "Invalid argument!!!", K(ret), K(palf_id), K(log_dir), K(alloc_mgr),
@@ -197,6 +201,9 @@ int PalfHandleImpl::load(const int64_t palf_id,
     //     to 'base_lsn_', we will generate default PalfBaseInfo or get it from LogSnapshotMeta(rebuild).
   } else if (false == is_integrity) {
     PALF_LOG(INFO, "palf instance is not integrity", KPC(this));
+  } else if (OB_FAIL(log_engine_.init_log_cache(palf_env_impl->get_log_cache_size(),
+                                                palf_env_impl->get_log_cache_budget()))) {
+    PALF_LOG(WARN, "LogEngine init_log_cache failed", K(ret), K(palf_id));
   } else if (FALSE_IT(snapshot_meta = log_engine_.get_log_meta().get_log_snapshot_meta())) {
   } else if (FALSE_IT(max_committed_end_lsn =
          (true == entry_header.is_valid() ? entry_header.get_committed_end_lsn() : snapshot_meta.base_lsn_)))  {
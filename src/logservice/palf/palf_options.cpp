@@ -21,11 +21,14 @@ void PalfOptions::reset()
 {
   disk_options_.reset();
   compress_options_.reset();
+  log_writer_parallelism_ = 1;
+  log_cache_size_ = PALF_LOG_CACHE_SIZE;
 }
 
 bool PalfOptions::is_valid() const
 {
-  return disk_options_.is_valid() && compress_options_.is_valid();
+  return disk_options_.is_valid() && compress_options_.is_valid() && 0 < log_writer_parallelism_
+      && 0 <= log_cache_size_;
 }
 
 void PalfDiskOptions::reset()
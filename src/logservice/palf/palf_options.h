@@ -13,6 +13,7 @@
 #ifndef OCEANBASE_LOGSERVICE_PALF_OPTIONS_
 #define OCEANBASE_LOGSERVICE_PALF_OPTIONS_
 #include "lib/compress/ob_compress_util.h"
+#include "log_define.h"
 #include "share/ob_partition_modify.h"
 #include <stdint.h>
 namespace oceanbase
@@ -161,16 +162,24 @@ public:
 struct PalfOptions
 {
   PalfOptions() : disk_options_(),
-                  compress_options_()
+                  compress_options_(),
+                  log_writer_parallelism_(1),
+                  log_cache_size_(PALF_LOG_CACHE_SIZE)
   {}
   ~PalfOptions() { reset(); }
   void reset();
   bool is_valid() const;
   TO_STRING_KV(K(disk_options_),
-               K(compress_options_));
+               K(compress_options_),
+               K(log_writer_parallelism_),
+               K(log_cache_size_));
 public:
   PalfDiskOptions disk_options_;
   PalfTransportCompressOptions compress_options_;
+  // the number of log io worker threads, only effective when creating PalfEnv.
+  int64_t log_writer_parallelism_;
+  // the size of LogCache of each palf, 0 means no cache, only effective when creating PalfEnv.
+  int64_t log_cache_size_;
 };
 } // end namespace palf
 } // end namspace oceanbase
@@ -1140,6 +1140,19 @@ int ObReplayStatus::push_log_replay_task(ObLogReplayTask &task)
     const uint64_t queue_idx = calc_replay_queue_idx(task.replay_hint_);
     ObReplayServiceReplayTask &task_queue = task_queues_[queue_idx];
     task_queue.push(&task);
+    // The logs of different queues have no dependency on each other, so hand the
+    // queue to replay service at once if no replay thread is working on it, idle
+    // threads can take it without waiting for the batch push. The busy queue is
+    // still pushed in batch, which is the common case when catching up.
+    if (task_queue.is_lease_idle()) {
+      int tmp_ret = OB_SUCCESS;
+      if (OB_SUCCESS != (tmp_ret = submit_task_to_replay_service_(task_queue))) {
+        CLOG_LOG(WARN, "failed to push idle replay task queue to replay service", K(tmp_ret),
+                 K(task_queue), KPC(this));
+      } else {
+        task_queue.set_batch_push_finish();
+      }
+    }
   }
   return ret;
 }
@@ -1326,6 +1339,9 @@ int ObReplayStatus::submit_task_to_replay_service_(ObReplayServiceTask &task)
       CLOG_LOG(ERROR, "failed to submit task to replay service", KPC(this),
                  K(task), K(ret));
       dec_ref();
+      // give back the lease, otherwise the task can never be submitted again and the
+      // caller can not retry, e.g. the queue left for batch push
+      while (!task.revoke_lease()) {}
     }
   }
   return ret;
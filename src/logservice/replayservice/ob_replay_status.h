@@ -214,6 +214,11 @@ public:
   {
     return lease_.revoke();
   }
+  // no replay thread holds or waits for this task
+  bool is_lease_idle() const
+  {
+    return common::ObThreadLease::IDLE == lease_.value();
+  }
 
   ObReplayServiceTaskType get_type() const
   {
@@ -1784,7 +1784,8 @@ int ObServer::init_io()
           } else if (OB_FAIL(ObIOManager::get_instance().add_device_channel(THE_IO_DEVICE,
                                                                             io_config.disk_io_thread_count_,
                                                                             io_config.disk_io_thread_count_ / 2,
-                                                                            max_io_depth))) {
+                                                                            max_io_depth,
+                                                                            GCONF._enable_io_uring))) {
             LOG_ERROR("add device channel failed", KR(ret));
           } else if (OB_FAIL(ObIOManager::get_instance().add_tenant_io_manager(OB_SERVER_TENANT_ID,
                                                                                server_tenant_io_config))) {
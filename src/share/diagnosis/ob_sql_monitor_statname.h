@@ -56,6 +56,9 @@ SQL_MONITOR_STATNAME_DEF(SSTABLE_INSERT_ROW_COUNT, sql_monitor_statname::INT, "s
 SQL_MONITOR_STATNAME_DEF(IO_READ_BYTES, sql_monitor_statname::CAPACITY, "total io bytes read from disk", "total io bytes read from storage")
 SQL_MONITOR_STATNAME_DEF(TOTAL_READ_BYTES, sql_monitor_statname::CAPACITY, "total bytes processed by storage", "total bytes processed by storage, including memtable")
 SQL_MONITOR_STATNAME_DEF(TOTAL_READ_ROW_COUNT, sql_monitor_statname::INT, "total rows processed by storage", "total rows processed by storage, including memtable")
+// Nested Loop Join adaptive hash probe
+SQL_MONITOR_STATNAME_DEF(NLJ_ADAPTIVE_SWITCH_ROW, sql_monitor_statname::INT, "adaptive switch left row", "left row count when nested loop join switched to hash probe")
+SQL_MONITOR_STATNAME_DEF(NLJ_ADAPTIVE_HASH_ROW_COUNT, sql_monitor_statname::INT, "adaptive hash row count", "right row count in the hash table built by nested loop join")
 
 //end
 SQL_MONITOR_STATNAME_DEF(MONITOR_STATNAME_END, sql_monitor_statname::INVALID, "monitor end", "monitor stat name end")
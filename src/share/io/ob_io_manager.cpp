@@ -385,7 +385,8 @@ int ObIOManager::reset_device_health()
 int ObIOManager::add_device_channel(ObIODevice *device_handle,
                                     const int64_t async_channel_count,
                                     const int64_t sync_channel_count,
-                                    const int64_t max_io_depth)
+                                    const int64_t max_io_depth,
+                                    const bool enable_io_uring)
 {
   int ret = OB_SUCCESS;
   ObDeviceChannel *device_channel = nullptr;
@@ -404,8 +405,9 @@ int ObIOManager::add_device_channel(ObIODevice *device_handle,
                                           async_channel_count,
                                           sync_channel_count,
                                           max_io_depth,
-                                          allocator_))) {
-    LOG_WARN("init device_channel failed", K(ret), K(async_channel_count), K(sync_channel_count));
+                                          allocator_,
+                                          enable_io_uring))) {
+    LOG_WARN("init device_channel failed", K(ret), K(async_channel_count), K(sync_channel_count), K(enable_io_uring));
   } else if (OB_FAIL(channel_map_.set_refactored(reinterpret_cast<int64_t>(device_handle), device_channel))) {
     LOG_WARN("set channel map failed", K(ret), KP(device_handle));
   } else {
@@ -454,6 +456,54 @@ int ObIOManager::get_device_channel(const ObIODevice *device_handle, ObDeviceCha
   return ret;
 }
 
+int ObIOManager::register_io_buffer(const char *begin, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (OB_UNLIKELY(nullptr == begin || size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(begin), K(size));
+  } else {
+    hash::ObHashMap<int64_t, ObDeviceChannel *>::iterator iter = channel_map_.begin();
+    for (; OB_SUCC(ret) && iter != channel_map_.end(); ++iter) {
+      if (OB_ISNULL(iter->second)) {
+        // skip
+      } else if (OB_FAIL(iter->second->register_io_buffer(begin, size))) {
+        if (OB_NOT_SUPPORTED == ret) {
+          ret = OB_SUCCESS;
+        } else {
+          LOG_WARN("register io buffer failed", K(ret), KP(begin), K(size), KPC(iter->second));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObIOManager::unregister_io_buffer(const char *begin)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (OB_ISNULL(begin)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(begin));
+  } else {
+    hash::ObHashMap<int64_t, ObDeviceChannel *>::iterator iter = channel_map_.begin();
+    for (; iter != channel_map_.end(); ++iter) { // ignore ret
+      int tmp_ret = OB_SUCCESS;
+      if (OB_NOT_NULL(iter->second) && OB_TMP_FAIL(iter->second->unregister_io_buffer(begin))) {
+        ret = tmp_ret;
+        LOG_WARN("unregister io buffer failed", K(ret), KP(begin), KPC(iter->second));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObIOManager::add_tenant_io_manager(const uint64_t tenant_id, const ObTenantIOConfig &tenant_io_config)
 {
   int ret = OB_SUCCESS;
@@ -618,6 +668,7 @@ void ObTenantIOManager::mtl_destroy(ObTenantIOManager *&io_service)
 ObTenantIOManager::ObTenantIOManager()
   : is_inited_(false),
     is_working_(false),
+    is_io_buffer_registered_(false),
     ref_cnt_(0),
     tenant_id_(0),
     io_config_(),
@@ -665,6 +716,7 @@ int ObTenantIOManager::init(const uint64_t tenant_id,
   } else {
     tenant_id_ = tenant_id;
     io_scheduler_ = io_scheduler;
+    register_io_buffer();
     is_inited_ = true;
   }
   if (OB_UNLIKELY(!is_inited_)) {
@@ -673,6 +725,35 @@ int ObTenantIOManager::init(const uint64_t tenant_id,
   return ret;
 }
 
+void ObTenantIOManager::register_io_buffer()
+{
+  int ret = OB_SUCCESS;
+  char *begin = nullptr;
+  int64_t size = 0;
+  io_allocator_.get_macro_pool_region(begin, size);
+  if (nullptr != begin && size > 0) {
+    if (OB_FAIL(OB_IO_MANAGER.register_io_buffer(begin, size))) {
+      LOG_WARN("register macro pool as io buffer failed, ignore it", K(ret), K(tenant_id_), KP(begin), K(size));
+    } else {
+      is_io_buffer_registered_ = true;
+    }
+  }
+}
+
+void ObTenantIOManager::unregister_io_buffer()
+{
+  int ret = OB_SUCCESS;
+  char *begin = nullptr;
+  int64_t size = 0;
+  io_allocator_.get_macro_pool_region(begin, size);
+  if (is_io_buffer_registered_ && nullptr != begin) {
+    if (OB_FAIL(OB_IO_MANAGER.unregister_io_buffer(begin))) {
+      LOG_WARN("unregister macro pool failed", K(ret), K(tenant_id_), KP(begin));
+    }
+  }
+  is_io_buffer_registered_ = false;
+}
+
 void ObTenantIOManager::destroy()
 {
   ATOMIC_SET(&is_working_, false);
@@ -686,6 +767,7 @@ void ObTenantIOManager::destroy()
   io_tracer_.destroy();
   io_scheduler_ = nullptr;
   tenant_id_ = 0;
+  unregister_io_buffer();
   io_allocator_.destroy();
   group_id_index_map_.destroy();
   is_inited_ = false;
@@ -63,9 +63,13 @@ public:
   int add_device_channel(ObIODevice *device_handle,
                          const int64_t async_channel_count,
                          const int64_t sync_channel_count,
-                         const int64_t max_io_depth);
+                         const int64_t max_io_depth,
+                         const bool enable_io_uring = false);
   int remove_device_channel(ObIODevice *device_handle);
   int get_device_channel(const ObIODevice *device_handle, ObDeviceChannel *&device_channel);
+  // register io buffer memory to all device channels, best effort
+  int register_io_buffer(const char *begin, const int64_t size);
+  int unregister_io_buffer(const char *begin);
 
   // tenant management
   int add_tenant_io_manager(const uint64_t tenant_id, const ObTenantIOConfig &tenant_io_config);
@@ -156,10 +160,14 @@ public:
   void dec_ref();
   TO_STRING_KV(K(is_inited_), K(ref_cnt_), K(tenant_id_), K(io_config_), K(io_clock_),
        K(io_allocator_), KPC(io_scheduler_), K(callback_mgr_));
+private:
+  void register_io_buffer();
+  void unregister_io_buffer();
 private:
   friend class ObIORequest;
   bool is_inited_;
   bool is_working_;
+  bool is_io_buffer_registered_;
   int64_t ref_cnt_;
   uint64_t tenant_id_;
   ObTenantIOConfig io_config_;
@@ -22,6 +22,7 @@
 #include "lib/utility/ob_tracepoint.h"
 #include "lib/file/file_directory_utils.h"
 #include "share/io/ob_io_manager.h"
+#include "share/ob_local_device.h"
 #include "observer/ob_server.h"
 
 using namespace oceanbase::lib;
@@ -337,6 +338,12 @@ int ObIOAllocator::calculate_pool_block_count(const int64_t memory_limit, int64_
   return ret;
 }
 
+void ObIOAllocator::get_macro_pool_region(char *&begin, int64_t &size) const
+{
+  begin = macro_pool_.get_begin_ptr();
+  size = nullptr == begin ? 0 : macro_pool_.get_total_size();
+}
+
 int ObIOAllocator::init_macro_pool(const int64_t memory_limit)
 {
   int ret = OB_SUCCESS;
@@ -1703,6 +1710,150 @@ void ObIOChannel::destroy_thread()
   }
 }
 
+void ObIOChannel::stop()
+{
+  if (tg_id_ >= 0) {
+    TG_STOP(tg_id_);
+  }
+}
+
+void ObIOChannel::wait()
+{
+  if (tg_id_ >= 0) {
+    TG_WAIT(tg_id_);
+  }
+}
+
+int ObIOChannel::on_io_return(ObIORequest &req, const int system_errno, const int64_t complete_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_LIKELY(0 == system_errno)) { // io succ
+    if (complete_size == req.io_size_) { // full complete
+      LOG_DEBUG("Success to get io event", K(req), K(complete_size));
+      if (OB_FAIL(on_full_return(req))) {
+        LOG_WARN("process full return io request failed", K(ret), K(req));
+      }
+    } else if (complete_size >= 0 && complete_size < req.io_size_) { // partial complete
+      LOG_WARN("io request partial finished", K(req), K(complete_size));
+      if (0 == complete_size || !is_io_aligned(complete_size)) { // reach end of file
+        if (OB_FAIL(on_partial_return(req, complete_size))) {
+          LOG_WARN("process partial return io request failed", K(ret), K(complete_size), K(req));
+        }
+      } else {
+        if (OB_FAIL(on_partial_retry(req, complete_size))) { // partial retry
+          LOG_WARN("partial retry io request failed", K(ret), K(complete_size), K(req));
+        }
+      }
+    } else { // invalid complete size
+      LOG_WARN("invalid complete size", K(req), K(complete_size));
+      if (OB_FAIL(on_failed(req, ObIORetCode(OB_IO_ERROR, complete_size)))) { // use complete_size as errno here
+        LOG_WARN("process failed io request failed", K(ret), K(req));
+      }
+    }
+  } else { // io failed
+    LOG_ERROR("io request failed", K(req), K(system_errno), K(complete_size));
+    if (-EAGAIN == system_errno) { //retry
+      if (OB_FAIL(on_full_retry(req))) {
+        LOG_WARN("retry io request failed", K(ret), K(system_errno), K(req));
+      }
+    } else {
+      if (OB_FAIL(on_failed(req, ObIORetCode(OB_IO_ERROR, system_errno)))) {
+        LOG_WARN("process failed io request failed", K(ret), K(req));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObIOChannel::on_full_return(ObIORequest &req)
+{
+  int ret = OB_SUCCESS;
+  req.complete_size_ = req.io_size_;
+  if (!req.is_canceled_ && req.can_callback()) {
+    if (OB_FAIL(req.tenant_io_mgr_.get_ptr()->enqueue_callback(req))) {
+      LOG_WARN("push io request into callback queue failed", K(ret), K(req));
+      req.finish(ret);
+    }
+  } else {
+    req.finish(OB_SUCCESS);
+  }
+  return ret;
+}
+
+int ObIOChannel::on_partial_return(ObIORequest &req, const int64_t complete_size)
+{
+  int ret = OB_SUCCESS;
+  // partial return ignore callback
+  req.complete_size_ += complete_size;
+  if (req.get_data_size() >= req.io_info_.size_) {
+    // in case of aligned_size > file_size > user_need_size
+    if (!req.is_canceled_ && req.can_callback()) {
+      // the callback is not aware of complete size, not supported for now
+      req.finish(OB_NOT_SUPPORTED);
+    } else {
+      req.finish(OB_SUCCESS);
+    }
+  } else {
+    req.finish(OB_DATA_OUT_OF_RANGE);
+  }
+  return ret;
+}
+
+int ObIOChannel::on_partial_retry(ObIORequest &req, const int64_t complete_size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_io_aligned(complete_size))) {
+    ret = OB_ERR_SYS;
+    LOG_WARN("complete size not aligned", K(ret), K(complete_size));
+  } else {
+    req.complete_size_ += complete_size;
+    req.io_buf_ += complete_size;
+    req.io_offset_ += complete_size;
+    req.io_size_ -= complete_size;
+    if (OB_FAIL(req.prepare())) {
+      LOG_WARN("prepare io request failed", K(ret), K(req));
+    } else if (OB_FAIL(submit(req))) {
+      LOG_WARN("submit io request failed", K(ret), K(req));
+    }
+  }
+  if (OB_FAIL(ret)) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_SUCCESS != (tmp_ret = on_failed(req, ObIORetCode(ret)))) {
+      LOG_WARN("deal with failed request failed", K(tmp_ret), K(ret), K(req));
+    }
+  }
+  return ret;
+}
+
+int ObIOChannel::on_full_retry(ObIORequest &req)
+{
+  int ret = OB_SUCCESS;
+  static const int64_t MAX_RETRY_COUNT = 10;
+  if (++req.retry_count_ > MAX_RETRY_COUNT) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("retry too many times", K(ret), K(req));
+  } else if (FALSE_IT(req.complete_size_ = 0)) {
+  } else if (OB_FAIL(req.prepare())) {
+    LOG_WARN("prepare io request failed", K(ret), K(req));
+  } else if (OB_FAIL(submit(req))) {
+    LOG_WARN("submit io request failed", K(ret));
+  }
+  if (OB_FAIL(ret)) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_SUCCESS != (tmp_ret = on_failed(req, ObIORetCode(ret)))) {
+      LOG_WARN("deal with failed request failed", K(tmp_ret), K(ret), K(req));
+    }
+  }
+  return ret;
+}
+
+int ObIOChannel::on_failed(ObIORequest &req, const ObIORetCode &ret_code)
+{
+  int ret = OB_SUCCESS;
+  req.finish(ret_code);
+  return ret;
+}
+
 /******************             AsyncIOChannel              **********************/
 ObAsyncIOChannel::ObAsyncIOChannel()
   : io_context_(nullptr),
@@ -1745,20 +1896,6 @@ int ObAsyncIOChannel::init(ObDeviceChannel *device_channel)
   return ret;
 }
 
-void ObAsyncIOChannel::stop()
-{
-  if (tg_id_ >= 0) {
-    TG_STOP(tg_id_);
-  }
-}
-
-void ObAsyncIOChannel::wait()
-{
-  if (tg_id_ >= 0) {
-    TG_WAIT(tg_id_);
-  }
-}
-
 void ObAsyncIOChannel::destroy()
 {
     // wait flying request
@@ -1895,40 +2032,8 @@ void ObAsyncIOChannel::get_events()
         ATOMIC_FAS(&device_channel_->used_io_depth_, req->io_size_);
         const int system_errno = io_events_->get_ith_ret_code(i);
         const int complete_size = io_events_->get_ith_ret_bytes(i);
-        if (OB_LIKELY(0 == system_errno)) { // io succ
-          if (complete_size == req->io_size_) { // full complete
-            LOG_DEBUG("Success to get io event", K(*req), K(complete_size));
-            if (OB_FAIL(on_full_return(*req))) {
-              LOG_WARN("process full return io request failed", K(ret), K(*req));
-            }
-          } else if (complete_size >= 0 && complete_size < req->io_size_) { // partial complete
-            LOG_WARN("io request partial finished", K(*req), K(complete_size));
-            if (0 == complete_size || !is_io_aligned(complete_size)) { // reach end of file
-              if (OB_FAIL(on_partial_return(*req, complete_size))) {
-                LOG_WARN("process partial return io request failed", K(ret), K(complete_size), K(*req));
-              }
-            } else {
-              if (OB_FAIL(on_partial_retry(*req, complete_size))) { // partial retry
-                LOG_WARN("partial retry io request failed", K(ret), K(complete_size), K(*req));
-              }
-            }
-          } else { // invalid complete size
-            LOG_WARN("invalid complete size", K(*req), K(complete_size));
-            if (OB_FAIL(on_failed(*req, ObIORetCode(OB_IO_ERROR, complete_size)))) { // use complete_size as errno here
-              LOG_WARN("process failed io request failed", K(ret), K(*req));
-            }
-          }
-        } else { // io failed
-          LOG_ERROR("io request failed", K(*req), K(system_errno), K(complete_size));
-          if (-EAGAIN == system_errno) { //retry
-            if (OB_FAIL(on_full_retry(*req))) {
-              LOG_WARN("retry io request failed", K(ret), K(system_errno), K(*req));
-            }
-          } else {
-            if (OB_FAIL(on_failed(*req, ObIORetCode(OB_IO_ERROR, system_errno)))) {
-              LOG_WARN("process failed io request failed", K(ret), K(*req));
-            }
-          }
+        if (OB_FAIL(on_io_return(*req, system_errno, complete_size))) {
+          LOG_WARN("process io return failed", K(ret), K(system_errno), K(complete_size), K(*req));
         }
       }
       ATOMIC_DEC(&submit_count_);
@@ -1936,96 +2041,6 @@ void ObAsyncIOChannel::get_events()
   }
 }
 
-int ObAsyncIOChannel::on_full_return(ObIORequest &req)
-{
-  int ret = OB_SUCCESS;
-  req.complete_size_ = req.io_size_;
-  if (!req.is_canceled_ && req.can_callback()) {
-    if (OB_FAIL(req.tenant_io_mgr_.get_ptr()->enqueue_callback(req))) {
-      LOG_WARN("push io request into callback queue failed", K(ret), K(req));
-      req.finish(ret);
-    }
-  } else {
-    req.finish(OB_SUCCESS);
-  }
-  return ret;
-}
-
-int ObAsyncIOChannel::on_partial_return(ObIORequest &req, const int64_t complete_size)
-{
-  int ret = OB_SUCCESS;
-  // partial return ignore callback
-  req.complete_size_ += complete_size;
-  if (req.get_data_size() >= req.io_info_.size_) {
-    // in case of aligned_size > file_size > user_need_size
-    if (!req.is_canceled_ && req.can_callback()) {
-      // the callback is not aware of complete size, not supported for now
-      req.finish(OB_NOT_SUPPORTED);
-    } else {
-      req.finish(OB_SUCCESS);
-    }
-  } else {
-    req.finish(OB_DATA_OUT_OF_RANGE);
-  }
-  return ret;
-}
-
-int ObAsyncIOChannel::on_partial_retry(ObIORequest &req, const int64_t complete_size)
-{
-  int ret = OB_SUCCESS;
-  if (OB_UNLIKELY(!is_io_aligned(complete_size))) {
-    ret = OB_ERR_SYS;
-    LOG_WARN("complete size not aligned", K(ret), K(complete_size));
-  } else {
-    req.complete_size_ += complete_size;
-    req.io_buf_ += complete_size;
-    req.io_offset_ += complete_size;
-    req.io_size_ -= complete_size;
-    if (OB_FAIL(req.prepare())) {
-      LOG_WARN("prepare io request failed", K(ret), K(req));
-    } else if (OB_FAIL(submit(req))) {
-      LOG_WARN("submit io request failed", K(ret), K(req));
-    }
-  }
-  if (OB_FAIL(ret)) {
-    int tmp_ret = OB_SUCCESS;
-    if (OB_SUCCESS != (tmp_ret = on_failed(req, ObIORetCode(ret)))) {
-      LOG_WARN("deal with failed request failed", K(tmp_ret), K(ret), K(req));
-    }
-  }
-  return ret;
-}
-
-int ObAsyncIOChannel::on_full_retry(ObIORequest &req)
-{
-  int ret = OB_SUCCESS;
-  static const int64_t MAX_RETRY_COUNT = 10;
-  if (++req.retry_count_ > MAX_RETRY_COUNT) {
-    ret = OB_IO_ERROR;
-    LOG_WARN("retry too many times", K(ret), K(req));
-  } else if (FALSE_IT(req.complete_size_ = 0)) {
-  } else if (OB_FAIL(req.prepare())) {
-    LOG_WARN("prepare io request failed", K(ret), K(req));
-  } else if (OB_FAIL(submit(req))) {
-    LOG_WARN("submit io request failed", K(ret));
-  }
-  if (OB_FAIL(ret)) {
-    int tmp_ret = OB_SUCCESS;
-    if (OB_SUCCESS != (tmp_ret = on_failed(req, ObIORetCode(ret)))) {
-      LOG_WARN("deal with failed request failed", K(tmp_ret), K(ret), K(req));
-    }
-  }
-  return ret;
-}
-
-int ObAsyncIOChannel::on_failed(ObIORequest &req, const ObIORetCode &ret_code)
-{
-  int ret = OB_SUCCESS;
-  req.finish(ret_code);
-  return ret;
-}
-
-
 /******************             SyncIOChannel              **********************/
 ObSyncIOChannel::ObSyncIOChannel()
   : req_queue_(),
@@ -2183,9 +2198,386 @@ int ObSyncIOChannel::do_sync_io(ObIORequest &req)
   return ret;
 }
 
+/******************             IOUringChannel              **********************/
+ObIOUringChannel::ObIOUringChannel()
+  : local_device_(nullptr),
+    ring_(),
+    sq_lock_(),
+    is_flushing_(false),
+    submit_count_(0),
+    wait_fail_count_(0),
+    block_fd_(-1),
+    has_fixed_file_(false),
+    has_fixed_buffers_(false),
+    fixed_buffer_count_(0)
+{
+
+}
+
+ObIOUringChannel::~ObIOUringChannel()
+{
+  destroy();
+}
+
+int ObIOUringChannel::init(ObDeviceChannel *device_channel)
+{
+  int ret = OB_SUCCESS;
+  int tmp_ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret), K(is_inited_));
+  } else if (OB_UNLIKELY(!ObIOUring::is_supported())) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("io_uring is not supported by this build", K(ret));
+  } else if (OB_FAIL(base_init(device_channel))) {
+    LOG_WARN("base init failed", K(ret), KP(device_channel));
+  } else if (OB_ISNULL(local_device_ = dynamic_cast<share::ObLocalDevice *>(device_handle_))) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("io_uring channel only supports local device", K(ret), KP(device_handle_));
+  } else if (OB_FAIL(ring_.init(MAX_URING_ENTRY_CNT))) {
+    LOG_WARN("init io_uring failed", K(ret));
+  } else {
+    block_fd_ = local_device_->get_block_file_fd();
+    if (block_fd_ > 0) {
+      if (OB_TMP_FAIL(ring_.register_files(&block_fd_, 1))) {
+        LOG_WARN("register block file as fixed file failed, use raw fd instead", K(tmp_ret), K(block_fd_));
+      } else {
+        has_fixed_file_ = true;
+      }
+    }
+    if (OB_TMP_FAIL(ring_.register_sparse_buffers(MAX_FIXED_BUFFER_CNT))) {
+      LOG_INFO("fixed buffer is not available, io buffers are mapped per request", K(tmp_ret));
+    } else {
+      has_fixed_buffers_ = true;
+    }
+    is_flushing_ = false;
+    submit_count_ = 0;
+    is_inited_ = true;
+  }
+  if (OB_UNLIKELY(!is_inited_)) {
+    destroy();
+  }
+  return ret;
+}
+
+void ObIOUringChannel::stop()
+{
+  int ret = OB_SUCCESS;
+  ObIOChannel::stop();
+  if (ring_.is_inited()) {
+    // wake up the channel thread blocking on completion queue
+    {
+      ObSpinLockGuard guard(sq_lock_);
+      if (OB_FAIL(ring_.prep_nop(WAKEUP_USER_DATA))) {
+        LOG_WARN("prepare wakeup sqe failed", K(ret));
+      } else {
+        ring_.publish();
+      }
+    }
+    if (OB_SUCC(ret) && OB_FAIL(flush_sqes())) {
+      LOG_WARN("flush wakeup sqe failed", K(ret));
+    }
+  }
+}
+
+void ObIOUringChannel::destroy()
+{
+  // wait flying request
+  const int64_t max_wait_ts = ObTimeUtility::fast_current_time() + 1000L * 1000L * 30L; // 30s
+  while (submit_count_ > 0 && ObTimeUtility::fast_current_time() < max_wait_ts) {
+    ob_usleep(1000 * 10);
+  }
+  if (submit_count_ > 0) {
+    LOG_WARN_RET(OB_ERR_UNEXPECTED, "some request have not returned from file system", K(submit_count_));
+  }
+  if (tg_id_ >= 0) {
+    stop();
+  }
+  destroy_thread();
+  ring_.destroy();
+  for (int64_t i = 0; i < MAX_FIXED_BUFFER_CNT; ++i) {
+    fixed_buffers_[i] = FixedBuffer();
+  }
+  fixed_buffer_count_ = 0;
+  has_fixed_buffers_ = false;
+  has_fixed_file_ = false;
+  block_fd_ = -1;
+  submit_count_ = 0;
+  is_flushing_ = false;
+  local_device_ = nullptr;
+  device_handle_ = nullptr;
+  is_inited_ = false;
+}
+
+void ObIOUringChannel::run1()
+{
+  int ret = OB_SUCCESS;
+  const int64_t thread_id = get_thread_idx();
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else {
+    set_thread_name("IO_URING", thread_id);
+    LOG_INFO("io uring completion thread started", K(thread_id), K(tg_id_));
+    while (!has_set_stop()) {
+      reap_completions();
+    }
+    LOG_INFO("io uring completion thread stopped", K(thread_id), K(tg_id_));
+  }
+}
+
+int ObIOUringChannel::submit(ObIORequest &req)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (OB_UNLIKELY(device_handle_ != req.io_info_.fd_.device_handle_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(req), KP(device_handle_));
+  } else if (submit_count_ >= MAX_URING_ENTRY_CNT) {
+    ret = OB_EAGAIN;
+    if (REACH_TIME_INTERVAL(1000000L)) {
+      LOG_WARN("too many io requests", K(ret), K(submit_count_));
+    }
+  } else if (device_channel_->used_io_depth_ > device_channel_->max_io_depth_) {
+    ret = OB_EAGAIN;
+    LOG_INFO("reach max io depth", K(ret), K(device_channel_->used_io_depth_), K(device_channel_->max_io_depth_));
+  } else {
+    ATOMIC_INC(&submit_count_);
+    ATOMIC_FAA(&device_channel_->used_io_depth_, get_io_depth(req.io_size_));
+    req.channel_ = this;
+    req.time_log_.submit_ts_ = ObTimeUtility::fast_current_time();
+    req.inc_ref("os_inc"); // ref for file system
+    {
+      ObSpinLockGuard guard(sq_lock_);
+      if (OB_SUCC(prepare_sqe(req))) {
+        ring_.publish();
+      }
+    }
+    if (OB_FAIL(ret)) {
+      ATOMIC_DEC(&submit_count_);
+      ATOMIC_FAS(&device_channel_->used_io_depth_, get_io_depth(req.io_size_));
+      req.dec_ref("os_dec"); // ref for file system
+      if (OB_EAGAIN != ret) {
+        LOG_WARN("prepare io_uring sqe failed", K(ret), K(submit_count_), K(req));
+      }
+    } else {
+      // the sqe has been published, a failed flush leaves it to the next flusher
+      int tmp_ret = OB_SUCCESS;
+      if (OB_TMP_FAIL(flush_sqes())) {
+        LOG_WARN("flush io_uring sqes failed", K(tmp_ret), K(req));
+      }
+      LOG_DEBUG("Success to submit io request, ", K(ret), K(submit_count_), KP(&req));
+    }
+  }
+  return ret;
+}
+
+int ObIOUringChannel::prepare_sqe(ObIORequest &req)
+{
+  int ret = OB_SUCCESS;
+  int raw_fd = -1;
+  int64_t file_offset = 0;
+  bool is_block_file = false;
+  if (OB_FAIL(local_device_->get_io_target(req.io_info_.fd_, req.io_offset_, raw_fd, file_offset, is_block_file))) {
+    LOG_WARN("get io target failed", K(ret), K(req));
+  } else {
+    const bool use_fixed_file = is_block_file && has_fixed_file_;
+    const int fd = use_fixed_file ? 0 /*index in fixed file table*/ : raw_fd;
+    const int32_t buf_index = get_fixed_buffer_index(req.io_buf_, req.io_size_);
+    const uint64_t user_data = reinterpret_cast<uint64_t>(&req);
+    if (req.io_info_.flag_.is_read()) {
+      ret = ring_.prep_read(fd, use_fixed_file, req.io_buf_, static_cast<uint32_t>(req.io_size_),
+                            file_offset, buf_index, user_data);
+    } else if (req.io_info_.flag_.is_write()) {
+      ret = ring_.prep_write(fd, use_fixed_file, req.io_buf_, static_cast<uint32_t>(req.io_size_),
+                             file_offset, buf_index, user_data);
+    } else {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("not supported io mode", K(ret), K(req));
+    }
+  }
+  return ret;
+}
+
+int ObIOUringChannel::flush_sqes()
+{
+  int ret = OB_SUCCESS;
+  // only one submitter enters the kernel at a time, sqes published by others meanwhile are
+  // picked up by the next round, so that concurrent requests share one io_uring_enter.
+  while (OB_SUCC(ret) && ring_.get_pending_count() > 0 && ATOMIC_BCAS(&is_flushing_, false, true)) {
+    uint32_t pending_count = 0;
+    uint32_t submitted_count = 0;
+    while (OB_SUCC(ret) && (pending_count = ring_.get_pending_count()) > 0) {
+      if (OB_FAIL(ring_.enter(pending_count, submitted_count))) {
+        if (OB_EAGAIN != ret) {
+          LOG_WARN("io_uring enter failed", K(ret), K(pending_count));
+        }
+      }
+    }
+    ATOMIC_STORE(&is_flushing_, false);
+  }
+  return ret;
+}
+
+void ObIOUringChannel::reap_completions()
+{
+  int ret = OB_SUCCESS;
+  int64_t complete_cnt = ring_.peek_cqes(cqes_, MAX_URING_ENTRY_CNT);
+  for (int64_t i = 0; 0 == complete_cnt && i < COMPLETION_SPIN_COUNT; ++i) {
+    PAUSE();
+    complete_cnt = ring_.peek_cqes(cqes_, MAX_URING_ENTRY_CNT);
+  }
+  if (0 == complete_cnt) {
+    if (OB_FAIL(ring_.wait_cqe())) {
+      if (REACH_TIME_INTERVAL(10 * 1000 * 1000)) {
+        LOG_ERROR("io uring wait completion failed", K(ret), K(wait_fail_count_));
+      }
+      // back off exponentially instead of spinning on a failing io_uring_enter
+      const int64_t shift = wait_fail_count_ < MAX_WAIT_BACKOFF_SHIFT ? wait_fail_count_ : MAX_WAIT_BACKOFF_SHIFT;
+      ++wait_fail_count_;
+      ob_usleep(1000L << shift);
+    } else {
+      wait_fail_count_ = 0;
+      complete_cnt = ring_.peek_cqes(cqes_, MAX_URING_ENTRY_CNT);
+    }
+  }
+  if (complete_cnt > 0) {
+    const int64_t io_return_time = ObTimeUtility::fast_current_time();
+    ObIORequest *req = nullptr;
+    for (int64_t i = 0; i < complete_cnt; ++i) { // ignore ret
+      if (WAKEUP_USER_DATA == cqes_[i].user_data_) {
+        // wakeup nop, skip
+      } else if (OB_ISNULL(req = reinterpret_cast<ObIORequest *>(cqes_[i].user_data_))) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("req is null", K(ret));
+      } else {
+        {
+          RequestHolder holder(req);
+          req->dec_ref("os_dec"); // ref for file system
+          req->time_log_.return_ts_ = io_return_time;
+          ATOMIC_FAS(&device_channel_->used_io_depth_, get_io_depth(req->io_size_));
+          const int32_t res = cqes_[i].res_;
+          const int system_errno = res < 0 ? res : 0;
+          const int64_t complete_size = res < 0 ? 0 : res;
+          if (OB_FAIL(on_io_return(*req, system_errno, complete_size))) {
+            LOG_WARN("process io return failed", K(ret), K(system_errno), K(complete_size), K(*req));
+          }
+        }
+        ATOMIC_DEC(&submit_count_);
+      }
+    }
+  }
+}
+
+void ObIOUringChannel::cancel(ObIORequest &req)
+{
+  // io_uring request can not be taken back reliably once submitted, the canceled request
+  // will be finished without callback when it returns from file system, same as libaio channel.
+  LOG_DEBUG("io uring channel does not cancel inflight request", K(req));
+}
+
+int64_t ObIOUringChannel::get_queue_count() const
+{
+  return submit_count_;
+}
+
+int32_t ObIOUringChannel::get_fixed_buffer_index(const char *buf, const int64_t size) const
+{
+  int32_t index = -1;
+  if (has_fixed_buffers_ && fixed_buffer_count_ > 0) {
+    for (int64_t i = 0; index < 0 && i < MAX_FIXED_BUFFER_CNT; ++i) {
+      if (fixed_buffers_[i].contain(buf, size)) {
+        index = static_cast<int32_t>(i);
+      }
+    }
+  }
+  return index;
+}
+
+int ObIOUringChannel::register_buffer(const char *begin, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (OB_UNLIKELY(nullptr == begin || size <= 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(begin), K(size));
+  } else if (!has_fixed_buffers_) {
+    ret = OB_NOT_SUPPORTED;
+  } else {
+    // the region is registered in chunks no larger than kernel limit,
+    // io buffer crossing two chunks simply falls back to normal read/write
+    ObSpinLockGuard guard(sq_lock_);
+    const char *cur = begin;
+    while (OB_SUCC(ret) && cur < begin + size) {
+      const int64_t chunk_size = min(MAX_FIXED_BUFFER_SIZE, begin + size - cur);
+      int64_t slot = -1;
+      for (int64_t i = 0; slot < 0 && i < MAX_FIXED_BUFFER_CNT; ++i) {
+        if (fixed_buffers_[i].is_empty()) {
+          slot = i;
+        }
+      }
+      if (slot < 0) {
+        ret = OB_SIZE_OVERFLOW;
+        LOG_WARN("fixed buffer table is full", K(ret), K(fixed_buffer_count_), KP(begin), K(size));
+      } else if (OB_FAIL(ring_.update_buffer(static_cast<uint32_t>(slot), const_cast<char *>(cur), chunk_size))) {
+        LOG_WARN("register fixed buffer failed", K(ret), K(slot), KP(cur), K(chunk_size));
+      } else {
+        fixed_buffers_[slot].begin_ = cur;
+        fixed_buffers_[slot].size_ = chunk_size;
+        ++fixed_buffer_count_;
+        cur += chunk_size;
+      }
+    }
+  }
+  if (OB_FAIL(ret) && OB_NOT_SUPPORTED != ret && nullptr != begin) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_TMP_FAIL(unregister_buffer(begin))) {
+      LOG_WARN("rollback fixed buffer failed", K(tmp_ret), KP(begin));
+    }
+  }
+  return ret;
+}
+
+int ObIOUringChannel::unregister_buffer(const char *begin)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (OB_ISNULL(begin)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(begin));
+  } else if (has_fixed_buffers_) {
+    ObSpinLockGuard guard(sq_lock_);
+    const char *cur = begin;
+    bool found = true;
+    while (OB_SUCC(ret) && found) {
+      found = false;
+      for (int64_t i = 0; OB_SUCC(ret) && !found && i < MAX_FIXED_BUFFER_CNT; ++i) {
+        if (cur == fixed_buffers_[i].begin_) {
+          found = true;
+          if (OB_FAIL(ring_.update_buffer(static_cast<uint32_t>(i), nullptr, 0))) {
+            LOG_WARN("unregister fixed buffer failed", K(ret), K(i), KP(cur));
+          } else {
+            cur += fixed_buffers_[i].size_;
+            fixed_buffers_[i] = FixedBuffer();
+            --fixed_buffer_count_;
+          }
+        }
+      }
+    }
+  }
+  return ret;
+}
+
 /******************             DeviceChannel              **********************/
 ObDeviceChannel::ObDeviceChannel()
   : is_inited_(false),
+    use_io_uring_(false),
     allocator_(nullptr),
     device_handle_(nullptr),
     used_io_depth_(0),
@@ -2203,7 +2595,8 @@ int ObDeviceChannel::init(ObIODevice *device_handle,
                           const int64_t async_channel_count,
                           const int64_t sync_channel_count,
                           const int64_t max_io_depth,
-                          ObIAllocator &allocator)
+                          ObIAllocator &allocator,
+                          const bool enable_io_uring)
 {
   int ret = OB_SUCCESS;
   if (OB_UNLIKELY(is_inited_)) {
@@ -2220,25 +2613,19 @@ int ObDeviceChannel::init(ObIODevice *device_handle,
     used_io_depth_ = 0;
     max_io_depth_ = max_io_depth;
     allocator_ = &allocator;
-    for (int64_t i = 0; OB_SUCC(ret) && i < async_channel_count; ++i) {
-      ObAsyncIOChannel *ch = nullptr;
-      void *buf = nullptr;
-      if (OB_ISNULL(buf = allocator.alloc(sizeof(ObAsyncIOChannel)))) {
-        ret = OB_ALLOCATE_MEMORY_FAILED;
-        LOG_WARN("alloc async channel failed", K(ret), K(i), K(async_channel_count));
-      } else if (FALSE_IT(ch = new (buf) ObAsyncIOChannel())) {
-      } else if (OB_FAIL(ch->init(this))) {
-        LOG_WARN("init async channel failed", K(ret));
-      } else if (OB_FAIL(ch->start_thread())) {
-        LOG_WARN("start thread failed", K(ret), KPC(ch));
-      } else if (OB_FAIL(async_channels_.push_back(ch))) {
-        LOG_WARN("push back async channel failed", K(ret), KPC(ch));
+    if (enable_io_uring) {
+      if (OB_SUCC(add_uring_channels(async_channel_count, allocator))) {
+        use_io_uring_ = true;
+      } else if (OB_NOT_SUPPORTED == ret) {
+        LOG_WARN("io_uring is not available, fall back to libaio", K(ret), KP(device_handle));
+        ret = OB_SUCCESS;
       } else {
-        ch = nullptr;
+        LOG_WARN("add io_uring channels failed", K(ret), K(async_channel_count));
       }
-      if (OB_UNLIKELY(nullptr != ch)) {
-        ch->~ObAsyncIOChannel();
-        allocator.free(ch);
+    }
+    if (OB_SUCC(ret) && !use_io_uring_) {
+      if (OB_FAIL(add_async_channels(async_channel_count, allocator))) {
+        LOG_WARN("add async channels failed", K(ret), K(async_channel_count));
       }
     }
     for (int64_t i = 0; OB_SUCC(ret) && i < sync_channel_count; ++i) {
@@ -2272,15 +2659,80 @@ int ObDeviceChannel::init(ObIODevice *device_handle,
   return ret;
 }
 
+int ObDeviceChannel::add_async_channels(const int64_t async_channel_count, ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < async_channel_count; ++i) {
+    ObAsyncIOChannel *ch = nullptr;
+    void *buf = nullptr;
+    if (OB_ISNULL(buf = allocator.alloc(sizeof(ObAsyncIOChannel)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc async channel failed", K(ret), K(i), K(async_channel_count));
+    } else if (FALSE_IT(ch = new (buf) ObAsyncIOChannel())) {
+    } else if (OB_FAIL(ch->init(this))) {
+      LOG_WARN("init async channel failed", K(ret));
+    } else if (OB_FAIL(ch->start_thread())) {
+      LOG_WARN("start thread failed", K(ret), KPC(ch));
+    } else if (OB_FAIL(async_channels_.push_back(ch))) {
+      LOG_WARN("push back async channel failed", K(ret), KPC(ch));
+    } else {
+      ch = nullptr;
+    }
+    if (OB_UNLIKELY(nullptr != ch)) {
+      ch->~ObAsyncIOChannel();
+      allocator.free(ch);
+    }
+  }
+  return ret;
+}
+
+int ObDeviceChannel::add_uring_channels(const int64_t async_channel_count, ObIAllocator &allocator)
+{
+  int ret = OB_SUCCESS;
+  for (int64_t i = 0; OB_SUCC(ret) && i < async_channel_count; ++i) {
+    ObIOUringChannel *ch = nullptr;
+    void *buf = nullptr;
+    if (OB_ISNULL(buf = allocator.alloc(sizeof(ObIOUringChannel)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("alloc io_uring channel failed", K(ret), K(i), K(async_channel_count));
+    } else if (FALSE_IT(ch = new (buf) ObIOUringChannel())) {
+    } else if (OB_FAIL(ch->init(this))) {
+      LOG_WARN("init io_uring channel failed", K(ret));
+    } else if (OB_FAIL(ch->start_thread())) {
+      LOG_WARN("start thread failed", K(ret), KPC(ch));
+    } else if (OB_FAIL(async_channels_.push_back(ch))) {
+      LOG_WARN("push back io_uring channel failed", K(ret), KPC(ch));
+    } else {
+      ch = nullptr;
+    }
+    if (OB_UNLIKELY(nullptr != ch)) {
+      ch->~ObIOUringChannel();
+      allocator.free(ch);
+    }
+  }
+  if (OB_FAIL(ret)) {
+    // release the channels created, caller may fall back to libaio
+    for (int64_t i = 0; i < async_channels_.count(); ++i) {
+      ObIOChannel *ch = async_channels_.at(i);
+      if (nullptr != ch) {
+        ch->~ObIOChannel();
+        allocator.free(ch);
+      }
+    }
+    async_channels_.reset();
+  }
+  return ret;
+}
+
 void ObDeviceChannel::destroy()
 {
   is_inited_ = false;
   for (int64_t i = 0; i < async_channels_.count(); ++i) {
-    ObAsyncIOChannel *ch = static_cast<ObAsyncIOChannel *>(async_channels_.at(i));
+    ObIOChannel *ch = async_channels_.at(i);
     ch->stop();
   }
   for (int64_t i = 0; i < async_channels_.count(); ++i) {
-    ObAsyncIOChannel *ch = static_cast<ObAsyncIOChannel *>(async_channels_.at(i));
+    ObIOChannel *ch = async_channels_.at(i);
     ch->wait();
   }
   for (int64_t i = 0; i < async_channels_.count(); ++i) {
@@ -2300,6 +2752,7 @@ void ObDeviceChannel::destroy()
   }
   sync_channels_.destroy();
   allocator_ = nullptr;
+  use_io_uring_ = false;
 }
 
 int ObDeviceChannel::submit(ObIORequest &req)
@@ -2321,6 +2774,52 @@ int ObDeviceChannel::submit(ObIORequest &req)
   return ret;
 }
 
+int ObDeviceChannel::register_io_buffer(const char *begin, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (!use_io_uring_) {
+    // only io_uring channel benefits from registered buffers
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && i < async_channels_.count(); ++i) {
+      ObIOUringChannel *ch = static_cast<ObIOUringChannel *>(async_channels_.at(i));
+      if (OB_FAIL(ch->register_buffer(begin, size))) {
+        if (OB_NOT_SUPPORTED != ret) {
+          LOG_WARN("register io buffer failed", K(ret), KP(begin), K(size), KPC(ch));
+        }
+      }
+    }
+    if (OB_FAIL(ret)) {
+      int tmp_ret = OB_SUCCESS;
+      if (OB_TMP_FAIL(unregister_io_buffer(begin))) {
+        LOG_WARN("rollback registered io buffer failed", K(tmp_ret), KP(begin));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObDeviceChannel::unregister_io_buffer(const char *begin)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (use_io_uring_) {
+    for (int64_t i = 0; i < async_channels_.count(); ++i) { // ignore ret
+      ObIOUringChannel *ch = static_cast<ObIOUringChannel *>(async_channels_.at(i));
+      int tmp_ret = OB_SUCCESS;
+      if (OB_TMP_FAIL(ch->unregister_buffer(begin))) {
+        ret = tmp_ret;
+        LOG_WARN("unregister io buffer failed", K(ret), KP(begin), KPC(ch));
+      }
+    }
+  }
+  return ret;
+}
+
 int ObDeviceChannel::get_random_io_channel(ObIArray<ObIOChannel *> &io_channels, ObIOChannel *&ch)
 {
   int ret = OB_SUCCESS;
@@ -23,10 +23,15 @@
 #include "lib/container/ob_array_wrap.h"
 #include "lib/lock/ob_spin_lock.h"
 #include "share/io/ob_io_define.h"
+#include "share/io/ob_io_uring.h"
 #include "share/io/io_schedule/ob_io_mclock.h"  
 
 namespace oceanbase
 {
+namespace share
+{
+class ObLocalDevice;
+}
 namespace common
 {
 
@@ -71,6 +76,8 @@ public:
   int free(void *ptr);
   bool contain(void *ptr);
   int64_t get_block_size() const { return SIZE; }
+  char *get_begin_ptr() const { return begin_ptr_; }
+  int64_t get_total_size() const { return capacity_ * SIZE; }
 private:
   bool is_inited_;
   int64_t capacity_;
@@ -94,6 +101,8 @@ public:
   virtual void free(void *ptr) override;
   template<typename T, typename... Args> int alloc(T *&instance, Args &...args);
   template<typename T> void free(T *instance);
+  // memory region of macro pool, which can be registered as fixed buffer of io_uring
+  void get_macro_pool_region(char *&begin, int64_t &size) const;
   TO_STRING_KV(K(is_inited_), "allocated", inner_allocator_.allocated());
 private:
   int init_macro_pool(const int64_t memory_limit);
@@ -309,11 +318,22 @@ public:
   int base_init(ObDeviceChannel *device_channel);
   int start_thread();
   void destroy_thread();
+  virtual void stop();
+  virtual void wait();
   virtual int submit(ObIORequest &req) = 0;
   virtual void cancel(ObIORequest &req) = 0;
   virtual int64_t get_queue_count() const = 0;
   TO_STRING_KV(K(is_inited_), KP(device_handle_), K(tg_id_), "queue_count", get_queue_count());
 
+protected:
+  // process the result returned from file system, shared by libaio and io_uring channel
+  int on_io_return(ObIORequest &req, const int system_errno, const int64_t complete_size);
+  int on_full_return(ObIORequest &req);
+  int on_partial_return(ObIORequest &req, const int64_t complete_size);
+  int on_partial_retry(ObIORequest &req, const int64_t complete_size);
+  int on_full_retry(ObIORequest &req);
+  int on_failed(ObIORequest &req, const ObIORetCode &ret_code);
+
 protected:
   bool is_inited_;
   int tg_id_; // thread group id
@@ -329,8 +349,6 @@ public:
   virtual ~ObAsyncIOChannel();
 
   int init(ObDeviceChannel *device_channel);
-  void stop();
-  void wait();
   void destroy();
   virtual void run1() override;
   virtual int submit(ObIORequest &req) override;
@@ -340,11 +358,6 @@ public:
 
 private:
   void get_events();
-  int on_full_return(ObIORequest &req);
-  int on_partial_return(ObIORequest &req, const int64_t complete_size);
-  int on_partial_retry(ObIORequest &req, const int64_t complete_size);
-  int on_full_retry(ObIORequest &req);
-  int on_failed(ObIORequest &req, const ObIORetCode &ret_code);
 
 private:
   static const int32_t MAX_AIO_EVENT_CNT = 512;
@@ -377,8 +390,70 @@ private:
   bool is_wait_;
 };
 
+/**
+ * async io channel based on io_uring, only for local device.
+ * sqes from concurrent submitters are batched into one io_uring_enter by whoever holds the flush role,
+ * the block file is registered as fixed file and macro pools of tenant io allocators can be
+ * registered as fixed buffers, completions are reaped from the mmaped cq ring by the channel thread.
+ */
+class ObIOUringChannel : public ObIOChannel
+{
+public:
+  ObIOUringChannel();
+  virtual ~ObIOUringChannel();
+
+  int init(ObDeviceChannel *device_channel);
+  virtual void stop() override;
+  void destroy();
+  virtual void run1() override;
+  virtual int submit(ObIORequest &req) override;
+  virtual void cancel(ObIORequest &req) override;
+  virtual int64_t get_queue_count() const override;
+  int register_buffer(const char *begin, const int64_t size);
+  int unregister_buffer(const char *begin);
+  INHERIT_TO_STRING_KV("IOChannel", ObIOChannel, K(ring_), K(submit_count_), K(has_fixed_file_),
+      K(has_fixed_buffers_), K(fixed_buffer_count_));
+
+private:
+  struct FixedBuffer
+  {
+    FixedBuffer() : begin_(nullptr), size_(0) {}
+    bool is_empty() const { return nullptr == begin_; }
+    bool contain(const char *buf, const int64_t size) const
+    {
+      return nullptr != begin_ && buf >= begin_ && buf + size <= begin_ + size_;
+    }
+    const char *begin_;
+    int64_t size_;
+  };
+  int prepare_sqe(ObIORequest &req);
+  int flush_sqes();
+  void reap_completions();
+  int32_t get_fixed_buffer_index(const char *buf, const int64_t size) const;
+
+private:
+  static const int32_t MAX_URING_ENTRY_CNT = 512;
+  static const int64_t MAX_FIXED_BUFFER_CNT = 64;
+  static const int64_t MAX_FIXED_BUFFER_SIZE = 1L << 30; // 1GB, limited by kernel
+  static const int64_t COMPLETION_SPIN_COUNT = 64;
+  static const int64_t MAX_WAIT_BACKOFF_SHIFT = 7; // 1ms << 7, about 128ms
+  static const uint64_t WAKEUP_USER_DATA = 0;
+  share::ObLocalDevice *local_device_;
+  ObIOUring ring_;
+  ObSpinLock sq_lock_;
+  bool is_flushing_;
+  int64_t submit_count_;
+  int64_t wait_fail_count_;
+  int block_fd_;
+  bool has_fixed_file_;
+  bool has_fixed_buffers_;
+  int64_t fixed_buffer_count_;
+  FixedBuffer fixed_buffers_[MAX_FIXED_BUFFER_CNT];
+  ObIOUringCqe cqes_[MAX_URING_ENTRY_CNT];
+};
+
 // each device has several channels, including async channels and sync channels.
-// this interface better in ObIODevice and can be replaced by io_uring.
+// async channels of local device can be replaced by io_uring, see _enable_io_uring.
 class ObDeviceChannel final
 {
 public:
@@ -388,18 +463,25 @@ public:
            const int64_t async_channel_count,
            const int64_t sync_channel_count,
            const int64_t max_io_depth,
-           ObIAllocator &allocator);
+           ObIAllocator &allocator,
+           const bool enable_io_uring = false);
   void destroy();
   int submit(ObIORequest &req);
-  TO_STRING_KV(K(is_inited_), KP(allocator_), K(async_channels_), K(sync_channels_));
+  int register_io_buffer(const char *begin, const int64_t size);
+  int unregister_io_buffer(const char *begin);
+  TO_STRING_KV(K(is_inited_), KP(allocator_), K(use_io_uring_), K(async_channels_), K(sync_channels_));
 private:
   int get_random_io_channel(ObIArray<ObIOChannel *> &io_channels, ObIOChannel *&ch);
+  int add_async_channels(const int64_t async_channel_count, ObIAllocator &allocator);
+  int add_uring_channels(const int64_t async_channel_count, ObIAllocator &allocator);
 
 private:
   friend class ObIOChannel;
   friend class ObAsyncIOChannel;
   friend class ObSyncIOChannel;
+  friend class ObIOUringChannel;
   bool is_inited_;
+  bool use_io_uring_;
   ObIAllocator *allocator_;
   ObSEArray<ObIOChannel *, 8> async_channels_;
   ObSEArray<ObIOChannel *, 8> sync_channels_;
@@ -0,0 +1,509 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX COMMON
+
+#include "share/io/ob_io_uring.h"
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include "lib/ob_errno.h"
+#include "lib/oblog/ob_log.h"
+#include "lib/ob_define.h"
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+// IORING_FEAT_RW_CUR_POS comes with IORING_OP_READ/IORING_OP_WRITE (linux 5.6)
+#if defined(IORING_FEAT_RW_CUR_POS)
+#define OB_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+#ifdef OB_HAS_IO_URING
+// the syscall numbers are shared by all architectures since linux 5.1
+#ifndef __NR_io_uring_setup
+#define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+#define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+#define __NR_io_uring_register 427
+#endif
+#endif
+
+namespace oceanbase
+{
+namespace common
+{
+
+#ifdef OB_HAS_IO_URING
+static inline int sys_io_uring_setup(const uint32_t entries, struct io_uring_params *p)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, p));
+}
+
+static inline int sys_io_uring_enter(const int fd, const uint32_t to_submit,
+                                     const uint32_t min_complete, const uint32_t flags)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+static inline int sys_io_uring_register(const int fd, const uint32_t opcode, const void *arg, const uint32_t nr_args)
+{
+  return static_cast<int>(::syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+#endif
+
+ObIOUring::ObIOUring()
+  : is_inited_(false),
+    ring_fd_(-1),
+    sq_entries_(0),
+    cq_entries_(0),
+    features_(0),
+    sq_ring_ptr_(nullptr),
+    sq_ring_size_(0),
+    sq_khead_(nullptr),
+    sq_ktail_(nullptr),
+    sq_kring_mask_(nullptr),
+    sq_kflags_(nullptr),
+    sq_array_(nullptr),
+    sqes_(nullptr),
+    sqes_size_(0),
+    sqe_head_(0),
+    sqe_tail_(0),
+    cq_ring_ptr_(nullptr),
+    cq_ring_size_(0),
+    cq_khead_(nullptr),
+    cq_ktail_(nullptr),
+    cq_kring_mask_(nullptr),
+    cqes_(nullptr),
+    has_fixed_buffers_(false)
+{
+
+}
+
+ObIOUring::~ObIOUring()
+{
+  destroy();
+}
+
+bool ObIOUring::is_supported()
+{
+#ifdef OB_HAS_IO_URING
+  return true;
+#else
+  return false;
+#endif
+}
+
+int ObIOUring::init(const uint32_t entries)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(params));
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret), K(is_inited_));
+  } else if (OB_UNLIKELY(0 == entries)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(entries));
+  } else if ((ring_fd_ = sys_io_uring_setup(entries, &params)) < 0) {
+    // io_uring disabled by kernel (ENOSYS), by sysctl or seccomp (EPERM), or short of locked memory
+    // (ENOMEM), let the caller fall back to libaio
+    ret = (ENOSYS == errno || EPERM == errno || ENOMEM == errno) ? OB_NOT_SUPPORTED : OB_IO_ERROR;
+    LOG_WARN("io_uring_setup failed", K(ret), K(entries), K(errno), KERRMSG);
+  } else if (0 == (params.features & IORING_FEAT_RW_CUR_POS)) {
+    ret = OB_NOT_SUPPORTED;
+    LOG_WARN("kernel io_uring does not support IORING_OP_READ/WRITE", K(ret), K(params.features));
+  } else {
+    sq_entries_ = params.sq_entries;
+    cq_entries_ = params.cq_entries;
+    features_ = params.features;
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(uint32_t);
+    cq_ring_size_ = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    sqes_size_ = params.sq_entries * sizeof(struct io_uring_sqe);
+    if (OB_FAIL(map_rings())) {
+      LOG_WARN("map io_uring rings failed", K(ret), K(ring_fd_));
+    } else {
+      char *sq_ptr = static_cast<char *>(sq_ring_ptr_);
+      char *cq_ptr = static_cast<char *>(cq_ring_ptr_);
+      sq_khead_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off.head);
+      sq_ktail_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off.tail);
+      sq_kring_mask_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off.ring_mask);
+      sq_kflags_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off.flags);
+      sq_array_ = reinterpret_cast<uint32_t *>(sq_ptr + params.sq_off.array);
+      cq_khead_ = reinterpret_cast<uint32_t *>(cq_ptr + params.cq_off.head);
+      cq_ktail_ = reinterpret_cast<uint32_t *>(cq_ptr + params.cq_off.tail);
+      cq_kring_mask_ = reinterpret_cast<uint32_t *>(cq_ptr + params.cq_off.ring_mask);
+      cqes_ = cq_ptr + params.cq_off.cqes;
+      sqe_head_ = 0;
+      sqe_tail_ = 0;
+      is_inited_ = true;
+      LOG_INFO("init io_uring succ", K(ring_fd_), K(sq_entries_), K(cq_entries_), K(features_));
+    }
+  }
+  if (OB_UNLIKELY(!is_inited_)) {
+    destroy();
+  }
+#else
+  UNUSED(entries);
+  ret = OB_NOT_SUPPORTED;
+  LOG_WARN("io_uring is not supported by this build", K(ret));
+#endif
+  return ret;
+}
+
+void ObIOUring::destroy()
+{
+#ifdef OB_HAS_IO_URING
+  unmap_rings();
+#endif
+  if (ring_fd_ >= 0) {
+    ::close(ring_fd_);
+    ring_fd_ = -1;
+  }
+  sq_entries_ = 0;
+  cq_entries_ = 0;
+  features_ = 0;
+  sq_khead_ = nullptr;
+  sq_ktail_ = nullptr;
+  sq_kring_mask_ = nullptr;
+  sq_kflags_ = nullptr;
+  sq_array_ = nullptr;
+  cq_khead_ = nullptr;
+  cq_ktail_ = nullptr;
+  cq_kring_mask_ = nullptr;
+  cqes_ = nullptr;
+  sqe_head_ = 0;
+  sqe_tail_ = 0;
+  has_fixed_buffers_ = false;
+  is_inited_ = false;
+}
+
+int ObIOUring::map_rings()
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  if (features_ & IORING_FEAT_SINGLE_MMAP) {
+    sq_ring_size_ = sq_ring_size_ > cq_ring_size_ ? sq_ring_size_ : cq_ring_size_;
+    cq_ring_size_ = sq_ring_size_;
+  }
+  void *ptr = ::mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+  if (MAP_FAILED == ptr) {
+    ret = ENOMEM == errno ? OB_NOT_SUPPORTED : OB_IO_ERROR;
+    LOG_WARN("mmap sq ring failed", K(ret), K(sq_ring_size_), K(errno), KERRMSG);
+  } else {
+    sq_ring_ptr_ = ptr;
+    if (features_ & IORING_FEAT_SINGLE_MMAP) {
+      cq_ring_ptr_ = sq_ring_ptr_;
+    } else if (MAP_FAILED == (ptr = ::mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                                           MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING))) {
+      ret = ENOMEM == errno ? OB_NOT_SUPPORTED : OB_IO_ERROR;
+      LOG_WARN("mmap cq ring failed", K(ret), K(cq_ring_size_), K(errno), KERRMSG);
+    } else {
+      cq_ring_ptr_ = ptr;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    if (MAP_FAILED == (ptr = ::mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE,
+                                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQES))) {
+      ret = ENOMEM == errno ? OB_NOT_SUPPORTED : OB_IO_ERROR;
+      LOG_WARN("mmap sqes failed", K(ret), K(sqes_size_), K(errno), KERRMSG);
+    } else {
+      sqes_ = ptr;
+    }
+  }
+#endif
+  return ret;
+}
+
+void ObIOUring::unmap_rings()
+{
+  if (nullptr != sqes_) {
+    ::munmap(sqes_, sqes_size_);
+    sqes_ = nullptr;
+  }
+  if (nullptr != cq_ring_ptr_ && cq_ring_ptr_ != sq_ring_ptr_) {
+    ::munmap(cq_ring_ptr_, cq_ring_size_);
+  }
+  cq_ring_ptr_ = nullptr;
+  if (nullptr != sq_ring_ptr_) {
+    ::munmap(sq_ring_ptr_, sq_ring_size_);
+    sq_ring_ptr_ = nullptr;
+  }
+  sq_ring_size_ = 0;
+  cq_ring_size_ = 0;
+  sqes_size_ = 0;
+}
+
+int ObIOUring::register_files(const int *fds, const uint32_t count)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (OB_UNLIKELY(nullptr == fds || 0 == count)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(fds), K(count));
+  } else if (0 != sys_io_uring_register(ring_fd_, IORING_REGISTER_FILES, fds, count)) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("register fixed files failed", K(ret), K(count), K(errno), KERRMSG);
+  }
+#else
+  UNUSEDx(fds, count);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+int ObIOUring::register_sparse_buffers(const uint32_t count)
+{
+  int ret = OB_SUCCESS;
+#if defined(OB_HAS_IO_URING) && defined(IORING_RSRC_REGISTER_SPARSE)
+  struct io_uring_rsrc_register reg;
+  memset(&reg, 0, sizeof(reg));
+  reg.nr = count;
+  reg.flags = IORING_RSRC_REGISTER_SPARSE;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (OB_UNLIKELY(0 == count)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(count));
+  } else if (0 != sys_io_uring_register(ring_fd_, IORING_REGISTER_BUFFERS2, &reg, sizeof(reg))) {
+    ret = EINVAL == errno ? OB_NOT_SUPPORTED : OB_IO_ERROR;
+    LOG_WARN("register sparse buffer table failed", K(ret), K(count), K(errno), KERRMSG);
+  } else {
+    has_fixed_buffers_ = true;
+  }
+#else
+  UNUSED(count);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+int ObIOUring::update_buffer(const uint32_t index, void *base, const int64_t size)
+{
+  int ret = OB_SUCCESS;
+#if defined(OB_HAS_IO_URING) && defined(IORING_RSRC_REGISTER_SPARSE)
+  struct iovec iov;
+  iov.iov_base = base;
+  iov.iov_len = size;
+  struct io_uring_rsrc_update2 update;
+  memset(&update, 0, sizeof(update));
+  update.offset = index;
+  update.data = reinterpret_cast<uint64_t>(&iov);
+  update.nr = 1;
+  if (OB_UNLIKELY(!is_inited_ || !has_fixed_buffers_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_), K(has_fixed_buffers_));
+  } else if (OB_UNLIKELY(size < 0 || (nullptr == base && size > 0))) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(index), KP(base), K(size));
+  } else if (sys_io_uring_register(ring_fd_, IORING_REGISTER_BUFFERS_UPDATE, &update, sizeof(update)) < 0) {
+    ret = OB_IO_ERROR;
+    LOG_WARN("update fixed buffer failed", K(ret), K(index), KP(base), K(size), K(errno), KERRMSG);
+  }
+#else
+  UNUSEDx(index, base, size);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+int ObIOUring::prep_rw(const uint8_t opcode, const int fd, const bool fixed_file, const void *buf,
+                       const uint32_t size, const int64_t offset, const uint64_t user_data)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (sqe_tail_ + 1 - __atomic_load_n(sq_khead_, __ATOMIC_ACQUIRE) > sq_entries_) {
+    ret = OB_EAGAIN;
+  } else {
+    struct io_uring_sqe *sqe = static_cast<struct io_uring_sqe *>(sqes_) + (sqe_tail_ & *sq_kring_mask_);
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = opcode;
+    sqe->flags = fixed_file ? IOSQE_FIXED_FILE : 0;
+    sqe->fd = fd;
+    sqe->off = offset;
+    sqe->addr = reinterpret_cast<uint64_t>(buf);
+    sqe->len = size;
+    sqe->user_data = user_data;
+    ++sqe_tail_;
+  }
+#else
+  UNUSEDx(opcode, fd, fixed_file, buf, size, offset, user_data);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+int ObIOUring::prep_read(const int fd, const bool fixed_file, void *buf, const uint32_t size,
+                         const int64_t offset, const int32_t buf_index, const uint64_t user_data)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  const uint8_t opcode = buf_index >= 0 ? IORING_OP_READ_FIXED : IORING_OP_READ;
+  if (OB_SUCC(prep_rw(opcode, fd, fixed_file, buf, size, offset, user_data)) && buf_index >= 0) {
+    (static_cast<struct io_uring_sqe *>(sqes_) + ((sqe_tail_ - 1) & *sq_kring_mask_))->buf_index = buf_index;
+  }
+#else
+  UNUSEDx(fd, fixed_file, buf, size, offset, buf_index, user_data);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+int ObIOUring::prep_write(const int fd, const bool fixed_file, const void *buf, const uint32_t size,
+                          const int64_t offset, const int32_t buf_index, const uint64_t user_data)
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  const uint8_t opcode = buf_index >= 0 ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+  if (OB_SUCC(prep_rw(opcode, fd, fixed_file, buf, size, offset, user_data)) && buf_index >= 0) {
+    (static_cast<struct io_uring_sqe *>(sqes_) + ((sqe_tail_ - 1) & *sq_kring_mask_))->buf_index = buf_index;
+  }
+#else
+  UNUSEDx(fd, fixed_file, buf, size, offset, buf_index, user_data);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+int ObIOUring::prep_nop(const uint64_t user_data)
+{
+#ifdef OB_HAS_IO_URING
+  return prep_rw(IORING_OP_NOP, -1, false, nullptr, 0, 0, user_data);
+#else
+  UNUSED(user_data);
+  return OB_NOT_SUPPORTED;
+#endif
+}
+
+uint32_t ObIOUring::publish()
+{
+  uint32_t count = 0;
+  if (OB_LIKELY(is_inited_)) {
+    const uint32_t mask = *sq_kring_mask_;
+    uint32_t ktail = *sq_ktail_;
+    count = sqe_tail_ - sqe_head_;
+    for (uint32_t i = 0; i < count; ++i) {
+      sq_array_[ktail & mask] = sqe_head_ & mask;
+      ++ktail;
+      ++sqe_head_;
+    }
+    if (count > 0) {
+      __atomic_store_n(sq_ktail_, ktail, __ATOMIC_RELEASE);
+    }
+  }
+  return count;
+}
+
+uint32_t ObIOUring::get_pending_count() const
+{
+  uint32_t count = 0;
+  if (OB_LIKELY(is_inited_)) {
+    count = __atomic_load_n(sq_ktail_, __ATOMIC_ACQUIRE) - __atomic_load_n(sq_khead_, __ATOMIC_ACQUIRE);
+  }
+  return count;
+}
+
+int ObIOUring::enter(const uint32_t to_submit, uint32_t &submitted_count)
+{
+  int ret = OB_SUCCESS;
+  submitted_count = 0;
+#ifdef OB_HAS_IO_URING
+  int sys_ret = 0;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (0 == to_submit) {
+    // do nothing
+  } else {
+    while ((sys_ret = sys_io_uring_enter(ring_fd_, to_submit, 0, 0)) < 0 && EINTR == errno);
+    if (sys_ret < 0) {
+      ret = (EAGAIN == errno || EBUSY == errno) ? OB_EAGAIN : OB_IO_ERROR;
+      if (OB_EAGAIN != ret) {
+        LOG_WARN("io_uring_enter failed", K(ret), K(to_submit), K(errno), KERRMSG);
+      }
+    } else {
+      submitted_count = static_cast<uint32_t>(sys_ret);
+    }
+  }
+#else
+  UNUSED(to_submit);
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+int64_t ObIOUring::peek_cqes(ObIOUringCqe *cqes, const int64_t max_count)
+{
+  int64_t count = 0;
+#ifdef OB_HAS_IO_URING
+  if (OB_LIKELY(is_inited_) && OB_NOT_NULL(cqes)) {
+    const uint32_t mask = *cq_kring_mask_;
+    uint32_t head = *cq_khead_;
+    const uint32_t tail = __atomic_load_n(cq_ktail_, __ATOMIC_ACQUIRE);
+    const struct io_uring_cqe *kcqes = static_cast<const struct io_uring_cqe *>(cqes_);
+    while (head != tail && count < max_count) {
+      const struct io_uring_cqe &cqe = kcqes[head & mask];
+      cqes[count].user_data_ = cqe.user_data;
+      cqes[count].res_ = cqe.res;
+      ++count;
+      ++head;
+    }
+    if (count > 0) {
+      __atomic_store_n(cq_khead_, head, __ATOMIC_RELEASE);
+    }
+  }
+#else
+  UNUSEDx(cqes, max_count);
+#endif
+  return count;
+}
+
+int ObIOUring::wait_cqe()
+{
+  int ret = OB_SUCCESS;
+#ifdef OB_HAS_IO_URING
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret), K(is_inited_));
+  } else if (*cq_khead_ != __atomic_load_n(cq_ktail_, __ATOMIC_ACQUIRE)) {
+    // already has completions
+  } else if (sys_io_uring_enter(ring_fd_, 0, 1, IORING_ENTER_GETEVENTS) < 0 && EINTR != errno) {
+    ret = OB_IO_ERROR;
+    if (REACH_TIME_INTERVAL(10 * 1000 * 1000)) {
+      LOG_WARN("wait io_uring completion failed", K(ret), K(errno), KERRMSG);
+    }
+  }
+#else
+  ret = OB_NOT_SUPPORTED;
+#endif
+  return ret;
+}
+
+} // namespace common
+} // namespace oceanbase
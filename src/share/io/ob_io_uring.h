@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_SHARE_IO_OB_IO_URING_H
+#define OCEANBASE_SHARE_IO_OB_IO_URING_H
+
+#include <stdint.h>
+#include "lib/utility/ob_print_utils.h"
+
+namespace oceanbase
+{
+namespace common
+{
+
+struct ObIOUringCqe final
+{
+public:
+  ObIOUringCqe() : user_data_(0), res_(0) {}
+  TO_STRING_KV(K(user_data_), K(res_));
+public:
+  uint64_t user_data_;
+  int32_t res_; // bytes transferred, or -errno
+};
+
+/**
+ * thin wrapper of one io_uring instance, talks to the kernel through raw syscalls so that
+ * no liburing is needed. prep_xxx and publish are not thread safe and should be serialized by caller,
+ * enter can be called concurrently. CQ is expected to be consumed by a single polling thread.
+ * when the build environment or the running kernel has no io_uring, init returns OB_NOT_SUPPORTED.
+ */
+class ObIOUring final
+{
+public:
+  ObIOUring();
+  ~ObIOUring();
+  static bool is_supported();
+  int init(const uint32_t entries);
+  void destroy();
+  bool is_inited() const { return is_inited_; }
+
+  // fixed resource registration
+  int register_files(const int *fds, const uint32_t count);
+  int register_sparse_buffers(const uint32_t count);
+  int update_buffer(const uint32_t index, void *base, const int64_t size);
+
+  // submission side, return OB_EAGAIN when SQ is full
+  int prep_read(const int fd, const bool fixed_file, void *buf, const uint32_t size,
+                const int64_t offset, const int32_t buf_index, const uint64_t user_data);
+  int prep_write(const int fd, const bool fixed_file, const void *buf, const uint32_t size,
+                 const int64_t offset, const int32_t buf_index, const uint64_t user_data);
+  int prep_nop(const uint64_t user_data);
+  // make prepared sqes visible to kernel, serialized with prep_xxx by caller
+  uint32_t publish();
+  // sqes published but not consumed by kernel yet, thread safe
+  uint32_t get_pending_count() const;
+  // hand published sqes to kernel, thread safe, concurrent callers are serialized by kernel
+  int enter(const uint32_t to_submit, uint32_t &submitted_count);
+
+  // completion side
+  int64_t peek_cqes(ObIOUringCqe *cqes, const int64_t max_count);
+  int wait_cqe(); // block until at least one cqe is ready
+
+  TO_STRING_KV(K(is_inited_), K(ring_fd_), K(sq_entries_), K(cq_entries_),
+               K(sqe_head_), K(sqe_tail_), K(has_fixed_buffers_));
+private:
+  int prep_rw(const uint8_t opcode, const int fd, const bool fixed_file, const void *buf,
+              const uint32_t size, const int64_t offset, const uint64_t user_data);
+  int map_rings();
+  void unmap_rings();
+private:
+  bool is_inited_;
+  int ring_fd_;
+  uint32_t sq_entries_;
+  uint32_t cq_entries_;
+  uint32_t features_;
+  // sq ring
+  void *sq_ring_ptr_;
+  int64_t sq_ring_size_;
+  uint32_t *sq_khead_;
+  uint32_t *sq_ktail_;
+  uint32_t *sq_kring_mask_;
+  uint32_t *sq_kflags_;
+  uint32_t *sq_array_;
+  void *sqes_;
+  int64_t sqes_size_;
+  uint32_t sqe_head_; // local, sqes handed to kernel
+  uint32_t sqe_tail_; // local, sqes prepared
+  // cq ring
+  void *cq_ring_ptr_;
+  int64_t cq_ring_size_;
+  uint32_t *cq_khead_;
+  uint32_t *cq_ktail_;
+  uint32_t *cq_kring_mask_;
+  void *cqes_;
+  bool has_fixed_buffers_;
+  DISALLOW_COPY_AND_ASSIGN(ObIOUring);
+};
+
+} // namespace common
+} // namespace oceanbase
+
+#endif // OCEANBASE_SHARE_IO_OB_IO_URING_H
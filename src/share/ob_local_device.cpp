@@ -1232,6 +1232,32 @@ int ObLocalDevice::io_getevents(
   return ret;
 }
 
+int ObLocalDevice::get_io_target(
+    const common::ObIOFd &fd,
+    const int64_t offset,
+    int &raw_fd,
+    int64_t &file_offset,
+    bool &is_block_file)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    SHARE_LOG(WARN, "The ObLocalDevice has not been inited, ", K(ret));
+  } else if (OB_UNLIKELY(fd.is_super_block())) {
+    ret = OB_NOT_SUPPORTED;
+    SHARE_LOG(WARN, "server entry doesn't support AIO", K(ret), K(fd));
+  } else if (fd.is_block_file()) {
+    raw_fd = block_fd_;
+    file_offset = get_block_file_offset(fd, offset);
+    is_block_file = true;
+  } else {
+    raw_fd = static_cast<int32_t>(fd.second_id_);
+    file_offset = offset;
+    is_block_file = false;
+  }
+  return ret;
+}
+
 common::ObIOCB* ObLocalDevice::alloc_iocb()
 {
   ObLocalIOCB *iocb = nullptr;
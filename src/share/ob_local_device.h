@@ -166,6 +166,15 @@ public:
   virtual int64_t get_reserved_block_count() const override;
   virtual int check_space_full(const int64_t required_size) const override;
 
+  // raw fd interfaces, used by io_uring channel which bypasses ObIOCB
+  int get_block_file_fd() const { return block_fd_; }
+  int get_io_target(
+    const common::ObIOFd &fd,
+    const int64_t offset,
+    int &raw_fd,
+    int64_t &file_offset,
+    bool &is_block_file);
+
 public:
   static const int64_t RESERVED_BLOCK_INDEX = 2; // the first 2 blocks is used for super block
 
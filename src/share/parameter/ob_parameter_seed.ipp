@@ -226,6 +226,15 @@ DEF_BOOL(enable_sql_operator_dump, OB_CLUSTER_PARAMETER, "True", "specifies whet
 DEF_CAP(_chunk_row_store_mem_limit, OB_CLUSTER_PARAMETER, "0B", "[0,]",
         "the maximum size of memory used by ChunkRowStore, 0 means follow operator's setting. Range: [0, +∞)",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_chunk_row_store_dump_compress, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether ChunkRowStore compresses blocks when dumping to temp file, "
+         "LZ4 or ZSTD is chosen by sampled compression ratio",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_nlj_adaptive_hash_threshold, OB_CLUSTER_PARAMETER, "1000", "[0,]",
+        "the left row count after which nested loop join without rescan params builds a hash table "
+        "on the right child and probes it instead of scanning right child per left row, "
+        "0 means disabled. Range: [0, +∞)",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_STR_WITH_CHECKER(tableapi_transport_compress_func, OB_CLUSTER_PARAMETER, "none",
                      common::ObConfigCompressFuncChecker,
                      "compressor used for tableAPI query result. Values: none, lz4_1.0, snappy_1.0, zlib_1.0, zstd_1.0 zstd 1.3.8",
@@ -419,6 +428,10 @@ DEF_INT(_enable_hash_join_processor, OB_TENANT_PARAMETER, "7", "[1, 7]",
          "which path to process for hash join, default 7 to auto choose "
          "1: nest loop, 2: recursive, 4: in-memory",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_hash_join_skew_partition, OB_TENANT_PARAMETER, "True",
+         "specifies whether hash join samples build side to keep heavy hitter keys in "
+         "an in-memory partition and sizes dumped partitions to fit memory bound in one pass",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(_pushdown_storage_level, OB_TENANT_PARAMETER, "3", "[0, 3]",
         "the level of storage pushdown. Range: [0, 3] "
         "0: disabled, 1:blockscan, 2: blockscan & filter, 3: blockscan & filter & aggregate",
@@ -574,6 +587,17 @@ DEF_TIME(log_storage_warning_tolerance_time, OB_CLUSTER_PARAMETER, "5s",
         "Range: [1s,300s]",
         ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
+DEF_INT(_log_writer_parallelism, OB_TENANT_PARAMETER, "1", "[1, 8]",
+        "the number of log writer threads of each tenant, log streams are distributed to them by id. "
+        "Range: [1, 8] in integer",
+        ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+
+DEF_CAP(_palf_log_cache_size, OB_TENANT_PARAMETER, "4M", "[0M, 64M]",
+        "the size of flushed log cached in memory for reading of each log stream, 0 means turned off. "
+        "The caches of all log streams of a tenant take at most 1% of the tenant memory. "
+        "Range: [0M, 64M]",
+        ObParameterAttr(Section::LOGSERVICE, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
+
 // ========================= LogService Config End   =====================
 DEF_INT(resource_hard_limit, OB_CLUSTER_PARAMETER, "100", "[100, 10000]",
         "system utilization should not be large than resource_hard_limit",
@@ -770,6 +794,11 @@ DEF_INT_WITH_CHECKER(disk_io_thread_count, OB_CLUSTER_PARAMETER, "8",
                      "[2,32]",
                      "The number of io threads on each disk. The default value is 8. Range: [2,32] in even integer",
                      ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_io_uring, OB_CLUSTER_PARAMETER, "False",
+         "specifies whether to submit data file io through io_uring instead of libaio, "
+         "fall back to libaio if io_uring is not supported by the kernel. "
+         "Value: True:turned on;  False: turned off",
+         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::STATIC_EFFECTIVE));
 DEF_INT(_io_callback_thread_count, OB_TENANT_PARAMETER, "8", "[1,64]",
         "The number of io callback threads. The default value is 8. Range: [1,64] in integer",
         ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -787,6 +816,23 @@ DEF_BOOL(_enable_parallel_minor_merge, OB_TENANT_PARAMETER, "True",
 DEF_BOOL(_enable_adaptive_compaction, OB_TENANT_PARAMETER, "True",
          "specifies whether allow adaptive compaction schedule and information collection",
          ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_skip_index, OB_TENANT_PARAMETER, "False",
+         "specifies whether major compaction writes min/max skip index into index blocks for pruning scans. "
+         "Value: True:turned on;  False: turned off",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_float_xor_encoding, OB_TENANT_PARAMETER, "False",
+         "specifies whether float and double columns can be written with xor encoding. "
+         "Value: True:turned on;  False: turned off",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_delta_of_delta_encoding, OB_TENANT_PARAMETER, "False",
+         "specifies whether integer and datetime columns can be written with delta of delta encoding. "
+         "Value: True:turned on;  False: turned off",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_BOOL(_enable_memtable_key_prefix, OB_TENANT_PARAMETER, "False",
+         "specifies whether the index of newly created memtables keeps the prefix of rowkeys in btree nodes "
+         "to speed up searching, it takes extra memory of each node. "
+         "Value: True:turned on;  False: turned off",
+         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 DEF_INT(compaction_low_thread_score, OB_TENANT_PARAMETER, "0", "[0,100]",
         "the current work thread score of low priority compaction. Range: [0,100] in integer. Especially, 0 means default value",
         ObParameterAttr(Section::TENANT, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
@@ -1266,6 +1312,10 @@ DEF_TIME(_ob_obj_dep_maint_task_interval, OB_CLUSTER_PARAMETER, "1ms", "[0,10s]"
 DEF_BOOL(_enable_newsort, OB_CLUSTER_PARAMETER, "True",
          "control if enable encode sort",
          ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
+DEF_INT(_newsort_collation_key_min_rows, OB_CLUSTER_PARAMETER, "10000", "[0,]",
+        "the estimated row count from which encode sort is used for sort keys containing "
+        "strings with non binary collation. Range: [0, +∞)",
+        ObParameterAttr(Section::OBSERVER, Source::DEFAULT, EditLevel::DYNAMIC_EFFECTIVE));
 
 DEF_INT(_session_context_size, OB_CLUSTER_PARAMETER, "10000", "[0, 2147483647]",
          "limits the total number of (namespace, attribute) pairs "
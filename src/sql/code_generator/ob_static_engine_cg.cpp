@@ -1707,6 +1707,15 @@ int ObStaticEngineCG::generate_spec(ObLogSort &op, ObSortSpec &spec, const bool
       spec.minimum_row_count_ = op.get_minimum_row_count();
       spec.topk_precision_ = op.get_topk_precision();
     }
+    if (OB_NOT_NULL(op.get_part_topn_expr())) {
+      spec.is_part_topn_with_ties_ = op.is_part_topn_with_ties();
+      OZ(generate_rt_expr(*op.get_part_topn_expr(), spec.part_topn_expr_));
+      if (OB_NOT_NULL(spec.part_topn_expr_)
+          && !ob_is_integer_type(spec.part_topn_expr_->datum_meta_.type_)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("part topn must be int", K(ret), K(*spec.part_topn_expr_));
+      }
+    }
     if (OB_SUCC(ret)) {
       ObSEArray<OrderItem, 1> sortkeys;
       if (op.get_part_cnt() > 0 && OB_FAIL(sortkeys.push_back(op.get_hash_sortkey()))) {
@@ -4359,6 +4368,9 @@ int ObStaticEngineCG::generate_join_spec(ObLogJoin &op, ObJoinSpec &spec)
               }
             }
           }
+          if (OB_SUCC(ret) && OB_FAIL(generate_nlj_adaptive_hash_keys(op, nlj))) {
+            LOG_WARN("fail to generate adaptive hash keys", K(ret));
+          }
         }
       }
     }
@@ -4529,6 +4541,92 @@ int ObStaticEngineCG::calc_equal_cond_opposite(const ObLogJoin &op,
   return ret;
 }
 
+// Nested loop join whose right child is independent of left row can switch to hash probe
+// at runtime, collect the hashable equal conditions of other join conditions here.
+int ObStaticEngineCG::generate_nlj_adaptive_hash_keys(const ObLogJoin &op,
+                                                      ObNestedLoopJoinSpec &spec)
+{
+  int ret = OB_SUCCESS;
+  const ObIArray<ObRawExpr*> &other_join_conds = op.get_other_join_conditions();
+  const ObLogicalOperator *left_child = op.get_child(0);
+  const ObLogicalOperator *right_child = op.get_child(1);
+  ObSEArray<ObExpr*, 4> left_keys;
+  ObSEArray<ObExpr*, 4> right_keys;
+  spec.enable_adaptive_hash_ = false;
+  if (OB_ISNULL(left_child) || OB_ISNULL(right_child)
+      || OB_UNLIKELY(other_join_conds.count() != spec.other_join_conds_.count())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("unexpected nested loop join", K(ret), KP(left_child), KP(right_child));
+  } else if (!op.get_nl_params().empty()
+             || spec.group_rescan_
+             || spec.enable_px_batch_rescan_
+             || spec.enable_gi_partition_pruning_
+             || (INNER_JOIN != spec.join_type_
+                 && LEFT_OUTER_JOIN != spec.join_type_
+                 && LEFT_SEMI_JOIN != spec.join_type_
+                 && LEFT_ANTI_JOIN != spec.join_type_)) {
+    // right child depends on left row, keep nested loop
+  } else {
+    ARRAY_FOREACH(other_join_conds, i) {
+      const ObRawExpr *raw_expr = other_join_conds.at(i);
+      const ObExpr *cond = spec.other_join_conds_.at(i);
+      const ObRawExpr *lexpr = NULL;
+      const ObRawExpr *rexpr = NULL;
+      bool hashable = true;
+      bool is_opposite = false;
+      if (OB_ISNULL(raw_expr) || OB_ISNULL(cond)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("null condition", K(ret), KP(raw_expr), KP(cond));
+      } else if (T_OP_EQ != raw_expr->get_expr_type()
+                 || 2 != raw_expr->get_param_count()
+                 || 2 != cond->arg_cnt_
+                 || raw_expr->has_flag(CNT_SUB_QUERY)
+                 || OB_ISNULL(lexpr = raw_expr->get_param_expr(0))
+                 || OB_ISNULL(rexpr = raw_expr->get_param_expr(1))
+                 || lexpr->get_relation_ids().is_empty()
+                 || rexpr->get_relation_ids().is_empty()) {
+        hashable = false;
+      } else if (lexpr->get_relation_ids().is_subset(left_child->get_table_set())
+                 && rexpr->get_relation_ids().is_subset(right_child->get_table_set())) {
+        is_opposite = false;
+      } else if (lexpr->get_relation_ids().is_subset(right_child->get_table_set())
+                 && rexpr->get_relation_ids().is_subset(left_child->get_table_set())) {
+        is_opposite = true;
+      } else {
+        hashable = false;
+      }
+      if (OB_SUCC(ret) && hashable) {
+        ObExpr *lkey = cond->args_[is_opposite ? 1 : 0];
+        ObExpr *rkey = cond->args_[is_opposite ? 0 : 1];
+        // equal values must have equal hash values, so both sides need the same hash function
+        if (OB_ISNULL(lkey) || OB_ISNULL(rkey)
+            || OB_ISNULL(lkey->basic_funcs_) || OB_ISNULL(rkey->basic_funcs_)
+            || lkey->datum_meta_.type_ != rkey->datum_meta_.type_
+            || lkey->datum_meta_.cs_type_ != rkey->datum_meta_.cs_type_
+            || is_lob_storage(lkey->datum_meta_.type_)
+            || lkey->obj_meta_.has_lob_header()
+            || rkey->obj_meta_.has_lob_header()) {
+          // not hashable
+        } else if (OB_FAIL(left_keys.push_back(lkey))) {
+          LOG_WARN("fail to push back left key", K(ret));
+        } else if (OB_FAIL(right_keys.push_back(rkey))) {
+          LOG_WARN("fail to push back right key", K(ret));
+        }
+      }
+    }
+    if (OB_SUCC(ret) && !left_keys.empty()) {
+      if (OB_FAIL(spec.left_hash_keys_.assign(left_keys))) {
+        LOG_WARN("fail to assign left hash keys", K(ret));
+      } else if (OB_FAIL(spec.right_hash_keys_.assign(right_keys))) {
+        LOG_WARN("fail to assign right hash keys", K(ret));
+      } else {
+        spec.enable_adaptive_hash_ = true;
+      }
+    }
+  }
+  return ret;
+}
+
 int ObStaticEngineCG::set_optimization_info(ObLogTableScan &op, ObTableScanSpec &spec)
 {
   int ret = OB_SUCCESS;
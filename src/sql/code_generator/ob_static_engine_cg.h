@@ -404,6 +404,7 @@ private:
   int calc_equal_cond_opposite(const ObLogJoin &op,
                                const ObRawExpr &raw_expr,
                                bool &is_opposite);
+  int generate_nlj_adaptive_hash_keys(const ObLogJoin &op, ObNestedLoopJoinSpec &spec);
   int fill_sort_info(
     const ObIArray<OrderItem> &sort_keys,
     ObSortCollations &collations,
@@ -18,6 +18,7 @@
 #include "sql/engine/basic/ob_chunk_row_store.h"
 #include "lib/container/ob_se_array_iterator.h"
 #include "lib/utility/ob_tracepoint.h"
+#include "lib/compress/ob_compressor_pool.h"
 #include "share/config/ob_server_config.h"
 
 namespace oceanbase
@@ -453,7 +454,9 @@ ObChunkDatumStore::ObChunkDatumStore(common::ObIAllocator *alloc /* = NULL */)
     mem_hold_(0), mem_used_(0), max_hold_mem_(0),
     allocator_(NULL == alloc ? &inner_allocator_ : alloc),
     row_extend_size_(0), callback_(nullptr), batch_ctx_(NULL),
-    tmp_dump_blk_(nullptr)
+    tmp_dump_blk_(nullptr), enable_dump_compress_(false),
+    dump_compressor_type_(NONE_COMPRESSOR), n_compress_block_(0),
+    compress_buf_(nullptr), compress_buf_size_(0)
 {
   io_.fd_ = -1;
   io_.dir_id_ = -1;
@@ -484,6 +487,9 @@ int ObChunkDatumStore::init(int64_t mem_limit,
   min_blk_size_ = INT64_MAX;
   io_.fd_ = -1;
   row_extend_size_ = row_extend_size;
+  enable_dump_compress_ = GCONF._chunk_row_store_dump_compress;
+  dump_compressor_type_ = NONE_COMPRESSOR;
+  n_compress_block_ = 0;
   return ret;
 }
 
@@ -518,6 +524,9 @@ void ObChunkDatumStore::reset()
   cur_blk_buffer_ = nullptr;
   free_block(tmp_dump_blk_);
   tmp_dump_blk_ = nullptr;
+  free_compress_buf();
+  dump_compressor_type_ = NONE_COMPRESSOR;
+  n_compress_block_ = 0;
   while (!free_list_.is_empty()) {
     Block *item = free_list_.remove_first();
     mem_hold_ -= item->get_buffer()->mem_size();
@@ -716,6 +725,10 @@ inline int ObChunkDatumStore::dump_one_block(BlockBuffer *item)
   item->block->magic_ = Block::MAGIC;
   if (OB_FAIL(item->get_block()->unswizzling())) {
     LOG_WARN("convert block to copyable failed", K(ret));
+  } else if (enable_dump_compress_) {
+    if (OB_FAIL(dump_compressed_block(item))) {
+      LOG_WARN("write compressed block to file failed", K(ret));
+    }
   } else if (item->capacity() < min_block_size) {
     if (OB_ISNULL(tmp_dump_blk_)) {
       if (OB_FAIL(alloc_block_buffer(tmp_dump_blk_, default_block_size_, false))) {
@@ -749,6 +762,158 @@ inline int ObChunkDatumStore::dump_one_block(BlockBuffer *item)
   return ret;
 }
 
+// only the used part of block is compressed, compressed blocks are written back to back
+// without padding, see ChunkIterator::read_next_compressed_blk() for the read path.
+int ObChunkDatumStore::dump_compressed_block(BlockBuffer *item)
+{
+  int ret = OB_SUCCESS;
+  const char *data = item->data();
+  const int64_t data_size = item->data_size();
+  CompressedBlockHead *head = NULL;
+  if (OB_FAIL(prepare_compress_buf(data_size))) {
+    LOG_WARN("prepare compress buffer failed", K(ret), K(data_size));
+  } else if (OB_FAIL(choose_dump_compressor(data, data_size))) {
+    LOG_WARN("choose dump compressor failed", K(ret), K(data_size));
+  } else if (OB_FAIL(compress_block(dump_compressor_type_, data, data_size, head))) {
+    LOG_WARN("compress block failed", K(ret), K_(dump_compressor_type), K(data_size));
+  } else {
+    head->rows_ = item->get_block()->rows_;
+    head->raw_blk_size_ = item->get_block()->blk_size_;
+    if (OB_FAIL(write_file(compress_buf_, head->blk_size_))) {
+      LOG_WARN("write compressed block to file failed", K(ret), KPC(head));
+    } else {
+      LOG_DEBUG("RowStore dumped compressed block", KPC(head));
+    }
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::prepare_compress_buf(const int64_t data_size)
+{
+  int ret = OB_SUCCESS;
+  int64_t overflow_size = 0;
+  if (OB_FAIL(ObCompressorPool::get_instance().get_max_overflow_size(data_size, overflow_size))) {
+    LOG_WARN("get max overflow size failed", K(ret), K(data_size));
+  } else {
+    const int64_t size = sizeof(CompressedBlockHead) + data_size + overflow_size;
+    if (size > compress_buf_size_) {
+      free_compress_buf();
+      const int64_t buf_size = next_pow2(std::max(size, default_block_size_));
+      if (OB_ISNULL(compress_buf_ = static_cast<char *>(alloc_blk_mem(buf_size, true)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("alloc compress buffer failed", K(ret), K(buf_size));
+      } else {
+        compress_buf_size_ = buf_size;
+      }
+    }
+  }
+  return ret;
+}
+
+void ObChunkDatumStore::free_compress_buf()
+{
+  if (NULL != compress_buf_) {
+    allocator_->free(compress_buf_);
+    callback_free(compress_buf_size_);
+    compress_buf_ = NULL;
+    compress_buf_size_ = 0;
+  }
+}
+
+// compress the sampled block with both LZ4 and ZSTD, ZSTD is only chosen when it saves
+// considerably more than LZ4 since temp file bandwidth is what we are trying to save.
+int ObChunkDatumStore::choose_dump_compressor(const char *data, const int64_t data_size)
+{
+  int ret = OB_SUCCESS;
+  if (0 == n_compress_block_++ % COMPRESS_SAMPLE_INTERVAL) {
+    CompressedBlockHead *head = NULL;
+    int64_t lz4_size = data_size;
+    int64_t zstd_size = data_size;
+    if (OB_FAIL(compress_block(LZ4_COMPRESSOR, data, data_size, head))) {
+      LOG_WARN("sample LZ4 compress failed", K(ret), K(data_size));
+    } else if (FALSE_IT(lz4_size = head->data_size())) {
+    } else if (OB_FAIL(compress_block(ZSTD_COMPRESSOR, data, data_size, head))) {
+      LOG_WARN("sample ZSTD compress failed", K(ret), K(data_size));
+    } else {
+      zstd_size = head->data_size();
+      if (zstd_size * 100 <= data_size * COMPRESS_MIN_GAIN_PCT
+          && zstd_size * 100 <= lz4_size * COMPRESS_ZSTD_PREFER_PCT) {
+        dump_compressor_type_ = ZSTD_COMPRESSOR;
+      } else if (lz4_size * 100 <= data_size * COMPRESS_MIN_GAIN_PCT) {
+        dump_compressor_type_ = LZ4_COMPRESSOR;
+      } else {
+        dump_compressor_type_ = NONE_COMPRESSOR;
+      }
+      LOG_TRACE("choose dump compressor", K_(dump_compressor_type), K(data_size),
+                K(lz4_size), K(zstd_size), K_(n_compress_block));
+    }
+  }
+  return ret;
+}
+
+// compress %data into %compress_buf_ and fill %head, fall back to store raw data
+// if compression gains nothing.
+int ObChunkDatumStore::compress_block(const ObCompressorType type,
+                                      const char *data,
+                                      const int64_t data_size,
+                                      CompressedBlockHead *&head)
+{
+  int ret = OB_SUCCESS;
+  ObCompressor *compressor = NULL;
+  char *buf = compress_buf_ + sizeof(CompressedBlockHead);
+  const int64_t buf_size = compress_buf_size_ - sizeof(CompressedBlockHead);
+  int64_t size = data_size;
+  ObCompressorType real_type = type;
+  if (OB_ISNULL(compress_buf_) || data_size > buf_size) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("compress buffer not enough", K(ret), KP_(compress_buf), K(buf_size), K(data_size));
+  } else if (NONE_COMPRESSOR == type) {
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(type, compressor))) {
+    LOG_WARN("get compressor failed", K(ret), K(type));
+  } else if (OB_FAIL(compressor->compress(data, data_size, buf, buf_size, size))) {
+    LOG_WARN("compress failed", K(ret), K(type), K(data_size), K(buf_size));
+  }
+  if (OB_SUCC(ret)) {
+    if (size >= data_size) {
+      real_type = NONE_COMPRESSOR;
+      size = data_size;
+      MEMCPY(buf, data, data_size);
+    }
+    head = new (compress_buf_) CompressedBlockHead();
+    head->blk_size_ = static_cast<uint32>(sizeof(CompressedBlockHead) + size);
+    head->raw_data_size_ = static_cast<uint32>(data_size);
+    head->compressor_type_ = real_type;
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::decompress_block(const CompressedBlockHead &head,
+                                        const char *data,
+                                        char *buf,
+                                        const int64_t buf_size)
+{
+  int ret = OB_SUCCESS;
+  ObCompressor *compressor = NULL;
+  const ObCompressorType type = static_cast<ObCompressorType>(head.compressor_type_);
+  int64_t size = 0;
+  if (OB_ISNULL(data) || OB_ISNULL(buf) || buf_size < head.raw_data_size_) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(head), KP(data), KP(buf), K(buf_size));
+  } else if (NONE_COMPRESSOR == type) {
+    MEMCPY(buf, data, head.raw_data_size_);
+    size = head.raw_data_size_;
+  } else if (OB_FAIL(ObCompressorPool::get_instance().get_compressor(type, compressor))) {
+    LOG_WARN("get compressor failed", K(ret), K(head));
+  } else if (OB_FAIL(compressor->decompress(data, head.data_size(), buf, buf_size, size))) {
+    LOG_WARN("decompress failed", K(ret), K(head), K(buf_size));
+  }
+  if (OB_SUCC(ret) && size != head.raw_data_size_) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("decompressed size mismatch", K(ret), K(head), K(size));
+  }
+  return ret;
+}
+
 int ObChunkDatumStore::clean_block(Block *clean_block)
 {
   int ret = OB_SUCCESS;
@@ -1945,6 +2110,140 @@ int ObChunkDatumStore::ChunkIterator::prefetch_next_blk()
   return ret;
 }
 
+// issue aio to fill the free space of compressed read ahead buffer.
+int ObChunkDatumStore::ChunkIterator::prefetch_compressed_data()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(comp_aio_pending_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("previous aio not finished", K(ret));
+  } else if (NULL == comp_blk_) {
+    if (OB_FAIL(alloc_block(comp_blk_, default_block_size_))) {
+      LOG_WARN("alloc block failed", K(ret));
+    } else {
+      comp_blk_buf_ = comp_blk_->get_buffer();
+      comp_begin_ = 0;
+      comp_end_ = 0;
+    }
+  }
+  if (OB_SUCC(ret)) {
+    char *buf = reinterpret_cast<char *>(comp_blk_);
+    if (comp_begin_ > 0) {
+      MEMMOVE(buf, buf + comp_begin_, comp_end_ - comp_begin_);
+      comp_end_ -= comp_begin_;
+      comp_begin_ = 0;
+    }
+    const int64_t read_size = std::min(comp_blk_buf_->capacity() - comp_end_,
+                                       file_size_ - cur_iter_pos_);
+    if (read_size > 0) {
+      if (OB_FAIL(aio_read(buf + comp_end_, read_size))) {
+        LOG_WARN("aio read failed", K(ret), K(read_size));
+      } else {
+        comp_end_ += read_size;
+        comp_aio_pending_ = true;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::ChunkIterator::wait_compressed_data()
+{
+  int ret = OB_SUCCESS;
+  if (comp_aio_pending_) {
+    if (OB_FAIL(aio_wait())) {
+      LOG_WARN("aio wait failed", K(ret));
+    } else {
+      comp_aio_pending_ = false;
+    }
+  }
+  return ret;
+}
+
+// make sure at least %size bytes are ready in read ahead buffer.
+int ObChunkDatumStore::ChunkIterator::ensure_compressed_data(const int64_t size)
+{
+  int ret = OB_SUCCESS;
+  if (OB_FAIL(wait_compressed_data())) {
+    LOG_WARN("wait compressed data failed", K(ret));
+  } else if (comp_end_ - comp_begin_ < size) {
+    if (NULL != comp_blk_ && size > comp_blk_buf_->capacity()) {
+      // block larger than read ahead buffer, enlarge it
+      Block *blk = NULL;
+      if (OB_FAIL(alloc_block(blk, size + sizeof(BlockBuffer)))) {
+        LOG_WARN("alloc block failed", K(ret), K(size));
+      } else {
+        BlockBuffer *blk_buf = blk->get_buffer();
+        MEMCPY(blk, reinterpret_cast<char *>(comp_blk_) + comp_begin_, comp_end_ - comp_begin_);
+        free_block(comp_blk_, comp_blk_buf_->mem_size(), true);
+        comp_blk_ = blk;
+        comp_blk_buf_ = blk_buf;
+        comp_end_ -= comp_begin_;
+        comp_begin_ = 0;
+      }
+    }
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(prefetch_compressed_data())) {
+      LOG_WARN("prefetch compressed data failed", K(ret));
+    } else if (OB_FAIL(wait_compressed_data())) {
+      LOG_WARN("wait compressed data failed", K(ret));
+    } else if (OB_UNLIKELY(comp_end_ - comp_begin_ < size)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("compressed data less than expected", K(ret), K(size), K(*this));
+    }
+  }
+  return ret;
+}
+
+int ObChunkDatumStore::ChunkIterator::read_next_compressed_blk()
+{
+  int ret = OB_SUCCESS;
+  CompressedBlockHead head;
+  Block *blk = NULL;
+  BlockBuffer *blk_buf = NULL;
+  if (OB_FAIL(ensure_compressed_data(sizeof(CompressedBlockHead)))) {
+    LOG_WARN("read compressed block head failed", K(ret));
+  } else if (FALSE_IT(MEMCPY(&head, reinterpret_cast<char *>(comp_blk_) + comp_begin_,
+                             sizeof(head)))) {
+  } else if (!head.magic_check() || head.blk_size_ <= sizeof(head)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("read corrupt compressed block", K(ret), K(head), K(*this), K(*store_));
+  } else if (OB_FAIL(ensure_compressed_data(head.blk_size_))) {
+    LOG_WARN("read compressed block failed", K(ret), K(head));
+  } else if (OB_FAIL(alloc_block(blk, head.raw_blk_size_ + sizeof(BlockBuffer)))) {
+    LOG_WARN("alloc block failed", K(ret), K(head));
+  } else if (FALSE_IT(blk_buf = blk->get_buffer())) {
+  } else if (OB_FAIL(ObChunkDatumStore::decompress_block(
+      head, reinterpret_cast<char *>(comp_blk_) + comp_begin_ + sizeof(head),
+      reinterpret_cast<char *>(blk), blk_buf->capacity()))) {
+    LOG_WARN("decompress block failed", K(ret), K(head));
+  } else if (!blk->magic_check()) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("read corrupt data", K(ret), K(head), K(*blk), K(*this), K(*store_));
+  } else {
+    comp_begin_ += head.blk_size_;
+    if (NULL != read_blk_) {
+      free_block(read_blk_, read_blk_buf_->mem_size());
+    }
+    read_blk_ = blk;
+    read_blk_buf_ = blk_buf;
+    blk = NULL;
+    if (OB_FAIL(read_blk_->swizzling(NULL))) {
+      LOG_WARN("swizzling failed", K(ret));
+    } else {
+      cur_chunk_n_blocks_ = 1;
+      cur_nth_blk_ += 1;
+      read_blk_->next_ = NULL;
+      cur_iter_blk_ = read_blk_;
+      chunk_n_rows_ = cur_iter_blk_->rows_;
+    }
+  }
+  if (NULL != blk) {
+    free_block(blk, blk_buf->mem_size(), true);
+  }
+  return ret;
+}
+
 // assume we have written blk(0)~blk(9) to the datum store
 // blk(0)~blk(n) will be read from disk first,
 // blk(n+1)~blk(9) will be read from memory then.
@@ -1963,7 +2262,16 @@ int ObChunkDatumStore::ChunkIterator::load_next_block()
     LOG_WARN("row should be saved", K(ret), K_(cur_nth_blk), K_(store_->n_blocks));
   } else if (store_->is_file_open() && !read_file_iter_end()) {
     uint64_t begin_io_read_time = rdtsc();
-    if (chunk_read_size_ > store_->max_blk_size_) {
+    if (store_->is_dump_compress()) {
+      // compressed blocks are always decompressed one by one
+      if (OB_FAIL(read_next_compressed_blk())) {
+        LOG_WARN("read next compressed blk failed", K(ret));
+      } else if (cur_iter_pos_ >= file_size_ && comp_begin_ >= comp_end_) {
+        set_read_file_iter_end();
+      } else if (OB_FAIL(prefetch_compressed_data())) {
+        LOG_WARN("prefetch compressed data failed", K(ret));
+      }
+    } else if (chunk_read_size_ > store_->max_blk_size_) {
       // may return OB_ITER_END when read file not end (!read_file_iter_end())
       if (OB_FAIL(store_->load_next_chunk_blocks(*this)) && OB_ITER_END != ret) {
         LOG_WARN("RowStore iter load next chunk blocks failed", K(ret));
@@ -2096,6 +2404,11 @@ ObChunkDatumStore::ChunkIterator::ChunkIterator()
     read_blk_buf_(NULL),
     aio_blk_(NULL),
     aio_blk_buf_(NULL),
+    comp_blk_(NULL),
+    comp_blk_buf_(NULL),
+    comp_begin_(0),
+    comp_end_(0),
+    comp_aio_pending_(false),
     age_(NULL)
 {
 }
@@ -2140,10 +2453,18 @@ void ObChunkDatumStore::ChunkIterator::reset_cursor(const int64_t file_size)
   if (NULL != read_blk_) {
     free_block(read_blk_, read_blk_buf_->mem_size(), force_free);
   }
+  if (NULL != comp_blk_) {
+    free_block(comp_blk_, comp_blk_buf_->mem_size(), force_free);
+  }
   aio_blk_ = NULL;
   aio_blk_buf_ = NULL;
   read_blk_ = NULL;
   read_blk_buf_ = NULL;
+  comp_blk_ = NULL;
+  comp_blk_buf_ = NULL;
+  comp_begin_ = 0;
+  comp_end_ = 0;
+  comp_aio_pending_ = false;
 
   while (NULL != cached_.get_first()) {
     free_block(cached_.remove_first(), default_block_size_, force_free);
@@ -2192,6 +2513,33 @@ int ObChunkDatumStore::ChunkIterator::load_next_chunk(RowIterator& it)
   return ret;
 }
 
+int ObChunkDatumStore::ChunkIterator::prefetch()
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_valid())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("ChunkIterator not init", K(ret));
+  } else if (!store_->is_file_open() || read_file_iter_end()) {
+    // nothing to read from disk
+  } else {
+    if (file_size_ != store_->file_size_) {
+      reset_cursor(store_->file_size_);
+    }
+    if (cur_iter_pos_ >= file_size_) {
+      // all data has been issued
+    } else if (store_->is_dump_compress()) {
+      if (!comp_aio_pending_ && NULL == comp_blk_ && OB_FAIL(prefetch_compressed_data())) {
+        LOG_WARN("prefetch compressed data failed", K(ret));
+      }
+    } else if (chunk_read_size_ > store_->max_blk_size_ || NULL != aio_blk_) {
+      // read by chunk synchronously, or aio is reading already
+    } else if (OB_FAIL(prefetch_next_blk())) {
+      LOG_WARN("prefetch next blk failed", K(ret));
+    }
+  }
+  return ret;
+}
+
 int ObChunkDatumStore::Iterator::init(ObChunkDatumStore *store,
                                       int64_t chunk_read_size,
                                       const IterationAge *age /* = NULL */)
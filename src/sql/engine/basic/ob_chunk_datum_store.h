@@ -18,6 +18,7 @@
 #include "lib/allocator/page_arena.h"
 #include "lib/utility/ob_print_utils.h"
 #include "lib/list/ob_dlist.h"
+#include "lib/compress/ob_compress_util.h"
 #include "common/row/ob_row.h"
 #include "common/row/ob_row_iterator.h"
 #include "share/datum/ob_datum.h"
@@ -478,6 +479,27 @@ public:
     char payload_[0];
   } __attribute__((packed));
 
+  /* head of compressed block in dump file, followed by the compressed block data
+   * (Block head included). compressed blocks are variable sized and written back to back.
+   */
+  struct CompressedBlockHead
+  {
+    static const int64_t MAGIC = 0xbc054e02d8536316;
+    CompressedBlockHead()
+      : magic_(MAGIC), blk_size_(0), rows_(0), raw_blk_size_(0), raw_data_size_(0),
+        compressor_type_(common::NONE_COMPRESSOR) {}
+    inline bool magic_check() const { return MAGIC == magic_; }
+    inline int64_t data_size() const { return blk_size_ - sizeof(CompressedBlockHead); }
+    TO_STRING_KV(K_(magic), K_(blk_size), K_(rows), K_(raw_blk_size), K_(raw_data_size),
+                 K_(compressor_type));
+    int64_t magic_;
+    uint32 blk_size_;       /* size in file, head included */
+    uint32 rows_;
+    uint32 raw_blk_size_;   /* blk_size_ of the original block */
+    uint32 raw_data_size_;  /* compressed data size before compression */
+    uint8_t compressor_type_;
+  } __attribute__((packed));
+
   struct BlockList
   {
   public:
@@ -693,6 +715,8 @@ public:
      int init(ObChunkDatumStore *row_store, int64_t chunk_read_size = 0, const IterationAge *age = NULL);
      void set_iteration_age(const IterationAge *age) { age_ = age; }
      int load_next_chunk(RowIterator& it);
+     // issue aio of the next disk block ahead of time, do nothing if already issued.
+     int prefetch();
      inline bool has_next_chunk()
      { return store_->n_blocks_ > 0 && (cur_nth_blk_ < store_->n_blocks_ - 1); }
      void set_chunk_read_size(int64_t chunk_read_size) { chunk_read_size_ = chunk_read_size; }
@@ -728,6 +752,11 @@ public:
      int read_next_blk();
      int aio_read(char *buf, const int64_t size);
      int aio_wait();
+     // read path of compressed dump file
+     int read_next_compressed_blk();
+     int prefetch_compressed_data();
+     int wait_compressed_data();
+     int ensure_compressed_data(const int64_t size);
      int alloc_block(Block *&blk, const int64_t size);
      void free_block(Block *blk, const int64_t size, bool force_free = false);
      void try_free_cached_blocks();
@@ -750,6 +779,13 @@ public:
     BlockBuffer *read_blk_buf_;
     Block *aio_blk_; // not null means aio is reading.
     BlockBuffer *aio_blk_buf_;
+    // read ahead buffer of compressed dump file, [comp_begin_, comp_end_) is not consumed,
+    // the tail of which may be still in reading if %comp_aio_pending_ is set.
+    Block *comp_blk_;
+    BlockBuffer *comp_blk_buf_;
+    int64_t comp_begin_;
+    int64_t comp_end_;
+    bool comp_aio_pending_;
 
     BlockList free_list_;
     // cached blocks for batch iterate
@@ -771,6 +807,8 @@ public:
     void set_chunk_read_size(int64_t chunk_read_size)
     { chunk_it_.set_chunk_read_size(chunk_read_size); }
     void set_iteration_age(const IterationAge *age) { chunk_it_.set_iteration_age(age); }
+    // start reading the first disk block in background, see ChunkIterator::prefetch()
+    int prefetch() { return chunk_it_.prefetch(); }
     int get_next_row(const common::ObIArray<ObExpr*> &exprs,
                      ObEvalCtx &ctx,
                      const StoredRow **sr = nullptr);
@@ -840,6 +878,12 @@ public:
   const static int64_t BLOCK_SIZE = (64L << 10);
   const static int64_t MIN_BLOCK_SIZE = (4L << 10);
   static const int32_t DATUM_SIZE = sizeof(common::ObDatum);
+  // compressor of dump blocks is re-chosen every %COMPRESS_SAMPLE_INTERVAL blocks
+  const static int64_t COMPRESS_SAMPLE_INTERVAL = 64;
+  // percentage of compressed size to raw size, above which data is dumped uncompressed
+  const static int64_t COMPRESS_MIN_GAIN_PCT = 90;
+  // percentage of ZSTD compressed size to LZ4 compressed size, below which ZSTD is preferred
+  const static int64_t COMPRESS_ZSTD_PREFER_PCT = 85;
 
   explicit ObChunkDatumStore(common::ObIAllocator *alloc = NULL);
 
@@ -917,6 +961,15 @@ public:
   void set_dumped(bool dumped) { enable_dump_ = dumped; }
   inline int64_t get_mem_limit() { return mem_limit_; }
   void set_block_size(const int64_t size) { default_block_size_ = size; }
+  // compress blocks when dump, LZ4 or ZSTD is chosen by sampled compression ratio.
+  // only take effect before the first dump.
+  void set_dump_compress(const bool enable)
+  {
+    if (!is_file_open()) {
+      enable_dump_compress_ = enable;
+    }
+  }
+  inline bool is_dump_compress() const { return enable_dump_compress_; }
   inline int64_t get_block_cnt() const { return n_blocks_; }
   inline int64_t get_block_list_cnt() { return blocks_.get_size(); }
   inline int64_t get_row_cnt() const { return row_cnt_; }
@@ -1008,6 +1061,14 @@ private:
       mem_used_ += used;
     }
   inline int dump_one_block(BlockBuffer *item);
+  int dump_compressed_block(BlockBuffer *item);
+  int prepare_compress_buf(const int64_t data_size);
+  void free_compress_buf();
+  int choose_dump_compressor(const char *data, const int64_t data_size);
+  int compress_block(const common::ObCompressorType type, const char *data,
+                     const int64_t data_size, CompressedBlockHead *&head);
+  static int decompress_block(const CompressedBlockHead &head, const char *data,
+                              char *buf, const int64_t buf_size);
 
   int write_file(void *buf, int64_t size);
   int read_file(
@@ -1103,6 +1164,12 @@ private:
   BatchCtx *batch_ctx_;
   Block *tmp_dump_blk_;
 
+  bool enable_dump_compress_;
+  common::ObCompressorType dump_compressor_type_;
+  int64_t n_compress_block_;
+  char *compress_buf_;
+  int64_t compress_buf_size_;
+
   DISALLOW_COPY_AND_ASSIGN(ObChunkDatumStore);
 };
 
@@ -13,6 +13,9 @@
 #ifndef OB_HASH_PARTITIONING_INFRASTRUCTURE_OP_H_
 #define OB_HASH_PARTITIONING_INFRASTRUCTURE_OP_H_
 
+#if defined(__x86_64__)
+#include <emmintrin.h>
+#endif
 #include "lib/list/ob_dlist.h"
 #include "sql/engine/basic/ob_hash_partitioning_basic.h"
 #include "share/datum/ob_datum_funcs.h"
@@ -86,14 +89,30 @@ struct ObHashPartCols
   TO_STRING_KV(K_(store_row));
 };
 
+// Open addressing hash table, buckets are organized in groups of GROUP_SIZE slots.
+// Each slot has a one byte tag (EMPTY_TAG or 7 bits of hash value) stored together
+// at the head of the group, so that all tags of a group are compared by one SIMD
+// instruction and item is only accessed when its tag matches.
 template <typename Item>
 class ObHashPartitionExtendHashTable
 {
 public:
   const static int64_t INITIAL_SIZE = 128;
   const static int64_t SIZE_BUCKET_PERCENT = 80;
+  // never fill the table more than this, otherwise probe may not terminate
+  const static int64_t MAX_LOAD_PERCENT = 87;
   const static int64_t MAX_MEM_PERCENT = 40;
   const static int64_t EXTENDED_RATIO = 2;
+  const static int64_t GROUP_SIZE = 16;
+  const static uint8_t EMPTY_TAG = 0;
+  struct BucketGroup
+  {
+    uint8_t tags_[GROUP_SIZE];
+    Item *items_[GROUP_SIZE];
+    TO_STRING_EMPTY();
+  };
+  // memory of one slot, include its tag
+  const static int64_t BUCKET_SLOT_SIZE = sizeof(BucketGroup) / GROUP_SIZE;
   const int64_t INIT_BKT_NUM_PUSH_DOWM = INIT_L2_CACHE_SIZE / sizeof(ObHashPartCols);
   const int64_t EXTEND_BKT_NUM_PUSH_DOWN = INIT_L3_CACHE_SIZE / sizeof(ObHashPartCols);
   ObHashPartitionExtendHashTable() :
@@ -124,11 +143,21 @@ public:
   int check_and_extend();
   int extend(const int64_t new_bucket_num);
   int64_t size() const { return size_; }
+  // the table reaches the max load and can't be extended within memory bound,
+  // new items should go to dumped partitions
+  bool is_full() const
+  {
+    return OB_NOT_NULL(buckets_)
+           && size_ * 100 >= get_bucket_num() * MAX_LOAD_PERCENT
+           && !can_extend();
+  }
 
   void reuse()
   {
     if (OB_NOT_NULL(buckets_)) {
-      buckets_->set_all(nullptr);
+      BucketGroup empty_group;
+      MEMSET(&empty_group, 0, sizeof(empty_group));
+      buckets_->set_all(empty_group);
     }
     size_ = 0;
     exprs_ = nullptr;
@@ -169,13 +198,11 @@ public:
       ret = OB_INVALID_ARGUMENT;
       SQL_ENG_LOG(WARN, "invalid null buckets", K(ret), K(buckets_));
     }
-    for (int64_t i = 0; OB_SUCC(ret) && i < get_bucket_num(); i++) {
-      Item *item = buckets_->at(i);
-      while (NULL != item && OB_SUCC(ret)) {
-        if (OB_FAIL(cb(*item))) {
+    for (int64_t i = 0; OB_SUCC(ret) && i < get_group_num(); i++) {
+      const BucketGroup &group = buckets_->at(i);
+      for (int64_t j = 0; OB_SUCC(ret) && j < GROUP_SIZE; j++) {
+        if (EMPTY_TAG != group.tags_[j] && OB_FAIL(cb(*group.items_[j]))) {
           SQL_ENG_LOG(WARN, "call back failed", K(ret));
-        } else {
-          item = item->next();
         }
       }
     }
@@ -183,9 +210,37 @@ public:
   }
 
   inline int64_t get_bucket_num() const
+  {
+    return get_group_num() * GROUP_SIZE;
+  }
+  inline int64_t get_group_num() const
   {
     return NULL == buckets_ ? 0 : buckets_->count();
   }
+  // prefetch tags of the home group, used before probing a batch
+  OB_INLINE void prefetch_bucket(const uint64_t hash_value) const
+  {
+    if (OB_NOT_NULL(buckets_)) {
+      __builtin_prefetch(&buckets_->at(hash_value & (get_group_num() - 1)),
+                         0/* read */, 2 /*high temp locality*/);
+    }
+  }
+  // prefetch items whose tag matches in the home group, should be called after prefetch_bucket
+  OB_INLINE void prefetch_items(const uint64_t hash_value) const
+  {
+    if (OB_NOT_NULL(buckets_)) {
+      const BucketGroup &group = buckets_->at(hash_value & (get_group_num() - 1));
+      uint32_t mask = match_tag(group.tags_, get_tag(hash_value));
+      while (0 != mask) {
+        const Item *item = group.items_[__builtin_ctz(mask)];
+        __builtin_prefetch(item, 0/* read */, 2 /*high temp locality*/);
+        if (!item->use_expr_) {
+          __builtin_prefetch(item->store_row_, 0/* read */, 2 /*high temp locality*/);
+        }
+        mask &= mask - 1;
+      }
+    }
+  }
 
   void set_funcs(
     const common::ObIArray<ObHashFunc> *hash_funcs,
@@ -204,12 +259,41 @@ public:
 private:
   DISALLOW_COPY_AND_ASSIGN(ObHashPartitionExtendHashTable);
   using BucketArray =
-    common::ObSegmentArray<Item*, OB_MALLOC_MIDDLE_BLOCK_SIZE, common::ModulePageAllocator>;
+    common::ObSegmentArray<BucketGroup, OB_MALLOC_MIDDLE_BLOCK_SIZE, common::ModulePageAllocator>;
   static int64_t estimate_bucket_num(
     const int64_t bucket_num,
     const int64_t max_hash_mem,
     const int64_t min_bucket);
   int create_bucket_array(const int64_t bucket_num, BucketArray *&new_buckets);
+  bool can_extend() const
+  {
+    return estimate_bucket_num(get_bucket_num() * 2, sql_mem_processor_->get_mem_bound(),
+                               min_bucket_num_) > get_bucket_num();
+  }
+  // tag never equals to EMPTY_TAG, use multiplicative hash of the whole value, since low bits
+  // decide the group and high bits may be the same in one partition.
+  OB_INLINE static uint8_t get_tag(const uint64_t hash_value)
+  {
+    return static_cast<uint8_t>(0x80 | ((hash_value * 0x9E3779B97F4A7C15ULL) >> 57));
+  }
+  // bit i of result is set if tags[i] == tag
+  OB_INLINE static uint32_t match_tag(const uint8_t *tags, const uint8_t tag)
+  {
+#if defined(__x86_64__)
+    const __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(tags));
+    return static_cast<uint32_t>(
+      _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(static_cast<char>(tag)))));
+#else
+    uint32_t mask = 0;
+    for (int64_t i = 0; i < GROUP_SIZE; ++i) {
+      mask |= static_cast<uint32_t>(tags[i] == tag) << i;
+    }
+    return mask;
+#endif
+  }
+  // insert without checking existence, caller makes sure that there is an empty slot
+  static void insert_item(BucketArray &buckets, const uint64_t hash_value, Item *item);
+  int extend_if_overload();
 public:
   int64_t size_;
   int64_t bucket_num_;
@@ -358,7 +442,8 @@ private:
     if (INT64_MAX == est_part_cnt_) {
       est_partition_count();
     }
-    return (sql_mem_processor_->get_mem_bound() <= est_part_cnt_ * BLOCK_SIZE + get_mem_used());
+    return (sql_mem_processor_->get_mem_bound() <= est_part_cnt_ * BLOCK_SIZE + get_mem_used())
+           || hash_table_.is_full();
   }
 
   int64_t get_mem_used() { return (nullptr == mem_context_) ? 0 : mem_context_->used();}
@@ -1278,13 +1363,16 @@ int64_t ObHashPartInfrastructure<HashCol, HashRowStore>::est_bucket_count(
   if (INT64_MAX == est_part_cnt_) {
     est_partition_count();
   }
-  int64_t est_bucket_mem_size = next_pow2(rows) * sizeof(void*);
+  // hash table is initialized with EXTENDED_RATIO times of buckets
+  const int64_t slot_size = ObHashPartitionExtendHashTable<HashCol>::BUCKET_SLOT_SIZE;
+  const int64_t ratio = ObHashPartitionExtendHashTable<HashCol>::EXTENDED_RATIO;
+  int64_t est_bucket_mem_size = next_pow2(rows * ratio) * slot_size;
   int64_t est_data_mem_size = rows * width;
   int64_t max_remain_mem_size = std::max(0l, sql_mem_processor_->get_mem_bound() - est_part_cnt_ * BLOCK_SIZE);
   int64_t est_bucket_num = rows;
   while (est_bucket_mem_size + est_data_mem_size > max_remain_mem_size && est_bucket_num > 0) {
     est_bucket_num >>= 1;
-    est_bucket_mem_size = next_pow2(est_bucket_num) * sizeof(void*);
+    est_bucket_mem_size = next_pow2(est_bucket_num * ratio) * slot_size;
     est_data_mem_size = est_bucket_num * width;
   }
   est_bucket_num = est_bucket_num < min_bucket_cnt ? min_bucket_cnt :
@@ -1377,29 +1465,19 @@ set_distinct_batch(const common::ObIArray<ObExpr *> &exprs,
   ObEvalCtx::BatchInfoScopeGuard batch_info_guard(*eval_ctx_);
   batch_info_guard.set_batch_idx(0);
   batch_info_guard.set_batch_size(batch_size);
-  int64_t num_cnt = hash_table_.get_bucket_num() - 1;
-  auto &buckets = hash_table_.buckets_;
   if (!is_push_down_) {
+    // prefetch tags of the whole batch first, then items with matched tag
     for (int i = 0; i < batch_size; ++i) {
       if (OB_NOT_NULL(skip) && skip->at(i)) {
         continue;
       }
-      int64_t bkt_idx = (hash_values_for_batch[i] & num_cnt);
-      auto &curr_bkt = buckets->at(bkt_idx);
-      __builtin_prefetch(curr_bkt, 0/* read */, 2 /*high temp locality*/);
+      hash_table_.prefetch_bucket(hash_values_for_batch[i]);
     }
     for (int i = 0; i < batch_size; ++i) {
-      int64_t bkt_idx = (hash_values_for_batch[i] & num_cnt);
-      auto &curr_bkt = buckets->at(bkt_idx);
-      if ((OB_NOT_NULL(skip) && skip->at(i))
-          || nullptr == curr_bkt
-          || curr_bkt->hash_value_ != hash_values_for_batch[i]) {
+      if (OB_NOT_NULL(skip) && skip->at(i)) {
         continue;
       }
-      __builtin_prefetch(curr_bkt->next(), 0/* read */, 2 /*high temp locality*/);
-      if (!curr_bkt->use_expr_) {
-        __builtin_prefetch(curr_bkt->store_row_, 0/* read */, 2 /*high temp locality*/);
-      }
+      hash_table_.prefetch_items(hash_values_for_batch[i]);
     }
   }
   for (int i = 0; OB_SUCC(ret) && i < batch_size; ++i) {
@@ -1460,14 +1538,18 @@ int ObHashPartInfrastructure<HashCol, HashRowStore>::
   ObEvalCtx::BatchInfoScopeGuard batch_info_guard(*eval_ctx_);
   batch_info_guard.set_batch_idx(0);
   batch_info_guard.set_batch_size(batch_size);
-  if (!is_push_down_ && OB_NOT_NULL(hash_table_.buckets_)) {
+  if (!is_push_down_) {
     for (int64_t i = 0; i < batch_size; ++i) {
       if (OB_NOT_NULL(skip) && skip->at(i)) {
         continue;
       }
-      __builtin_prefetch(hash_table_.buckets_->at(hash_values_for_batch[i]
-                                              & (hash_table_.get_bucket_num() - 1)), 0/* read */,
-                                              2 /*high temp locality*/);
+      hash_table_.prefetch_bucket(hash_values_for_batch[i]);
+    }
+    for (int64_t i = 0; i < batch_size; ++i) {
+      if (OB_NOT_NULL(skip) && skip->at(i)) {
+        continue;
+      }
+      hash_table_.prefetch_items(hash_values_for_batch[i]);
     }
   }
   for (int64_t i = 0; OB_SUCC(ret) && i < batch_size; ++i) {
@@ -1653,9 +1735,13 @@ int ObHashPartInfrastructure<HashCol, HashRowStore>::exists_batch(
       if (OB_NOT_NULL(child_skip) && child_skip->at(i)) {
         continue;
       }
-      __builtin_prefetch(hash_table_.buckets_->at(hash_values_for_batch[i]
-                                             & (hash_table_.get_bucket_num() - 1)), 0/* read */,
-                                             2 /*high temp locality*/);
+      hash_table_.prefetch_bucket(hash_values_for_batch[i]);
+    }
+    for (int i = 0; i < batch_size; ++i) {
+      if (OB_NOT_NULL(child_skip) && child_skip->at(i)) {
+        continue;
+      }
+      hash_table_.prefetch_items(hash_values_for_batch[i]);
     }
     {
       ObEvalCtx::BatchInfoScopeGuard guard(*eval_ctx_);
@@ -2624,10 +2710,10 @@ int64_t ObHashPartitionExtendHashTable<Item>::estimate_bucket_num(
 {
   int64_t max_bound_size = std::max(0l, max_hash_mem * MAX_MEM_PERCENT / 100);
   int64_t est_bucket_num = common::next_pow2(bucket_num);
-  int64_t est_size = est_bucket_num * sizeof(void*);
+  int64_t est_size = est_bucket_num * BUCKET_SLOT_SIZE;
   while (est_size > max_bound_size && est_bucket_num > 0) {
     est_bucket_num >>= 1;
-    est_size = est_bucket_num * sizeof(void*);
+    est_size = est_bucket_num * BUCKET_SLOT_SIZE;
   }
   if (est_bucket_num < INITIAL_SIZE) {
     est_bucket_num = INITIAL_SIZE;
@@ -2645,7 +2731,7 @@ int ObHashPartitionExtendHashTable<Item>::create_bucket_array(
 {
   int ret = OB_SUCCESS;
   void *buckets_buf = NULL;
-  int64_t tmp_bucket_num = common::next_pow2(bucket_num);
+  int64_t tmp_group_num = std::max(common::next_pow2(bucket_num) / GROUP_SIZE, 1L);
   new_buckets = nullptr;
   if (OB_ISNULL(allocator_)) {
     ret = OB_ERR_UNEXPECTED;
@@ -2655,11 +2741,11 @@ int ObHashPartitionExtendHashTable<Item>::create_bucket_array(
     SQL_ENG_LOG(WARN, "failed to allocate memory", K(ret));
   } else {
     new_buckets = new (buckets_buf) BucketArray(*allocator_);
-    if (OB_FAIL(new_buckets->init(tmp_bucket_num))) {
+    if (OB_FAIL(new_buckets->init(tmp_group_num))) {
       new_buckets->reset();
       allocator_->free(new_buckets);
       new_buckets = nullptr;
-      SQL_ENG_LOG(DEBUG, "resize bucket array", K(ret), K(tmp_bucket_num));
+      SQL_ENG_LOG(DEBUG, "resize bucket array", K(ret), K(tmp_group_num));
     }
   }
   return ret;
@@ -2699,19 +2785,28 @@ int ObHashPartitionExtendHashTable<Item>::get(
   } else {
     common::hash::hash_func<Item> hf;
     bool equal_res = false;
-    Item *bucket = buckets_->at(hash_value & (get_bucket_num() - 1));
+    bool probe_end = false;
+    const uint8_t tag = get_tag(hash_value);
+    const int64_t group_mask = get_group_num() - 1;
+    int64_t group_idx = hash_value & group_mask;
     ObEvalCtx::BatchInfoScopeGuard guard(*eval_ctx_);
-    while (OB_SUCC(ret) && NULL != bucket) {
-      if (hash_value == hf(*bucket)) {
-        if (OB_FAIL(bucket->equal_distinct(exprs_, part_cols, sort_collations_,
-                                           cmp_funcs_, eval_ctx_, equal_res, guard))) {
+    for (int64_t step = 1; OB_SUCC(ret) && !probe_end; ++step) {
+      const BucketGroup &group = buckets_->at(group_idx);
+      uint32_t mask = match_tag(group.tags_, tag);
+      while (OB_SUCC(ret) && 0 != mask && NULL == item) {
+        Item *bucket = group.items_[__builtin_ctz(mask)];
+        mask &= mask - 1;
+        if (hash_value != hf(*bucket)) {
+        } else if (OB_FAIL(bucket->equal_distinct(exprs_, part_cols, sort_collations_,
+                                                  cmp_funcs_, eval_ctx_, equal_res, guard))) {
           SQL_ENG_LOG(WARN, "compare info is null", K(ret));
         } else if (equal_res) {
           item = bucket;
-          break;
         }
       }
-      bucket = bucket->next();
+      // an empty slot means the probe sequence ends here
+      probe_end = (NULL != item) || 0 != match_tag(group.tags_, EMPTY_TAG);
+      group_idx = (group_idx + step) & group_mask;
     }
   }
   return ret;
@@ -2738,10 +2833,10 @@ int ObHashPartitionExtendHashTable<Item>::set(Item &item)
   } else if (item.use_expr_) {
     ret = OB_ERR_UNEXPECTED;
     SQL_ENG_LOG(WARN, "unexpected status: store_row is null", K(ret));
+  } else if (OB_FAIL(extend_if_overload())) {
+    SQL_ENG_LOG(WARN, "extend failed", K(ret));
   } else {
-    Item *&bucket = buckets_->at(hf(item) & (get_bucket_num() - 1));
-    item.next() = bucket;
-    bucket = &item;
+    insert_item(*buckets_, hf(item), &item);
     size_ += 1;
   }
   return ret;
@@ -2752,30 +2847,78 @@ int ObHashPartitionExtendHashTable<Item>::set_distinct(Item &item, uint64_t hash
 {
   int ret = OB_SUCCESS;
   common::hash::hash_func<Item> hf;
-  //if bucket != nullptr, check is duplicate and append distinct value
-  bool need_insert = true;
-  Item *&insert_bucket = buckets_->at(hash_value & (get_bucket_num() - 1));
-  Item *bucket = insert_bucket;
-  ObEvalCtx::BatchInfoScopeGuard guard(*eval_ctx_);
-  if (OB_NOT_NULL(bucket)) {
-    while(OB_SUCC(ret) && OB_NOT_NULL(bucket)) {
-      bool equal_res = (hash_value == hf(*bucket));
-      if (equal_res &&
-          OB_FAIL(bucket->equal_distinct(exprs_, item, sort_collations_,
-                                         cmp_funcs_, eval_ctx_, equal_res, guard))) {
-        SQL_ENG_LOG(WARN, "failed to compare items", K(ret));
-      } else if (equal_res) {
-        need_insert = false;
-        ret = OB_HASH_EXIST;
-      } else {
-        bucket = bucket->next();
+  if (OB_FAIL(extend_if_overload())) {
+    SQL_ENG_LOG(WARN, "extend failed", K(ret));
+  } else {
+    // check is duplicate along the probe sequence, append to the first empty slot if not
+    bool probe_end = false;
+    const uint8_t tag = get_tag(hash_value);
+    const int64_t group_mask = get_group_num() - 1;
+    int64_t group_idx = hash_value & group_mask;
+    ObEvalCtx::BatchInfoScopeGuard guard(*eval_ctx_);
+    for (int64_t step = 1; OB_SUCC(ret) && !probe_end; ++step) {
+      BucketGroup &group = buckets_->at(group_idx);
+      uint32_t mask = match_tag(group.tags_, tag);
+      while (OB_SUCC(ret) && 0 != mask) {
+        Item *bucket = group.items_[__builtin_ctz(mask)];
+        bool equal_res = (hash_value == hf(*bucket));
+        mask &= mask - 1;
+        if (equal_res &&
+            OB_FAIL(bucket->equal_distinct(exprs_, item, sort_collations_,
+                                           cmp_funcs_, eval_ctx_, equal_res, guard))) {
+          SQL_ENG_LOG(WARN, "failed to compare items", K(ret));
+        } else if (equal_res) {
+          ret = OB_HASH_EXIST;
+        }
       }
+      const uint32_t empty_mask = match_tag(group.tags_, EMPTY_TAG);
+      if (OB_SUCC(ret) && 0 != empty_mask) {
+        const int64_t slot = __builtin_ctz(empty_mask);
+        group.tags_[slot] = tag;
+        group.items_[slot] = &item;
+        size_ += 1;
+        probe_end = true;
+      }
+      group_idx = (group_idx + step) & group_mask;
     }
   }
-  if (need_insert) {
-    item.next() = insert_bucket;
-    insert_bucket = &item;
-    size_ += 1;
+  return ret;
+}
+
+template <typename Item>
+void ObHashPartitionExtendHashTable<Item>::insert_item(
+  BucketArray &buckets, const uint64_t hash_value, Item *item)
+{
+  const int64_t group_mask = buckets.count() - 1;
+  int64_t group_idx = hash_value & group_mask;
+  uint32_t empty_mask = 0;
+  for (int64_t step = 1;
+       0 == (empty_mask = match_tag(buckets.at(group_idx).tags_, EMPTY_TAG));
+       ++step) {
+    group_idx = (group_idx + step) & group_mask;
+  }
+  BucketGroup &group = buckets.at(group_idx);
+  const int64_t slot = __builtin_ctz(empty_mask);
+  group.tags_[slot] = get_tag(hash_value);
+  group.items_[slot] = item;
+}
+
+// extend within memory bound once the max load is reached. Otherwise the caller dumps new
+// items when is_full(), the table is only extended beyond the bound when no empty slot would
+// be left for the items already accepted, e.g. the rest of a batch.
+template <typename Item>
+int ObHashPartitionExtendHashTable<Item>::extend_if_overload()
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(buckets_)) {
+    ret = OB_INVALID_ARGUMENT;
+    SQL_ENG_LOG(WARN, "invalid argument", K(ret), K(buckets_));
+  } else if ((size_ + 1) * 100 <= get_bucket_num() * MAX_LOAD_PERCENT) {
+    // enough empty slots
+  } else if (!can_extend() && size_ + 1 < get_bucket_num()) {
+    // keep probing the loaded table until the caller dumps
+  } else if (OB_FAIL(extend(get_bucket_num() * 2))) {
+    SQL_ENG_LOG(WARN, "extend failed", K(ret), K(size_), K(get_bucket_num()));
   }
   return ret;
 }
@@ -2813,35 +2956,23 @@ int ObHashPartitionExtendHashTable<Item>::extend(const int64_t new_bucket_num)
   } else if (OB_ISNULL(buckets_)) {
     ret = OB_INVALID_ARGUMENT;
     SQL_ENG_LOG(WARN, "invalid argument", K(ret), K(buckets_));
-  } else if (OB_FAIL(create_bucket_array(new_bucket_num, new_buckets))) {
+  } else if (OB_FAIL(create_bucket_array(std::max(new_bucket_num, get_bucket_num()),
+                                         new_buckets))) {
     SQL_ENG_LOG(WARN, "failed to create bucket array", K(ret));
   } else {
     // rehash
-    const int64_t tmp_new_bucket_num = new_buckets->count();
-    const int64_t old_bucket_num = get_bucket_num();
-    const int64_t BATCH_SIZE = 1024;
-    for (int64_t i = 0; i < old_bucket_num; i += BATCH_SIZE) {
-      int64_t batch_size = min(old_bucket_num - i, BATCH_SIZE);
-      for (int64_t j = 0; j < batch_size; ++j) {
-        Item *bucket = buckets_->at(i + j);
-        __builtin_prefetch(bucket, 0/* read */, 2 /*high temp locality*/);
-      }
-      for (int64_t j = 0; j < batch_size; ++j) {
-        Item *bucket = buckets_->at(i + j);
-        if (nullptr != bucket) {
-          __builtin_prefetch(bucket->next(), 0/* read */, 2 /*high temp locality*/);
+    const int64_t tmp_new_bucket_num = new_buckets->count() * GROUP_SIZE;
+    const int64_t old_group_num = get_group_num();
+    for (int64_t i = 0; i < old_group_num; ++i) {
+      const BucketGroup &group = buckets_->at(i);
+      for (int64_t j = 0; j < GROUP_SIZE; ++j) {
+        if (EMPTY_TAG != group.tags_[j]) {
+          __builtin_prefetch(group.items_[j], 0/* read */, 2 /*high temp locality*/);
         }
       }
-      for (int64_t j = 0; j < batch_size; ++j) {
-        Item *bucket = buckets_->at(i + j);
-        if (nullptr != bucket) {
-          do {
-            Item *item = bucket;
-            bucket = bucket->next();
-            Item *&new_bucket = new_buckets->at(hf(*item) & (tmp_new_bucket_num - 1));
-            item->next() = new_bucket;
-            new_bucket = item;
-          } while (nullptr != bucket);
+      for (int64_t j = 0; j < GROUP_SIZE; ++j) {
+        if (EMPTY_TAG != group.tags_[j]) {
+          insert_item(*new_buckets, hf(*group.items_[j]), group.items_[j]);
         }
       }
     }
@@ -1341,6 +1341,41 @@ int ObBlackFilterExecutor::filter_batch(
             K(result_bitmap.popcnt()));
   return ret;
 }
+
+int ObBlackFilterExecutor::filter_batch(
+    const int64_t *row_ids,
+    const int64_t row_count,
+    common::ObBitmap &result_bitmap)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(nullptr == row_ids || row_count <= 0 || row_count > op_.get_batch_size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid batch row ids", K(ret), KP(row_ids), K(row_count), K(op_.get_batch_size()));
+  } else if (nullptr == skip_bit_) {
+    if (OB_ISNULL(skip_bit_ = to_bit_vector(
+                (char *)(allocator_.alloc(ObBitVector::memory_size(op_.get_batch_size())))))) {
+      ret = common::OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc skip_bit", K(ret));
+    }
+  }
+
+  if (OB_SUCC(ret)) {
+    skip_bit_->init(row_count);
+    if (OB_FAIL(eval_exprs_batch(*skip_bit_, row_count))) {
+      LOG_WARN("failed to eval batch", K(ret));
+    } else {
+      for (int64_t i = 0; OB_SUCC(ret) && i < row_count; i++) {
+        if (skip_bit_->contain(i)) {
+        } else if (OB_FAIL(result_bitmap.set(row_ids[i]))) {
+          LOG_WARN("Failed to set result bitmap", K(ret), K(i), K(row_ids[i]));
+        }
+      }
+    }
+  }
+  LOG_DEBUG("[PUSHDOWN] microblock black pushdown filter batch rows by row ids", K(ret),
+            K(row_count), K(result_bitmap.popcnt()));
+  return ret;
+}
 //--------------------- end filter executor ----------------------------
 
 
@@ -408,6 +408,10 @@ public:
                    const int64_t start,
                    const int64_t end,
                    common::ObBitmap &result_bitmap);
+  // filter rows decoded compactly, the i-th datum belongs to row %row_ids[i]
+  int filter_batch(const int64_t *row_ids,
+                   const int64_t row_count,
+                   common::ObBitmap &result_bitmap);
   int get_datums_from_column(common::ObIArray<common::ObDatum *> &datums);
   INHERIT_TO_STRING_KV("ObPushdownBlackFilterExecutor", ObPushdownFilterExecutor,
                        K_(filter), K_(n_eval_infos),
@@ -256,7 +256,13 @@ ObHashJoinOp::ObHashJoinOp(ObExecContext &ctx_, const ObOpSpec &spec, ObOpInput
   non_preserved_side_is_not_empty_(false),
   null_random_hash_value_(0),
   skip_left_null_(false),
-  skip_right_null_(false)
+  skip_right_null_(false),
+  enable_skew_partition_(false),
+  skew_detected_(false),
+  skew_part_pinned_(false),
+  skew_hash_cnt_(0),
+  skew_hash_filter_(0),
+  skew_sample_vals_(NULL)
 {
   /*
                         read_left_row -> build_hash_table
@@ -420,6 +426,7 @@ int ObHashJoinOp::inner_open()
     ObTenantConfigGuard tenant_config(TENANT_CONF(session->get_effective_tenant_id()));
     if (tenant_config.is_valid()) {
       force_hash_join_spill_ = tenant_config->_force_hash_join_spill;
+      enable_skew_partition_ = tenant_config->_enable_hash_join_skew_partition;
       hash_join_processor_ = tenant_config->_enable_hash_join_processor;
       if (0 == (hash_join_processor_ & HJ_PROCESSOR_MASK)) {
         ret = OB_ERR_UNEXPECTED;
@@ -521,7 +528,8 @@ int ObHashJoinOp::inner_open()
                   cur_tuples_, sizeof(*cur_tuples_) * batch_size,
                   child_brs_.skip_, ObBitVector::memory_size(batch_size),
                   hj_part_added_rows_, sizeof(hj_part_added_rows_) * batch_size,
-                  right_selector_, sizeof(*right_selector_) * batch_size));
+                  right_selector_, sizeof(*right_selector_) * batch_size,
+                  skew_sample_vals_, sizeof(*skew_sample_vals_) * batch_size));
   }
   cur_hash_table_ = &hash_table_;
   return ret;
@@ -657,6 +665,10 @@ void ObHashJoinOp::part_rescan()
   right_read_from_stored_ = false;
   right_batch_traverse_cnt_ = 0;
   null_random_hash_value_ = 0;
+  skew_detected_ = false;
+  skew_part_pinned_ = false;
+  skew_hash_cnt_ = 0;
+  skew_hash_filter_ = 0;
 }
 
 int ObHashJoinOp::part_rescan(bool reset_all)
@@ -2041,6 +2053,11 @@ int ObHashJoinOp::asyn_dump_partition(
   int64_t last_dumped_partition_idx = start_dumped_part_idx;
   bool tmp_dump_all = (INT64_MAX == dumped_size) || dump_all;
   ObHashJoinPartition *dumped_parts = nullptr;
+  if (skew_part_pinned_ && start_dumped_part_idx < 1) {
+    // partition 0 holds heavy hitters, keep it in memory
+    start_dumped_part_idx = 1;
+    last_dumped_partition_idx = start_dumped_part_idx;
+  }
   if (is_left) {
     dumped_parts = hj_part_array_;
   } else {
@@ -2108,6 +2125,7 @@ int ObHashJoinOp::dump_build_table(int64_t row_count, bool force_update)
   int ret = OB_SUCCESS;
   bool tmp_need_dump = false;
   int64_t mem_used = get_cur_mem_used();
+  check_skew_partition_pinned();
   if (OB_FAIL(update_remain_data_memory_size_periodically(
               row_count, tmp_need_dump, force_update))) {
     LOG_WARN("failed to update remain memory size periodically", K(ret));
@@ -2502,6 +2520,8 @@ int ObHashJoinOp::fill_partition_batch(int64_t &num_left_rows)
                                             hash_vals_, hj_part_stored_rows_,
                                             is_left_side))) {
       LOG_WARN("fail to calc hash value batch", K(ret));
+    } else if (!skew_detected_ && OB_FAIL(detect_skew_hash_values(*child_brs))) {
+      LOG_WARN("failed to detect skew hash values", K(ret));
     } else if (child_brs->size_ > 16 * part_count_) {
       // add partition by batch
       if (OB_FAIL(calc_part_idx_batch(hash_vals_, *child_brs))) {
@@ -2566,6 +2586,119 @@ int ObHashJoinOp::fill_partition_batch(int64_t &num_left_rows)
   return ret;
 }
 
+// Sample hash values of the first build batch before any row is added to partitions, so
+// that the routing of a hash value never changes during partitioning. Rows of the heavy
+// hitters all go to partition 0 on both sides, splitting them again in deeper level is
+// useless since they have the same hash value.
+int ObHashJoinOp::detect_skew_hash_values(const ObBatchRows &child_brs)
+{
+  int ret = OB_SUCCESS;
+  skew_detected_ = true;
+  skew_hash_cnt_ = 0;
+  skew_hash_filter_ = 0;
+  if (enable_skew_partition_ && top_part_level() && !is_shared_ && !force_hash_join_spill_
+      && part_count_ > 1 && NULL == left_batch_ && NULL != skew_sample_vals_) {
+    int64_t cnt = 0;
+    for (int64_t i = 0; i < child_brs.size_; i++) {
+      if (!child_brs.skip_->exist(i)) {
+        skew_sample_vals_[cnt++] = hash_vals_[i];
+      }
+    }
+    skew_hash_cnt_ = find_skew_hash_values(skew_sample_vals_, cnt, skew_hash_vals_,
+                                           skew_hash_filter_);
+    skew_part_pinned_ = skew_hash_cnt_ > 0;
+    LOG_TRACE("trace detect skew hash values", K(cnt), K(skew_hash_cnt_), K(part_count_));
+    if (skew_hash_cnt_ > 0 && OB_FAIL(raise_skew_part_count())) {
+      LOG_WARN("failed to raise partition count for skew", K(ret));
+    }
+  }
+  return ret;
+}
+
+// sort the sampled hash values and return the heavy hitters in ascending order
+int64_t ObHashJoinOp::find_skew_hash_values(uint64_t *sample_vals,
+                                            const int64_t sample_cnt,
+                                            uint64_t *skew_hash_vals,
+                                            uint64_t &skew_hash_filter)
+{
+  int64_t skew_hash_cnt = 0;
+  skew_hash_filter = 0;
+  if (sample_cnt >= SKEW_MIN_SAMPLE_ROWS) {
+    std::sort(sample_vals, sample_vals + sample_cnt);
+    for (int64_t i = 0, j = 0; i < sample_cnt && skew_hash_cnt < MAX_SKEW_HASH_CNT; i = j) {
+      while (j < sample_cnt && sample_vals[j] == sample_vals[i]) {
+        ++j;
+      }
+      if ((j - i) * SKEW_HASH_RATIO >= sample_cnt) {
+        skew_hash_vals[skew_hash_cnt++] = sample_vals[i];
+        skew_hash_filter |= 1ULL << (sample_vals[i] & 63);
+      }
+    }
+  }
+  return skew_hash_cnt;
+}
+
+// Once skew is found, make every dumped partition fit in memory bound, so that it can be
+// joined in one pass at the next level instead of being split again. No row is added to
+// partitions yet, so the partitions are rebuilt with the new count.
+int ObHashJoinOp::raise_skew_part_count()
+{
+  int ret = OB_SUCCESS;
+  const int64_t input_size = profile_.get_input_size();
+  const int64_t mem_bound = sql_mem_processor_.get_mem_bound();
+  const int64_t one_pass_part_count = calc_partition_count(
+    input_size, max(mem_bound, MIN_MEM_SIZE), max_partition_count_per_level_);
+  if (one_pass_part_count > part_count_ && one_pass_part_count * PAGE_SIZE <= mem_bound) {
+    char *buf = NULL;
+    LOG_TRACE("trace one pass partition count", K(part_count_), K(one_pass_part_count),
+      K(input_size), K(mem_bound));
+    if (NULL == (buf = (char *)mem_context_->get_malloc_allocator().alloc(
+        sizeof(uint16_t) * (MY_SPEC.max_batch_size_ * one_pass_part_count + one_pass_part_count)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc memory", K(ret), K(MY_SPEC.max_batch_size_), K(one_pass_part_count));
+    } else {
+      if (NULL != part_selectors_) {
+        mem_context_->get_malloc_allocator().free(part_selectors_);
+      }
+      part_selectors_ = reinterpret_cast<uint16_t *>(buf);
+      part_selector_sizes_ = reinterpret_cast<uint16_t *>(buf +
+                             sizeof(uint16_t) * (MY_SPEC.max_batch_size_ * one_pass_part_count));
+      if (NULL != hj_part_array_) {
+        for (int64_t i = 0; i < part_count_; i ++) {
+          hj_part_array_[i].~ObHashJoinPartition();
+        }
+        alloc_->free(hj_part_array_);
+        hj_part_array_ = NULL;
+      }
+      if (NULL != right_hj_part_array_) {
+        for (int64_t i = 0; i < part_count_; i ++) {
+          right_hj_part_array_[i].~ObHashJoinPartition();
+        }
+        alloc_->free(right_hj_part_array_);
+        right_hj_part_array_ = NULL;
+      }
+      part_count_ = one_pass_part_count;
+      if (OB_FAIL(init_join_partition())) {
+        LOG_WARN("fail to init join partition", K(ret), K(part_count_));
+      }
+    }
+  }
+  return ret;
+}
+
+// partition 0 is pinned in memory only if it fits in memory bound by itself,
+// otherwise it's dumped as other partitions. Routing is not changed, so it's still correct.
+void ObHashJoinOp::check_skew_partition_pinned()
+{
+  if (skew_part_pinned_ && OB_NOT_NULL(hj_part_array_)
+      && hj_part_array_[0].get_size_in_memory()
+         > sql_mem_processor_.get_mem_bound() * buf_mgr_->get_data_ratio()) {
+    skew_part_pinned_ = false;
+    LOG_TRACE("skew partition exceeds memory bound, unpin it",
+      K(hj_part_array_[0].get_size_in_memory()), K(sql_mem_processor_.get_mem_bound()));
+  }
+}
+
 int ObHashJoinOp::calc_part_idx_batch(uint64_t *hash_vals, const ObBatchRows &child_brs)
 {
   int ret = OB_SUCCESS;
@@ -970,8 +970,25 @@ private:
 private:
   using PredFunc = std::function<bool(int64_t)>;
   int fill_partition(int64_t &num_left_rows);
+  // heavy hitter rows of build side are routed to partition 0, see detect_skew_hash_values()
   OB_INLINE int64_t get_part_idx(const uint64_t hash_value)
-  { return (hash_value >> part_shift_) & (part_count_ - 1); }
+  {
+    return (OB_UNLIKELY(skew_hash_cnt_ > 0) && is_skew_hash(hash_value))
+        ? 0 : (hash_value >> part_shift_) & (part_count_ - 1);
+  }
+  // skew_hash_vals_ is sorted, most of the other hash values are rejected by the one bit filter
+  OB_INLINE bool is_skew_hash(const uint64_t hash_value) const
+  {
+    return 0 != (skew_hash_filter_ & (1ULL << (hash_value & 63)))
+        && std::binary_search(skew_hash_vals_, skew_hash_vals_ + skew_hash_cnt_, hash_value);
+  }
+  static int64_t find_skew_hash_values(uint64_t *sample_vals,
+                                       const int64_t sample_cnt,
+                                       uint64_t *skew_hash_vals,
+                                       uint64_t &skew_hash_filter);
+  int detect_skew_hash_values(const ObBatchRows &child_brs);
+  int raise_skew_part_count();
+  void check_skew_partition_pinned();
   OB_INLINE bool top_part_level() { return 0 == part_level_; }
   void set_processor(HJProcessor p) { hj_processor_ = p; }
   OB_INLINE  bool need_right_bitset() const
@@ -1131,6 +1148,10 @@ private:
 
   // hard code seed, 24bit max prime number
   static const int64_t HASH_SEED = 16777213;
+  // a hash value is heavy hitter if it occupies at least 1/SKEW_HASH_RATIO of sampled rows
+  static const int64_t MAX_SKEW_HASH_CNT = 8;
+  static const int64_t SKEW_HASH_RATIO = 16;
+  static const int64_t SKEW_MIN_SAMPLE_ROWS = 64;
   // about 120M
   static const int64_t MAX_NEST_LOOP_RIGHT_ROW_COUNT = 1000000000;
   static bool TEST_NEST_LOOP_TO_RECURSIVE;
@@ -1270,6 +1291,15 @@ private:
   */
   bool skip_left_null_;
   bool skip_right_null_;
+  // skew aware partitioning: heavy hitter hash values sampled from the first build batch
+  // are routed to partition 0, which is pinned in memory and dumped last.
+  bool enable_skew_partition_;
+  bool skew_detected_;
+  bool skew_part_pinned_;
+  int64_t skew_hash_cnt_;
+  uint64_t skew_hash_filter_;
+  uint64_t skew_hash_vals_[MAX_SKEW_HASH_CNT];
+  uint64_t *skew_sample_vals_;
 };
 
 inline int ObHashJoinOp::init_mem_context(uint64_t tenant_id)
@@ -15,6 +15,9 @@
 #include "sql/engine/join/ob_nested_loop_join_op.h"
 #include "sql/engine/table/ob_table_scan_op.h"
 #include "sql/engine/ob_exec_context.h"
+#include "sql/engine/ob_sql_mem_mgr_processor.h"
+#include "share/config/ob_server_config.h"
+#include "share/diagnosis/ob_sql_monitor_statname.h"
 
 namespace oceanbase
 {
@@ -26,7 +29,10 @@ OB_SERIALIZE_MEMBER((ObNestedLoopJoinSpec, ObBasicNestedLoopJoinSpec),
                     group_rescan_, group_size_,
                     left_expr_ids_in_other_cond_,
                     left_rescan_params_,
-                    right_rescan_params_);
+                    right_rescan_params_,
+                    enable_adaptive_hash_,
+                    left_hash_keys_,
+                    right_hash_keys_);
 
 ObNestedLoopJoinOp::ObNestedLoopJoinOp(ObExecContext &exec_ctx,
                                        const ObOpSpec &spec,
@@ -41,7 +47,10 @@ ObNestedLoopJoinOp::ObNestedLoopJoinOp(ObExecContext &exec_ctx,
     max_group_size_(OB_MAX_BULK_JOIN_ROWS),
     group_join_buffer_(),
     match_left_batch_end_(false), match_right_batch_end_(false), l_idx_(0),
-    no_match_row_found_(true), need_output_row_(false), left_expr_extend_size_(0)
+    no_match_row_found_(true), need_output_row_(false), left_expr_extend_size_(0),
+    ah_state_(AH_DISABLED), ah_threshold_(0), ah_left_row_cnt_(0), ah_mem_ctx_(nullptr),
+    ah_store_(), ah_buckets_(NULL), ah_bucket_cnt_(0), ah_probing_(false), ah_probe_hash_(0),
+    ah_cur_(NULL), ah_batch_rows_(NULL), ah_brs_()
 {
   state_operation_func_[JS_JOIN_END] = &ObNestedLoopJoinOp::join_end_operate;
   state_function_func_[JS_JOIN_END][FT_ITER_GOING] = NULL;
@@ -110,6 +119,23 @@ int ObNestedLoopJoinOp::inner_open()
       }
     }
   }
+  if (OB_SUCC(ret)) {
+    ah_threshold_ = GCONF._nlj_adaptive_hash_threshold;
+    ah_state_ = (MY_SPEC.enable_adaptive_hash_ && ah_threshold_ > 0) ? AH_NONE : AH_DISABLED;
+    if (AH_NONE == ah_state_ && is_vectorized()) {
+      ObIAllocator &alloc = batch_mem_ctx_->get_arena_allocator();
+      void *rows_buf = alloc.alloc(sizeof(ObChunkDatumStore::StoredRow *) * MY_SPEC.max_batch_size_);
+      void *skip_buf = alloc.alloc(ObBitVector::memory_size(MY_SPEC.max_batch_size_));
+      if (OB_ISNULL(rows_buf) || OB_ISNULL(skip_buf)) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("fail to alloc", K(ret));
+      } else {
+        MEMSET(skip_buf, 0, ObBitVector::memory_size(MY_SPEC.max_batch_size_));
+        ah_batch_rows_ = static_cast<const ObChunkDatumStore::StoredRow **>(rows_buf);
+        ah_brs_.skip_ = to_bit_vector(skip_buf);
+      }
+    }
+  }
   if (OB_SUCC(ret) && MY_SPEC.group_rescan_) {
     if (OB_FAIL(group_join_buffer_.init(this,
                                         max_group_size_,
@@ -244,6 +270,7 @@ void ObNestedLoopJoinOp::reset_buf_state()
   no_match_row_found_ = true;
   need_output_row_ = false;
   left_expr_extend_size_ = 0;
+  reset_adaptive_hash();
 }
 
 int ObNestedLoopJoinOp::fill_cur_row_rescan_param()
@@ -278,10 +305,15 @@ int ObNestedLoopJoinOp::join_row_with_semi_join()
 {
   int ret = OB_SUCCESS;
   const bool is_anti = (LEFT_ANTI_JOIN == MY_SPEC.join_type_);
+  bool probed = false;
   while (OB_SUCC(ret) && OB_SUCC(get_next_left_row())) {
     clear_evaluated_flag();
     if (OB_FAIL(try_check_status())) {
       LOG_WARN("check status failed", K(ret));
+    } else if (OB_FAIL(adaptive_hash_probe(probed))) {
+      LOG_WARN("adaptive hash probe failed", K(ret));
+    } else if (probed) {
+      // right rows come from hash table, no need to rescan
     } else if (OB_FAIL(prepare_rescan_params())) {
       LOG_WARN("prepare right child rescan param failed", K(ret));
     } else if (OB_FAIL(rescan_right_operator())) {
@@ -292,7 +324,7 @@ int ObNestedLoopJoinOp::join_row_with_semi_join()
       bool is_matched = false;
       while (OB_SUCC(ret)
              && !is_matched
-             && OB_SUCC(right_->get_next_row())) {
+             && OB_SUCC(get_next_right_row())) {
         clear_evaluated_flag();
         if (OB_FAIL(try_check_status())) {
           LOG_WARN("check status failed", K(ret));
@@ -544,9 +576,14 @@ int ObNestedLoopJoinOp::group_read_left_operate()
 int ObNestedLoopJoinOp::read_left_func_going()
 {
   int ret = OB_SUCCESS;
+  bool probed = false;
   if (MY_SPEC.group_rescan_ || MY_SPEC.enable_px_batch_rescan_) {
     // do nothing
     // group nested loop join 已经做过 rescan 了
+  } else if (OB_FAIL(adaptive_hash_probe(probed))) {
+    LOG_WARN("adaptive hash probe failed", K(ret));
+  } else if (probed) {
+    // right rows come from hash table, no need to rescan
   } else if (OB_FAIL(prepare_rescan_params())) {
     LOG_WARN("failed to prepare rescan params", K(ret));
   } else if (OB_FAIL(rescan_right_operator())) {
@@ -804,7 +841,12 @@ int ObNestedLoopJoinOp::rescan_right_op()
   batch_info_guard.set_batch_size(left_brs_->size_);
   if (!MY_SPEC.group_rescan_ && !MY_SPEC.enable_px_batch_rescan_) {
     batch_info_guard.set_batch_idx(l_idx_);
-    if (OB_FAIL(rescan_params_batch_one(l_idx_))) {
+    bool probed = false;
+    if (OB_FAIL(adaptive_hash_probe(probed))) {
+      LOG_WARN("adaptive hash probe failed", K(ret));
+    } else if (probed) {
+      // right rows come from hash table, no need to rescan
+    } else if (OB_FAIL(rescan_params_batch_one(l_idx_))) {
       LOG_WARN("fail to rescan params", K(ret));
     }
   } else if (MY_SPEC.group_rescan_ && !MY_SPEC.enable_px_batch_rescan_) {
@@ -841,7 +883,7 @@ int ObNestedLoopJoinOp::process_right_batch()
   const ObBatchRows *right_brs = &right_->get_brs();
   const ObIArray<ObExpr *> &conds = get_spec().other_join_conds_;
   clear_evaluated_flag();
-  if (OB_FAIL(right_->get_next_batch(op_max_batch_size_, right_brs))) {
+  if (OB_FAIL(get_next_right_batch(right_brs))) {
     LOG_WARN("fail to get next right batch", K(ret), K(MY_SPEC));
   } else if (0 == right_brs->size_ && right_brs->end_) {
     match_right_batch_end_ = true;
@@ -1076,6 +1118,262 @@ int ObNestedLoopJoinOp::inner_get_next_batch(const int64_t max_row_cnt)
 }
 
 
+int ObNestedLoopJoinOp::get_next_right_row()
+{
+  int ret = OB_SUCCESS;
+  if (!ah_probing_) {
+    ret = ObBasicNestedLoopJoinOp::get_next_right_row();
+  } else if (NULL == ah_cur_) {
+    ret = OB_ITER_END;
+  } else if (OB_FAIL(ah_cur_->to_expr(right_->get_spec().output_, eval_ctx_))) {
+    LOG_WARN("fail to convert stored row to exprs", K(ret));
+  } else {
+    ah_cur_ = ah_cur_->extra_payload<AdaptiveHashLink>().next_;
+    next_hash_candidate();
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinOp::get_next_right_batch(const ObBatchRows *&right_brs)
+{
+  int ret = OB_SUCCESS;
+  if (!ah_probing_) {
+    if (OB_FAIL(right_->get_next_batch(op_max_batch_size_, right_brs))) {
+      LOG_WARN("fail to get next right batch", K(ret));
+    }
+  } else {
+    int64_t size = 0;
+    while (NULL != ah_cur_ && size < op_max_batch_size_) {
+      ah_batch_rows_[size++] = ah_cur_;
+      ah_cur_ = ah_cur_->extra_payload<AdaptiveHashLink>().next_;
+      next_hash_candidate();
+    }
+    if (size > 0) {
+      ObChunkDatumStore::Iterator::attach_rows(right_->get_spec().output_, eval_ctx_,
+                                               ah_batch_rows_, size);
+    }
+    ah_brs_.skip_->reset(size);
+    ah_brs_.size_ = size;
+    ah_brs_.end_ = (NULL == ah_cur_);
+    right_brs = &ah_brs_;
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinOp::adaptive_hash_probe(bool &probed)
+{
+  int ret = OB_SUCCESS;
+  probed = false;
+  ah_probing_ = false;
+  if (AH_NONE == ah_state_ && ++ah_left_row_cnt_ > ah_threshold_) {
+    if (OB_FAIL(build_adaptive_hash())) {
+      LOG_WARN("fail to build adaptive hash table", K(ret));
+    }
+  }
+  if (OB_SUCC(ret) && AH_READY == ah_state_) {
+    bool has_null = false;
+    if (is_vectorized()) {
+      left_batch_.to_exprs(eval_ctx_, l_idx_, l_idx_);
+    }
+    clear_datum_eval_flag();
+    if (OB_FAIL(calc_hash_value(MY_SPEC.left_hash_keys_, ah_probe_hash_, has_null))) {
+      LOG_WARN("fail to calc left hash value", K(ret));
+    } else {
+      // null never matches equal condition
+      ah_cur_ = has_null ? NULL : ah_buckets_[ah_probe_hash_ & (ah_bucket_cnt_ - 1)];
+      next_hash_candidate();
+      ah_probing_ = true;
+      probed = true;
+    }
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinOp::build_adaptive_hash()
+{
+  int ret = OB_SUCCESS;
+  ObSQLSessionInfo *session = ctx_.get_my_session();
+  int64_t mem_limit = 0;
+  bool too_big = false;
+  ObChunkDatumStore::StoredRow *list = NULL;
+  if (OB_ISNULL(session)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("session is null", K(ret));
+  } else if (OB_FAIL(ObSqlWorkareaUtil::get_workarea_size(
+      ObSqlWorkAreaType::HASH_WORK_AREA, session->get_effective_tenant_id(), mem_limit))) {
+    LOG_WARN("fail to get workarea size", K(ret));
+  } else if (OB_ISNULL(ah_mem_ctx_)) {
+    lib::ContextParam param;
+    param.set_mem_attr(session->get_effective_tenant_id(),
+                       ObModIds::OB_SQL_NLJ_CACHE,
+                       ObCtxIds::WORK_AREA)
+      .set_properties(lib::USE_TL_PAGE_OPTIONAL);
+    if (OB_FAIL(CURRENT_CONTEXT->CREATE_CONTEXT(ah_mem_ctx_, param))) {
+      LOG_WARN("create entity failed", K(ret));
+    } else if (OB_ISNULL(ah_mem_ctx_)) {
+      ret = OB_ERR_UNEXPECTED;
+      LOG_WARN("null memory entity returned", K(ret));
+    }
+  }
+  if (OB_SUCC(ret) && !ah_store_.is_inited()) {
+    if (OB_FAIL(ah_store_.init(mem_limit, session->get_effective_tenant_id(),
+                               ObCtxIds::WORK_AREA, ObModIds::OB_SQL_NLJ_CACHE,
+                               false /*enable dump*/, sizeof(AdaptiveHashLink)))) {
+      LOG_WARN("init adaptive hash store failed", K(ret));
+    } else {
+      ah_store_.set_allocator(ah_mem_ctx_->get_malloc_allocator());
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(rescan_right_operator())) {
+    if (OB_ITER_END != ret) {
+      LOG_WARN("rescan right operator failed", K(ret));
+    }
+  } else if (!is_vectorized()) {
+    while (OB_SUCC(ret) && !too_big && OB_SUCC(right_->get_next_row())) {
+      clear_evaluated_flag();
+      if (OB_FAIL(try_check_status())) {
+        LOG_WARN("check status failed", K(ret));
+      } else if (OB_FAIL(add_adaptive_hash_row(list))) {
+        LOG_WARN("fail to add adaptive hash row", K(ret));
+      } else {
+        too_big = ah_store_.get_mem_hold() > mem_limit;
+      }
+    }
+  } else {
+    ObEvalCtx::BatchInfoScopeGuard batch_info_guard(eval_ctx_);
+    const ObBatchRows *right_brs = NULL;
+    bool right_end = false;
+    while (OB_SUCC(ret) && !too_big && !right_end) {
+      clear_evaluated_flag();
+      if (OB_FAIL(right_->get_next_batch(op_max_batch_size_, right_brs))) {
+        LOG_WARN("fail to get next right batch", K(ret));
+      } else if (OB_FAIL(try_check_status())) {
+        LOG_WARN("check status failed", K(ret));
+      } else {
+        batch_info_guard.set_batch_size(right_brs->size_);
+        for (int64_t i = 0; OB_SUCC(ret) && i < right_brs->size_; i++) {
+          if (right_brs->skip_->exist(i)) {
+            continue;
+          }
+          batch_info_guard.set_batch_idx(i);
+          if (OB_FAIL(add_adaptive_hash_row(list))) {
+            LOG_WARN("fail to add adaptive hash row", K(ret));
+          }
+        }
+        right_end = right_brs->end_;
+        too_big = ah_store_.get_mem_hold() > mem_limit;
+      }
+    }
+  }
+  if (OB_ITER_END == ret) {
+    ret = OB_SUCCESS;
+  }
+  if (OB_SUCC(ret) && !too_big) {
+    ah_bucket_cnt_ = next_pow2(MAX(ah_store_.get_row_cnt(), 1) * 2);
+    const int64_t bucket_size = sizeof(ObChunkDatumStore::StoredRow *) * ah_bucket_cnt_;
+    if (ah_store_.get_mem_hold() + bucket_size > mem_limit) {
+      too_big = true;
+    } else if (OB_ISNULL(ah_buckets_ = static_cast<ObChunkDatumStore::StoredRow **>(
+        ah_mem_ctx_->get_malloc_allocator().alloc(bucket_size)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("fail to alloc buckets", K(ret), K(bucket_size));
+    } else {
+      MEMSET(ah_buckets_, 0, bucket_size);
+      // %list is in reverse insertion order, insert to bucket head keeps the right child order
+      while (NULL != list) {
+        AdaptiveHashLink &link = list->extra_payload<AdaptiveHashLink>();
+        ObChunkDatumStore::StoredRow *next = link.next_;
+        const int64_t idx = link.hash_value_ & (ah_bucket_cnt_ - 1);
+        link.next_ = ah_buckets_[idx];
+        ah_buckets_[idx] = list;
+        list = next;
+      }
+      ah_state_ = AH_READY;
+      op_monitor_info_.otherstat_3_id_ = ObSqlMonitorStatIds::NLJ_ADAPTIVE_SWITCH_ROW;
+      op_monitor_info_.otherstat_3_value_ = ah_left_row_cnt_;
+      op_monitor_info_.otherstat_4_id_ = ObSqlMonitorStatIds::NLJ_ADAPTIVE_HASH_ROW_COUNT;
+      op_monitor_info_.otherstat_4_value_ = ah_store_.get_row_cnt();
+      LOG_TRACE("nested loop join switch to hash probe", K(ah_left_row_cnt_),
+                K(ah_store_.get_row_cnt()), K(ah_bucket_cnt_));
+    }
+  }
+  if (OB_SUCC(ret) && too_big) {
+    // right child does not fit in hash work area, stay in nested loop for this operator.
+    LOG_TRACE("right child too big for adaptive hash", K(mem_limit), K(ah_store_.get_mem_hold()));
+    reset_adaptive_hash();
+    ah_state_ = AH_DISABLED;
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinOp::add_adaptive_hash_row(ObChunkDatumStore::StoredRow *&list)
+{
+  int ret = OB_SUCCESS;
+  uint64_t hash_value = 0;
+  bool has_null = false;
+  ObChunkDatumStore::StoredRow *sr = NULL;
+  if (OB_FAIL(calc_hash_value(MY_SPEC.right_hash_keys_, hash_value, has_null))) {
+    LOG_WARN("fail to calc right hash value", K(ret));
+  } else if (has_null) {
+    // null never matches equal condition
+  } else if (OB_FAIL(ah_store_.add_row(right_->get_spec().output_, &eval_ctx_, &sr))) {
+    LOG_WARN("fail to add row", K(ret));
+  } else {
+    AdaptiveHashLink &link = sr->extra_payload<AdaptiveHashLink>();
+    link.hash_value_ = hash_value;
+    link.next_ = list;
+    list = sr;
+  }
+  return ret;
+}
+
+int ObNestedLoopJoinOp::calc_hash_value(const ExprFixedArray &keys,
+                                        uint64_t &hash_value,
+                                        bool &has_null)
+{
+  int ret = OB_SUCCESS;
+  hash_value = ADAPTIVE_HASH_SEED;
+  has_null = false;
+  ObDatum *datum = NULL;
+  for (int64_t i = 0; OB_SUCC(ret) && !has_null && i < keys.count(); i++) {
+    ObExpr *key = keys.at(i);
+    if (OB_FAIL(key->eval(eval_ctx_, datum))) {
+      LOG_WARN("fail to eval hash key", K(ret), K(i));
+    } else if (datum->is_null()) {
+      has_null = true;
+    } else {
+      hash_value = key->basic_funcs_->murmur_hash_v2_(*datum, hash_value);
+    }
+  }
+  return ret;
+}
+
+void ObNestedLoopJoinOp::next_hash_candidate()
+{
+  while (NULL != ah_cur_
+         && ah_cur_->extra_payload<AdaptiveHashLink>().hash_value_ != ah_probe_hash_) {
+    ah_cur_ = ah_cur_->extra_payload<AdaptiveHashLink>().next_;
+  }
+}
+
+void ObNestedLoopJoinOp::reset_adaptive_hash()
+{
+  if (AH_READY == ah_state_) {
+    ah_state_ = AH_NONE;
+  }
+  ah_left_row_cnt_ = 0;
+  ah_probing_ = false;
+  ah_probe_hash_ = 0;
+  ah_cur_ = NULL;
+  ah_store_.reset();
+  if (NULL != ah_buckets_ && NULL != ah_mem_ctx_) {
+    ah_mem_ctx_->get_malloc_allocator().free(ah_buckets_);
+  }
+  ah_buckets_ = NULL;
+  ah_bucket_cnt_ = 0;
+}
+
 //calc other conditions
 int ObNestedLoopJoinOp::calc_other_conds(bool &is_match)
 {
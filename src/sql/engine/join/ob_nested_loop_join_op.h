@@ -32,7 +32,10 @@ public:
       group_size_(OB_MAX_BULK_JOIN_ROWS),
       left_expr_ids_in_other_cond_(alloc),
       left_rescan_params_(alloc),
-      right_rescan_params_(alloc)
+      right_rescan_params_(alloc),
+      enable_adaptive_hash_(false),
+      left_hash_keys_(alloc),
+      right_hash_keys_(alloc)
   {}
 
 public:
@@ -53,6 +56,12 @@ public:
   // by NLJ 1.
   common::ObFixedArray<ObDynamicParamSetter, common::ObIAllocator> left_rescan_params_;
   common::ObFixedArray<ObDynamicParamSetter, common::ObIAllocator> right_rescan_params_;
+  // for adaptive hash probe: right child is independent of left row, so it can be
+  // materialized into a hash table on the equal keys of other join conditions once
+  // enough left rows are seen, instead of being rescanned for every left row.
+  bool enable_adaptive_hash_;
+  ExprFixedArray left_hash_keys_;
+  ExprFixedArray right_hash_keys_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObNestedLoopJoinSpec);
 };
@@ -87,6 +96,17 @@ public:
     FT_ITER_END,
     FT_TYPE_COUNT
   };
+  enum ObAdaptiveHashState {
+    AH_NONE = 0,   // still nested loop, counting left rows
+    AH_READY,      // hash table built, probe it for each left row
+    AH_DISABLED    // disabled or right child too big, keep nested loop
+  };
+  // row extend of right rows stored in adaptive hash table
+  struct AdaptiveHashLink
+  {
+    uint64_t hash_value_;
+    ObChunkDatumStore::StoredRow *next_;
+  };
 
   ObNestedLoopJoinOp(ObExecContext &exec_ctx, const ObOpSpec &spec, ObOpInput *input);
 
@@ -116,6 +136,11 @@ public:
     if (MY_SPEC.group_rescan_) {
       group_join_buffer_.destroy();
     }
+    reset_adaptive_hash();
+    if (nullptr != ah_mem_ctx_) {
+      DESTROY_CONTEXT(ah_mem_ctx_);
+      ah_mem_ctx_ = nullptr;
+    }
     ObBasicNestedLoopJoinOp::destroy();
   }
   ObBatchRescanCtl &get_batch_rescan_ctl() { return batch_rescan_ctl_; }
@@ -124,6 +149,7 @@ public:
 
 public:
   static const int64_t PX_RESCAN_BATCH_ROW_COUNT = 8192;
+  static const uint64_t ADAPTIVE_HASH_SEED = 16777213;
 private:
   // state operation and transfer function type.
   typedef int (ObNestedLoopJoinOp::*state_operation_func_type)();
@@ -151,6 +177,17 @@ private:
   // used for rescan and switch iter
   virtual void reset_buf_state();
 
+  // for adaptive hash probe
+  virtual int get_next_right_row() override;
+  int get_next_right_batch(const ObBatchRows *&right_brs);
+  // probe hash table for current left row if switched, otherwise caller rescan right child.
+  int adaptive_hash_probe(bool &probed);
+  int build_adaptive_hash();
+  int add_adaptive_hash_row(ObChunkDatumStore::StoredRow *&list);
+  int calc_hash_value(const ExprFixedArray &keys, uint64_t &hash_value, bool &has_null);
+  void next_hash_candidate();
+  void reset_adaptive_hash();
+
   // for vectorized
   int rescan_params_batch_one(int64_t batch_idx);
   int get_left_batch();
@@ -208,6 +245,20 @@ public:
   bool need_output_row_;
   int32_t left_expr_extend_size_;
   // for refactor vectorized end
+
+  // for adaptive hash probe
+  ObAdaptiveHashState ah_state_;
+  int64_t ah_threshold_;
+  int64_t ah_left_row_cnt_;
+  lib::MemoryContext ah_mem_ctx_;
+  ObChunkDatumStore ah_store_;
+  ObChunkDatumStore::StoredRow **ah_buckets_;
+  int64_t ah_bucket_cnt_;
+  bool ah_probing_;
+  uint64_t ah_probe_hash_;
+  ObChunkDatumStore::StoredRow *ah_cur_;
+  const ObChunkDatumStore::StoredRow **ah_batch_rows_;
+  ObBatchRows ah_brs_;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObNestedLoopJoinOp);
 };
@@ -37,7 +37,9 @@ ObSortSpec::ObSortSpec(common::ObIAllocator &alloc, const ObPhyOperatorType type
   is_fetch_with_ties_(false),
   prescan_enabled_(false),
   enable_encode_sortkey_opt_(false),
-  part_cnt_(0)
+  part_cnt_(0),
+  part_topn_expr_(nullptr),
+  is_part_topn_with_ties_(false)
 {}
 
 OB_SERIALIZE_MEMBER((ObSortSpec, ObOpSpec),
@@ -54,7 +56,9 @@ OB_SERIALIZE_MEMBER((ObSortSpec, ObOpSpec),
                     is_fetch_with_ties_,
                     prescan_enabled_,
                     enable_encode_sortkey_opt_,
-                    part_cnt_);
+                    part_cnt_,
+                    part_topn_expr_,
+                    is_part_topn_with_ties_);
 
 ObSortOp::ObSortOp(ObExecContext &ctx_, const ObOpSpec &spec, ObOpInput *input)
   : ObOperator(ctx_, spec, input),
@@ -188,6 +192,21 @@ int ObSortOp::get_topn_count(int64_t &topn_cnt)
   return ret;
 }
 
+int ObSortOp::get_part_topn_count(int64_t &part_topn_cnt)
+{
+  int ret = OB_SUCCESS;
+  part_topn_cnt = INT64_MAX;
+  if (OB_ISNULL(MY_SPEC.part_topn_expr_)) {
+    // do nothing
+  } else if (OB_UNLIKELY(MY_SPEC.part_cnt_ <= 0)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("part topn without partition sort", K(ret), K(MY_SPEC.part_cnt_));
+  } else if (OB_FAIL(get_int_value(MY_SPEC.part_topn_expr_, part_topn_cnt))) {
+    LOG_WARN("failed to get int value", K(ret), K(MY_SPEC.part_topn_expr_));
+  }
+  return ret;
+}
+
 int ObSortOp::process_sort()
 {
   int ret = OB_SUCCESS;
@@ -431,6 +450,14 @@ int ObSortOp::init_sort(int64_t tenant_id,
   OZ(sort_impl_.init(tenant_id, &MY_SPEC.sort_collations_, &MY_SPEC.sort_cmp_funs_,
       &eval_ctx_, &ctx_, MY_SPEC.enable_encode_sortkey_opt_, MY_SPEC.is_local_merge_sort_,
       false /* need_rewind */, MY_SPEC.part_cnt_, topn_cnt, MY_SPEC.is_fetch_with_ties_));
+  if (OB_SUCC(ret) && NULL != MY_SPEC.part_topn_expr_) {
+    int64_t part_topn_cnt = INT64_MAX;
+    if (OB_FAIL(get_part_topn_count(part_topn_cnt))) {
+      LOG_WARN("failed to get part topn count", K(ret));
+    } else if (OB_FAIL(sort_impl_.set_part_topn(part_topn_cnt, MY_SPEC.is_part_topn_with_ties_))) {
+      LOG_WARN("failed to set part topn", K(ret), K(part_topn_cnt));
+    }
+  }
   if (is_batch) {
     read_batch_func_ = &ObSortOp::sort_impl_next_batch;
   } else {
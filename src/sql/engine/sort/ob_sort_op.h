@@ -33,7 +33,8 @@ public:
   INHERIT_TO_STRING_KV("op_spec", ObOpSpec,
     K_(topn_expr), K_(topk_limit_expr), K_(topk_offset_expr), K_(prefix_pos),
     K_(minimum_row_count), K_(topk_precision), K_(prefix_pos), K_(is_local_merge_sort),
-    K_(prescan_enabled), K_(enable_encode_sortkey_opt), K_(part_cnt));
+    K_(prescan_enabled), K_(enable_encode_sortkey_opt), K_(part_cnt), K_(part_topn_expr),
+    K_(is_part_topn_with_ties));
 public:
   ObExpr *topn_expr_;
   ObExpr *topk_limit_expr_;
@@ -56,6 +57,9 @@ public:
   bool enable_encode_sortkey_opt_;
   // if use, all_exprs_ is : hash(part_by) + part_by + order_by.
   int64_t part_cnt_;
+  // for partition sort, only top n rows of each partition are needed by `rn <= n` filter.
+  ObExpr *part_topn_expr_;
+  bool is_part_topn_with_ties_;
 };
 
 class ObSortOp : public ObOperator
@@ -115,6 +119,7 @@ private:
 
   int get_int_value(const ObExpr *in_val, int64_t &out_val);
   int get_topn_count(int64_t &topn_cnt);
+  int get_part_topn_count(int64_t &part_topn_cnt);
   int process_sort();
   int process_sort_batch();
   int scan_all_then_sort();
@@ -519,22 +519,21 @@ int ObSortOpImpl::Compare::with_ties_cmp(const ObChunkDatumStore::StoredRow *l,
 }
 
 // compare function for external merge sort
-bool ObSortOpImpl::Compare::operator()(const ObSortOpChunk *l, const ObSortOpChunk *r)
+int ObSortOpImpl::Compare::cmp(const ObSortOpChunk *l, const ObSortOpChunk *r, int64_t &cmp_ret)
 {
-  bool less = false;
   int &ret = ret_;
+  cmp_ret = 0;
   if (OB_UNLIKELY(OB_SUCCESS != ret)) {
     // already fail
   } else if (OB_ISNULL(l) || OB_ISNULL(r)) {
     ret = OB_INVALID_ARGUMENT;
     LOG_WARN("invalid argument", K(ret), KP(l), KP(r));
   } else {
-    // Return the reverse order since the heap top is the maximum element.
-    // NOTE: can not return !(*this)(l->row_, r->row_)
-    //       because we should always return false if l == r.
-    less = (*this)(r->row_, l->row_);
+    // the winner of loser tree is the one with negative cmp_ret,
+    // equal rows are treated as draw in favor of the defender to save one comparison.
+    cmp_ret = (*this)(l->row_, r->row_) ? -1 : 1;
   }
-  return less;
+  return ret;
 }
 
 bool ObSortOpImpl::Compare::operator()(
@@ -568,7 +567,10 @@ ObSortOpImpl::ObSortOpImpl(ObMonitorNode &op_monitor_info)
     profile_(ObSqlWorkAreaType::SORT_WORK_AREA), op_monitor_info_(op_monitor_info), sql_mem_processor_(profile_, op_monitor_info_),
     op_type_(PHY_INVALID), op_id_(UINT64_MAX), exec_ctx_(nullptr), stored_rows_(nullptr),
     io_event_observer_(nullptr), buckets_(NULL), max_bucket_cnt_(0), part_hash_nodes_(NULL),
-    max_node_cnt_(0), part_cnt_(0), topn_cnt_(INT64_MAX), outputted_rows_cnt_(0),
+    max_node_cnt_(0), part_cnt_(0), part_topn_cnt_(INT64_MAX), is_part_topn_with_ties_(false),
+    part_topn_buckets_(NULL), part_topn_bucket_cnt_(0), part_topn_node_cnt_(0),
+    part_topn_filtered_cnt_(0), part_topn_skip_(NULL), part_topn_skip_size_(0),
+    topn_cnt_(INT64_MAX), outputted_rows_cnt_(0),
     is_fetch_with_ties_(false), topn_heap_(NULL), ties_array_pos_(0), ties_array_(),
     last_ties_row_(NULL), rows_(NULL)
 {
@@ -689,6 +691,7 @@ int ObSortOpImpl::init(
 void ObSortOpImpl::reuse()
 {
   sorted_ = false;
+  reset_part_topn_nodes();
   iter_.reset();
   quick_sort_array_.reuse();
   datum_store_.reset();
@@ -717,7 +720,7 @@ void ObSortOpImpl::reuse()
   }
   heap_iter_begin_ = false;
   if (NULL != ems_heap_) {
-    ems_heap_->reset();
+    ems_heap_->reuse();
   }
   if (NULL != topn_heap_) {
     for (int64_t i = 0; i < topn_heap_->count(); ++i) {
@@ -756,6 +759,9 @@ void ObSortOpImpl::reset()
   max_bucket_cnt_ = 0;
   max_node_cnt_ = 0;
   part_cnt_ = 0;
+  part_topn_cnt_ = INT64_MAX;
+  is_part_topn_with_ties_ = false;
+  part_topn_filtered_cnt_ = 0;
   topn_cnt_ = INT64_MAX;
   outputted_rows_cnt_ = 0;
   is_fetch_with_ties_ = false;
@@ -775,7 +781,7 @@ void ObSortOpImpl::reset()
       imms_heap_ = NULL;
     }
     if (NULL != ems_heap_) {
-      ems_heap_->~EMSHeap();
+      ems_heap_->~EMSLoserTree();
       mem_context_->get_malloc_allocator().free(ems_heap_);
       ems_heap_ = NULL;
     }
@@ -791,6 +797,11 @@ void ObSortOpImpl::reset()
       mem_context_->get_malloc_allocator().free(part_hash_nodes_);
       part_hash_nodes_ = NULL;
     }
+    if (NULL != part_topn_skip_) {
+      mem_context_->get_malloc_allocator().free(part_topn_skip_);
+      part_topn_skip_ = NULL;
+      part_topn_skip_size_ = 0;
+    }
     if (NULL != topn_heap_) {
       for (int64_t i = 0; i < topn_heap_->count(); ++i) {
         mem_context_->get_malloc_allocator().free(static_cast<SortStoredRow *>(topn_heap_->at(i)));
@@ -1061,6 +1072,8 @@ int ObSortOpImpl::after_add_row(ObChunkDatumStore::StoredRow *sr)
   if (OB_SUCC(ret)) {
     if (OB_FAIL(rows_->push_back(sr))) {
       LOG_WARN("array push back failed", K(ret), K(rows_->count()));
+    } else if (is_part_topn_sort() && OB_FAIL(add_part_topn_row(sr))) {
+      LOG_WARN("failed to add part topn row", K(ret));
     }
   }
   return ret;
@@ -1071,8 +1084,13 @@ int ObSortOpImpl::add_quick_sort_row(const common::ObIArray<ObExpr*> &exprs,
 {
   int ret = OB_SUCCESS;
   ObChunkDatumStore::StoredRow *sr = NULL;
+  bool need_add = true;
   if (OB_FAIL(before_add_row())) {
     LOG_WARN("before add row process failed", K(ret));
+  } else if (is_part_topn_sort() && OB_FAIL(part_topn_need_add(exprs, need_add))) {
+    LOG_WARN("failed to check part topn", K(ret));
+  } else if (!need_add) {
+    ++part_topn_filtered_cnt_;
   } else if (OB_FAIL(datum_store_.add_row(exprs, eval_ctx_, &sr))) {
     LOG_WARN("add store row failed", K(ret), K(mem_context_->used()), K(get_memory_limit()));
   } else if (OB_FAIL(after_add_row(sr))) {
@@ -1112,9 +1130,13 @@ int ObSortOpImpl::add_quick_sort_batch(const common::ObIArray<ObExpr *> &exprs,
 {
   int ret = OB_SUCCESS;
   int64_t stored_rows_cnt = 0;
+  const ObBitVector *add_skip = &skip;
   if (OB_FAIL(before_add_row())) {
     LOG_WARN("before add row process failed", K(ret));
-  } else if (OB_FAIL(datum_store_.add_batch(exprs, *eval_ctx_, skip, batch_size,
+  } else if (is_part_topn_sort()
+             && OB_FAIL(part_topn_filter_batch(exprs, skip, batch_size, start_pos, add_skip))) {
+    LOG_WARN("failed to filter batch by part topn", K(ret));
+  } else if (OB_FAIL(datum_store_.add_batch(exprs, *eval_ctx_, *add_skip, batch_size,
                                             stored_rows_cnt, stored_rows_, start_pos))) {
     LOG_WARN("add store row failed", K(ret), K(mem_context_->used()), K(get_memory_limit()));
   } else {
@@ -1235,6 +1257,262 @@ bool ObSortOpImpl::is_equal_part(const ObChunkDatumStore::StoredRow *l,
   return is_equal;
 }
 
+int ObSortOpImpl::set_part_topn(const int64_t part_topn_cnt, const bool with_ties)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited()) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(part_cnt_ <= 0 || got_first_row_)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("part topn only valid for partition sort before adding rows",
+             K(ret), K(part_cnt_), K(got_first_row_));
+  } else if (need_rewind_ || local_merge_sort_) {
+    // rows are merged by imms heap, which expects all the stored rows, do not filter.
+  } else {
+    part_topn_cnt_ = std::max(0L, part_topn_cnt);
+    is_part_topn_with_ties_ = with_ties;
+  }
+  return ret;
+}
+
+// return the end of rows kept in sorted partition [part_begin, part_end)
+int64_t ObSortOpImpl::get_part_topn_end(common::ObIArray<ObChunkDatumStore::StoredRow *> &rows,
+                                        const int64_t part_begin, const int64_t part_end)
+{
+  int64_t keep_end = part_end;
+  if (part_end - part_begin > part_topn_cnt_) {
+    keep_end = part_begin + part_topn_cnt_;
+    if (is_part_topn_with_ties_ && part_topn_cnt_ > 0) {
+      // rows of the same partition only differ in order by keys
+      const ObChunkDatumStore::StoredRow *last_row = rows.at(keep_end - 1);
+      while (keep_end < part_end && 0 == comp_.with_ties_cmp(rows.at(keep_end), last_row)) {
+        ++keep_end;
+      }
+    }
+  }
+  return keep_end;
+}
+
+// a row is dropped when it is ordered after the part_topn_cnt_ best rows already added of its
+// partition, or after the ties of them for rank. Only the rows added since the last dump are
+// checked, the rows of the last run are filtered when the run is sorted.
+int ObSortOpImpl::part_topn_need_add(const common::ObIArray<ObExpr*> &exprs, bool &need_add)
+{
+  int ret = OB_SUCCESS;
+  ObDatum *hash_datum = NULL;
+  need_add = true;
+  if (part_topn_cnt_ <= 0) {
+    need_add = false;
+  } else if (NULL == part_topn_buckets_) {
+    // no row added
+  } else if (OB_FAIL(exprs.at(sort_collations_->at(0).field_idx_)->eval(*eval_ctx_, hash_datum))) {
+    LOG_WARN("failed to eval hash expr", K(ret));
+  } else {
+    const uint64_t hash_value = hash_datum->get_uint64();
+    PartTopnNode *node = part_topn_buckets_[hash_value & (part_topn_bucket_cnt_ - 1)];
+    bool is_equal = false;
+    while (OB_SUCC(ret) && NULL != node && !is_equal) {
+      is_equal = (node->hash_value_ == hash_value);
+      for (int64_t i = 1; OB_SUCC(ret) && is_equal && i <= part_cnt_; ++i) {
+        const int64_t idx = sort_collations_->at(i).field_idx_;
+        ObDatum *datum = NULL;
+        if (OB_FAIL(exprs.at(idx)->eval(*eval_ctx_, datum))) {
+          LOG_WARN("failed to eval part expr", K(ret));
+        } else {
+          is_equal = (0 == sort_cmp_funs_->at(i).cmp_func_(*datum, node->heap_[0]->cells()[idx]));
+        }
+      }
+      if (!is_equal) {
+        node = node->next_;
+      }
+    }
+    if (OB_SUCC(ret) && NULL != node && node->cnt_ >= part_topn_cnt_) {
+      const int cmp = comp_.with_ties_cmp(&exprs, node->heap_[0], *eval_ctx_);
+      if (OB_FAIL(comp_.ret_)) {
+        LOG_WARN("failed to compare", K(ret));
+      } else {
+        need_add = is_part_topn_with_ties_ ? cmp >= 0 : cmp > 0;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObSortOpImpl::part_topn_filter_batch(const common::ObIArray<ObExpr *> &exprs,
+                                         const ObBitVector &skip,
+                                         const int64_t batch_size,
+                                         const int64_t start_pos,
+                                         const ObBitVector *&add_skip)
+{
+  int ret = OB_SUCCESS;
+  add_skip = &skip;
+  if (NULL == part_topn_buckets_ && part_topn_cnt_ > 0) {
+    // no row added
+  } else {
+    if (part_topn_skip_size_ < batch_size) {
+      void *buf = NULL;
+      if (NULL != part_topn_skip_) {
+        mem_context_->get_malloc_allocator().free(part_topn_skip_);
+        part_topn_skip_ = NULL;
+        part_topn_skip_size_ = 0;
+      }
+      if (OB_ISNULL(buf = mem_context_->get_malloc_allocator().alloc(
+                    ObBitVector::memory_size(batch_size)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("failed to alloc part topn skip", K(ret), K(batch_size));
+      } else {
+        part_topn_skip_ = to_bit_vector(buf);
+        part_topn_skip_size_ = batch_size;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      ObEvalCtx::BatchInfoScopeGuard batch_info_guard(*eval_ctx_);
+      batch_info_guard.set_batch_size(batch_size);
+      part_topn_skip_->deep_copy(skip, batch_size);
+      for (int64_t i = start_pos; OB_SUCC(ret) && i < batch_size; ++i) {
+        bool need_add = true;
+        if (skip.at(i)) {
+          continue;
+        }
+        batch_info_guard.set_batch_idx(i);
+        if (OB_FAIL(part_topn_need_add(exprs, need_add))) {
+          LOG_WARN("failed to check part topn", K(ret));
+        } else if (!need_add) {
+          part_topn_skip_->set(i);
+          ++part_topn_filtered_cnt_;
+        }
+      }
+      add_skip = part_topn_skip_;
+    }
+  }
+  return ret;
+}
+
+int ObSortOpImpl::add_part_topn_row(ObChunkDatumStore::StoredRow *sr)
+{
+  int ret = OB_SUCCESS;
+  ObIAllocator &allocator = mem_context_->get_malloc_allocator();
+  PartTopnNode *node = NULL;
+  if (OB_ISNULL(sr) || part_topn_cnt_ <= 0) {
+    // do nothing
+  } else if (part_topn_node_cnt_ >= part_topn_bucket_cnt_ && OB_FAIL(extend_part_topn_buckets())) {
+    LOG_WARN("failed to extend part topn buckets", K(ret));
+  } else {
+    const uint64_t hash_value = sr->cells()[sort_collations_->at(0).field_idx_].get_uint64();
+    PartTopnNode *&bucket = part_topn_buckets_[hash_value & (part_topn_bucket_cnt_ - 1)];
+    node = bucket;
+    while (NULL != node && !is_equal_part(node->heap_[0], sr)) {
+      node = node->next_;
+    }
+    if (NULL == node) {
+      const int64_t cap = part_topn_cnt_ < PART_TOPN_INIT_HEAP_SIZE
+                          ? part_topn_cnt_ : PART_TOPN_INIT_HEAP_SIZE;
+      void *buf = NULL;
+      if (OB_ISNULL(buf = allocator.alloc(sizeof(PartTopnNode)
+                                          + sizeof(ObChunkDatumStore::StoredRow *) * cap))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("failed to alloc part topn node", K(ret), K(cap));
+      } else {
+        node = new (buf) PartTopnNode();
+        node->hash_value_ = hash_value;
+        node->heap_ = reinterpret_cast<ObChunkDatumStore::StoredRow **>(node + 1);
+        node->cap_ = cap;
+        node->next_ = bucket;
+        bucket = node;
+        ++part_topn_node_cnt_;
+      }
+    }
+  }
+  if (OB_FAIL(ret) || NULL == node) {
+  } else if (node->cnt_ < part_topn_cnt_) {
+    if (node->cnt_ >= node->cap_) {
+      const int64_t cap = std::min(part_topn_cnt_, node->cap_ * 2);
+      ObChunkDatumStore::StoredRow **heap = NULL;
+      if (OB_ISNULL(heap = static_cast<ObChunkDatumStore::StoredRow **>(
+                    allocator.alloc(sizeof(ObChunkDatumStore::StoredRow *) * cap)))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("failed to alloc part topn heap", K(ret), K(cap));
+      } else {
+        MEMCPY(heap, node->heap_, sizeof(ObChunkDatumStore::StoredRow *) * node->cnt_);
+        if (node->heap_ != reinterpret_cast<ObChunkDatumStore::StoredRow **>(node + 1)) {
+          allocator.free(node->heap_);
+        }
+        node->heap_ = heap;
+        node->cap_ = cap;
+      }
+    }
+    if (OB_SUCC(ret)) {
+      node->heap_[node->cnt_++] = sr;
+      std::push_heap(node->heap_, node->heap_ + node->cnt_, CopyableComparer(comp_));
+    }
+  } else if (comp_(sr, node->heap_[0])) {
+    // replace the last row kept, the rows replaced are filtered when sorted
+    std::pop_heap(node->heap_, node->heap_ + node->cnt_, CopyableComparer(comp_));
+    node->heap_[node->cnt_ - 1] = sr;
+    std::push_heap(node->heap_, node->heap_ + node->cnt_, CopyableComparer(comp_));
+  }
+  if (OB_SUCC(ret) && OB_FAIL(comp_.ret_)) {
+    LOG_WARN("failed to compare", K(ret));
+  }
+  return ret;
+}
+
+int ObSortOpImpl::extend_part_topn_buckets()
+{
+  int ret = OB_SUCCESS;
+  ObIAllocator &allocator = mem_context_->get_malloc_allocator();
+  const int64_t bucket_cnt = part_topn_bucket_cnt_ > 0
+                             ? part_topn_bucket_cnt_ * 2 : PART_TOPN_INIT_BUCKET_CNT;
+  PartTopnNode **buckets = NULL;
+  if (OB_ISNULL(buckets = static_cast<PartTopnNode **>(
+                allocator.alloc(sizeof(PartTopnNode *) * bucket_cnt)))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    LOG_WARN("failed to alloc part topn buckets", K(ret), K(bucket_cnt));
+  } else {
+    MEMSET(buckets, 0, sizeof(PartTopnNode *) * bucket_cnt);
+    for (int64_t i = 0; i < part_topn_bucket_cnt_; ++i) {
+      PartTopnNode *node = part_topn_buckets_[i];
+      while (NULL != node) {
+        PartTopnNode *next = node->next_;
+        PartTopnNode *&bucket = buckets[node->hash_value_ & (bucket_cnt - 1)];
+        node->next_ = bucket;
+        bucket = node;
+        node = next;
+      }
+    }
+    if (NULL != part_topn_buckets_) {
+      allocator.free(part_topn_buckets_);
+    }
+    part_topn_buckets_ = buckets;
+    part_topn_bucket_cnt_ = bucket_cnt;
+  }
+  return ret;
+}
+
+void ObSortOpImpl::reset_part_topn_nodes()
+{
+  if (NULL != part_topn_buckets_ && NULL != mem_context_) {
+    ObIAllocator &allocator = mem_context_->get_malloc_allocator();
+    for (int64_t i = 0; i < part_topn_bucket_cnt_; ++i) {
+      PartTopnNode *node = part_topn_buckets_[i];
+      while (NULL != node) {
+        PartTopnNode *next = node->next_;
+        if (node->heap_ != reinterpret_cast<ObChunkDatumStore::StoredRow **>(node + 1)) {
+          allocator.free(node->heap_);
+        }
+        node->~PartTopnNode();
+        allocator.free(node);
+        node = next;
+      }
+    }
+    allocator.free(part_topn_buckets_);
+  }
+  part_topn_buckets_ = NULL;
+  part_topn_bucket_cnt_ = 0;
+  part_topn_node_cnt_ = 0;
+}
+
 int ObSortOpImpl::do_partition_sort(common::ObIArray<ObChunkDatumStore::StoredRow *> &rows,
                                     const int64_t rows_begin, const int64_t rows_end)
 {
@@ -1323,6 +1601,8 @@ int ObSortOpImpl::do_partition_sort(common::ObIArray<ObChunkDatumStore::StoredRo
   }
 
   int64_t rows_idx = rows_begin;
+  // write position of kept rows when part topn filters rows
+  int64_t keep_idx = rows_begin;
   ObArray<PartHashNode *> bucket_nodes;
   if (OB_SUCC(ret)) {
     if (OB_FAIL(bucket_nodes.prepare_allocate(16))) {
@@ -1373,9 +1653,23 @@ int ObSortOpImpl::do_partition_sort(common::ObIArray<ObChunkDatumStore::StoredRo
           std::sort(&rows.at(0) + rows_last, &rows.at(0) + rows_idx, CopyableComparer(comp_));
         }
       }
+      if (is_part_topn_sort()) {
+        const int64_t keep_end = get_part_topn_end(rows, rows_last, rows_idx);
+        for (int64_t j = rows_last; j < keep_end; ++j) {
+          rows.at(keep_idx++) = rows.at(j);
+        }
+      }
     }
     comp_.set_cmp_range(0, comp_.get_cnt());
   }
+  if (OB_SUCC(ret) && is_part_topn_sort() && rows_end > rows_begin) {
+    const int64_t filtered_cnt = rows_end - keep_idx;
+    for (int64_t i = 0; i < filtered_cnt; ++i) {
+      rows.pop_back();
+    }
+    LOG_TRACE("partition topn filter rows", K(part_topn_cnt_), K(filtered_cnt), K(rows.count()),
+              K(part_topn_filtered_cnt_));
+  }
   return ret;
 }
 
@@ -1461,6 +1755,8 @@ int ObSortOpImpl::do_dump()
       heap_iter_begin_ = false;
       row_idx_ = 0;
       quick_sort_array_.reset();
+      // the kept rows are released with the datum store
+      reset_part_topn_nodes();
       datum_store_.reset();
       inmem_row_size_ = 0;
       mem_check_interval_mask_ = 1;
@@ -1501,15 +1797,6 @@ int ObSortOpImpl::build_ems_heap(int64_t &merge_ways)
       c = c->get_next();
     }
 
-    if (NULL == ems_heap_) {
-      if (OB_ISNULL(ems_heap_ = OB_NEWx(EMSHeap, (&mem_context_->get_malloc_allocator()),
-          comp_, &mem_context_->get_malloc_allocator()))) {
-        ret = OB_ALLOCATE_MEMORY_FAILED;
-        LOG_WARN("allocate memory failed", K(ret));
-      }
-    } else {
-      ems_heap_->reset();
-    }
     if (OB_SUCC(ret)) {
       merge_ways = get_memory_limit() / ObChunkDatumStore::BLOCK_SIZE;
       merge_ways = std::max(2L, merge_ways);
@@ -1530,13 +1817,42 @@ int ObSortOpImpl::build_ems_heap(int64_t &merge_ways)
       LOG_TRACE("do merge sort ", K(first->level_), K(merge_ways), K(sort_chunks_.get_size()), K(get_memory_limit()), K(sql_mem_processor_.get_profile()));
     }
 
+    if (OB_FAIL(ret)) {
+    } else if (NULL == ems_heap_) {
+      if (OB_ISNULL(ems_heap_ = OB_NEWx(EMSLoserTree, (&mem_context_->get_malloc_allocator()),
+          comp_))) {
+        ret = OB_ALLOCATE_MEMORY_FAILED;
+        LOG_WARN("allocate memory failed", K(ret));
+      } else if (OB_FAIL(ems_heap_->init(merge_ways, mem_context_->get_malloc_allocator()))) {
+        LOG_WARN("init loser tree failed", K(ret), K(merge_ways));
+      }
+    } else {
+      ems_heap_->reuse();
+      if (OB_FAIL(ems_heap_->open(merge_ways))) {
+        LOG_WARN("open loser tree failed", K(ret), K(merge_ways));
+      }
+    }
+
     if (OB_SUCC(ret)) {
+      // issue read of the first block of all merging chunks before waiting any of them,
+      // the following blocks are read ahead by the chunk iterator itself.
       ObSortOpChunk *chunk = sort_chunks_.get_first();
       for (int64_t i = 0; i < merge_ways && OB_SUCC(ret); i++) {
         chunk->iter_.reset();
         if (OB_FAIL(chunk->iter_.init(&chunk->datum_store_))) {
           LOG_WARN("init iterator failed", K(ret));
-        } else if (OB_FAIL(chunk->iter_.get_next_row(chunk->row_))
+        } else if (OB_FAIL(chunk->iter_.prefetch())) {
+          LOG_WARN("prefetch failed", K(ret));
+        } else {
+          chunk = chunk->get_next();
+        }
+      }
+    }
+
+    if (OB_SUCC(ret)) {
+      ObSortOpChunk *chunk = sort_chunks_.get_first();
+      for (int64_t i = 0; i < merge_ways && OB_SUCC(ret); i++) {
+        if (OB_FAIL(chunk->iter_.get_next_row(chunk->row_))
             || NULL == chunk->row_) {
           if (OB_ITER_END == ret || OB_SUCCESS == ret) {
             ret = OB_ERR_UNEXPECTED;
@@ -1545,11 +1861,14 @@ int ObSortOpImpl::build_ems_heap(int64_t &merge_ways)
           }
           LOG_WARN("get next row failed", K(ret));
         } else if (OB_FAIL(ems_heap_->push(chunk))) {
-          LOG_WARN("heap push failed", K(ret));
+          LOG_WARN("loser tree push failed", K(ret));
         } else {
           chunk = chunk->get_next();
         }
       }
+      if (OB_SUCC(ret) && OB_FAIL(ems_heap_->rebuild())) {
+        LOG_WARN("loser tree rebuild failed", K(ret));
+      }
     }
   }
   if (OB_SUCC(ret)) {
@@ -1600,19 +1919,43 @@ int ObSortOpImpl::heap_next(Heap &heap, const NextFunc &func, Item &item)
 
 int ObSortOpImpl::ems_heap_next(ObSortOpChunk *&chunk)
 {
-  const auto f = [](ObSortOpChunk *&c, bool &is_end) {
-    int ret = OB_SUCCESS;
-    if (OB_FAIL(c->iter_.get_next_row(c->row_))) {
-      if (OB_ITER_END == ret) {
-        is_end = true;
-        ret = OB_SUCCESS;
+  int ret = OB_SUCCESS;
+  ObSortOpChunk * const *top = NULL;
+  if (!is_inited()) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (heap_iter_begin_) {
+    if (!ems_heap_->empty()) {
+      if (OB_FAIL(ems_heap_->top(top))) {
+        LOG_WARN("get loser tree top failed", K(ret));
       } else {
-        LOG_WARN("get next row failed", K(ret));
+        ObSortOpChunk *c = *top;
+        if (OB_FAIL(c->iter_.get_next_row(c->row_))) {
+          if (OB_ITER_END == ret) {
+            if (OB_FAIL(ems_heap_->pop())) {
+              LOG_WARN("loser tree pop failed", K(ret));
+            }
+          } else {
+            LOG_WARN("get next row failed", K(ret));
+          }
+        } else if (OB_FAIL(ems_heap_->push_top(c))) {
+          LOG_WARN("loser tree push top failed", K(ret));
+        }
       }
     }
-    return ret;
-  };
-  return heap_next(*ems_heap_, f, chunk);
+  } else {
+    heap_iter_begin_ = true;
+  }
+  if (OB_SUCC(ret)) {
+    if (ems_heap_->empty()) {
+      ret = OB_ITER_END;
+    } else if (OB_FAIL(ems_heap_->top(top))) {
+      LOG_WARN("get loser tree top failed", K(ret));
+    } else {
+      chunk = *top;
+    }
+  }
+  return ret;
 }
 
 int ObSortOpImpl::imms_heap_next(const ObChunkDatumStore::StoredRow *&store_row)
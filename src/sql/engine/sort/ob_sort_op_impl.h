@@ -15,6 +15,7 @@
 
 #include "lib/container/ob_array.h"
 #include "lib/container/ob_heap.h"
+#include "lib/container/ob_loser_tree.h"
 #include "sql/engine/basic/ob_chunk_datum_store.h"
 #include "sql/engine/ob_sql_mem_mgr_processor.h"
 #include "sql/engine/sort/ob_sort_basic_info.h"
@@ -215,6 +216,10 @@ public:
 
   bool is_inited() const { return inited_; }
   bool is_topn_sort() const { return INT64_MAX != topn_cnt_; }
+  // keep at most %part_topn_cnt rows (plus ties of the last one if %with_ties) for each
+  // partition of partition sort, rows beyond are filtered by `rn <= k` above window function.
+  int set_part_topn(const int64_t part_topn_cnt, const bool with_ties);
+  bool is_part_topn_sort() const { return INT64_MAX != part_topn_cnt_; }
 
   void set_input_rows(int64_t input_rows) { input_rows_ = input_rows; }
   void set_input_width(int64_t input_width) { input_width_ = input_width; }
@@ -254,8 +259,8 @@ public:
 
     // compare function for in-memory merge sort
     bool operator()(ObChunkDatumStore::StoredRow **l, ObChunkDatumStore::StoredRow **r);
-    // compare function for external merge sort
-    bool operator()(const ObSortOpChunk *l, const ObSortOpChunk *r);
+    // compare function for external merge sort, interface required by ObLoserTree
+    int cmp(const ObSortOpChunk *l, const ObSortOpChunk *r, int64_t &cmp_ret);
 
     bool operator()(
         const common::ObIArray<ObExpr*> *l,
@@ -324,6 +329,19 @@ public:
     TO_STRING_EMPTY();
   };
   
+  // the best rows added for one partition of the part topn sort
+  struct PartTopnNode
+  {
+    PartTopnNode() : hash_value_(0), heap_(NULL), cnt_(0), cap_(0), next_(NULL) {}
+    uint64_t hash_value_;
+    // max heap by sort order, the last row kept is on the top
+    ObChunkDatumStore::StoredRow **heap_;
+    int64_t cnt_;
+    int64_t cap_;
+    PartTopnNode *next_;
+    TO_STRING_KV(K_(hash_value), K_(cnt), K_(cap));
+  };
+
   class HashNodeComparer
   {
   public:
@@ -510,6 +528,18 @@ protected:
   bool is_equal_part(const ObChunkDatumStore::StoredRow *l, const ObChunkDatumStore::StoredRow *r);
   int do_partition_sort(common::ObIArray<ObChunkDatumStore::StoredRow *> &rows,
                         const int64_t rows_begin, const int64_t rows_end);
+  int64_t get_part_topn_end(common::ObIArray<ObChunkDatumStore::StoredRow *> &rows,
+                            const int64_t part_begin, const int64_t part_end);
+  // rows after the part_topn_cnt_ best rows added of the same partition are not added
+  int part_topn_need_add(const common::ObIArray<ObExpr*> &exprs, bool &need_add);
+  int part_topn_filter_batch(const common::ObIArray<ObExpr *> &exprs,
+                             const ObBitVector &skip,
+                             const int64_t batch_size,
+                             const int64_t start_pos,
+                             const ObBitVector *&add_skip);
+  int add_part_topn_row(ObChunkDatumStore::StoredRow *sr);
+  int extend_part_topn_buckets();
+  void reset_part_topn_nodes();
   void set_iteration_age(ObChunkDatumStore::IterationAge *iter_age);
   // for topn sort
   int add_heap_sort_row(const common::ObIArray<ObExpr*> &exprs,
@@ -543,9 +573,11 @@ protected:
 
 protected:
   typedef common::ObBinaryHeap<ObChunkDatumStore::StoredRow **, Compare, 16> IMMSHeap;
-  typedef common::ObBinaryHeap<ObSortOpChunk *, Compare, MAX_MERGE_WAYS> EMSHeap;
+  typedef common::ObLoserTree<ObSortOpChunk *, Compare, MAX_MERGE_WAYS> EMSLoserTree;
   typedef common::ObBinaryHeap<ObChunkDatumStore::StoredRow *, Compare> TopnHeap;
   static const int64_t MAX_ROW_CNT = 268435456; // (2G / 8)
+  static const int64_t PART_TOPN_INIT_BUCKET_CNT = 64;
+  static const int64_t PART_TOPN_INIT_HEAP_SIZE = 8;
   static const int64_t STORE_ROW_HEADER_SIZE = sizeof(SortStoredRow);
   static const int64_t STORE_ROW_EXTRA_SIZE = sizeof(uint64_t);
   bool inited_;
@@ -571,8 +603,8 @@ protected:
   bool heap_iter_begin_;
   // heap for in-memory merge sort local order rows
   IMMSHeap *imms_heap_;
-  // heap for external merge sort
-  EMSHeap *ems_heap_;
+  // loser tree for external merge sort
+  EMSLoserTree *ems_heap_;
   NextStoredRowFunc next_stored_row_func_;
   int64_t input_rows_;
   int64_t input_width_;
@@ -591,6 +623,15 @@ protected:
   PartHashNode *part_hash_nodes_;
   uint64_t max_node_cnt_;
   int64_t part_cnt_;
+  int64_t part_topn_cnt_;
+  bool is_part_topn_with_ties_;
+  // per partition heaps of the rows added, rebuilt after each dump
+  PartTopnNode **part_topn_buckets_;
+  int64_t part_topn_bucket_cnt_;
+  int64_t part_topn_node_cnt_;
+  int64_t part_topn_filtered_cnt_;
+  ObBitVector *part_topn_skip_;
+  int64_t part_topn_skip_size_;
   // for limit topn sort change to simple sort
   int64_t topn_cnt_;
   int64_t outputted_rows_cnt_;
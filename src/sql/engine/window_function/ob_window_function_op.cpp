@@ -19,6 +19,7 @@
 #include "sql/engine/ob_physical_plan.h"
 #include "sql/engine/expr/ob_sql_expression.h"
 #include "sql/engine/ob_exec_context.h"
+#include "sql/engine/ob_sql_mem_mgr_processor.h"
 #include "sql/engine/expr/ob_expr_func_ceil.h"
 #include "sql/engine/expr/ob_expr_add.h"
 #include "sql/engine/expr/ob_expr_minus.h"
@@ -34,6 +35,8 @@ using namespace common;
 namespace sql
 {
 const int64_t CHECK_STATUS_INTERVAL = 10000;
+// restart MIN/MAX with extremum tree only when frame is larger than this
+const int64_t EXTREMUM_TREE_MIN_FRAME_ROWS = 16;
 OB_SERIALIZE_MEMBER(WinFuncInfo::ExtBound,
                     is_preceding_,
                     is_unbounded_,
@@ -383,6 +386,97 @@ DEF_TO_STRING(ObWindowFunctionOp::AggrCell)
   return pos;
 }
 
+int ObWindowFunctionOp::ExtremumSegTree::build(ObWindowFunctionOp &op,
+                                               const WinFuncInfo &wf_info,
+                                               const int64_t begin_idx,
+                                               const int64_t end_idx)
+{
+  int ret = OB_SUCCESS;
+  reuse();
+  const int64_t row_cnt = end_idx - begin_idx + 1;
+  ObExpr *param = NULL;
+  bool exceed_limit = false;
+  if (OB_UNLIKELY(row_cnt <= 0 || 1 != wf_info.aggr_info_.param_exprs_.count())
+      || OB_ISNULL(param = wf_info.aggr_info_.param_exprs_.at(0))
+      || OB_ISNULL(wf_info.aggr_info_.expr_)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K(begin_idx), K(end_idx), K(wf_info.aggr_info_));
+  } else if (row_cnt * static_cast<int64_t>(sizeof(ObDatum) + 2 * sizeof(int64_t)) > mem_limit_) {
+    exceed_limit = true;
+  } else {
+    is_max_ = (T_FUN_MAX == wf_info.func_type_);
+    cmp_func_ = wf_info.aggr_info_.expr_->basic_funcs_->null_first_cmp_;
+    if (OB_ISNULL(datums_ = static_cast<ObDatum *>(alloc_.alloc(sizeof(ObDatum) * row_cnt)))
+        || OB_ISNULL(nodes_ = static_cast<int64_t *>(alloc_.alloc(sizeof(int64_t) * 2 * row_cnt)))) {
+      ret = OB_ALLOCATE_MEMORY_FAILED;
+      LOG_WARN("allocate memory failed", K(ret), K(row_cnt));
+    }
+  }
+  const ObRADatumStore::StoredRow *row = NULL;
+  ObDatum *datum = NULL;
+  for (int64_t i = 0; OB_SUCC(ret) && !exceed_limit && i < row_cnt; ++i) {
+    if (OB_FAIL(op.input_rows_.cur_->get_row(begin_idx + i, row))) {
+      LOG_WARN("get row failed", K(ret), K(begin_idx), K(i));
+    } else if (FALSE_IT(op.clear_evaluated_flag())) {
+    } else if (OB_FAIL(row->to_expr(op.get_all_expr(), op.eval_ctx_))) {
+      LOG_WARN("to expr failed", K(ret));
+    } else if (OB_FAIL(param->eval(op.eval_ctx_, datum))) {
+      LOG_WARN("eval param failed", K(ret));
+    } else if (FALSE_IT(new (&datums_[i]) ObDatum())) {
+    } else if (OB_FAIL(datums_[i].deep_copy(*datum, alloc_))) {
+      LOG_WARN("deep copy datum failed", K(ret));
+    } else {
+      nodes_[row_cnt + i] = i;
+      exceed_limit = alloc_.used() > mem_limit_;
+    }
+  }
+  if (OB_FAIL(ret)) {
+    reuse();
+  } else if (exceed_limit) {
+    // remember the skipped rows, restart of this partition scans frame then.
+    reuse();
+    is_skipped_ = true;
+    begin_idx_ = begin_idx;
+    row_cnt_ = row_cnt;
+    LOG_DEBUG("extremum tree exceeds memory limit, skip it", K(*this));
+  } else {
+    row_cnt_ = row_cnt;
+    for (int64_t i = row_cnt - 1; i > 0; --i) {
+      nodes_[i] = pick(nodes_[2 * i], nodes_[2 * i + 1]);
+    }
+    begin_idx_ = begin_idx;
+  }
+  return ret;
+}
+
+int ObWindowFunctionOp::ExtremumSegTree::query(const int64_t head,
+                                               const int64_t tail,
+                                               int64_t &row_idx) const
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(nodes_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("extremum tree not built", K(ret));
+  } else if (OB_UNLIKELY(head < begin_idx_ || tail >= begin_idx_ + row_cnt_ || head > tail)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("frame out of range", K(ret), K(head), K(tail), K(*this));
+  } else {
+    int64_t res = -1;
+    for (int64_t l = head - begin_idx_ + row_cnt_, r = tail - begin_idx_ + row_cnt_ + 1;
+         l < r;
+         l >>= 1, r >>= 1) {
+      if (l & 1) {
+        res = pick(res, nodes_[l++]);
+      }
+      if (r & 1) {
+        res = pick(nodes_[--r], res);
+      }
+    }
+    row_idx = begin_idx_ + res;
+  }
+  return ret;
+}
+
 template <typename OP>
 int ObWindowFunctionOp::foreach_stores(OP op)
 {
@@ -1077,9 +1171,14 @@ int ObWindowFunctionOp::init()
     FuncAllocer func_alloc;
     func_alloc.local_allocator_ = &local_allocator_;
     int64_t prev_pushdown_pby_col_count = -1;
+    int64_t sort_area_size = 0;
     WFInfoFixedArray &wf_infos = *const_cast<WFInfoFixedArray *>(&MY_SPEC.wf_infos_);
     if (OB_FAIL(ObChunkStoreUtil::alloc_dir_id(dir_id_))) {
       LOG_WARN("failed to alloc dir id", K(ret));
+    } else if (OB_FAIL(ObSqlWorkareaUtil::get_workarea_size(
+                SORT_WORK_AREA, tenant_id, sort_area_size))) {
+      LOG_WARN("failed to get workarea size", K(ret), K(tenant_id));
+    } else if (FALSE_IT(extremum_tree_.init(tenant_id, sort_area_size))) {
     } else if (OB_FAIL(curr_row_collect_values_.prepare_allocate(wf_infos.count()))) {
       LOG_WARN("cur row collect values prepare allocate failed", K(ret));
     } else if (MY_SPEC.is_vectorized()) {
@@ -1432,6 +1531,7 @@ int ObWindowFunctionOp::inner_close()
     local_allocator_.free(pby_hash_values_sets_.at(i));
     pby_hash_values_sets_.at(i) = NULL;
   }
+  extremum_tree_.destroy();
   return ObOperator::inner_close();
 }
 
@@ -1443,6 +1543,7 @@ void ObWindowFunctionOp::destroy()
   local_allocator_.~ObArenaAllocator();
   rescan_alloc_.~ObArenaAllocator();
   patch_alloc_.~ObArenaAllocator();
+  extremum_tree_.~ExtremumSegTree();
   ObOperator::destroy();
 }
 
@@ -1626,6 +1727,7 @@ int ObWindowFunctionOp::compute(RowsReader &row_reader, WinFuncCell &wf_cell,
       if (wf_cell.is_aggr()) {
         AggrCell *aggr_func = static_cast<AggrCell *>(&wf_cell);
         const ObRADatumStore::StoredRow *cur_row = NULL;
+        bool use_tree = false;
         if (!Frame::same_frame(last_valid_frame, new_frame)) {
           if (!Frame::need_restart_aggr(aggr_func->can_inv(), last_valid_frame, new_frame,
                                         aggr_func->aggr_processor_.get_removal_info(),
@@ -1690,6 +1792,12 @@ int ObWindowFunctionOp::compute(RowsReader &row_reader, WinFuncCell &wf_cell,
                 }
               }
             }
+          } else if (OB_FAIL(use_extremum_tree(*aggr_func, new_frame, use_tree))) {
+            LOG_WARN("check use extremum tree failed", K(ret), K(new_frame));
+          } else if (use_tree) {
+            if (OB_FAIL(restart_aggr_by_extremum_tree(*aggr_func, new_frame))) {
+              LOG_WARN("restart aggr by extremum tree failed", K(ret), K(new_frame));
+            }
           } else {
             aggr_func->reset_for_restart();
             if (common::REMOVE_EXTRENUM == wf_cell.wf_info_.remove_type_) {
@@ -1755,6 +1863,59 @@ int ObWindowFunctionOp::compute(RowsReader &row_reader, WinFuncCell &wf_cell,
   return ret;
 }
 
+// Build extremum tree for the partition at the first restart of a large frame.
+int ObWindowFunctionOp::use_extremum_tree(const AggrCell &aggr_func,
+                                          const Frame &frame,
+                                          bool &use_tree)
+{
+  int ret = OB_SUCCESS;
+  const int64_t part_begin_idx = aggr_func.part_first_row_idx_;
+  const int64_t part_end_idx = get_part_end_idx();
+  use_tree = false;
+  // rows may be skipped in push down mode, frame position is not row position then.
+  if (common::REMOVE_EXTRENUM != aggr_func.wf_info_.remove_type_
+      || MY_SPEC.is_push_down()
+      || frame.tail_ - frame.head_ + 1 <= EXTREMUM_TREE_MIN_FRAME_ROWS
+      || extremum_tree_.is_skipped(part_begin_idx, part_end_idx)) {
+  } else if (!extremum_tree_.is_built(part_begin_idx, part_end_idx)
+             && OB_FAIL(extremum_tree_.build(*this, aggr_func.wf_info_,
+                                             part_begin_idx, part_end_idx))) {
+    LOG_WARN("build extremum tree failed", K(ret), K(part_begin_idx), K(part_end_idx));
+  } else {
+    use_tree = extremum_tree_.is_built(part_begin_idx, part_end_idx);
+  }
+  return ret;
+}
+
+// Restart MIN/MAX aggregation with the extremum row of frame only, the result is the
+// same as aggregating all rows of frame. Later frames still slide incrementally and
+// come back here when the extremum slides out.
+int ObWindowFunctionOp::restart_aggr_by_extremum_tree(AggrCell &aggr_func, const Frame &frame)
+{
+  int ret = OB_SUCCESS;
+  const ObRADatumStore::StoredRow *row = NULL;
+  int64_t idx = -1;
+  if (OB_FAIL(extremum_tree_.query(frame.head_, frame.tail_, idx))) {
+    LOG_WARN("query extremum tree failed", K(ret), K(frame));
+  } else if (OB_FAIL(input_rows_.cur_->get_row(idx, row))) {
+    LOG_WARN("get row failed", K(ret), K(idx));
+  } else if (FALSE_IT(clear_evaluated_flag())) {
+  } else if (OB_FAIL(row->to_expr(get_all_expr(), eval_ctx_))) {
+    LOG_WARN("to expr failed", K(ret));
+  } else {
+    aggr_func.reset_for_restart();
+    if (OB_FAIL(aggr_func.trans(*row))) {
+      LOG_WARN("trans failed", K(ret));
+    } else {
+      RemovalInfo &removal_info = aggr_func.aggr_processor_.get_removal_info();
+      removal_info.max_min_index_ = idx;
+      removal_info.is_index_change_ = false;
+      LOG_DEBUG("restart agg by extremum tree", K(frame), K(idx), K_(extremum_tree));
+    }
+  }
+  return ret;
+}
+
 bool ObWindowFunctionOp::skip_calc(const int64_t wf_idx)
 {
   bool bret = false;
@@ -3065,6 +3226,7 @@ int ObWindowFunctionOp::compute_wf_values(const WinFuncCell *end, int64_t &check
   int64_t prev_wf_pby_expr_count = -1; // prev_wf_pby_expr_count transmit to datahub
   for (WinFuncCell *wf = first; OB_SUCC(ret) && wf != end; wf = wf->get_next()) {
     wf->reset_for_restart();
+    extremum_tree_.reuse();
     ObDatum result_datum;
     RowsReader row_reader(*input_rows_.cur_);
     if (wf == wf_list_.get_last()) {
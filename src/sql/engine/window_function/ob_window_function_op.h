@@ -553,6 +553,91 @@ public:
     Frame last_valid_frame_;
   };
 
+  // Segment tree of MIN/MAX over rows of current partition, leaf is the param value of
+  // one row and inner node is the position of extremum of its children.
+  // It answers extremum row of any frame in O(log n) comparisons, used to restart MIN/MAX
+  // aggregation when extremum slides out of frame instead of scanning the whole frame.
+  // Only one tree lives in the operator, it is rebuilt for each window function and
+  // partition, and skipped if the partition needs more memory than the sort work area.
+  class ExtremumSegTree
+  {
+  public:
+    ExtremumSegTree()
+      : alloc_(), mem_limit_(0), is_max_(false), is_skipped_(false), cmp_func_(NULL),
+        begin_idx_(-1), row_cnt_(0), datums_(NULL), nodes_(NULL)
+    {}
+    ~ExtremumSegTree() { destroy(); }
+    void init(const uint64_t tenant_id, const int64_t mem_limit)
+    {
+      alloc_.set_tenant_id(tenant_id);
+      alloc_.set_label("WfExtremumTree");
+      alloc_.set_ctx_id(common::ObCtxIds::WORK_AREA);
+      mem_limit_ = mem_limit;
+    }
+    // build on rows [begin_idx, end_idx] of `op.input_rows_.cur_`, the tree is skipped
+    // for these rows if it exceeds the memory limit.
+    int build(ObWindowFunctionOp &op, const WinFuncInfo &wf_info,
+              const int64_t begin_idx, const int64_t end_idx);
+    // get row idx of extremum in [head, tail], null values are ignored unless all are null.
+    int query(const int64_t head, const int64_t tail, int64_t &row_idx) const;
+    bool is_built(const int64_t begin_idx, const int64_t end_idx) const
+    {
+      return NULL != nodes_ && begin_idx_ == begin_idx && begin_idx_ + row_cnt_ - 1 == end_idx;
+    }
+    bool is_skipped(const int64_t begin_idx, const int64_t end_idx) const
+    {
+      return is_skipped_ && begin_idx_ == begin_idx && begin_idx_ + row_cnt_ - 1 == end_idx;
+    }
+    void reuse()
+    {
+      is_skipped_ = false;
+      begin_idx_ = -1;
+      row_cnt_ = 0;
+      datums_ = NULL;
+      nodes_ = NULL;
+      alloc_.reset_remain_one_page();
+    }
+    void destroy()
+    {
+      reuse();
+      alloc_.reset();
+    }
+    TO_STRING_KV(K_(is_max), K_(is_skipped), K_(begin_idx), K_(row_cnt), K_(mem_limit),
+                 "used", alloc_.used());
+  private:
+    // position of extremum of two positions, the latter one wins if equal.
+    OB_INLINE int64_t pick(const int64_t l, const int64_t r) const
+    {
+      int64_t res = l;
+      if (l < 0) {
+        res = r;
+      } else if (r < 0 || datums_[r].is_null()) {
+        res = l;
+      } else if (datums_[l].is_null()) {
+        res = r;
+      } else {
+        const int cmp = cmp_func_(datums_[l], datums_[r]);
+        if (0 == cmp) {
+          res = std::max(l, r);
+        } else {
+          res = (is_max_ == (cmp > 0)) ? l : r;
+        }
+      }
+      return res;
+    }
+  private:
+    common::ObArenaAllocator alloc_;
+    int64_t mem_limit_;
+    bool is_max_;
+    bool is_skipped_;
+    ObExprCmpFuncType cmp_func_;
+    int64_t begin_idx_;
+    int64_t row_cnt_;
+    common::ObDatum *datums_;
+    // nodes_[row_cnt_ + i] is leaf of row i, nodes_[1] is root
+    int64_t *nodes_;
+  };
+
   class AggrCell : public WinFuncCell
   {
   public:
@@ -811,6 +896,8 @@ protected:
   int compute(RowsReader &row_reader, WinFuncCell &wf_cell, const int64_t row_idx,
               common::ObDatum &val);
   int compute_push_down_by_pass(WinFuncCell &wf_cell, common::ObDatum &val);
+  int use_extremum_tree(const AggrCell &aggr_func, const Frame &frame, bool &use_tree);
+  int restart_aggr_by_extremum_tree(AggrCell &aggr_func, const Frame &frame);
   int check_same_partition(const ExprFixedArray &other_exprs,
                            bool &is_same_part,
                            const ExprFixedArray *curr_exprs = NULL);
@@ -930,6 +1017,8 @@ private:
 
   ObRDWFPartialInfo *rd_patch_;
   common::ObArenaAllocator patch_alloc_;
+  // extremum tree of the window function being computed
+  ExtremumSegTree extremum_tree_;
 
   bool first_part_outputed_;
   bool patch_first_;
@@ -6513,11 +6513,21 @@ int ObJoinOrder::generate_subquery_paths(PathHelper &helper)
   } else if (OB_FAIL(log_plan->add_pushdown_filters(helper.pushdown_filters_))) {
     LOG_WARN("failed to add pushdown filters", K(ret));
   } else {
+    ObWinFunRawExpr *win_topn_expr = NULL;
+    ObRawExpr *topn_expr = NULL;
+    if (child_stmt->is_select_stmt() &&
+        OB_FAIL(extract_window_topn_filter(*helper.child_stmt_, helper.filters_,
+                                           win_topn_expr, topn_expr))) {
+      LOG_WARN("failed to extract window topn filter", K(ret));
+    } else {
+      log_plan->set_window_topn(win_topn_expr, topn_expr);
+    }
     log_plan->set_is_subplan_scan(true);
     if (parent_stmt->is_insert_stmt()) {
       log_plan->set_insert_stmt(static_cast<const ObInsertStmt*>(parent_stmt));
     }
-    if (OB_FAIL(log_plan->generate_raw_plan())) {
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(log_plan->generate_raw_plan())) {
       LOG_WARN("failed to optimize sub-select", K(ret));
     } else if (OB_FAIL(log_plan->get_candidate_plans().get_best_plan(best_child_plan))) {
       LOG_WARN("failed to get best plan", K(ret));
@@ -6580,6 +6590,103 @@ int ObJoinOrder::generate_subquery_paths(PathHelper &helper)
   return ret;
 }
 
+int ObJoinOrder::extract_window_topn_filter(const ObSelectStmt &child_stmt,
+                                            const ObIArray<ObRawExpr*> &filters,
+                                            ObWinFunRawExpr *&win_expr,
+                                            ObRawExpr *&topn_expr)
+{
+  int ret = OB_SUCCESS;
+  bool has_rownum = false;
+  win_expr = NULL;
+  topn_expr = NULL;
+  if (!child_stmt.has_window_function() || child_stmt.is_set_stmt() ||
+      child_stmt.is_hierarchical_query() || child_stmt.has_limit() ||
+      child_stmt.has_distinct() || child_stmt.has_sequence()) {
+    // rows filtered by window topn may affect the result of these operators
+  } else if (OB_FAIL(child_stmt.has_rownum(has_rownum))) {
+    LOG_WARN("failed to check stmt has rownum", K(ret));
+  } else if (has_rownum) {
+    // do nothing
+  } else {
+    for (int64_t i = 0; OB_SUCC(ret) && NULL == win_expr && i < filters.count(); ++i) {
+      ObRawExpr *filter = filters.at(i);
+      ObRawExpr *col_expr = NULL;
+      ObRawExpr *limit_expr = NULL;
+      if (OB_ISNULL(filter)) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("get unexpected null", K(ret));
+      } else if (2 != filter->get_param_count()) {
+        // do nothing
+      } else if (T_OP_LE == filter->get_expr_type() || T_OP_EQ == filter->get_expr_type()) {
+        col_expr = filter->get_param_expr(0);
+        limit_expr = filter->get_param_expr(1);
+      } else if (T_OP_GE == filter->get_expr_type()) {
+        col_expr = filter->get_param_expr(1);
+        limit_expr = filter->get_param_expr(0);
+      }
+      if (OB_FAIL(ret) || OB_ISNULL(col_expr) || OB_ISNULL(limit_expr)) {
+        // do nothing
+      } else if (!col_expr->is_column_ref_expr() ||
+                 static_cast<ObColumnRefRawExpr*>(col_expr)->get_table_id() != table_id_ ||
+                 !limit_expr->is_static_const_expr() ||
+                 ObIntTC != limit_expr->get_result_type().get_type_class()) {
+        // do nothing
+      } else {
+        int64_t idx = static_cast<ObColumnRefRawExpr*>(col_expr)->get_column_id()
+                      - OB_APP_MIN_COLUMN_ID;
+        ObRawExpr *sel_expr = NULL;
+        if (idx < 0 || idx >= child_stmt.get_select_item_size()) {
+          // do nothing
+        } else if (OB_ISNULL(sel_expr = child_stmt.get_select_item(idx).expr_)) {
+          ret = OB_ERR_UNEXPECTED;
+          LOG_WARN("get unexpected null", K(ret));
+        } else if (!sel_expr->is_win_func_expr()) {
+          // do nothing
+        } else if (is_window_topn_valid(child_stmt, *static_cast<ObWinFunRawExpr*>(sel_expr))) {
+          win_expr = static_cast<ObWinFunRawExpr*>(sel_expr);
+          topn_expr = limit_expr;
+          LOG_TRACE("find window topn filter", K(table_id_), KPC(filter));
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+// rows after the top n of each partition can be discarded before computing window functions
+// only if all window functions are ranking functions of the same window.
+// DENSE_RANK <= n may return more than n rows of a partition, can not be the topn filter.
+bool ObJoinOrder::is_window_topn_valid(const ObSelectStmt &child_stmt,
+                                       const ObWinFunRawExpr &win_expr)
+{
+  bool is_valid = T_WIN_FUN_ROW_NUMBER == win_expr.get_func_type() ||
+                  T_WIN_FUN_RANK == win_expr.get_func_type();
+  const ObIArray<ObWinFunRawExpr*> &win_exprs = child_stmt.get_window_func_exprs();
+  for (int64_t i = 0; is_valid && i < win_exprs.count(); ++i) {
+    const ObWinFunRawExpr *cur_expr = win_exprs.at(i);
+    if (OB_ISNULL(cur_expr)) {
+      is_valid = false;
+    } else if (cur_expr == &win_expr) {
+      // do nothing
+    } else if (T_WIN_FUN_ROW_NUMBER != cur_expr->get_func_type() &&
+               T_WIN_FUN_RANK != cur_expr->get_func_type() &&
+               T_WIN_FUN_DENSE_RANK != cur_expr->get_func_type()) {
+      is_valid = false;
+    } else if (!ObOptimizerUtil::same_exprs(cur_expr->get_partition_exprs(),
+                                            win_expr.get_partition_exprs()) ||
+               cur_expr->get_order_items().count() != win_expr.get_order_items().count()) {
+      is_valid = false;
+    } else {
+      for (int64_t j = 0; is_valid && j < win_expr.get_order_items().count(); ++j) {
+        const OrderItem &l = cur_expr->get_order_items().at(j);
+        const OrderItem &r = win_expr.get_order_items().at(j);
+        is_valid = l.expr_ == r.expr_ && l.order_type_ == r.order_type_;
+      }
+    }
+  }
+  return is_valid;
+}
+
 // generate physical property for each subquery path, including ordering, sharding
 int ObJoinOrder::compute_subquery_path_property(const uint64_t table_id,
                                                  ObLogicalOperator *root,
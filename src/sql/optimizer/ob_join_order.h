@@ -1586,6 +1586,14 @@ struct NullAwareAntiJoinInfo {
 
     int generate_subquery_paths(PathHelper &helper);
 
+    // find `rn <= n` filter on ROW_NUMBER/RANK of subquery, only top n rows of each
+    // window partition are needed then.
+    int extract_window_topn_filter(const ObSelectStmt &child_stmt,
+                                   const ObIArray<ObRawExpr*> &filters,
+                                   ObWinFunRawExpr *&win_expr,
+                                   ObRawExpr *&topn_expr);
+    bool is_window_topn_valid(const ObSelectStmt &child_stmt, const ObWinFunRawExpr &win_expr);
+
     // generate physical property for each subquery path, including ordering, sharding
     int compute_subquery_path_property(const uint64_t table_id,
                                        ObLogicalOperator *root,
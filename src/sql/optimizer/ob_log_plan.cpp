@@ -123,6 +123,8 @@ ObLogPlan::ObLogPlan(ObOptimizerContext &ctx, const ObDMLStmt *stmt)
     max_op_id_(OB_INVALID_ID),
     is_subplan_scan_(false),
     is_parent_set_distinct_(false),
+    window_topn_win_expr_(NULL),
+    window_topn_expr_(NULL),
     temp_table_info_(NULL),
     const_exprs_(),
     hash_dist_info_(),
@@ -1155,6 +1155,15 @@ public:
     return pushdown_filters_;
   }
 
+  // `rn <= n` filter of parent stmt on a ranking window function of this subquery
+  inline void set_window_topn(ObWinFunRawExpr *win_expr, ObRawExpr *topn_expr)
+  {
+    window_topn_win_expr_ = win_expr;
+    window_topn_expr_ = topn_expr;
+  }
+  inline ObWinFunRawExpr *get_window_topn_win_expr() const { return window_topn_win_expr_; }
+  inline ObRawExpr *get_window_topn_expr() const { return window_topn_expr_; }
+
   int init_onetime_subquery_info();
 
   int extract_onetime_subquery(ObRawExpr *expr,
@@ -1824,6 +1833,8 @@ private:
   uint64_t max_op_id_;
   bool is_subplan_scan_;  // 当前plan是否是一个subplan scan
   bool is_parent_set_distinct_;
+  ObWinFunRawExpr *window_topn_win_expr_;
+  ObRawExpr *window_topn_expr_;
   ObSqlTempTableInfo *temp_table_info_; // current plan is a temp table
   // 从where condition中抽出的常量表达式
   common::ObSEArray<ObRawExpr*, 4, common::ModulePageAllocator, true> const_exprs_;
@@ -98,6 +98,8 @@ int ObLogSort::get_op_exprs(ObIArray<ObRawExpr*> &all_exprs)
     LOG_WARN("failed to push back expr", K(ret));
   } else if (NULL != topk_offset_expr_ && OB_FAIL(all_exprs.push_back(topk_offset_expr_))) {
     LOG_WARN("failed to push back expr", K(ret));
+  } else if (NULL != part_topn_expr_ && OB_FAIL(all_exprs.push_back(part_topn_expr_))) {
+    LOG_WARN("failed to push back expr", K(ret));
   } else if (OB_FAIL(ObOptimizerUtil::check_can_encode_sortkey(sort_keys_,
                               can_sort_opt, *get_plan(), child->get_card()))) {
     LOG_WARN("failed to check encode sortkey expr", K(ret));
@@ -147,7 +149,9 @@ int ObLogSort::get_op_exprs(ObIArray<ObRawExpr*> &all_exprs)
 uint64_t ObLogSort::hash(uint64_t seed) const
 {
   bool is_topn = NULL != topn_expr_;
+  bool is_part_topn = NULL != part_topn_expr_;
   seed = do_hash(is_topn, seed);
+  seed = do_hash(is_part_topn, seed);
   seed = ObLogicalOperator::hash(seed);
 
   return seed;
@@ -199,6 +203,10 @@ int ObLogSort::get_plan_item_info(PlanText &plan_text,
   if (OB_SUCC(ret) && is_local_merge_sort_) {
     BUF_PRINTF(", local merge sort");
   }
+  if (OB_SUCC(ret) && (EXPLAIN_EXTENDED == type || EXPLAIN_EXTENDED_NOADDR == type)
+      && enable_encode_sortkey_opt()) {
+    BUF_PRINTF(", encoded");
+  }
   // this will be opened later, when newsort enabled by default
   //if (OB_SUCC(ret) && !enable_encode_sortkey_opt()) {
   //  BUF_PRINTF(", not encoded");
@@ -206,6 +214,14 @@ int ObLogSort::get_plan_item_info(PlanText &plan_text,
   if (OB_SUCC(ret) && is_fetch_with_ties_) {
     BUF_PRINTF(", with_ties(true)");
   }
+  if (OB_SUCC(ret) && NULL != part_topn_expr_) {
+    ObRawExpr *part_topn = part_topn_expr_;
+    BUF_PRINTF(", ");
+    EXPLAIN_PRINT_EXPR(part_topn, type);
+    if (is_part_topn_with_ties_) {
+      BUF_PRINTF(", part_topn_with_ties(true)");
+    }
+  }
   END_BUF_PRINT(plan_item.special_predicates_,
                 plan_item.special_predicates_len_);
   return ret;
@@ -224,6 +240,9 @@ int ObLogSort::inner_replace_op_exprs(
   } else if (NULL != topk_offset_expr_ &&
              OB_FAIL(replace_expr_action(to_replace_exprs, topk_offset_expr_))) {
     LOG_WARN("failed to replace topk offset expr", K(ret));
+  } else if (NULL != part_topn_expr_ &&
+             OB_FAIL(replace_expr_action(to_replace_exprs, part_topn_expr_))) {
+    LOG_WARN("failed to replace part topn expr", K(ret));
   }
   for(int64_t i = 0; OB_SUCC(ret) && i < N; ++i) {
     OrderItem &cur_order_item = sort_keys_.at(i);
@@ -369,6 +388,8 @@ int ObLogSort::inner_est_cost(double child_card, double &double_topn_count, doub
   int ret = OB_SUCCESS;
   int64_t parallel = 0;
   int64_t topn_count = -1;
+  int64_t part_topn_count = -1;
+  double part_topn_card = -1;
   bool is_null_value = false;
   double_topn_count = -1;
   ObLogicalOperator *child = get_child(ObLogicalOperator::first_child);
@@ -388,6 +409,14 @@ int ObLogSort::inner_est_cost(double child_card, double &double_topn_count, doub
                                                        topn_count,
                                                        is_null_value))) {
     LOG_WARN("failed to get value", K(ret));
+  } else if (NULL != part_topn_expr_ &&
+             OB_FAIL(ObTransformUtils::get_limit_value(part_topn_expr_,
+                                                       get_plan()->get_optimizer_context().get_params(),
+                                                       get_plan()->get_optimizer_context().get_exec_ctx(),
+                                                       &get_plan()->get_optimizer_context().get_allocator(),
+                                                       part_topn_count,
+                                                       is_null_value))) {
+    LOG_WARN("failed to get part topn value", K(ret));
   } else {
     if (NULL != topn_expr_) {
       double_topn_count = std::min(static_cast<double>(topn_count), child_card);
@@ -402,9 +431,54 @@ int ObLogSort::inner_est_cost(double child_card, double &double_topn_count, doub
                              &get_plan()->get_update_table_metas(),
                              &get_plan()->get_selectivity_ctx(),
                              double_topn_count,
-                             part_cnt_);
+                             part_cnt_,
+                             NULL == part_topn_expr_ ? -1 : std::max(0L, part_topn_count));
     if (OB_FAIL(ObOptEstCost::cost_sort(cost_info, op_cost, opt_ctx.get_cost_model_type()))) {
       LOG_WARN("failed to calc cost", K(ret), K(child->get_type()));
+    } else if (NULL != part_topn_expr_ &&
+               OB_FAIL(est_part_topn_card(child_card, std::max(0L, part_topn_count), part_topn_card))) {
+      LOG_WARN("failed to est part topn card", K(ret));
+    } else if (part_topn_card >= 0) {
+      double_topn_count = part_topn_card;
+    }
+  }
+  return ret;
+}
+
+// the rows of a partition are on one worker if repartitioned by the partition keys below,
+// otherwise every worker keeps the top n rows of each partition it meets
+int ObLogSort::est_part_topn_card(const double child_card,
+                                  const int64_t part_topn_count,
+                                  double &part_topn_card)
+{
+  int ret = OB_SUCCESS;
+  ObSEArray<ObRawExpr*, 4> part_exprs;
+  ObLogicalOperator *child = get_child(ObLogicalOperator::first_child);
+  double part_ndv = 0.0;
+  part_topn_card = child_card;
+  if (OB_ISNULL(child) || OB_ISNULL(get_plan())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("get unexpected null", K(ret), K(child), K(get_plan()));
+  } else {
+    const int64_t parallel = std::max(1L, get_parallel());
+    const bool is_repart = 1 == parallel || log_op_def::LOG_EXCHANGE == child->get_type();
+    const double worker_card = is_repart ? child_card : child_card / parallel;
+    for (int64_t i = 0; OB_SUCC(ret) && i < part_cnt_ && i < sort_keys_.count(); ++i) {
+      if (OB_FAIL(part_exprs.push_back(sort_keys_.at(i).expr_))) {
+        LOG_WARN("failed to push back expr", K(ret));
+      }
+    }
+    if (OB_FAIL(ret) || part_exprs.empty()) {
+    } else if (OB_FAIL(ObOptSelectivity::calculate_distinct(get_plan()->get_update_table_metas(),
+                                                            get_plan()->get_selectivity_ctx(),
+                                                            part_exprs,
+                                                            worker_card,
+                                                            part_ndv))) {
+      LOG_WARN("failed to calculate distinct", K(ret));
+    } else {
+      part_topn_card = std::min(child_card, part_ndv * part_topn_count * (is_repart ? 1 : parallel));
+      LOG_TRACE("est part topn card", K(child_card), K(part_ndv), K(part_topn_count),
+                K(parallel), K(is_repart), K(part_topn_card));
     }
   }
   return ret;
@@ -37,7 +37,9 @@ namespace sql
           topk_limit_expr_(NULL),
           topk_offset_expr_(NULL),
           is_fetch_with_ties_(false),
-          part_cnt_(0)
+          part_cnt_(0),
+          part_topn_expr_(NULL),
+          is_part_topn_with_ties_(false)
     {}
     virtual ~ObLogSort()
     {}
@@ -45,6 +47,9 @@ namespace sql
     virtual int est_width() override;
     virtual int re_est_cost(EstimateCostInfo &param, double &card, double &cost) override;
     int inner_est_cost(double child_card, double &topn_count, double &op_cost);
+    int est_part_topn_card(const double child_card,
+                           const int64_t part_topn_count,
+                           double &part_topn_card);
     const OrderItem &get_hash_sortkey() const { return hash_sortkey_; }
     OrderItem &get_hash_sortkey() { return hash_sortkey_; }
     inline void set_hash_sortkey(const OrderItem &hash_sortkey) { hash_sortkey_ = hash_sortkey; }
@@ -61,6 +66,11 @@ namespace sql
     inline void set_local_merge_sort(bool is_local_merge_sort) { is_local_merge_sort_ = is_local_merge_sort; }
     inline void set_fetch_with_ties(bool is_fetch_with_ties) { is_fetch_with_ties_ = is_fetch_with_ties; }
     inline void set_part_cnt(uint64_t part_cnt) { part_cnt_ = part_cnt; }
+    inline void set_part_topn(ObRawExpr *expr, bool with_ties)
+    {
+      part_topn_expr_ = expr;
+      is_part_topn_with_ties_ = with_ties;
+    }
 
     // check if the current sort is a pushed down
     inline bool is_prefix_sort() const { return prefix_pos_ != 0; }
@@ -71,6 +81,8 @@ namespace sql
     inline int64_t get_part_cnt() const { return part_cnt_; }
     inline int64_t get_prefix_pos() const { return prefix_pos_; }
     inline ObRawExpr *get_topn_expr() const { return topn_expr_; }
+    inline ObRawExpr *get_part_topn_expr() const { return part_topn_expr_; }
+    inline bool is_part_topn_with_ties() const { return is_part_topn_with_ties_; }
     inline void set_topk_limit_expr(ObRawExpr *top_limit_expr)
     {
       topk_limit_expr_ = top_limit_expr;
@@ -115,6 +127,9 @@ namespace sql
     ObRawExpr *topk_offset_expr_;
     bool is_fetch_with_ties_;
     int64_t part_cnt_;
+    // rows kept for each partition of partition sort, pushed down from `rn <= n` filter
+    ObRawExpr *part_topn_expr_;
+    bool is_part_topn_with_ties_;
   };
 } // end of namespace sql
 } // end of namespace oceanbase
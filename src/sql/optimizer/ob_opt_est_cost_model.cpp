@@ -589,12 +589,24 @@ int ObOptEstCostModel::cost_part_sort(const ObSortCostInfo &cost_info,
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("negative cost", K(comp_cost), K(ret));
       } else {
-        real_sort_cost = rows * LOG2(rows / distinct_parts) * comp_cost;
-        material_cost = cost_material(rows, width) + cost_read_materialized(rows);
+        // with part topn, every row is compared with the top n rows of its partition, and
+        // at most n rows of each partition are materialized and sorted
+        double sort_rows = rows;
+        double check_cost = 0.0;
+        if (cost_info.part_topn_ >= 0) {
+          sort_rows = std::min(rows, distinct_parts * cost_info.part_topn_);
+          check_cost = cost_info.part_topn_ < 1.0 ? 0.0 : rows * LOG2(cost_info.part_topn_) * comp_cost;
+        }
+        real_sort_cost = check_cost;
+        if (sort_rows > distinct_parts) {
+          real_sort_cost += sort_rows * LOG2(sort_rows / distinct_parts) * comp_cost;
+        }
+        material_cost = cost_material(sort_rows, width) + cost_read_materialized(sort_rows);
         calc_hash_cost = cost_hash(rows, part_exprs) + rows * cost_params_.BUILD_HASH_PER_ROW_COST / 2.0;
         cost = real_sort_cost + material_cost + calc_hash_cost;
         LOG_TRACE("OPT: [COST HASH SORT]", K(cost), K(real_sort_cost), K(calc_hash_cost),
-                  K(material_cost), K(rows), K(width), K(cost_info.part_cnt_));
+                  K(material_cost), K(rows), K(sort_rows), K(width), K(cost_info.part_cnt_),
+                  K(cost_info.part_topn_));
       }
     }
   }
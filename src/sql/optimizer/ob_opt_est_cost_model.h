@@ -464,7 +464,8 @@ struct ObSortCostInfo
                  OptTableMetas *table_metas = NULL,
                  OptSelectivityCtx *sel_ctx = NULL,
                  double topn = -1,
-                 int64_t part_cnt = 0)
+                 int64_t part_cnt = 0,
+                 double part_topn = -1)
   : rows_(rows),
     width_(width),
     prefix_pos_(prefix_pos),
@@ -473,10 +474,11 @@ struct ObSortCostInfo
     table_metas_(table_metas),
     sel_ctx_(sel_ctx),
     topn_(topn),
-    part_cnt_(part_cnt)
+    part_cnt_(part_cnt),
+    part_topn_(part_topn)
   {}
   TO_STRING_KV(K_(rows), K_(width), K_(prefix_pos), K_(order_items),
-               K_(is_local_merge_sort), K_(topn), K_(part_cnt));
+               K_(is_local_merge_sort), K_(topn), K_(part_cnt), K_(part_topn));
   double rows_;
   double width_;
   // not prefix sort if prefix_pos_ <= 0
@@ -490,6 +492,8 @@ struct ObSortCostInfo
   double topn_;
   // not hash_based sort if part_cnt <= 0
   int64_t part_cnt_;
+  // rows kept for each partition of hash_based sort, keep all if part_topn_ < 0
+  double part_topn_;
 };
 
 struct ObDelUpCostInfo
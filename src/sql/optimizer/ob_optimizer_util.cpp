@@ -8099,6 +8099,9 @@ int ObOptimizerUtil::check_can_encode_sortkey(const common::ObIArray<OrderItem>
   bool has_hint = false;
   can_sort_opt = true;
   bool old_can_opt = false;
+  // string key with non binary collation is compared by weight in every comparison,
+  // encoding it into sort key once pays off even for narrow keys and small input.
+  bool has_collation_key = false;
   const ObOptParamHint opt_params = plan.get_optimizer_context().get_global_hint().opt_params_;
   if (OB_FAIL(opt_params.has_opt_param(ObOptParamHint::ENABLE_NEWSORT, has_hint))) {
     LOG_WARN("failed to check whether has hint param", K(ret));
@@ -8116,7 +8119,11 @@ int ObOptimizerUtil::check_can_encode_sortkey(const common::ObIArray<OrderItem>
         can_sort_opt = false;
       } else if (OB_FAIL(sort_keys.push_back(order_keys.at(i).expr_))) {
         LOG_WARN("failed to add sort key expr", K(ret));
-      } else { /* do nothing */ }
+      } else if (ob_is_string_tc(order_keys.at(i).expr_->get_data_type())
+                 && ObCharset::is_valid_collation(order_keys.at(i).expr_->get_collation_type())
+                 && !ObCharset::is_bin_sort(order_keys.at(i).expr_->get_collation_type())) {
+        has_collation_key = true;
+      }
     }
     old_can_opt = can_sort_opt;
 
@@ -8132,6 +8139,8 @@ int ObOptimizerUtil::check_can_encode_sortkey(const common::ObIArray<OrderItem>
       LOG_WARN("failed to estimate width for output join column exprs", K(ret));
     } else if (avg_len > 256) {
       can_sort_opt = false;
+    } else if (has_collation_key) {
+      can_sort_opt = card >= GCONF._newsort_collation_key_min_rows;
     } else if (avg_len < 64 && card < 100000) {
       can_sort_opt = false;
     } else if (avg_len > 64 && avg_len < 128 && card < 1500000 ) {
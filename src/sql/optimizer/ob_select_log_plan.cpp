@@ -5214,6 +5214,103 @@ int ObSelectLogPlan::split_winfuncs_by_dist_method(
   return ret;
 }
 
+// `rn <= n` filter of parent stmt is pushed into partition sort of the window function,
+// see ObJoinOrder::extract_window_topn_filter
+int ObSelectLogPlan::get_window_part_topn(const ObIArray<ObWinFunRawExpr*> &winfunc_exprs,
+                                          ObRawExpr *&part_topn_expr,
+                                          bool &with_ties)
+{
+  int ret = OB_SUCCESS;
+  ObWinFunRawExpr *win_expr = get_window_topn_win_expr();
+  part_topn_expr = NULL;
+  with_ties = false;
+  if (NULL == win_expr || NULL == get_window_topn_expr()) {
+    // do nothing
+  } else if (ObOptimizerUtil::find_item(winfunc_exprs, win_expr)) {
+    part_topn_expr = get_window_topn_expr();
+    with_ties = T_WIN_FUN_RANK == win_expr->get_func_type();
+  }
+  return ret;
+}
+
+int ObSelectLogPlan::set_sort_part_topn(ObLogicalOperator *top,
+                                        ObRawExpr *part_topn_expr,
+                                        const bool with_ties)
+{
+  int ret = OB_SUCCESS;
+  if (OB_ISNULL(top) || OB_ISNULL(part_topn_expr)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("get unexpected null", K(ret), K(top), K(part_topn_expr));
+  } else if (log_op_def::LOG_SORT != top->get_type() ||
+             !static_cast<ObLogSort*>(top)->is_part_sort()) {
+    // do nothing
+  } else if (OB_FALSE_IT(static_cast<ObLogSort*>(top)->set_part_topn(part_topn_expr, with_ties))) {
+  } else if (OB_FAIL(top->est_cost())) {
+    LOG_WARN("failed to est cost", K(ret));
+  }
+  return ret;
+}
+
+// the pre-filter sort is allocated only if it costs less than repartitioning the rows it filters
+int ObSelectLogPlan::allocate_part_topn_pre_sort_as_top(ObLogicalOperator *&top,
+                                                        const ObIArray<OrderItem> &sort_keys,
+                                                        OrderItem &hash_sortkey,
+                                                        const ObExchangeInfo &exch_info,
+                                                        ObRawExpr *part_topn_expr,
+                                                        const bool with_ties)
+{
+  int ret = OB_SUCCESS;
+  ObLogicalOperator *pre_sort = top;
+  ObSEArray<OrderItem, 1> dummy_sort_keys;
+  double origin_exch_cost = 0.0;
+  double filtered_exch_cost = 0.0;
+  if (OB_ISNULL(top) || OB_ISNULL(part_topn_expr)) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("get unexpected null", K(ret), K(top), K(part_topn_expr));
+  } else if (OB_FAIL(allocate_sort_as_top(pre_sort,
+                                          sort_keys,
+                                          0, /* prefix_pos */
+                                          false, /* is_local_order */
+                                          NULL, /* topn_expr */
+                                          false, /* is_fetch_with_ties */
+                                          &hash_sortkey))) {
+    LOG_WARN("failed to allocate pre-filter sort as top", K(ret));
+  } else if (OB_FAIL(set_sort_part_topn(pre_sort, part_topn_expr, with_ties))) {
+    LOG_WARN("failed to set sort part topn", K(ret));
+  } else {
+    ObExchCostInfo origin_exch_info(top->get_card(),
+                                    top->get_width(),
+                                    exch_info.dist_method_,
+                                    top->get_parallel(),
+                                    top->get_parallel(),
+                                    false, /* is_local_order */
+                                    dummy_sort_keys,
+                                    top->get_server_cnt());
+    ObExchCostInfo filtered_exch_info(pre_sort->get_card(),
+                                      top->get_width(),
+                                      exch_info.dist_method_,
+                                      top->get_parallel(),
+                                      top->get_parallel(),
+                                      false, /* is_local_order */
+                                      dummy_sort_keys,
+                                      top->get_server_cnt());
+    if (OB_FAIL(ObOptEstCost::cost_exchange(origin_exch_info,
+                                            origin_exch_cost,
+                                            get_optimizer_context().get_cost_model_type()))) {
+      LOG_WARN("failed to cost exchange", K(ret));
+    } else if (OB_FAIL(ObOptEstCost::cost_exchange(filtered_exch_info,
+                                                   filtered_exch_cost,
+                                                   get_optimizer_context().get_cost_model_type()))) {
+      LOG_WARN("failed to cost exchange", K(ret));
+    } else if (pre_sort->get_op_cost() + filtered_exch_cost < origin_exch_cost) {
+      top = pre_sort;
+    }
+    LOG_TRACE("cost part topn pre-filter sort", K(top->get_card()), K(pre_sort->get_card()),
+              K(pre_sort->get_op_cost()), K(origin_exch_cost), K(filtered_exch_cost));
+  }
+  return ret;
+}
+
 /**
  * @brief 假设 winfunc_exprs 都采用 sort_keys 进行排序
  * 同一个分组中的 win_expr 应该按照一定的顺序排序 (`adjust_window_functions()`)
@@ -5475,10 +5572,17 @@ int ObSelectLogPlan::create_hash_window_function_plan(ObLogicalOperator *&top,
   bool is_partition_wise = false;
   const int64_t range_dist_keys_cnt = 0;
   const int64_t range_dist_pby_prefix = 0;
+  ObRawExpr *part_topn_expr = NULL;
+  bool part_topn_with_ties = false;
   LOG_DEBUG("create hash window function plan", K(part_cnt), K(sort_keys), K(adjusted_winfunc_exprs));
   if (OB_ISNULL(top) || OB_UNLIKELY(partition_exprs.empty())) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("get unexpected error", K(ret), K(top), K(partition_exprs.empty()));
+  } else if (part_cnt > 0 && !is_pushdown &&
+             OB_FAIL(get_window_part_topn(adjusted_winfunc_exprs,
+                                          part_topn_expr,
+                                          part_topn_with_ties))) {
+    LOG_WARN("failed to get window part topn", K(ret));
   } else if (top->is_distributed() &&
              OB_FAIL(top->check_sharding_compatible_with_reduce_expr(partition_exprs,
                                                                      is_partition_wise))) {
@@ -5497,6 +5601,9 @@ int ObSelectLogPlan::create_hash_window_function_plan(ObLogicalOperator *&top,
                                                   false, /* is_fetch_with_ties */
                                                   part_cnt > 0 ? &hash_sortkey : NULL))) {
       LOG_WARN("failed to allocate sort as top", K(ret));
+    } else if (NULL != part_topn_expr &&
+               OB_FAIL(set_sort_part_topn(top, part_topn_expr, part_topn_with_ties))) {
+      LOG_WARN("failed to set sort part topn", K(ret));
     } else if (OB_FAIL(allocate_window_function_as_top(adjusted_winfunc_exprs,
                                                false, /* match_parallel */
                                                is_partition_wise,
@@ -5514,6 +5621,15 @@ int ObSelectLogPlan::create_hash_window_function_plan(ObLogicalOperator *&top,
                                                  top->get_output_equal_sets(),
                                                  exch_info))) {
       LOG_WARN("failed to get grouping style exchange info", K(ret));
+    } else if (NULL != part_topn_expr &&
+               OB_FAIL(allocate_part_topn_pre_sort_as_top(top,
+                                                          sort_keys,
+                                                          hash_sortkey,
+                                                          exch_info,
+                                                          part_topn_expr,
+                                                          part_topn_with_ties))) {
+      // pre-filter top n rows of each partition on every worker before repartition
+      LOG_WARN("failed to allocate pre-filter sort as top", K(ret));
     } else if (OB_FAIL(allocate_sort_and_exchange_as_top(top,
                                                          exch_info,
                                                          sort_keys,
@@ -5524,6 +5640,9 @@ int ObSelectLogPlan::create_hash_window_function_plan(ObLogicalOperator *&top,
                                                          false, /* is_fetch_with_ties */
                                                          part_cnt > 0 ? &hash_sortkey : NULL))) {
       LOG_WARN("failed to allocate sort as top", K(ret));
+    } else if (NULL != part_topn_expr &&
+               OB_FAIL(set_sort_part_topn(top, part_topn_expr, part_topn_with_ties))) {
+      LOG_WARN("failed to set sort part topn", K(ret));
     } else if (OB_FAIL(allocate_window_function_as_top(adjusted_winfunc_exprs,
                                                false, /* match_parallel */
                                                is_partition_wise,
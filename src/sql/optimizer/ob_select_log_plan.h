@@ -577,6 +577,17 @@ private:
                                        ObOpPseudoColumnRawExpr *wf_aggr_status_expr,
                                        const ObIArray<bool> &pushdown_info);
 
+  int get_window_part_topn(const ObIArray<ObWinFunRawExpr*> &winfunc_exprs,
+                           ObRawExpr *&part_topn_expr,
+                           bool &with_ties);
+  int set_sort_part_topn(ObLogicalOperator *top, ObRawExpr *part_topn_expr, const bool with_ties);
+  int allocate_part_topn_pre_sort_as_top(ObLogicalOperator *&top,
+                                         const ObIArray<OrderItem> &sort_keys,
+                                         OrderItem &hash_sortkey,
+                                         const ObExchangeInfo &exch_info,
+                                         ObRawExpr *part_topn_expr,
+                                         const bool with_ties);
+
   int adjust_window_functions(const ObLogicalOperator *top,
                               const ObIArray<ObWinFunRawExpr *> &winfunc_exprs,
                               ObIArray<ObWinFunRawExpr *> &adjusted_winfunc_exprs);
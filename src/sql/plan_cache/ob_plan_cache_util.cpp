@@ -393,6 +393,7 @@ int ObConfigInfoInPC::load_influence_plan_config()
   // here to add value of configs that can influence execution plan.
   enable_px_ordered_coord_ = GCONF._enable_px_ordered_coord;
   enable_newsort_ = GCONF._enable_newsort;
+  newsort_collation_key_min_rows_ = GCONF._newsort_collation_key_min_rows;
 
   // For Tenant configs
   // tenant config use tenant_config to get configs
@@ -434,6 +435,9 @@ int ObConfigInfoInPC::serialize_configs(char *buf, int buf_len, int64_t &pos)
   } else if (OB_FAIL(databuff_printf(buf, buf_len, pos,
                               "%d,", enable_newsort_))) {
     SQL_PC_LOG(WARN, "failed to databuff_printf", K(ret), K(enable_newsort_));
+  } else if (OB_FAIL(databuff_printf(buf, buf_len, pos,
+                              "%ld,", newsort_collation_key_min_rows_))) {
+    SQL_PC_LOG(WARN, "failed to databuff_printf", K(ret), K(newsort_collation_key_min_rows_));
   } else if (OB_FAIL(databuff_printf(buf, buf_len, pos,
                               "%d,", px_join_skew_handling_))) {
     SQL_PC_LOG(WARN, "failed to databuff_printf", K(ret), K(px_join_skew_handling_));
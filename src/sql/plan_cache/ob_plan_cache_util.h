@@ -963,6 +963,7 @@ public:
     enable_px_batch_rescan_(true),
     bloom_filter_enabled_(true),
     enable_newsort_(true),
+    newsort_collation_key_min_rows_(10000),
     px_join_skew_handling_(true),
     px_join_skew_minfreq_(30),
     min_cluster_version_(0),
@@ -1002,6 +1003,7 @@ public:
   bool enable_px_ordered_coord_;
   bool bloom_filter_enabled_;
   bool enable_newsort_;
+  int64_t newsort_collation_key_min_rows_;
   bool px_join_skew_handling_;
   int8_t px_join_skew_minfreq_;
   uint64_t min_cluster_version_;
@@ -110,12 +110,41 @@ int ObBlockBatchedRowStore::filter_micro_block_batch(
   int64_t last_start = cur_row_index;
   int64_t capacity = row_capacity_;
   ObSEArray<common::ObDatum *, 4> datums;
+  // late materialization: rows already filtered by former children of AND node are not
+  // decoded, filter columns are decoded only for the remaining rows.
+  const common::ObBitmap *parent_bitmap = nullptr;
+  if (nullptr != parent && parent->is_logic_and_node() && 0 < filter.get_col_count()
+      && nullptr != parent->get_result() && !parent->get_result()->is_all_true()) {
+    parent_bitmap = parent->get_result();
+  }
   if (OB_FAIL(filter.get_datums_from_column(datums))) {
     LOG_WARN("failed to get filter column datums", K(ret));
+  } else if (nullptr != parent_bitmap) {
+    while (OB_SUCC(ret) && cur_row_index < end_row_index) {
+      int64_t row_count = 0;
+      if (OB_FAIL(reuse_capacity(min(batch_size_, end_row_index - cur_row_index)))) {
+        LOG_WARN("failed to reuse vector store", K(ret));
+      } else if (OB_FAIL(copy_filter_rows(
+                  &block_reader,
+                  cur_row_index,
+                  end_row_index,
+                  filter.get_col_offsets(),
+                  filter.get_col_params(),
+                  datums,
+                  row_count,
+                  parent_bitmap))) {
+        LOG_WARN("failed to get rows", K(ret), K(cur_row_index), K(*this));
+      } else if (0 == row_count) {
+        // all the left rows are filtered
+      } else if (OB_FAIL(filter.filter_batch(row_ids_, row_count, result_bitmap))) {
+        LOG_WARN("failed to filter batch", K(ret), K(row_count));
+      }
+    }
   } else {
     while (OB_SUCC(ret) && cur_row_index < end_row_index) {
       last_start = cur_row_index;
       int64_t filter_rows = min(batch_size_, end_row_index - cur_row_index);
+      int64_t row_count = 0;
       if (0 == filter.get_col_count()) {
         cur_row_index +=  filter_rows;
       } else if (OB_FAIL(reuse_capacity(filter_rows))) {
@@ -123,19 +152,21 @@ int ObBlockBatchedRowStore::filter_micro_block_batch(
       } else if (OB_FAIL(copy_filter_rows(
                   &block_reader,
                   cur_row_index,
+                  end_row_index,
                   filter.get_col_offsets(),
                   filter.get_col_params(),
-                  datums))) {
+                  datums,
+                  row_count))) {
         LOG_WARN("failed to get rows", K(ret), K(cur_row_index), K(*this));
       }
       if (OB_SUCC(ret) && OB_FAIL(filter.filter_batch(parent, last_start, cur_row_index, result_bitmap))) {
         LOG_WARN("failed to filter batch", K(ret), K(last_start), K(cur_row_index));
       }
     }
-    // restore vector store
-    if (OB_SUCC(ret) && OB_FAIL(reuse_capacity(capacity))) {
-      LOG_WARN("failed to reuse vector store", K(ret));
-    }
+  }
+  // restore vector store
+  if (OB_SUCC(ret) && OB_FAIL(reuse_capacity(capacity))) {
+    LOG_WARN("failed to reuse vector store", K(ret));
   }
   return ret;
 }
@@ -143,13 +174,15 @@ int ObBlockBatchedRowStore::filter_micro_block_batch(
 int ObBlockBatchedRowStore::copy_filter_rows(
     blocksstable::ObMicroBlockDecoder *reader,
     int64_t &begin_index,
+    const int64_t end_index,
     const common::ObIArray<int32_t> &cols,
     const common::ObIArray<const share::schema::ObColumnParam *> &col_params,
-    common::ObIArray<common::ObDatum *> &datums)
+    common::ObIArray<common::ObDatum *> &datums,
+    int64_t &row_capacity,
+    const common::ObBitmap *bitmap)
 {
   int ret = OB_SUCCESS;
-  int64_t row_capacity = 0;
-  int64_t end_index = common::OB_INVALID_INDEX;
+  row_capacity = 0;
   if (IS_NOT_INIT) {
     ret = OB_NOT_INIT;
     LOG_WARN("vector store is not inited", K(ret));
@@ -160,8 +193,7 @@ int ObBlockBatchedRowStore::copy_filter_rows(
     // defense code: fill rows banned when there is row copied in the front
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("Unexpected vector store count", K(ret), KPC(this));
-  } else if (FALSE_IT(end_index = reader->row_count())) {
-  } else if (OB_FAIL(get_row_ids(reader, begin_index, end_index, row_capacity, false))) {
+  } else if (OB_FAIL(get_row_ids(reader, begin_index, end_index, row_capacity, false, bitmap))) {
     if (OB_UNLIKELY(OB_ITER_END != ret)) {
       LOG_WARN("fail to get row ids", K(ret), K(begin_index), K(end_index));
     }
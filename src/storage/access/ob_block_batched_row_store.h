@@ -75,12 +75,17 @@ protected:
       int64_t &row_count,
       const bool can_limit,
       const common::ObBitmap *bitmap = nullptr);
+  // decode filter columns of rows in [begin_index, end_index), at most row_capacity_ rows.
+  // if %bitmap is not null, only rows set in %bitmap are decoded, row ids are kept in row_ids_.
   int copy_filter_rows(
       blocksstable::ObMicroBlockDecoder *reader,
       int64_t &begin_index,
+      const int64_t end_index,
       const common::ObIArray<int32_t> &cols,
       const common::ObIArray<const share::schema::ObColumnParam *> &col_params,
-      common::ObIArray<common::ObDatum *> &datums);
+      common::ObIArray<common::ObDatum *> &datums,
+      int64_t &row_capacity,
+      const common::ObBitmap *bitmap = nullptr);
   IterEndState iter_end_flag_;
   int64_t batch_size_;
   int64_t row_capacity_;
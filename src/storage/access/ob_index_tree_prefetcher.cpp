@@ -16,6 +16,8 @@
 #include "share/rc/ob_tenant_base.h"
 #include "ob_index_tree_prefetcher.h"
 #include "ob_aggregated_store.h"
+#include "ob_block_row_store.h"
+#include "storage/blocksstable/ob_skip_index.h"
 #include "storage/blocksstable/ob_storage_cache_suite.h"
 
 namespace oceanbase
@@ -674,6 +676,7 @@ void ObIndexTreeMultiPassPrefetcher::reset()
   micro_data_prefetch_idx_ = 0;
   row_lock_check_version_ = transaction::ObTransVersion::INVALID_TRANS_VERSION;
   agg_row_store_ = nullptr;
+  block_row_store_ = nullptr;
   max_micro_handle_cnt_ = 0;
   iter_type_ = 0;
   cur_level_ = 0;
@@ -699,6 +702,7 @@ void ObIndexTreeMultiPassPrefetcher::reuse()
   micro_data_prefetch_idx_ = 0;
   row_lock_check_version_ = transaction::ObTransVersion::INVALID_TRANS_VERSION;
   agg_row_store_ = nullptr;
+  block_row_store_ = nullptr;
   prefetch_depth_ = 1;
   total_micro_data_cnt_ = 0;
   for (int64_t i = 0; i < tree_handles_.count(); i++) {
@@ -991,6 +995,7 @@ int ObIndexTreeMultiPassPrefetcher::prefetch_micro_data()
     // DataBlock ring buf full
   } else {
     int64_t prefetched_cnt = 0;
+    bool can_skip = false;
     int64_t prefetch_micro_idx = 0;
     prefetch_depth_ = MIN(max_micro_handle_cnt_, 2 * prefetch_depth_);
     if (need_check_prefetch_depth_) {
@@ -1029,6 +1034,10 @@ int ObIndexTreeMultiPassPrefetcher::prefetch_micro_data()
               LOG_DEBUG("Success to agg index info", K(ret), KPC(agg_row_store_));
               continue;
             }
+          } else if (OB_FAIL(check_skip_index(block_info, can_skip))) {
+            LOG_WARN("Fail to check skip index", K(ret), K(block_info));
+          } else if (can_skip) {
+            continue;
           } else if (OB_FAIL(check_row_lock(block_info, is_row_lock_checked_))) {
             if (OB_UNLIKELY(OB_ITER_END != ret)) {
               LOG_WARN("Fail to check row lock", K(ret), K(block_info), KPC(this));
@@ -1374,6 +1383,31 @@ int ObIndexTreeMultiPassPrefetcher::check_blockscan(bool &can_blockscan)
   return ret;
 }
 
+int ObIndexTreeMultiPassPrefetcher::check_skip_index(
+    const ObMicroIndexInfo &index_info,
+    bool &can_skip)
+{
+  int ret = OB_SUCCESS;
+  can_skip = false;
+  sql::ObPushdownFilterExecutor *filter = nullptr;
+  const ObTableReadInfo *read_info = nullptr;
+  if (nullptr == block_row_store_
+      || block_row_store_->is_disabled()
+      || nullptr == (filter = block_row_store_->get_pd_filter())
+      || nullptr == index_info.get_skip_index()
+      // blocks before the border rowkey have no newer version in other tables
+      || !index_info.can_blockscan(iter_param_->has_lob_column_out())) {
+  } else if (OB_ISNULL(read_info = iter_param_->get_read_info(access_ctx_->use_fuse_row_cache_))) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_WARN("Unexpected null read info", K(ret), KPC_(iter_param));
+  } else if (OB_FAIL(ObSkipIndexFilter::check_skip(*read_info, *filter, index_info, can_skip))) {
+    LOG_WARN("Fail to check skip index", K(ret), K(index_info));
+  } else if (can_skip) {
+    LOG_DEBUG("skip block by skip index", K(index_info));
+  }
+  return ret;
+}
+
 int ObIndexTreeMultiPassPrefetcher::check_row_lock(
     const blocksstable::ObMicroIndexInfo &index_info,
     bool &is_row_lock_checked)
@@ -1426,6 +1460,7 @@ int ObIndexTreeMultiPassPrefetcher::ObIndexTreeLevelHandle::prefetch(
       ObIndexTreeLevelHandle &parent = prefetcher.tree_handles_[level - 1];
       int8_t prefetch_idx = (prefetch_idx_ + 1) % INDEX_TREE_PREFETCH_DEPTH;
       ObMicroIndexInfo &index_info = index_block_read_handles_[prefetch_idx].index_info_;
+      bool can_skip = false;
       if (OB_FAIL(parent.get_next_index_row(
                   read_info,
                   border_rowkey,
@@ -1443,6 +1478,10 @@ int ObIndexTreeMultiPassPrefetcher::ObIndexTreeLevelHandle::prefetch(
         } else {
           LOG_DEBUG("Success to agg index info", K(ret), K(index_info));
         }
+      } else if (OB_FAIL(prefetcher.check_skip_index(index_info, can_skip))) {
+        LOG_WARN("Fail to check skip index", K(ret), K(index_info));
+      } else if (can_skip) {
+        // no row under this index row can pass the filter
       } else if (OB_FAIL(prefetcher.check_row_lock(index_info, is_row_lock_checked_))) {
         if (OB_UNLIKELY(OB_ITER_END != ret)) {
           LOG_WARN("Fail to check row lock", K(ret), KPC(this));
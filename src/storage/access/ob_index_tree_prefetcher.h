@@ -316,6 +316,7 @@ public:
       micro_data_prefetch_idx_(0),
       row_lock_check_version_(transaction::ObTransVersion::INVALID_TRANS_VERSION),
       agg_row_store_(nullptr),
+      block_row_store_(nullptr),
       can_blockscan_(false),
       need_check_prefetch_depth_(false),
       iter_type_(0),
@@ -373,6 +374,10 @@ public:
   int check_row_lock(
       const blocksstable::ObMicroIndexInfo &index_info,
       bool &is_prefetch_end);
+  // whether no row in the block can pass the pushdown filter, judged by the skip index
+  int check_skip_index(
+      const blocksstable::ObMicroIndexInfo &index_info,
+      bool &can_skip);
   INHERIT_TO_STRING_KV("ObIndexTreeMultiPassPrefetcher", ObIndexTreePrefetcher,
                        K_(is_prefetch_end), K_(cur_range_fetch_idx), K_(cur_range_prefetch_idx), K_(max_range_prefetching_cnt),
                        K_(cur_micro_data_fetch_idx), K_(micro_data_prefetch_idx), K_(max_micro_handle_cnt),
@@ -566,6 +571,7 @@ public:
   int64_t micro_data_prefetch_idx_;
   int64_t row_lock_check_version_;
   ObAggregatedStore *agg_row_store_;
+  ObBlockRowStore *block_row_store_;
 private:
   bool can_blockscan_;
   bool need_check_prefetch_depth_;
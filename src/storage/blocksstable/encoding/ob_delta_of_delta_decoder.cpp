@@ -0,0 +1,423 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_delta_of_delta_decoder.h"
+
+#include "storage/blocksstable/ob_block_sstable_struct.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+using namespace common;
+const ObColumnHeader::Type ObDeltaOfDeltaDecoder::type_;
+
+ObMultiDimArray_T<dod_fix_unpack_func, 4> dod_fix_unpack_funcs;
+
+bool init_dod_fix_unpack_simd_funcs();
+
+template <int32_t LEN_TAG>
+struct DeltaOfDeltaFixUnpackArrayInit
+{
+  bool operator()()
+  {
+    dod_fix_unpack_funcs[LEN_TAG] = &(DeltaOfDeltaFixUnpackFunc_T<LEN_TAG>::unpack_func);
+    return true;
+  }
+};
+
+bool init_dod_fix_unpack_funcs()
+{
+  bool res = false;
+  res = ObNDArrayIniter<DeltaOfDeltaFixUnpackArrayInit, 4>::apply();
+  // Dispatch simd version unpack funcs
+#if defined ( __x86_64__ )
+  if (is_avx2_valid()) {
+    res = init_dod_fix_unpack_simd_funcs();
+  }
+#endif
+  return res;
+}
+
+bool dod_fix_unpack_funcs_inited = init_dod_fix_unpack_funcs();
+
+namespace
+{
+template <typename T>
+struct DeltaOfDeltaCmpOp
+{
+  DeltaOfDeltaCmpOp(const T ref, const ObFPIntCmpOpType op) : ref_(ref), op_(op) {}
+  OB_INLINE int operator()(const uint64_t v, bool &result) const
+  {
+    result = fp_int_cmp<T>(static_cast<T>(v), ref_, op_);
+    return OB_SUCCESS;
+  }
+  T ref_;
+  ObFPIntCmpOpType op_;
+};
+
+template <typename T>
+struct DeltaOfDeltaBtOp
+{
+  DeltaOfDeltaBtOp(const T left, const T right) : left_(left), right_(right) {}
+  OB_INLINE int operator()(const uint64_t v, bool &result) const
+  {
+    result = static_cast<T>(v) >= left_ && static_cast<T>(v) <= right_;
+    return OB_SUCCESS;
+  }
+  T left_;
+  T right_;
+};
+
+struct DeltaOfDeltaInOp
+{
+  explicit DeltaOfDeltaInOp(const sql::ObWhiteFilterExecutor &filter)
+    : filter_(filter), cur_obj_(filter.get_objs().at(0)) {}
+  OB_INLINE int operator()(const uint64_t v, bool &result)
+  {
+    int ret = OB_SUCCESS;
+    cur_obj_.v_.uint64_ = v;
+    if (OB_FAIL(filter_.exist_in_obj_set(cur_obj_, result))) {
+      LOG_WARN("Failed to check object in hashset", K(ret), K_(cur_obj));
+    }
+    return ret;
+  }
+  const sql::ObWhiteFilterExecutor &filter_;
+  ObObj cur_obj_;
+};
+
+OB_INLINE int32_t get_fix_len_tag(const int64_t len)
+{
+  int32_t tag = -1;
+  switch (len) {
+    case 1: tag = 0; break;
+    case 2: tag = 1; break;
+    case 4: tag = 2; break;
+    case 8: tag = 3; break;
+    default: break;
+  }
+  return tag;
+}
+}
+
+int ObDeltaOfDeltaDecoder::decode(ObColumnDecoderCtx &ctx, common::ObObj &cell, const int64_t row_id,
+    const ObBitStream &bs, const char *data, const int64_t len) const
+{
+  int ret = OB_SUCCESS;
+  uint64_t val = STORED_NOT_EXT;
+  const unsigned char *col_data = reinterpret_cast<const unsigned char *>(header_) + ctx.col_header_->length_;
+
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(NULL == data || len < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(data), K(len));
+  } else if (ctx.has_extend_value()) {
+    if (OB_FAIL(ObBitStream::get(col_data, row_id * ctx.micro_block_header_->extend_value_bit_,
+        ctx.micro_block_header_->extend_value_bit_, val))) {
+      LOG_WARN("get extend value failed", K(ret), K(bs), K(ctx));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (STORED_NOT_EXT != val) {
+    set_stored_ext_value(cell, static_cast<ObStoredExtValue>(val));
+  } else {
+    if (cell.get_meta() != ctx.obj_meta_) {
+      cell.set_meta_type(ctx.obj_meta_);
+    }
+    const int64_t data_offset = get_data_offset(ctx);
+    uint64_t v = 0;
+    if (ctx.is_bit_packing()) {
+      if (OB_FAIL(ObBitStream::get(col_data, data_offset + row_id * header_->length_,
+          header_->length_, v))) {
+        LOG_WARN("get bit packing value failed", K(ret), K_(header));
+      } else {
+        cell.v_.uint64_ = restore(row_id, v);
+      }
+    } else {
+      MEMCPY(&v, col_data + data_offset + row_id * header_->length_, header_->length_);
+      cell.v_.uint64_ = restore(row_id, v);
+    }
+  }
+  return ret;
+}
+
+int ObDeltaOfDeltaDecoder::update_pointer(const char *old_block, const char *cur_block)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited()) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_ISNULL(old_block) || OB_ISNULL(cur_block)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(old_block), KP(cur_block));
+  } else {
+    ObIColumnDecoder::update_pointer(header_, old_block, cur_block);
+  }
+  return ret;
+}
+
+int ObDeltaOfDeltaDecoder::unpack_values(
+    const ObColumnDecoderCtx &ctx,
+    const int64_t start,
+    const int64_t cnt,
+    uint64_t *values) const
+{
+  int ret = OB_SUCCESS;
+  const unsigned char *col_data = reinterpret_cast<const unsigned char *>(header_)
+                                  + ctx.col_header_->length_;
+  const int64_t data_offset = get_data_offset(ctx);
+  const int64_t cell_len = header_->length_;
+  if (ctx.is_bit_packing()) {
+    uint64_t v = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < cnt; ++i) {
+      if (OB_FAIL(ObBitStream::get(col_data, data_offset + (start + i) * cell_len, cell_len, v))) {
+        LOG_WARN("Failed to get bit packing value", K(ret), K_(header));
+      } else {
+        values[i] = restore(start + i, v);
+      }
+    }
+  } else {
+    const int32_t len_tag = get_fix_len_tag(cell_len);
+    if (len_tag >= 0) {
+      dod_fix_unpack_funcs[len_tag](
+          col_data + data_offset, start, cnt, header_->base_, header_->step_, values);
+    } else {
+      const unsigned char *stored = col_data + data_offset + start * cell_len;
+      uint64_t v = 0;
+      for (int64_t i = 0; i < cnt; ++i) {
+        v = 0;
+        MEMCPY(&v, stored + i * cell_len, cell_len);
+        values[i] = restore(start + i, v);
+      }
+    }
+  }
+  return ret;
+}
+
+// Internal call, not check parameters for performance
+int ObDeltaOfDeltaDecoder::batch_decode(
+    const ObColumnDecoderCtx &ctx,
+    const ObIRowIndex* row_index,
+    const int64_t *row_ids,
+    const char **cell_datas,
+    const int64_t row_cap,
+    common::ObDatum *datums) const
+{
+  UNUSEDx(row_index, cell_datas);
+  int ret = OB_SUCCESS;
+  uint32_t datum_len = 0;
+  const unsigned char *col_data = reinterpret_cast<const unsigned char *>(header_)
+                                  + ctx.col_header_->length_;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Not inited", K(ret));
+  } else if (ctx.has_extend_value() && OB_FAIL(set_null_datums_from_fixed_column(
+      ctx, row_ids, row_cap, col_data, datums))) {
+    LOG_WARN("Failed to set null datums from fixed data", K(ret), K(ctx));
+  } else if (OB_FAIL(get_uint_data_datum_len(
+      ObDatum::get_obj_datum_map_type(ctx.obj_meta_.get_type()),
+      datum_len))) {
+    LOG_WARN("Failed to get datum length of int/uint data", K(ret));
+  } else if (row_cap > 0 && row_ids[row_cap - 1] - row_ids[0] == row_cap - 1) {
+    // continuous rows, unpack in batch
+    uint64_t values[UNPACK_BATCH_SIZE];
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_cap; i += UNPACK_BATCH_SIZE) {
+      const int64_t cnt = MIN(UNPACK_BATCH_SIZE, row_cap - i);
+      if (OB_FAIL(unpack_values(ctx, row_ids[i], cnt, values))) {
+        LOG_WARN("Failed to unpack values", K(ret), K(i), K(cnt));
+      } else {
+        for (int64_t j = 0; j < cnt; ++j) {
+          ObDatum &datum = datums[i + j];
+          if (ctx.has_extend_value() && datum.is_null()) {
+            // Skip
+          } else {
+            MEMCPY(const_cast<char *>(datum.ptr_), &values[j], datum_len);
+            datum.pack_ = datum_len;
+          }
+        }
+      }
+    }
+  } else {
+    uint64_t value = 0;
+    for (int64_t i = 0; OB_SUCC(ret) && i < row_cap; ++i) {
+      if (ctx.has_extend_value() && datums[i].is_null()) {
+        // Skip
+      } else if (OB_FAIL(unpack_values(ctx, row_ids[i], 1, &value))) {
+        LOG_WARN("Failed to unpack value", K(ret), K(i), K(row_ids[i]));
+      } else {
+        MEMCPY(const_cast<char *>(datums[i].ptr_), &value, datum_len);
+        datums[i].pack_ = datum_len;
+      }
+    }
+  }
+  return ret;
+}
+
+int ObDeltaOfDeltaDecoder::pushdown_operator(
+    const sql::ObPushdownFilterExecutor *parent,
+    const ObColumnDecoderCtx &col_ctx,
+    const sql::ObWhiteFilterExecutor &filter,
+    const char* meta_data,
+    const ObIRowIndex* row_index,
+    ObBitmap &result_bitmap) const
+{
+  UNUSEDx(meta_data, row_index);
+  int ret = OB_SUCCESS;
+  const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
+  const unsigned char *col_data = reinterpret_cast<const unsigned char *>(header_) +
+      col_ctx.col_header_->length_;
+  const ObIArray<ObObj> &objs = filter.get_objs();
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Delta of delta decoder not inited", K(ret), K(filter));
+  } else if (OB_UNLIKELY(op_type >= sql::WHITE_OP_MAX
+                         || col_ctx.micro_block_header_->row_count_ != result_bitmap.size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument for pushed down white filter", K(ret), K(op_type),
+        K(result_bitmap.size()));
+  } else if (sql::WHITE_OP_NU != op_type && sql::WHITE_OP_NN != op_type
+      && (0 == objs.count() || col_ctx.obj_meta_.get_type() != objs.at(0).get_type()
+          || (sql::WHITE_OP_BT == op_type
+              && (2 != objs.count() || col_ctx.obj_meta_.get_type() != objs.at(1).get_type())))) {
+    // Filter type not match with column type, back to retro path
+    ret = OB_NOT_SUPPORTED;
+    LOG_DEBUG("Type not match, back to retrograde path", K(col_ctx), K(filter));
+  } else if (OB_FAIL(get_is_null_bitmap_from_fixed_column(col_ctx, col_data, result_bitmap))) {
+    LOG_WARN("Failed to get is null bitmap", K(ret), K(col_ctx));
+  } else {
+    const bool is_signed = ObIntSC == store_class_;
+    switch (op_type) {
+    case sql::WHITE_OP_NU: {
+      break;
+    }
+    case sql::WHITE_OP_NN: {
+      if (OB_FAIL(result_bitmap.bit_not())) {
+        LOG_WARN("Failed to flip bits for result bitmap",
+            K(ret), K(result_bitmap.size()));
+      }
+      break;
+    }
+    case sql::WHITE_OP_EQ:
+    case sql::WHITE_OP_NE:
+    case sql::WHITE_OP_GT:
+    case sql::WHITE_OP_GE:
+    case sql::WHITE_OP_LT:
+    case sql::WHITE_OP_LE: {
+      const ObFPIntCmpOpType cmp_op = get_white_op_int_op_map()[op_type];
+      if (is_signed) {
+        DeltaOfDeltaCmpOp<int64_t> op(objs.at(0).v_.int64_, cmp_op);
+        ret = traverse_all_data(parent, col_ctx, op, result_bitmap);
+      } else {
+        DeltaOfDeltaCmpOp<uint64_t> op(objs.at(0).v_.uint64_, cmp_op);
+        ret = traverse_all_data(parent, col_ctx, op, result_bitmap);
+      }
+      if (OB_FAIL(ret)) {
+        LOG_WARN("Failed on comparison operator", K(ret), K(col_ctx));
+      }
+      break;
+    }
+    case sql::WHITE_OP_BT: {
+      if (is_signed) {
+        DeltaOfDeltaBtOp<int64_t> op(objs.at(0).v_.int64_, objs.at(1).v_.int64_);
+        ret = traverse_all_data(parent, col_ctx, op, result_bitmap);
+      } else {
+        DeltaOfDeltaBtOp<uint64_t> op(objs.at(0).v_.uint64_, objs.at(1).v_.uint64_);
+        ret = traverse_all_data(parent, col_ctx, op, result_bitmap);
+      }
+      if (OB_FAIL(ret)) {
+        LOG_WARN("Failed on BT operator", K(ret), K(col_ctx));
+      }
+      break;
+    }
+    case sql::WHITE_OP_IN: {
+      DeltaOfDeltaInOp op(filter);
+      if (OB_FAIL(traverse_all_data(parent, col_ctx, op, result_bitmap))) {
+        LOG_WARN("Failed on IN operator", K(ret), K(col_ctx));
+      }
+      break;
+    }
+    default: {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("Unexpected operation type", K(ret), K(op_type));
+    }
+    }
+  }
+  return ret;
+}
+
+// evaluate filter on unpacked values batch by batch, no datum materialized
+template <typename Op>
+int ObDeltaOfDeltaDecoder::traverse_all_data(
+    const sql::ObPushdownFilterExecutor *parent,
+    const ObColumnDecoderCtx &col_ctx,
+    Op &op,
+    ObBitmap &result_bitmap) const
+{
+  int ret = OB_SUCCESS;
+  const int64_t row_count = col_ctx.micro_block_header_->row_count_;
+  const bool null_value_contained = result_bitmap.popcnt() > 0;
+  const bool exist_parent_filter = nullptr != parent;
+  uint64_t values[UNPACK_BATCH_SIZE];
+  for (int64_t start = 0; OB_SUCC(ret) && start < row_count; start += UNPACK_BATCH_SIZE) {
+    const int64_t cnt = MIN(UNPACK_BATCH_SIZE, row_count - start);
+    if (OB_FAIL(unpack_values(col_ctx, start, cnt, values))) {
+      LOG_WARN("Failed to unpack values", K(ret), K(start), K(cnt));
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < cnt; ++i) {
+      const int64_t row_id = start + i;
+      bool result = false;
+      if (exist_parent_filter && parent->can_skip_filter(row_id)) {
+      } else if (null_value_contained && result_bitmap.test(row_id)) {
+        if (OB_FAIL(result_bitmap.set(row_id, false))) {
+          LOG_WARN("Failed to set row with null object to false", K(ret));
+        }
+      } else if (OB_FAIL(op(values[i], result))) {
+        LOG_WARN("Failed on trying to filter the row", K(ret), K(row_id), K(values[i]));
+      } else if (result && OB_FAIL(result_bitmap.set(row_id))) {
+        LOG_WARN("Failed to set result bitmap", K(ret), K(row_id));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObDeltaOfDeltaDecoder::get_null_count(
+    const ObColumnDecoderCtx &ctx,
+    const ObIRowIndex *row_index,
+    const int64_t *row_ids,
+    const int64_t row_cap,
+    int64_t &null_count) const
+{
+  int ret = OB_SUCCESS;
+  const char *col_data = reinterpret_cast<const char *>(header_) + ctx.col_header_->length_;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Delta of delta decoder is not inited", K(ret));
+  } else if (OB_FAIL(ObIColumnDecoder::get_null_count_from_extend_value(
+      ctx,
+      row_index,
+      row_ids,
+      row_cap,
+      col_data,
+      null_count))) {
+    LOG_WARN("Failed to get null count", K(ctx), K(ret));
+  }
+  return ret;
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
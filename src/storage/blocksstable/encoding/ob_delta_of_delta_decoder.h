@@ -0,0 +1,169 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_DELTA_OF_DELTA_DECODER_H_
+#define OCEANBASE_ENCODING_OB_DELTA_OF_DELTA_DECODER_H_
+
+#include "ob_icolumn_decoder.h"
+#include "ob_encoding_util.h"
+#include "ob_encoding_query_util.h"
+#include "ob_delta_of_delta_encoder.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+struct ObColumnHeader;
+struct ObDeltaOfDeltaHeader;
+
+// unpack @cnt fix length stored values start from row @start to (base + row_id * step + stored)
+typedef void (*dod_fix_unpack_func)(
+    const unsigned char *col_data,
+    const int64_t start,
+    const int64_t cnt,
+    const uint64_t base,
+    const uint64_t step,
+    uint64_t *values);
+
+class ObDeltaOfDeltaDecoder : public ObIColumnDecoder
+{
+public:
+  static const ObColumnHeader::Type type_ = ObColumnHeader::DELTA_OF_DELTA;
+  static const int64_t UNPACK_BATCH_SIZE = 256;
+  ObDeltaOfDeltaDecoder() : header_(NULL), store_class_(ObExtendSC)
+  {}
+  virtual ~ObDeltaOfDeltaDecoder() {}
+
+  OB_INLINE int init(
+      const ObMicroBlockHeader &micro_block_header,
+      const ObColumnHeader &column_header,
+      const char *meta);
+
+  virtual int decode(ObColumnDecoderCtx &ctx, common::ObObj &cell, const int64_t row_id,
+      const ObBitStream &bs, const char *data, const int64_t len) const override;
+
+  virtual int update_pointer(const char *old_block, const char *cur_block) override;
+
+  void reset() { this->~ObDeltaOfDeltaDecoder(); new (this) ObDeltaOfDeltaDecoder(); }
+  OB_INLINE void reuse() { header_ = NULL; }
+  virtual ObColumnHeader::Type get_type() const override { return type_; }
+  bool is_inited() const { return NULL != header_; }
+
+  virtual int batch_decode(
+      const ObColumnDecoderCtx &ctx,
+      const ObIRowIndex* row_index,
+      const int64_t *row_ids,
+      const char **cell_datas,
+      const int64_t row_cap,
+      common::ObDatum *datums) const override;
+
+  virtual int pushdown_operator(
+      const sql::ObPushdownFilterExecutor *parent,
+      const ObColumnDecoderCtx &col_ctx,
+      const sql::ObWhiteFilterExecutor &filter,
+      const char* meta_data,
+      const ObIRowIndex* row_index,
+      ObBitmap &result_bitmap) const override;
+
+  virtual int get_null_count(
+      const ObColumnDecoderCtx &ctx,
+      const ObIRowIndex *row_index,
+      const int64_t *row_ids,
+      const int64_t row_cap,
+      int64_t &null_count) const override;
+private:
+  OB_INLINE uint64_t restore(const int64_t row_id, const uint64_t stored) const
+  {
+    return header_->base_ + static_cast<uint64_t>(row_id) * header_->step_ + stored;
+  }
+  OB_INLINE int64_t get_data_offset(const ObColumnDecoderCtx &ctx) const
+  {
+    int64_t data_offset = 0;
+    if (ctx.has_extend_value()) {
+      data_offset = ctx.micro_block_header_->row_count_ * ctx.micro_block_header_->extend_value_bit_;
+    }
+    if (!ctx.is_bit_packing()) {
+      data_offset = (data_offset + CHAR_BIT - 1) / CHAR_BIT;
+    }
+    return data_offset;
+  }
+  // unpack values of rows in [start, start + cnt)
+  int unpack_values(
+      const ObColumnDecoderCtx &ctx,
+      const int64_t start,
+      const int64_t cnt,
+      uint64_t *values) const;
+
+  template <typename Op>
+  int traverse_all_data(
+      const sql::ObPushdownFilterExecutor *parent,
+      const ObColumnDecoderCtx &col_ctx,
+      Op &op,
+      ObBitmap &result_bitmap) const;
+private:
+  const ObDeltaOfDeltaHeader *header_;
+  ObObjTypeStoreClass store_class_;
+};
+
+OB_INLINE int ObDeltaOfDeltaDecoder::init(
+    const ObMicroBlockHeader &micro_block_header,
+    const ObColumnHeader &column_header,
+    const char *meta)
+{
+  UNUSED(micro_block_header);
+  int ret = common::OB_SUCCESS;
+  // performance critical, don't check params
+  if (is_inited()) {
+    ret = common::OB_INIT_TWICE;
+    STORAGE_LOG(WARN, "init twice", K(ret));
+  } else {
+    store_class_ = get_store_class_map()[ob_obj_type_class(column_header.get_store_obj_type())];
+    if (ObIntSC != store_class_ && ObUIntSC != store_class_) {
+      ret = common::OB_INNER_STAT_ERROR;
+      STORAGE_LOG(WARN, "not supported store class", K(ret), K(column_header), K_(store_class));
+    } else {
+      header_ = reinterpret_cast<const ObDeltaOfDeltaHeader *>(meta + column_header.offset_);
+    }
+  }
+  return ret;
+}
+
+extern ObMultiDimArray_T<dod_fix_unpack_func, 4> dod_fix_unpack_funcs;
+extern bool dod_fix_unpack_funcs_inited;
+
+template <int32_t LEN_TAG>
+struct DeltaOfDeltaFixUnpackFunc_T
+{
+  static void unpack_func(
+      const unsigned char *col_data,
+      const int64_t start,
+      const int64_t cnt,
+      const uint64_t base,
+      const uint64_t step,
+      uint64_t *values)
+  {
+    typedef typename ObEncodingTypeInference<false, LEN_TAG>::Type DataType;
+    const DataType *stored = reinterpret_cast<const DataType *>(col_data) + start;
+    uint64_t predict = base + static_cast<uint64_t>(start) * step;
+    for (int64_t i = 0; i < cnt; ++i) {
+      values[i] = predict + stored[i];
+      predict += step;
+    }
+  }
+};
+
+} // end namespace blocksstable
+} // end namespace oceanbase
+
+#endif // OCEANBASE_ENCODING_OB_DELTA_OF_DELTA_DECODER_H_
@@ -0,0 +1,120 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_encoding_query_util.h"
+#include "ob_delta_of_delta_decoder.h"
+
+namespace oceanbase {
+namespace blocksstable {
+
+template <int32_t LEN_TAG>
+struct DeltaOfDeltaFixUnpackAVX2Func_T : public DeltaOfDeltaFixUnpackFunc_T<LEN_TAG>
+{};
+
+#if defined ( __AVX2__ )
+// widen 4 stored values of LEN_TAG to 4 uint64 lanes
+template <int32_t LEN_TAG>
+OB_INLINE __m256i dod_load_4(const unsigned char *data);
+
+template <>
+OB_INLINE __m256i dod_load_4<0>(const unsigned char *data)
+{
+  int32_t packed = 0;
+  MEMCPY(&packed, data, sizeof(packed));
+  return _mm256_cvtepu8_epi64(_mm_cvtsi32_si128(packed));
+}
+
+template <>
+OB_INLINE __m256i dod_load_4<1>(const unsigned char *data)
+{
+  return _mm256_cvtepu16_epi64(_mm_loadl_epi64(reinterpret_cast<const __m128i *>(data)));
+}
+
+template <>
+OB_INLINE __m256i dod_load_4<2>(const unsigned char *data)
+{
+  return _mm256_cvtepu32_epi64(_mm_loadu_si128(reinterpret_cast<const __m128i *>(data)));
+}
+
+template <>
+OB_INLINE __m256i dod_load_4<3>(const unsigned char *data)
+{
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data));
+}
+
+template <int32_t LEN_TAG>
+struct DeltaOfDeltaFixUnpackAVX2Impl_T
+{
+  // Fast unpack with SIMD: values[i] = base + (start + i) * step + stored[start + i]
+  static void unpack_func(
+      const unsigned char *col_data,
+      const int64_t start,
+      const int64_t cnt,
+      const uint64_t base,
+      const uint64_t step,
+      uint64_t *values)
+  {
+    typedef typename ObEncodingTypeInference<false, LEN_TAG>::Type DataType;
+    const DataType *stored = reinterpret_cast<const DataType *>(col_data) + start;
+    const uint64_t predict = base + static_cast<uint64_t>(start) * step;
+    __m256i predict_vec = _mm256_set_epi64x(
+        predict + 3 * step, predict + 2 * step, predict + step, predict);
+    const __m256i step_vec = _mm256_set1_epi64x(4 * step);
+    const int64_t vec_cnt = cnt / 4 * 4;
+    for (int64_t i = 0; i < vec_cnt; i += 4) {
+      __m256i data_vec = dod_load_4<LEN_TAG>(reinterpret_cast<const unsigned char *>(stored + i));
+      _mm256_storeu_si256(reinterpret_cast<__m256i *>(values + i),
+          _mm256_add_epi64(data_vec, predict_vec));
+      predict_vec = _mm256_add_epi64(predict_vec, step_vec);
+    }
+    for (int64_t i = vec_cnt; i < cnt; ++i) {
+      values[i] = predict + static_cast<uint64_t>(i) * step + stored[i];
+    }
+  }
+};
+
+template <>
+struct DeltaOfDeltaFixUnpackAVX2Func_T<0> : public DeltaOfDeltaFixUnpackAVX2Impl_T<0>
+{};
+
+template <>
+struct DeltaOfDeltaFixUnpackAVX2Func_T<1> : public DeltaOfDeltaFixUnpackAVX2Impl_T<1>
+{};
+
+template <>
+struct DeltaOfDeltaFixUnpackAVX2Func_T<2> : public DeltaOfDeltaFixUnpackAVX2Impl_T<2>
+{};
+
+template <>
+struct DeltaOfDeltaFixUnpackAVX2Func_T<3> : public DeltaOfDeltaFixUnpackAVX2Impl_T<3>
+{};
+#endif
+
+template <int32_t LEN_TAG>
+struct DeltaOfDeltaFixUnpackAVX2ArrayInit
+{
+  bool operator()()
+  {
+    dod_fix_unpack_funcs[LEN_TAG] = &(DeltaOfDeltaFixUnpackAVX2Func_T<LEN_TAG>::unpack_func);
+    return true;
+  }
+};
+
+bool init_dod_fix_unpack_simd_funcs()
+{
+  return ObNDArrayIniter<DeltaOfDeltaFixUnpackAVX2ArrayInit, 4>::apply();
+}
+
+} // end of namespace blocksstable
+} // end of namespace oceanbase
@@ -0,0 +1,209 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_delta_of_delta_encoder.h"
+
+#include "storage/blocksstable/ob_data_buffer.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+using namespace common;
+
+const ObColumnHeader::Type ObDeltaOfDeltaEncoder::type_;
+
+ObDeltaOfDeltaEncoder::ObDeltaOfDeltaEncoder()
+  : type_store_size_(0), mask_(0), reverse_mask_(0), base_(0), step_(0), header_(NULL)
+{
+}
+
+int ObDeltaOfDeltaEncoder::init(
+    const ObColumnEncodingCtx &ctx,
+    const int64_t column_index,
+    const ObConstDatumRowArray &rows)
+{
+  int ret = OB_SUCCESS;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_FAIL(ObIColumnEncoder::init(ctx, column_index, rows))) {
+    LOG_WARN("init base column encoder failed",
+        K(ret), K(ctx), K(column_index), "row count", rows.count());
+  } else {
+    const ObObjTypeClass tc = ob_obj_type_class(column_type_.get_type());
+    const ObObjTypeStoreClass sc = get_store_class_map()[tc];
+    type_store_size_ = get_type_size_map()[column_type_.get_type()];
+    if ((ObIntSC != sc && ObUIntSC != sc) || ObFloatTC == tc || ObDoubleTC == tc
+        || type_store_size_ <= 0) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("not supported type for delta of delta", K(ret), K(sc), K(tc),
+          K_(type_store_size), K_(column_index));
+    } else {
+      mask_ = INTEGER_MASK_TABLE[type_store_size_];
+      reverse_mask_ = ObIntSC == sc ? ~mask_ : 0;
+      column_header_.type_ = type_;
+    }
+  }
+  return ret;
+}
+
+void ObDeltaOfDeltaEncoder::reuse()
+{
+  ObIColumnEncoder::reuse();
+  type_store_size_ = 0;
+  mask_ = 0;
+  reverse_mask_ = 0;
+  base_ = 0;
+  step_ = 0;
+  header_ = NULL;
+  is_inited_ = false;
+}
+
+int ObDeltaOfDeltaEncoder::traverse(bool &suitable)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    suitable = false;
+    const ObColDatums &datums = *ctx_->col_datums_;
+    int64_t first_row = -1;
+    int64_t last_row = -1;
+    for (int64_t i = 0; i < datums.count(); ++i) {
+      const ObDatum &datum = datums.at(i);
+      if (!datum.is_null() && !datum.is_nop()) {
+        if (first_row < 0) {
+          first_row = i;
+        }
+        last_row = i;
+      }
+    }
+
+    if (first_row < 0 || first_row == last_row) {
+      // not enough values to predict
+    } else {
+      const int64_t delta = static_cast<int64_t>(
+          get_value(datums.at(last_row)) - get_value(datums.at(first_row)));
+      step_ = static_cast<uint64_t>(delta / (last_row - first_row));
+      if (0 == step_) {
+        // leave it to integer base diff
+      } else {
+        int64_t min_residual = INT64_MAX;
+        int64_t max_residual = INT64_MIN;
+        for (int64_t i = first_row; i <= last_row; ++i) {
+          const ObDatum &datum = datums.at(i);
+          if (!datum.is_null() && !datum.is_nop()) {
+            const int64_t residual = static_cast<int64_t>(
+                get_value(datum) - static_cast<uint64_t>(i) * step_);
+            min_residual = MIN(min_residual, residual);
+            max_residual = MAX(max_residual, residual);
+          }
+        }
+        base_ = static_cast<uint64_t>(min_residual);
+        const uint64_t max_stored = static_cast<uint64_t>(max_residual) - base_;
+        const bool enable_bit_packing = ctx_->encoding_ctx_->encoder_opt_.enable_bit_packing_;
+        bool bit_packing = false;
+        int64_t stored_size = get_packing_size(bit_packing, max_stored, enable_bit_packing);
+        if (!bit_packing) {
+          stored_size *= CHAR_BIT;
+        }
+        const int64_t orig_size = type_store_size_ * CHAR_BIT;
+        LOG_DEBUG("delta of delta size", K_(column_index), K(stored_size), K(orig_size),
+            K_(base), K_(step));
+        if ((orig_size - stored_size) * rows_->count()
+            > static_cast<int64_t>(sizeof(*header_) * CHAR_BIT)) {
+          suitable = true;
+          if (bit_packing) {
+            desc_.bit_packing_length_ = stored_size;
+          } else {
+            desc_.fix_data_length_ = stored_size / CHAR_BIT;
+          }
+          desc_.need_data_store_ = true;
+          desc_.has_null_ = ctx_->null_cnt_ > 0;
+          desc_.has_nope_ = ctx_->nope_cnt_ > 0;
+          desc_.need_extend_value_bit_store_ = desc_.has_null_ || desc_.has_nope_;
+          if (desc_.need_extend_value_bit_store_) {
+            column_header_.set_has_extend_value_attr();
+          }
+          if (desc_.bit_packing_length_ > 0) {
+            column_header_.set_bit_packing_attr();
+          }
+          column_header_.set_fix_lenght_attr();
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObDeltaOfDeltaEncoder::store_meta(ObBufferWriter &buf_writer)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    header_ = reinterpret_cast<ObDeltaOfDeltaHeader *>(buf_writer.current());
+    if (OB_FAIL(buf_writer.advance_zero(sizeof(*header_)))) {
+      LOG_WARN("advance meta store size failed", K(ret));
+    } else {
+      header_->version_ = ObDeltaOfDeltaHeader::OB_DELTA_OF_DELTA_HEADER_V1;
+      header_->base_ = base_;
+      header_->step_ = step_;
+    }
+  }
+  return ret;
+}
+
+int64_t ObDeltaOfDeltaEncoder::calc_size() const
+{
+  int64_t size = INT64_MAX;
+  if (is_inited_) {
+    if (desc_.bit_packing_length_ > 0) {
+      size = (rows_->count() * desc_.bit_packing_length_ + CHAR_BIT - 1) / CHAR_BIT;
+    } else {
+      size = rows_->count() * desc_.fix_data_length_;
+    }
+  }
+  return size + sizeof(*header_);
+}
+
+int ObDeltaOfDeltaEncoder::store_fix_data(ObBufferWriter &buf_writer)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(!is_valid_fix_encoder())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K_(desc));
+  } else {
+    StoredValueGetter getter(*this);
+    FixDataSetter setter(*this);
+    header_->length_ = static_cast<uint8_t>(desc_.bit_packing_length_ > 0
+        ? desc_.bit_packing_length_
+        : desc_.fix_data_length_);
+    if (OB_FAIL(fill_column_store(buf_writer, *ctx_->col_datums_, getter, setter))) {
+      LOG_WARN("fill column store failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
@@ -0,0 +1,129 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_DELTA_OF_DELTA_ENCODER_H_
+#define OCEANBASE_ENCODING_OB_DELTA_OF_DELTA_ENCODER_H_
+
+#include "ob_icolumn_encoder.h"
+#include "ob_encoding_util.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+// meta: ObDeltaOfDeltaHeader
+// value of row i is (base + i * step + stored(i)), computed in uint64.
+// step is the average delta of the column, so stored(i) is the accumulated
+// delta of delta of row i, which is small for regularly increasing columns.
+struct ObDeltaOfDeltaHeader
+{
+  static constexpr uint8_t OB_DELTA_OF_DELTA_HEADER_V1 = 0;
+  uint8_t version_;
+  uint8_t length_;
+  uint64_t base_;
+  uint64_t step_;
+
+  ObDeltaOfDeltaHeader()
+    : version_(OB_DELTA_OF_DELTA_HEADER_V1), length_(0), base_(0), step_(0)
+  {
+  }
+
+  TO_STRING_KV(K_(version), K_(length), K_(base), K_(step));
+} __attribute__((packed));
+
+class ObDeltaOfDeltaEncoder : public ObIColumnEncoder
+{
+public:
+  static const ObColumnHeader::Type type_ = ObColumnHeader::DELTA_OF_DELTA;
+
+  ObDeltaOfDeltaEncoder();
+  virtual ~ObDeltaOfDeltaEncoder() {}
+
+  virtual int init(
+      const ObColumnEncodingCtx &ctx,
+      const int64_t column_index,
+      const ObConstDatumRowArray &rows) override;
+
+  virtual void reuse() override;
+  virtual int store_meta(ObBufferWriter &buf_writer) override;
+  virtual int store_data(
+      const int64_t row_id, ObBitStream &bs, char *buf, const int64_t len) override
+  {
+    UNUSEDx(row_id, bs, buf, len);
+    return common::OB_NOT_SUPPORTED;
+  }
+
+  virtual int traverse(bool &suitable) override;
+  virtual int64_t calc_size() const override;
+  virtual ObColumnHeader::Type get_type() const { return type_; }
+  virtual int store_fix_data(ObBufferWriter &buf_writer) override;
+
+  OB_INLINE uint64_t get_value(const common::ObDatum &datum) const
+  {
+    uint64_t v = datum.get_uint64() & mask_;
+    if (0 != reverse_mask_ && (v & (reverse_mask_ >> 1))) {
+      v |= reverse_mask_;
+    }
+    return v;
+  }
+  OB_INLINE uint64_t get_stored_value(const int64_t row_id, const common::ObDatum &datum) const
+  {
+    return get_value(datum) - static_cast<uint64_t>(row_id) * step_ - base_;
+  }
+
+public:
+  struct StoredValueGetter
+  {
+    explicit StoredValueGetter(const ObDeltaOfDeltaEncoder &encoder) : encoder_(encoder) {}
+    inline int operator()(const int64_t row_id, const common::ObDatum &datum, uint64_t &v)
+    {
+      v = encoder_.get_stored_value(row_id, datum);
+      return common::OB_SUCCESS;
+    }
+
+    const ObDeltaOfDeltaEncoder &encoder_;
+  };
+
+  struct FixDataSetter
+  {
+    explicit FixDataSetter(const ObDeltaOfDeltaEncoder &encoder) : encoder_(encoder) {}
+    inline int operator()(
+        const int64_t row_id,
+        const common::ObDatum &datum,
+        char *buf,
+        const int64_t len) const
+    {
+      // performance critical, do not check parameters
+      uint64_t v = encoder_.get_stored_value(row_id, datum);
+      MEMCPY(buf, &v, len);
+      return common::OB_SUCCESS;
+    }
+
+    const ObDeltaOfDeltaEncoder &encoder_;
+  };
+
+private:
+  int64_t type_store_size_;
+  uint64_t mask_;
+  uint64_t reverse_mask_;
+  uint64_t base_;
+  uint64_t step_;
+  // is null before write meta
+  ObDeltaOfDeltaHeader *header_;
+};
+
+} // end namespace blocksstable
+} // end namespace oceanbase
+
+#endif // OCEANBASE_ENCODING_OB_DELTA_OF_DELTA_ENCODER_H_
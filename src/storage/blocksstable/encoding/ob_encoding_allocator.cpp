@@ -29,6 +29,8 @@ int64_t size_array [] = {                \
   sizeof(ObStringPrefix##Item),          \
   sizeof(ObColumnEqual##Item),           \
   sizeof(ObInterColSubStr##Item),        \
+  sizeof(ObFloatXor##Item),              \
+  sizeof(ObDeltaOfDelta##Item),          \
 }                                        \
 
 DEF_SIZE_ARRAY(Encoder, encoder_sizes);
@@ -0,0 +1,422 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_float_xor_decoder.h"
+
+#include "storage/blocksstable/ob_block_sstable_struct.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+using namespace common;
+const ObColumnHeader::Type ObFloatXorDecoder::type_;
+
+namespace
+{
+struct FloatXorCmpOp
+{
+  FloatXorCmpOp(const double ref, const ObFPIntCmpOpType op) : ref_(ref), op_(op) {}
+  OB_INLINE int operator()(const uint64_t, const double value, bool &result) const
+  {
+    result = fp_int_cmp<double>(value, ref_, op_);
+    return OB_SUCCESS;
+  }
+  double ref_;
+  ObFPIntCmpOpType op_;
+};
+
+struct FloatXorBtOp
+{
+  FloatXorBtOp(const double left, const double right) : left_(left), right_(right) {}
+  OB_INLINE int operator()(const uint64_t, const double value, bool &result) const
+  {
+    result = value >= left_ && value <= right_;
+    return OB_SUCCESS;
+  }
+  double left_;
+  double right_;
+};
+
+struct FloatXorInOp
+{
+  explicit FloatXorInOp(const sql::ObWhiteFilterExecutor &filter)
+    : filter_(filter), cur_obj_(filter.get_objs().at(0)) {}
+  OB_INLINE int operator()(const uint64_t bits, const double, bool &result)
+  {
+    int ret = OB_SUCCESS;
+    cur_obj_.v_.uint64_ = bits;
+    if (OB_FAIL(filter_.exist_in_obj_set(cur_obj_, result))) {
+      LOG_WARN("Failed to check object in hashset", K(ret), K_(cur_obj));
+    }
+    return ret;
+  }
+  const sql::ObWhiteFilterExecutor &filter_;
+  ObObj cur_obj_;
+};
+}
+
+int ObFloatXorDecoder::decode(ObColumnDecoderCtx &ctx, common::ObObj &cell, const int64_t row_id,
+    const ObBitStream &bs, const char *data, const int64_t len) const
+{
+  int ret = OB_SUCCESS;
+  uint64_t val = STORED_NOT_EXT;
+  const unsigned char *col_data = reinterpret_cast<const unsigned char *>(header_) + ctx.col_header_->length_;
+  int64_t data_offset = 0;
+
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(NULL == data || len < 0)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(data), K(len));
+  } else if (ctx.has_extend_value()) {
+    data_offset = ctx.micro_block_header_->row_count_ * ctx.micro_block_header_->extend_value_bit_;
+    if (OB_FAIL(ObBitStream::get(col_data, row_id * ctx.micro_block_header_->extend_value_bit_,
+        ctx.micro_block_header_->extend_value_bit_, val))) {
+      LOG_WARN("get extend value failed", K(ret), K(bs), K(ctx));
+    }
+  }
+  if (OB_FAIL(ret)) {
+  } else if (STORED_NOT_EXT != val) {
+    set_stored_ext_value(cell, static_cast<ObStoredExtValue>(val));
+  } else {
+    if (cell.get_meta() != ctx.obj_meta_) {
+      cell.set_meta_type(ctx.obj_meta_);
+    }
+    uint64_t v = 0;
+    if (ctx.is_bit_packing()) {
+      if (OB_FAIL(ObBitStream::get(col_data, data_offset + row_id * header_->length_,
+          header_->length_, v))) {
+        LOG_WARN("get bit packing value failed", K(ret), K_(header));
+      } else {
+        cell.v_.uint64_ = restore(v);
+      }
+    } else {
+      data_offset = (data_offset + CHAR_BIT - 1) / CHAR_BIT;
+      MEMCPY(&v, col_data + data_offset + row_id * header_->length_, header_->length_);
+      cell.v_.uint64_ = restore(v);
+    }
+  }
+  return ret;
+}
+
+int ObFloatXorDecoder::update_pointer(const char *old_block, const char *cur_block)
+{
+  int ret = OB_SUCCESS;
+  if (!is_inited()) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_ISNULL(old_block) || OB_ISNULL(cur_block)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), KP(old_block), KP(cur_block));
+  } else {
+    ObIColumnDecoder::update_pointer(header_, old_block, cur_block);
+  }
+  return ret;
+}
+
+template <ObBitStream::ObBitStreamUnpackType UNPACK_TYPE>
+void ObFloatXorDecoder::batch_unpack_values(
+    const ObColumnDecoderCtx &ctx,
+    const int64_t *row_ids,
+    const int64_t row_cap,
+    const int64_t datum_len,
+    const int64_t data_offset,
+    common::ObDatum *datums) const
+{
+  const bool has_ext_val = ctx.has_extend_value();
+  const int64_t bs_len = data_offset + header_->length_ * ctx.micro_block_header_->row_count_;
+  const unsigned char *col_data = reinterpret_cast<const unsigned char *>(header_)
+                                  + ctx.col_header_->length_;
+  int64_t value = 0;
+  for (int64_t i = 0; i < row_cap; ++i) {
+    if (has_ext_val && datums[i].is_null()) {
+      // skip
+    } else {
+      value = 0;
+      ObBitStream::get<UNPACK_TYPE>(
+          col_data, data_offset + row_ids[i] * header_->length_, header_->length_,
+          bs_len, value);
+      const uint64_t bits = restore(static_cast<uint64_t>(value));
+      MEMCPY(const_cast<char *>(datums[i].ptr_), &bits, datum_len);
+      datums[i].pack_ = static_cast<uint32_t>(datum_len);
+    }
+  }
+}
+
+// Internal call, not check parameters for performance
+int ObFloatXorDecoder::batch_decode(
+    const ObColumnDecoderCtx &ctx,
+    const ObIRowIndex* row_index,
+    const int64_t *row_ids,
+    const char **cell_datas,
+    const int64_t row_cap,
+    common::ObDatum *datums) const
+{
+  UNUSEDx(row_index, cell_datas);
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Not inited", K(ret));
+  } else {
+    int64_t data_offset = 0;
+    const unsigned char *col_data = reinterpret_cast<const unsigned char *>(header_)
+                                    + ctx.col_header_->length_;
+    uint32_t datum_len = 0;
+    if (ctx.has_extend_value()) {
+      data_offset = ctx.micro_block_header_->row_count_
+          * ctx.micro_block_header_->extend_value_bit_;
+      if (OB_FAIL(set_null_datums_from_fixed_column(
+          ctx, row_ids, row_cap, col_data, datums))) {
+        LOG_WARN("Failed to set null datums from fixed data", K(ret), K(ctx));
+      }
+    }
+
+    if (OB_FAIL(ret)) {
+    } else if (OB_FAIL(get_uint_data_datum_len(
+        ObDatum::get_obj_datum_map_type(ctx.obj_meta_.get_type()),
+        datum_len))) {
+      LOG_WARN("Failed to get datum length of float/double data", K(ret));
+    } else if (ctx.is_bit_packing()) {
+      const int64_t packed_len = header_->length_;
+      if (packed_len < 10) {
+        batch_unpack_values<ObBitStream::PACKED_LEN_LESS_THAN_10>(
+            ctx, row_ids, row_cap, datum_len, data_offset, datums);
+      } else if (packed_len < 26) {
+        batch_unpack_values<ObBitStream::PACKED_LEN_LESS_THAN_26>(
+            ctx, row_ids, row_cap, datum_len, data_offset, datums);
+      } else if (packed_len <= 64) {
+        batch_unpack_values<ObBitStream::DEFAULT>(
+            ctx, row_ids, row_cap, datum_len, data_offset, datums);
+      } else {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("Unpack size larger than 64 bit", K(ret), K(packed_len));
+      }
+    } else {
+      // Fixed store data
+      data_offset = (data_offset + CHAR_BIT - 1) / CHAR_BIT;
+      uint64_t value = 0;
+      for (int64_t i = 0; i < row_cap; ++i) {
+        if (ctx.has_extend_value() && datums[i].is_null()) {
+          // Skip
+        } else {
+          value = 0;
+          MEMCPY(&value, col_data + data_offset + row_ids[i] * header_->length_, header_->length_);
+          value = restore(value);
+          MEMCPY(const_cast<char *>(datums[i].ptr_), &value, datum_len);
+          datums[i].pack_ = datum_len;
+        }
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFloatXorDecoder::obj_to_double(
+    const ObColumnDecoderCtx &col_ctx,
+    const common::ObObj &obj,
+    double &value) const
+{
+  int ret = OB_SUCCESS;
+  const ObObjTypeClass tc = obj.get_type_class();
+  if (OB_UNLIKELY(col_ctx.obj_meta_.get_type() != obj.get_type())) {
+    // Filter type not match with column type, back to retro path
+    ret = OB_NOT_SUPPORTED;
+    LOG_DEBUG("Type not match, back to retrograde path", K(col_ctx), K(obj));
+  } else if (ObFloatTC == tc) {
+    value = obj.get_float();
+  } else if (ObDoubleTC == tc) {
+    value = obj.get_double();
+  } else {
+    ret = OB_NOT_SUPPORTED;
+    LOG_DEBUG("Not float/double filter object, back to retro path", K(obj));
+  }
+  return ret;
+}
+
+int ObFloatXorDecoder::pushdown_operator(
+    const sql::ObPushdownFilterExecutor *parent,
+    const ObColumnDecoderCtx &col_ctx,
+    const sql::ObWhiteFilterExecutor &filter,
+    const char* meta_data,
+    const ObIRowIndex* row_index,
+    ObBitmap &result_bitmap) const
+{
+  UNUSEDx(meta_data, row_index);
+  int ret = OB_SUCCESS;
+  const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
+  const unsigned char *col_data = reinterpret_cast<const unsigned char *>(header_) +
+      col_ctx.col_header_->length_;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Float xor decoder not inited", K(ret), K(filter));
+  } else if (OB_UNLIKELY(op_type >= sql::WHITE_OP_MAX
+                         || col_ctx.micro_block_header_->row_count_ != result_bitmap.size())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid argument for pushed down white filter", K(ret), K(op_type),
+        K(result_bitmap.size()));
+  } else if (OB_FAIL(get_is_null_bitmap_from_fixed_column(col_ctx, col_data, result_bitmap))) {
+    LOG_WARN("Failed to get is null bitmap", K(ret), K(col_ctx));
+  } else {
+    const ObIArray<ObObj> &objs = filter.get_objs();
+    switch (op_type) {
+    case sql::WHITE_OP_NU: {
+      break;
+    }
+    case sql::WHITE_OP_NN: {
+      if (OB_FAIL(result_bitmap.bit_not())) {
+        LOG_WARN("Failed to flip bits for result bitmap",
+            K(ret), K(result_bitmap.size()));
+      }
+      break;
+    }
+    case sql::WHITE_OP_EQ:
+    case sql::WHITE_OP_NE:
+    case sql::WHITE_OP_GT:
+    case sql::WHITE_OP_GE:
+    case sql::WHITE_OP_LT:
+    case sql::WHITE_OP_LE: {
+      double ref = 0;
+      if (OB_UNLIKELY(1 != objs.count())) {
+        ret = OB_INVALID_ARGUMENT;
+        LOG_WARN("Invalid filter object count", K(ret), K(filter));
+      } else if (OB_FAIL(obj_to_double(col_ctx, objs.at(0), ref))) {
+      } else {
+        FloatXorCmpOp op(ref, get_white_op_int_op_map()[op_type]);
+        if (OB_FAIL(traverse_all_data(parent, col_ctx, col_data, op, result_bitmap))) {
+          LOG_WARN("Failed on comparison operator", K(ret), K(col_ctx));
+        }
+      }
+      break;
+    }
+    case sql::WHITE_OP_BT: {
+      double left = 0;
+      double right = 0;
+      if (OB_UNLIKELY(2 != objs.count())) {
+        ret = OB_INVALID_ARGUMENT;
+        LOG_WARN("Invalid filter object count", K(ret), K(filter));
+      } else if (OB_FAIL(obj_to_double(col_ctx, objs.at(0), left))
+                 || OB_FAIL(obj_to_double(col_ctx, objs.at(1), right))) {
+      } else {
+        FloatXorBtOp op(left, right);
+        if (OB_FAIL(traverse_all_data(parent, col_ctx, col_data, op, result_bitmap))) {
+          LOG_WARN("Failed on BT operator", K(ret), K(col_ctx));
+        }
+      }
+      break;
+    }
+    case sql::WHITE_OP_IN: {
+      if (OB_UNLIKELY(0 == objs.count())) {
+        ret = OB_INVALID_ARGUMENT;
+        LOG_WARN("Invalid filter object count", K(ret), K(filter));
+      } else if (OB_UNLIKELY(col_ctx.obj_meta_.get_type() != objs.at(0).get_type())) {
+        ret = OB_NOT_SUPPORTED;
+        LOG_DEBUG("Type not match, back to retrograde path", K(col_ctx), K(filter));
+      } else {
+        FloatXorInOp op(filter);
+        if (OB_FAIL(traverse_all_data(parent, col_ctx, col_data, op, result_bitmap))) {
+          LOG_WARN("Failed on IN operator", K(ret), K(col_ctx));
+        }
+      }
+      break;
+    }
+    default: {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("Unexpected operation type", K(ret), K(op_type));
+    }
+    }
+  }
+  return ret;
+}
+
+template <typename Op>
+int ObFloatXorDecoder::traverse_all_data(
+    const sql::ObPushdownFilterExecutor *parent,
+    const ObColumnDecoderCtx &col_ctx,
+    const unsigned char* col_data,
+    Op &op,
+    ObBitmap &result_bitmap) const
+{
+  int ret = OB_SUCCESS;
+  const uint8_t cell_len = header_->length_;
+  const bool is_bit_packing = col_ctx.is_bit_packing();
+  int64_t data_offset = 0;
+  if (col_ctx.has_extend_value()) {
+    data_offset = col_ctx.micro_block_header_->row_count_
+        * col_ctx.micro_block_header_->extend_value_bit_;
+  }
+  if (!is_bit_packing) {
+    data_offset = (data_offset + CHAR_BIT - 1) / CHAR_BIT;
+  }
+  const bool null_value_contained = result_bitmap.popcnt() > 0;
+  const bool exist_parent_filter = nullptr != parent;
+  uint64_t v = 0;
+  for (int64_t row_id = 0;
+       OB_SUCC(ret) && row_id < col_ctx.micro_block_header_->row_count_;
+       ++row_id) {
+    if (exist_parent_filter && parent->can_skip_filter(row_id)) {
+    } else if (null_value_contained && result_bitmap.test(row_id)) {
+      if (OB_FAIL(result_bitmap.set(row_id, false))) {
+        LOG_WARN("Failed to set row with null object to false", K(ret));
+      }
+    } else {
+      v = 0;
+      if (is_bit_packing) {
+        if (OB_FAIL(ObBitStream::get(col_data, data_offset + row_id * cell_len, cell_len, v))) {
+          LOG_WARN("Failed to get bit packing value", K(ret), K_(header));
+        }
+      } else {
+        MEMCPY(&v, col_data + data_offset + row_id * cell_len, cell_len);
+      }
+      bool result = false;
+      if (OB_FAIL(ret)) {
+      } else if (FALSE_IT(v = restore(v))) {
+      } else if (OB_FAIL(op(v, to_double(v), result))) {
+        LOG_WARN("Failed on trying to filter the row", K(ret), K(row_id), K(v));
+      } else if (result && OB_FAIL(result_bitmap.set(row_id))) {
+        LOG_WARN("Failed to set result bitmap", K(ret), K(row_id));
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFloatXorDecoder::get_null_count(
+    const ObColumnDecoderCtx &ctx,
+    const ObIRowIndex *row_index,
+    const int64_t *row_ids,
+    const int64_t row_cap,
+    int64_t &null_count) const
+{
+  int ret = OB_SUCCESS;
+  const char *col_data = reinterpret_cast<const char *>(header_) + ctx.col_header_->length_;
+  if (OB_UNLIKELY(!is_inited())) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Float xor decoder is not inited", K(ret));
+  } else if (OB_FAIL(ObIColumnDecoder::get_null_count_from_extend_value(
+      ctx,
+      row_index,
+      row_ids,
+      row_cap,
+      col_data,
+      null_count))) {
+    LOG_WARN("Failed to get null count", K(ctx), K(ret));
+  }
+  return ret;
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
@@ -0,0 +1,149 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_FLOAT_XOR_DECODER_H_
+#define OCEANBASE_ENCODING_OB_FLOAT_XOR_DECODER_H_
+
+#include "ob_icolumn_decoder.h"
+#include "ob_encoding_util.h"
+#include "ob_float_xor_encoder.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+struct ObColumnHeader;
+struct ObFloatXorHeader;
+
+class ObFloatXorDecoder : public ObIColumnDecoder
+{
+public:
+  static const ObColumnHeader::Type type_ = ObColumnHeader::FLOAT_XOR;
+  ObFloatXorDecoder() : header_(NULL), base_(0), is_float_(false)
+  {}
+  virtual ~ObFloatXorDecoder() {}
+
+  OB_INLINE int init(
+      const ObMicroBlockHeader &micro_block_header,
+      const ObColumnHeader &column_header,
+      const char *meta);
+
+  virtual int decode(ObColumnDecoderCtx &ctx, common::ObObj &cell, const int64_t row_id,
+      const ObBitStream &bs, const char *data, const int64_t len) const override;
+
+  virtual int update_pointer(const char *old_block, const char *cur_block) override;
+
+  void reset() { this->~ObFloatXorDecoder(); new (this) ObFloatXorDecoder(); }
+  OB_INLINE void reuse() { header_ = NULL; }
+  virtual ObColumnHeader::Type get_type() const override { return type_; }
+  bool is_inited() const { return NULL != header_; }
+
+  virtual int batch_decode(
+      const ObColumnDecoderCtx &ctx,
+      const ObIRowIndex* row_index,
+      const int64_t *row_ids,
+      const char **cell_datas,
+      const int64_t row_cap,
+      common::ObDatum *datums) const override;
+
+  virtual int pushdown_operator(
+      const sql::ObPushdownFilterExecutor *parent,
+      const ObColumnDecoderCtx &col_ctx,
+      const sql::ObWhiteFilterExecutor &filter,
+      const char* meta_data,
+      const ObIRowIndex* row_index,
+      ObBitmap &result_bitmap) const override;
+
+  virtual int get_null_count(
+      const ObColumnDecoderCtx &ctx,
+      const ObIRowIndex *row_index,
+      const int64_t *row_ids,
+      const int64_t row_cap,
+      int64_t &null_count) const override;
+private:
+  OB_INLINE uint64_t restore(const uint64_t v) const
+  {
+    return (v << header_->trailing_) ^ base_;
+  }
+  OB_INLINE double to_double(const uint64_t v) const
+  {
+    double d = 0;
+    if (is_float_) {
+      float f = 0;
+      MEMCPY(&f, &v, sizeof(f));
+      d = f;
+    } else {
+      MEMCPY(&d, &v, sizeof(d));
+    }
+    return d;
+  }
+  int obj_to_double(
+      const ObColumnDecoderCtx &col_ctx,
+      const common::ObObj &obj,
+      double &value) const;
+
+  template <ObBitStream::ObBitStreamUnpackType UNPACK_TYPE>
+  void batch_unpack_values(
+      const ObColumnDecoderCtx &ctx,
+      const int64_t *row_ids,
+      const int64_t row_cap,
+      const int64_t datum_len,
+      const int64_t data_offset,
+      common::ObDatum *datums) const;
+
+  template <typename Op>
+  int traverse_all_data(
+      const sql::ObPushdownFilterExecutor *parent,
+      const ObColumnDecoderCtx &col_ctx,
+      const unsigned char* col_data,
+      Op &op,
+      ObBitmap &result_bitmap) const;
+private:
+  const ObFloatXorHeader *header_;
+  uint64_t base_;
+  bool is_float_;
+};
+
+OB_INLINE int ObFloatXorDecoder::init(
+    const ObMicroBlockHeader &micro_block_header,
+    const ObColumnHeader &column_header,
+    const char *meta)
+{
+  UNUSED(micro_block_header);
+  int ret = common::OB_SUCCESS;
+  // performance critical, don't check params
+  if (is_inited()) {
+    ret = common::OB_INIT_TWICE;
+    STORAGE_LOG(WARN, "init twice", K(ret));
+  } else {
+    const int64_t store_size = get_type_size_map()[column_header.get_store_obj_type()];
+    const common::ObObjTypeClass tc = ob_obj_type_class(column_header.get_store_obj_type());
+    if (common::ObFloatTC != tc && common::ObDoubleTC != tc) {
+      ret = common::OB_INNER_STAT_ERROR;
+      STORAGE_LOG(WARN, "not supported type class", K(ret), K(column_header), K(tc));
+    } else {
+      meta += column_header.offset_;
+      header_ = reinterpret_cast<const ObFloatXorHeader *>(meta);
+      base_ = 0;
+      MEMCPY(&base_, meta + sizeof(*header_), store_size);
+      is_float_ = common::ObFloatTC == tc;
+    }
+  }
+  return ret;
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
+
+#endif // OCEANBASE_ENCODING_OB_FLOAT_XOR_DECODER_H_
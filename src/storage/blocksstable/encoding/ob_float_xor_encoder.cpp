@@ -0,0 +1,189 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_float_xor_encoder.h"
+
+#include "storage/blocksstable/ob_data_buffer.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+using namespace common;
+
+const ObColumnHeader::Type ObFloatXorEncoder::type_;
+
+ObFloatXorEncoder::ObFloatXorEncoder()
+  : type_store_size_(0), base_(0), trailing_(0), header_(NULL)
+{
+}
+
+int ObFloatXorEncoder::init(
+    const ObColumnEncodingCtx &ctx,
+    const int64_t column_index,
+    const ObConstDatumRowArray &rows)
+{
+  int ret = OB_SUCCESS;
+  if (IS_INIT) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("init twice", K(ret));
+  } else if (OB_FAIL(ObIColumnEncoder::init(ctx, column_index, rows))) {
+    LOG_WARN("init base column encoder failed",
+        K(ret), K(ctx), K(column_index), "row count", rows.count());
+  } else {
+    const ObObjTypeClass tc = ob_obj_type_class(column_type_.get_type());
+    type_store_size_ = get_type_size_map()[column_type_.get_type()];
+    if ((ObFloatTC != tc && ObDoubleTC != tc)
+        || (sizeof(float) != type_store_size_ && sizeof(double) != type_store_size_)) {
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("not supported type for float xor", K(ret), K(tc), K_(type_store_size),
+          K_(column_index));
+    } else {
+      column_header_.type_ = type_;
+    }
+  }
+  return ret;
+}
+
+void ObFloatXorEncoder::reuse()
+{
+  ObIColumnEncoder::reuse();
+  type_store_size_ = 0;
+  base_ = 0;
+  trailing_ = 0;
+  header_ = NULL;
+  is_inited_ = false;
+}
+
+int ObFloatXorEncoder::traverse(bool &suitable)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    suitable = false;
+    bool has_base = false;
+    uint64_t xor_bits = 0;
+    for (int64_t i = 0; i < ctx_->col_datums_->count(); ++i) {
+      const ObDatum &datum = ctx_->col_datums_->at(i);
+      if (!datum.is_null() && !datum.is_nop()) {
+        uint64_t v = 0;
+        MEMCPY(&v, datum.ptr_, type_store_size_);
+        if (!has_base) {
+          base_ = v;
+          has_base = true;
+        } else {
+          xor_bits |= v ^ base_;
+        }
+      }
+    }
+
+    if (!has_base || 0 == xor_bits) {
+      // all values are null or same, leave it to const encoder
+    } else {
+      const bool enable_bit_packing = ctx_->encoding_ctx_->encoder_opt_.enable_bit_packing_;
+      trailing_ = __builtin_ctzl(xor_bits);
+      bool bit_packing = false;
+      int64_t xor_size = get_packing_size(bit_packing, xor_bits >> trailing_, enable_bit_packing);
+      if (!bit_packing) {
+        xor_size *= CHAR_BIT;
+      }
+      const int64_t orig_size = type_store_size_ * CHAR_BIT;
+      LOG_DEBUG("float xor size", K_(column_index), K(xor_size), K(orig_size), K_(trailing));
+      if ((orig_size - xor_size) * rows_->count()
+          > (sizeof(*header_) + type_store_size_) * CHAR_BIT) {
+        suitable = true;
+        if (bit_packing) {
+          desc_.bit_packing_length_ = xor_size;
+        } else {
+          desc_.fix_data_length_ = xor_size / CHAR_BIT;
+        }
+        desc_.need_data_store_ = true;
+        desc_.has_null_ = ctx_->null_cnt_ > 0;
+        desc_.has_nope_ = ctx_->nope_cnt_ > 0;
+        desc_.need_extend_value_bit_store_ = desc_.has_null_ || desc_.has_nope_;
+        if (desc_.need_extend_value_bit_store_) {
+          column_header_.set_has_extend_value_attr();
+        }
+        if (desc_.bit_packing_length_ > 0) {
+          column_header_.set_bit_packing_attr();
+        }
+        column_header_.set_fix_lenght_attr();
+      }
+    }
+  }
+  return ret;
+}
+
+int ObFloatXorEncoder::store_meta(ObBufferWriter &buf_writer)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else {
+    char *data = buf_writer.current();
+    header_ = reinterpret_cast<ObFloatXorHeader *>(data);
+    data += sizeof(*header_);
+    if (OB_FAIL(buf_writer.advance_zero(sizeof(*header_) + type_store_size_))) {
+      LOG_WARN("advance meta store size failed", K(ret), K_(type_store_size));
+    } else {
+      header_->version_ = ObFloatXorHeader::OB_FLOAT_XOR_HEADER_V1;
+      header_->trailing_ = static_cast<uint8_t>(trailing_);
+      MEMCPY(data, &base_, type_store_size_);
+    }
+  }
+  return ret;
+}
+
+int64_t ObFloatXorEncoder::calc_size() const
+{
+  int64_t size = INT64_MAX;
+  if (is_inited_) {
+    if (desc_.bit_packing_length_ > 0) {
+      size = (rows_->count() * desc_.bit_packing_length_ + CHAR_BIT - 1) / CHAR_BIT;
+    } else {
+      size = rows_->count() * desc_.fix_data_length_;
+    }
+  }
+  return size + sizeof(*header_) + type_store_size_;
+}
+
+int ObFloatXorEncoder::store_fix_data(ObBufferWriter &buf_writer)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(!is_inited_)) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("not init", K(ret));
+  } else if (OB_UNLIKELY(!is_valid_fix_encoder())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("invalid argument", K(ret), K_(desc));
+  } else {
+    XorValueGetter getter(*this);
+    FixDataSetter setter(*this);
+    header_->length_ = static_cast<uint8_t>(desc_.bit_packing_length_ > 0
+        ? desc_.bit_packing_length_
+        : desc_.fix_data_length_);
+    if (OB_FAIL(fill_column_store(buf_writer, *ctx_->col_datums_, getter, setter))) {
+      LOG_WARN("fill column store failed", K(ret));
+    }
+  }
+  return ret;
+}
+
+} // end namespace blocksstable
+} // end namespace oceanbase
@@ -0,0 +1,121 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_ENCODING_OB_FLOAT_XOR_ENCODER_H_
+#define OCEANBASE_ENCODING_OB_FLOAT_XOR_ENCODER_H_
+
+#include "ob_icolumn_encoder.h"
+#include "ob_encoding_util.h"
+#include "ob_bit_stream.h"
+
+namespace oceanbase
+{
+namespace blocksstable
+{
+
+// meta: ObFloatXorHeader | base value (type store size)
+// data: ((bits(v) ^ base) >> trailing_) for each row, bit packed or fix length stored.
+// the leading and trailing zero bits common to all xor values are stripped, so neighbouring
+// floats sharing sign, exponent and high mantissa bits are stored in a few bits,
+// and every row is still random accessible.
+struct ObFloatXorHeader
+{
+  static constexpr uint8_t OB_FLOAT_XOR_HEADER_V1 = 0;
+  uint8_t version_;
+  uint8_t length_;
+  uint8_t trailing_;
+
+  ObFloatXorHeader()
+    : version_(OB_FLOAT_XOR_HEADER_V1), length_(0), trailing_(0)
+  {
+  }
+
+  TO_STRING_KV(K_(version), K_(length), K_(trailing));
+} __attribute__((packed));
+
+class ObFloatXorEncoder : public ObIColumnEncoder
+{
+public:
+  static const ObColumnHeader::Type type_ = ObColumnHeader::FLOAT_XOR;
+
+  ObFloatXorEncoder();
+  virtual ~ObFloatXorEncoder() {}
+
+  virtual int init(
+      const ObColumnEncodingCtx &ctx,
+      const int64_t column_index,
+      const ObConstDatumRowArray &rows) override;
+
+  virtual void reuse() override;
+  virtual int store_meta(ObBufferWriter &buf_writer) override;
+  virtual int store_data(
+      const int64_t row_id, ObBitStream &bs, char *buf, const int64_t len) override
+  {
+    UNUSEDx(row_id, bs, buf, len);
+    return common::OB_NOT_SUPPORTED;
+  }
+
+  virtual int traverse(bool &suitable) override;
+  virtual int64_t calc_size() const override;
+  virtual ObColumnHeader::Type get_type() const { return type_; }
+  virtual int store_fix_data(ObBufferWriter &buf_writer) override;
+
+  OB_INLINE uint64_t get_xor_value(const common::ObDatum &datum) const
+  {
+    uint64_t v = 0;
+    MEMCPY(&v, datum.ptr_, type_store_size_);
+    return (v ^ base_) >> trailing_;
+  }
+
+public:
+  struct XorValueGetter
+  {
+    explicit XorValueGetter(const ObFloatXorEncoder &encoder) : encoder_(encoder) {}
+    inline int operator()(const int64_t, const common::ObDatum &datum, uint64_t &v)
+    {
+      v = encoder_.get_xor_value(datum);
+      return common::OB_SUCCESS;
+    }
+
+    const ObFloatXorEncoder &encoder_;
+  };
+
+  struct FixDataSetter
+  {
+    explicit FixDataSetter(const ObFloatXorEncoder &encoder) : encoder_(encoder) {}
+    inline int operator()(
+        const int64_t,
+        const common::ObDatum &datum,
+        char *buf,
+        const int64_t len) const
+    {
+      // performance critical, do not check parameters
+      uint64_t v = encoder_.get_xor_value(datum);
+      MEMCPY(buf, &v, len);
+      return common::OB_SUCCESS;
+    }
+
+    const ObFloatXorEncoder &encoder_;
+  };
+
+private:
+  int64_t type_store_size_;
+  uint64_t base_;
+  int64_t trailing_;
+  // is null before write meta
+  ObFloatXorHeader *header_;
+};
+
+} // end namespace blocksstable
+} // end namespace oceanbase
+
+#endif // OCEANBASE_ENCODING_OB_FLOAT_XOR_ENCODER_H_
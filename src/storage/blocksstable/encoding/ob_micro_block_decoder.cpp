@@ -271,7 +271,9 @@ ObIEncodeBlockReader::decode_acquire_func ObIEncodeBlockReader::acquire_funcs_[O
     acquire_decoder<ObHexStringDecoder>,
     acquire_decoder<ObStringPrefixDecoder>,
     acquire_decoder<ObColumnEqualDecoder>,
-    acquire_decoder<ObInterColSubStrDecoder>
+    acquire_decoder<ObInterColSubStrDecoder>,
+    acquire_decoder<ObFloatXorDecoder>,
+    acquire_decoder<ObDeltaOfDeltaDecoder>
 };
 
 ObIEncodeBlockReader::ObIEncodeBlockReader()
@@ -1016,6 +1018,28 @@ int ObMicroBlockDecoder::acquire(
         }
         break;
       }
+      case ObColumnHeader::FLOAT_XOR: {
+        ObFloatXorDecoder *d = NULL;
+        if (OB_FAIL(allocator.alloc(d))) {
+          LOG_WARN("alloc failed", K(ret));
+        } else if (OB_FAIL(d->init(header, col_header, meta_data))) {
+          LOG_WARN("init float xor decoder failed", K(ret));
+        } else {
+          decoder = d;
+        }
+        break;
+      }
+      case ObColumnHeader::DELTA_OF_DELTA: {
+        ObDeltaOfDeltaDecoder *d = NULL;
+        if (OB_FAIL(allocator.alloc(d))) {
+          LOG_WARN("alloc failed", K(ret));
+        } else if (OB_FAIL(d->init(header, col_header, meta_data))) {
+          LOG_WARN("init delta of delta decoder failed", K(ret));
+        } else {
+          decoder = d;
+        }
+        break;
+      }
       default:
         ret = OB_INNER_STAT_ERROR;
         LOG_WARN("unsupported encoding type", K(ret), "type", col_header.type_);
@@ -23,6 +23,8 @@
 #include "ob_raw_encoder.h"
 #include "ob_dict_encoder.h"
 #include "ob_integer_base_diff_encoder.h"
+#include "ob_float_xor_encoder.h"
+#include "ob_delta_of_delta_encoder.h"
 #include "ob_string_diff_encoder.h"
 #include "ob_hex_string_encoder.h"
 #include "ob_rle_encoder.h"
@@ -1311,6 +1313,14 @@ int ObMicroBlockEncoder::try_encoder(ObIColumnEncoder *&e, const int64_t column_
               : try_span_column_encoder<ObInterColSubStrEncoder>(e, column_index);
         break;
       }
+      case ObColumnHeader::FLOAT_XOR: {
+        ret = try_encoder<ObFloatXorEncoder>(e, column_index);
+        break;
+      }
+      case ObColumnHeader::DELTA_OF_DELTA: {
+        ret = try_encoder<ObDeltaOfDeltaEncoder>(e, column_index);
+        break;
+      }
       default:
         ret = OB_ERR_UNEXPECTED;
         LOG_WARN("unknown encoding type", K(ret), K(type));
@@ -1618,6 +1628,42 @@ int ObMicroBlockEncoder::choose_encoder(const int64_t column_idx,
       }
     }
 
+    if (OB_SUCC(ret) && try_more && ctx_.enable_delta_of_delta_encoding_
+        && (ObIntSC == sc || ObUIntSC == sc) && ObFloatTC != tc && ObDoubleTC != tc) {
+      if (cc.detected_encoders_[ObDeltaOfDeltaEncoder::type_]) {
+      } else if (OB_FAIL(try_encoder<ObDeltaOfDeltaEncoder>(e, column_idx))) {
+        LOG_WARN("try delta of delta encoder failed", K(ret), K(column_idx));
+      } else if (NULL != e) {
+        int64_t size = e->calc_size();
+        if (size < choose->calc_size()) {
+          free_encoder(choose);
+          choose = e;
+          try_more = size <= acceptable_size;
+        } else {
+          free_encoder(e);
+          e = NULL;
+        }
+      }
+    }
+
+    if (OB_SUCC(ret) && try_more && ctx_.enable_float_xor_encoding_
+        && (ObFloatTC == tc || ObDoubleTC == tc)) {
+      if (cc.detected_encoders_[ObFloatXorEncoder::type_]) {
+      } else if (OB_FAIL(try_encoder<ObFloatXorEncoder>(e, column_idx))) {
+        LOG_WARN("try float xor encoder failed", K(ret), K(column_idx));
+      } else if (NULL != e) {
+        int64_t size = e->calc_size();
+        if (size < choose->calc_size()) {
+          free_encoder(choose);
+          choose = e;
+          try_more = size <= acceptable_size;
+        } else {
+          free_encoder(e);
+          e = NULL;
+        }
+      }
+    }
+
     bool string_diff_suitable = false;
     if (OB_SUCC(ret) && try_more) {
       if (is_string_encoding_valid(sc) && cc.fix_data_size_ > 0) {
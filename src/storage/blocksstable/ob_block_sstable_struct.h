@@ -292,6 +292,8 @@ struct ObColumnHeader
     STRING_PREFIX,
     COLUMN_EQUAL,
     COLUMN_SUBSTR,
+    FLOAT_XOR,
+    DELTA_OF_DELTA,
     MAX_TYPE
   };
 
@@ -387,6 +389,8 @@ struct ObMicroBlockEncoderOpt
   bool &enable_rle() { return enable(ObColumnHeader::RLE); }
   bool &enable_const() { return enable(ObColumnHeader::CONST); }
   bool &enable_str_prefix() { return enable(ObColumnHeader::STRING_PREFIX); }
+  bool &enable_float_xor() { return enable(ObColumnHeader::FLOAT_XOR); }
+  bool &enable_delta_of_delta() { return enable(ObColumnHeader::DELTA_OF_DELTA); }
 
   const bool &enable_raw() const { return enable(ObColumnHeader::RAW); }
   const bool &enable_dict() const { return enable(ObColumnHeader::DICT); }
@@ -396,6 +400,8 @@ struct ObMicroBlockEncoderOpt
   const bool &enable_rle() const { return enable(ObColumnHeader::RLE); }
   const bool &enable_const() const { return enable(ObColumnHeader::CONST); }
   const bool &enable_str_prefix() const { return enable(ObColumnHeader::STRING_PREFIX); }
+  const bool &enable_float_xor() const { return enable(ObColumnHeader::FLOAT_XOR); }
+  const bool &enable_delta_of_delta() const { return enable(ObColumnHeader::DELTA_OF_DELTA); }
 
   ObMicroBlockEncoderOpt() { set_store_type(ENCODING_ROW_STORE); }
 
@@ -424,7 +430,8 @@ struct ObMicroBlockEncoderOpt
 #define KF(f) #f, f()
   TO_STRING_KV(K_(enable_bit_packing), K_(store_sorted_var_len_numbers_dict),
       KF(enable_raw), KF(enable_dict), KF(enable_int_diff), KF(enable_str_diff),
-      KF(enable_hex_pack), KF(enable_rle),KF(enable_const));
+      KF(enable_hex_pack), KF(enable_rle),KF(enable_const), KF(enable_float_xor),
+      KF(enable_delta_of_delta));
 #undef KF
 };
 
@@ -538,19 +545,24 @@ struct ObMicroBlockEncodingCtx
   int64_t major_working_cluster_version_;
   common::ObRowStoreType row_store_type_;
   bool need_calc_column_chksum_;
+  // new on-disk encoding types are only chosen when turned on by tenant parameter
+  bool enable_float_xor_encoding_;
+  bool enable_delta_of_delta_encoding_;
 
   ObMicroBlockEncodingCtx() : macro_block_size_(0), micro_block_size_(0),
     rowkey_column_cnt_(0), column_cnt_(0), col_descs_(nullptr),
     encoder_opt_(), estimate_block_size_(0), real_block_size_(0), micro_block_cnt_(0),
     column_encodings_(nullptr), major_working_cluster_version_(0),
-    row_store_type_(ENCODING_ROW_STORE), need_calc_column_chksum_(false)
+    row_store_type_(ENCODING_ROW_STORE), need_calc_column_chksum_(false),
+    enable_float_xor_encoding_(false), enable_delta_of_delta_encoding_(false)
   {
   }
   bool is_valid() const;
   TO_STRING_KV(K_(macro_block_size), K_(micro_block_size), K_(rowkey_column_cnt),
       K_(column_cnt), KP_(col_descs), K_(estimate_block_size), K_(real_block_size),
       K_(micro_block_cnt), K_(encoder_opt), K_(previous_encodings), KP_(column_encodings),
-      K_(major_working_cluster_version), K_(row_store_type), K_(need_calc_column_chksum));
+      K_(major_working_cluster_version), K_(row_store_type), K_(need_calc_column_chksum),
+      K_(enable_float_xor_encoding), K_(enable_delta_of_delta_encoding));
 };
 
 template <typename T, int64_t MAX_COUNT, int64_t BLOCK_SIZE>
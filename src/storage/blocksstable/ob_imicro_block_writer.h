@@ -27,6 +27,7 @@ namespace oceanbase
 {
 namespace blocksstable
 {
+struct ObSkipIndexColMeta;
 struct ObMicroBlockDesc
 {
   ObDatumRowkey last_rowkey_;
@@ -48,6 +49,9 @@ struct ObMicroBlockDesc
   bool has_string_out_row_;
   bool has_lob_out_row_;
   bool is_last_row_last_flag_;
+  // skip index aggregated on rows of this micro block
+  const ObSkipIndexColMeta *skip_index_cols_;
+  int64_t skip_index_col_cnt_;
 
   ObMicroBlockDesc() { reset(); }
   bool is_valid() const;
@@ -72,7 +76,8 @@ struct ObMicroBlockDesc
       K_(has_string_out_row),
       K_(has_lob_out_row),
       K_(is_last_row_last_flag),
-      K_(original_size));
+      K_(original_size),
+      K_(skip_index_col_cnt));
 };
 enum MICRO_BLOCK_MERGE_VERIFY_LEVEL
 {
@@ -460,6 +460,8 @@ int ObSSTableIndexBuilder::init(const ObDataStoreDesc &index_desc,
     optimization_mode_ = mode;
     index_store_desc_.need_build_hash_index_for_micro_block_ = false;
     container_store_desc_.need_build_hash_index_for_micro_block_ = false;
+    index_store_desc_.need_build_skip_index_ = false;
+    container_store_desc_.need_build_skip_index_ = false;
     is_inited_ = true;
   }
   STORAGE_LOG(DEBUG, "init sstable index builder", K(ret), K(index_desc), K_(index_store_desc));
@@ -1125,6 +1127,7 @@ ObBaseIndexBlockBuilder::ObBaseIndexBlockBuilder()
    has_string_out_row_(false),
    has_lob_out_row_(false),
    is_last_row_last_flag_(false),
+   skip_index_aggregator_(),
    next_level_builder_(nullptr),
    level_(0)
 {
@@ -1251,6 +1254,7 @@ int ObBaseIndexBlockBuilder::append_row(const ObIndexBlockRowDesc &row_desc)
     macro_block_count_ += row_desc.macro_block_count_;
     // use the flag of the last row in last micro block
     is_last_row_last_flag_ = row_desc.is_last_row_last_flag_;
+    skip_index_aggregator_.eval(row_desc.skip_index_cols_, row_desc.skip_index_col_cnt_);
   }
   return ret;
 }
@@ -1429,6 +1433,7 @@ void ObBaseIndexBlockBuilder::update_accumulative_info(ObIndexBlockRowDesc &next
   next_row_desc.macro_block_count_ = macro_block_count_;
   next_row_desc.micro_block_count_ = micro_block_count_;
   next_row_desc.is_last_row_last_flag_ = is_last_row_last_flag_;
+  skip_index_aggregator_.get_aggregated_cols(next_row_desc.skip_index_cols_, next_row_desc.skip_index_col_cnt_);
 }
 
 int ObBaseIndexBlockBuilder::close_index_tree(ObBaseIndexBlockBuilder *&root_builder)
@@ -1471,6 +1476,8 @@ void ObBaseIndexBlockBuilder::block_to_row_desc(
   row_desc.has_string_out_row_ = micro_block_desc.has_string_out_row_;
   row_desc.has_lob_out_row_ = micro_block_desc.has_lob_out_row_;
   row_desc.is_last_row_last_flag_ = micro_block_desc.is_last_row_last_flag_;
+  row_desc.skip_index_cols_ = micro_block_desc.skip_index_cols_;
+  row_desc.skip_index_col_cnt_ = micro_block_desc.skip_index_col_cnt_;
 }
 
 int ObBaseIndexBlockBuilder::meta_to_row_desc(
@@ -1510,14 +1517,17 @@ int ObBaseIndexBlockBuilder::meta_to_row_desc(
     row_desc.macro_block_count_ = 1;
     row_desc.has_string_out_row_ = macro_meta.val_.has_string_out_row_;
     row_desc.has_lob_out_row_ = !macro_meta.val_.all_lob_in_row_;
+    row_desc.skip_index_cols_ = macro_meta.val_.skip_index_cols_.get_data();
+    row_desc.skip_index_col_cnt_ = macro_meta.val_.skip_index_cols_.count();
   }
   return ret;
 }
 
-void ObBaseIndexBlockBuilder::row_desc_to_meta(
+int ObBaseIndexBlockBuilder::row_desc_to_meta(
     const ObIndexBlockRowDesc &macro_row_desc,
     ObDataMacroBlockMeta &macro_meta)
 {
+  int ret = OB_SUCCESS;
   macro_meta.end_key_ = macro_row_desc.row_key_;
   macro_meta.val_.macro_id_ = macro_row_desc.macro_id_; // DEFAULT_IDX_ROW_MACRO_ID
   macro_meta.val_.block_offset_ = macro_row_desc.block_offset_;
@@ -1530,6 +1540,13 @@ void ObBaseIndexBlockBuilder::row_desc_to_meta(
   macro_meta.val_.has_string_out_row_ = macro_row_desc.has_string_out_row_;
   macro_meta.val_.all_lob_in_row_ = !macro_row_desc.has_lob_out_row_;
   macro_meta.val_.is_last_row_last_flag_ = macro_row_desc.is_last_row_last_flag_;
+  macro_meta.val_.skip_index_cols_.reuse();
+  for (int64_t i = 0; OB_SUCC(ret) && i < macro_row_desc.skip_index_col_cnt_; ++i) {
+    if (OB_FAIL(macro_meta.val_.skip_index_cols_.push_back(macro_row_desc.skip_index_cols_[i]))) {
+      STORAGE_LOG(WARN, "fail to push back skip index col", K(ret), K(i));
+    }
+  }
+  return ret;
 }
 
 
@@ -1546,6 +1563,7 @@ void ObBaseIndexBlockBuilder::reset_accumulative_info()
   is_last_row_last_flag_ = false;
   macro_block_count_ = 0;
   micro_block_count_ = 0;
+  skip_index_aggregator_.reuse();
 }
 
 int ObBaseIndexBlockBuilder::new_next_builder(ObBaseIndexBlockBuilder *&next_builder)
@@ -1748,6 +1766,20 @@ int ObDataIndexBlockBuilder::cal_macro_meta_block_size(
     macro_meta.val_.macro_id_ = ObIndexBlockRowHeader::DEFAULT_IDX_ROW_MACRO_ID;
     meta_row_.reuse();
     row_allocator_.reuse();
+    if (data_store_desc_->need_build_skip_index_) {
+      // reserve for the largest encoding of every possible skip index column
+      ObSkipIndexColMeta max_col_meta;
+      max_col_meta.col_idx_ = -1;
+      max_col_meta.flag_ = UINT16_MAX;
+      max_col_meta.null_count_ = UINT32_MAX;
+      max_col_meta.min_ = INT64_MIN;
+      max_col_meta.max_ = INT64_MIN;
+      for (int64_t i = 0; OB_SUCC(ret) && i < ObSkipIndexAggregator::MAX_SKIP_INDEX_COL_CNT; ++i) {
+        if (OB_FAIL(macro_meta.val_.skip_index_cols_.push_back(max_col_meta))) {
+          STORAGE_LOG(WARN, "fail to push back skip index col", K(ret), K(i));
+        }
+      }
+    }
     if (OB_FAIL(ret)) {
     } else if (OB_FAIL(macro_meta.build_estimate_row(meta_row_, row_allocator_))) {
       STORAGE_LOG(WARN, "fail to build meta row", K(ret), K(macro_meta));
@@ -1879,7 +1911,8 @@ int ObDataIndexBlockBuilder::write_meta_block(
       != macro_row_desc.micro_block_count_)) {
     ret = OB_ERR_UNEXPECTED;
     STORAGE_LOG(WARN, "check micro block count failed", K(ret), K_(macro_meta), K(macro_row_desc));
-  } else if (FALSE_IT(row_desc_to_meta(macro_row_desc, macro_meta_))) {
+  } else if (OB_FAIL(row_desc_to_meta(macro_row_desc, macro_meta_))) {
+    STORAGE_LOG(WARN, "fail to convert row desc to macro meta", K(ret), K(macro_row_desc));
   } else if (OB_FAIL(macro_meta_.build_row(meta_row_, row_allocator_))) {
     STORAGE_LOG(WARN, "fail to build row", K(ret), K_(macro_meta));
   } else if (OB_FAIL(meta_block_writer_->append_row(meta_row_))) {
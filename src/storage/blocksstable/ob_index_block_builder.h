@@ -258,7 +258,7 @@ protected:
   int meta_to_row_desc(
       const ObDataMacroBlockMeta &macro_meta,
       ObIndexBlockRowDesc &row_desc);
-  void row_desc_to_meta(
+  int row_desc_to_meta(
       const ObIndexBlockRowDesc &macro_row_desc,
       ObDataMacroBlockMeta &macro_meta);
   int64_t get_row_count() { return micro_writer_->get_row_count(); }
@@ -291,6 +291,7 @@ protected:
   bool has_string_out_row_;
   bool has_lob_out_row_;
   bool is_last_row_last_flag_;
+  ObSkipIndexAggregator skip_index_aggregator_;
 private:
   ObBaseIndexBlockBuilder *next_level_builder_;
   int64_t level_; // default 0
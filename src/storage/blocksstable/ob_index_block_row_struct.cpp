@@ -24,7 +24,7 @@ namespace blocksstable
 {
 
 ObIndexBlockRowDesc::ObIndexBlockRowDesc()
-  : data_store_desc_(nullptr), row_key_(), macro_id_(), block_offset_(0),
+  : data_store_desc_(nullptr), skip_index_cols_(nullptr), skip_index_col_cnt_(0), row_key_(), macro_id_(), block_offset_(0),
     row_count_(0), row_count_delta_(0), max_merged_trans_version_(0), block_size_(0),
     macro_block_count_(0), micro_block_count_(0),
     is_deleted_(false), contain_uncommitted_row_(false), is_data_block_(false),
@@ -32,7 +32,7 @@ ObIndexBlockRowDesc::ObIndexBlockRowDesc()
     is_last_row_last_flag_(false) {}
 
 ObIndexBlockRowDesc::ObIndexBlockRowDesc(ObDataStoreDesc &data_store_desc)
-  : data_store_desc_(&data_store_desc), row_key_(), macro_id_(), block_offset_(0),
+  : data_store_desc_(&data_store_desc), skip_index_cols_(nullptr), skip_index_col_cnt_(0), row_key_(), macro_id_(), block_offset_(0),
     row_count_(0), row_count_delta_(0), max_merged_trans_version_(0), block_size_(0),
     macro_block_count_(0), micro_block_count_(0),
     is_deleted_(false), contain_uncommitted_row_(false), is_data_block_(false),
@@ -247,10 +247,9 @@ int ObIndexBlockRowBuilder::calc_data_size(const ObIndexBlockRowDesc &desc, int6
     size = sizeof(ObIndexBlockRowHeader);
   } else if (MAJOR_MERGE == desc.data_store_desc_->merge_type_) {
     size = sizeof(ObIndexBlockRowHeader);
-    // if (desc.is_pre_aggregated_) {
-      // TODO: @saitong.zst Calculate aggregate size here
-      // size += aggregate_size;
-    // }
+    if (desc.skip_index_col_cnt_ > 0) {
+      size += ObSkipIndexRowHeader::calc_size(desc.skip_index_col_cnt_);
+    }
   } else {
     size = sizeof(ObIndexBlockRowHeader) + sizeof(ObIndexBlockRowMinorMetaInfo);
   }
@@ -270,6 +269,9 @@ int ObIndexBlockRowBuilder::calc_data_size(
     size = sizeof(ObIndexBlockRowHeader);
   } else if (idx_row_header.is_major_node()) {
     size = sizeof(ObIndexBlockRowHeader);
+    if (idx_row_header.is_pre_aggregated()) {
+      size += idx_row_header.get_skip_index()->get_size();
+    }
   } else {
     size = sizeof(ObIndexBlockRowHeader) + sizeof(ObIndexBlockRowMinorMetaInfo);
   }
@@ -295,7 +297,8 @@ int ObIndexBlockRowBuilder::append_header_and_meta(const ObIndexBlockRowDesc &de
     header_->is_major_node_ = desc.data_store_desc_->merge_type_ == MAJOR_MERGE;
     header_->has_string_out_row_ = desc.has_string_out_row_;
     header_->all_lob_in_row_ = !desc.has_lob_out_row_;
-    // header_->is_pre_aggregated_ =
+    header_->is_pre_aggregated_ = is_data_mid_micro_block && header_->is_major_node_
+        && desc.skip_index_col_cnt_ > 0;
     header_->is_deleted_ = desc.is_deleted_;
     header_->macro_id_ =(desc.is_data_block_ && is_data_mid_micro_block)
         ? ObIndexBlockRowHeader::DEFAULT_IDX_ROW_MACRO_ID : desc.macro_id_;
@@ -329,13 +332,21 @@ int ObIndexBlockRowBuilder::append_header_and_meta(const ObIndexBlockRowDesc &de
 int ObIndexBlockRowBuilder::append_aggregate_data(const ObIndexBlockRowDesc &desc)
 {
   int ret = OB_SUCCESS;
-  UNUSED(desc);
   if (OB_ISNULL(header_)) {
     ret = OB_ERR_UNEXPECTED;
     LOG_WARN("Fail to append aggregation data to buffer", K(ret), KP_(header));
   } else if (!header_->is_pre_aggregated()) {
+  } else if (OB_ISNULL(desc.skip_index_cols_)
+      || OB_UNLIKELY(desc.skip_index_col_cnt_ > ObSkipIndexAggregator::MAX_SKIP_INDEX_COL_CNT)) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid skip index columns", K(ret), KP(desc.skip_index_cols_), K(desc.skip_index_col_cnt_));
   } else {
-    // TODO: @saitong.zst Write aggregate data here
+    ObSkipIndexRowHeader *skip_index = reinterpret_cast<ObSkipIndexRowHeader *>(data_buf_ + write_pos_);
+    skip_index->version_ = ObSkipIndexRowHeader::SKIP_INDEX_VERSION_V1;
+    skip_index->col_cnt_ = static_cast<uint16_t>(desc.skip_index_col_cnt_);
+    write_pos_ += sizeof(ObSkipIndexRowHeader);
+    MEMCPY(data_buf_ + write_pos_, desc.skip_index_cols_, desc.skip_index_col_cnt_ * sizeof(ObSkipIndexColMeta));
+    write_pos_ += desc.skip_index_col_cnt_ * sizeof(ObSkipIndexColMeta);
   }
   return ret;
 }
@@ -384,7 +395,12 @@ int ObIndexBlockRowParser::init(const char *data_buf)
       data_buf + minor_meta_offset);
   }
 
-  // TODO: @saitong.zst locate aggregated data logic here
+  if (OB_FAIL(ret) || nullptr == header_ || !header_->is_pre_aggregated()) {
+  } else if (OB_ISNULL(header_->get_skip_index()) || OB_UNLIKELY(!header_->get_skip_index()->is_valid())) {
+    ret = OB_ERR_UNEXPECTED;
+    LOG_ERROR("Invalid skip index parsed from data", K(ret), KPC(header_));
+    header_ = nullptr;
+  }
 
   if (OB_SUCC(ret)) {
     is_inited_ = true;
@@ -18,6 +18,7 @@
 #include "ob_data_buffer.h"
 #include "ob_macro_block.h"
 #include "ob_datum_row.h"
+#include "ob_skip_index.h"
 
 namespace oceanbase
 {
@@ -49,8 +50,9 @@ struct ObIndexBlockRowDesc
     return ret;
   }
 
-  // const ObSSTablePreAggreator *aggregator_;
   const ObDataStoreDesc *data_store_desc_;
+  const ObSkipIndexColMeta *skip_index_cols_;
+  int64_t skip_index_col_cnt_;
   ObDatumRowkey row_key_;
   MacroBlockId macro_id_;
   int64_t block_offset_;
@@ -75,7 +77,7 @@ struct ObIndexBlockRowDesc
       K_(macro_block_count), K_(micro_block_count),
       K_(is_deleted), K_(contain_uncommitted_row), K_(is_data_block),
       K_(is_secondary_meta), K_(is_macro_node), K_(has_string_out_row), K_(has_lob_out_row),
-      K_(is_last_row_last_flag));
+      K_(is_last_row_last_flag), KP_(skip_index_cols), K_(skip_index_col_cnt));
 };
 
 struct ObIndexBlockRowHeader
@@ -132,6 +134,12 @@ struct ObIndexBlockRowHeader
   OB_INLINE bool is_data_index() const { return 1 == is_data_index_; }
   OB_INLINE bool has_string_out_row() const { return 1 == has_string_out_row_; }
   OB_INLINE bool has_lob_out_row() const { return 0 == all_lob_in_row_; }
+  // skip index is only written right after the header of major data index rows
+  OB_INLINE const ObSkipIndexRowHeader *get_skip_index() const
+  {
+    return (is_pre_aggregated() && is_major_node() && is_data_index())
+        ? reinterpret_cast<const ObSkipIndexRowHeader *>(this + 1) : nullptr;
+  }
 
   OB_INLINE void set_data_block() { is_data_block_ = 1; }
   OB_INLINE void set_leaf_block() { is_leaf_block_ = 1; }
@@ -305,6 +313,11 @@ public:
     OB_ASSERT(nullptr != row_header_);
     return row_header_->has_lob_out_row();
   }
+  OB_INLINE const ObSkipIndexRowHeader *get_skip_index() const
+  {
+    OB_ASSERT(nullptr != row_header_);
+    return row_header_->get_skip_index();
+  }
   OB_INLINE bool is_left_border() const
   {
     return is_left_border_;
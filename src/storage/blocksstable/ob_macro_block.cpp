@@ -17,6 +17,7 @@
 #include "ob_macro_block.h"
 #include "ob_micro_block_hash_index.h"
 #include "observer/ob_server_struct.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 #include "share/ob_encryption_util.h"
 #include "share/ob_force_print_log.h"
 #include "share/ob_task_define.h"
@@ -218,6 +219,9 @@ int ObDataStoreDesc::init(
       STORAGE_LOG(WARN, "Failed to make the row store type", K(ret));
     } else if (encoding_enabled()) {
       encoder_opt_.set_store_type(row_store_type_);
+      omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+      enable_float_xor_encoding_ = tenant_config.is_valid() && tenant_config->_enable_float_xor_encoding;
+      enable_delta_of_delta_encoding_ = tenant_config.is_valid() && tenant_config->_enable_delta_of_delta_encoding;
     }
 
     if (OB_SUCC(ret) && is_major) {
@@ -246,6 +250,11 @@ int ObDataStoreDesc::init(
       }
     }
 
+    if (OB_SUCC(ret) && MAJOR_MERGE == merge_type_) {
+      omt::ObTenantConfigGuard tenant_config(TENANT_CONF(MTL_ID()));
+      need_build_skip_index_ = tenant_config.is_valid() && tenant_config->_enable_skip_index;
+    }
+
     if (OB_FAIL(ret)) {
     } else if (OB_FAIL(col_desc_array_.init(row_column_count_))) {
       STORAGE_LOG(WARN, "Failed to reserve column desc array", K(ret));
@@ -291,6 +300,9 @@ void ObDataStoreDesc::reset()
   schema_rowkey_col_cnt_ = 0;
   row_store_type_ = ENCODING_ROW_STORE;
   need_build_hash_index_for_micro_block_ = false;
+  need_build_skip_index_ = false;
+  enable_float_xor_encoding_ = false;
+  enable_delta_of_delta_encoding_ = false;
   encoder_opt_.reset();
   schema_version_ = 0;
   merge_info_ = NULL;
@@ -326,6 +338,9 @@ int ObDataStoreDesc::assign(const ObDataStoreDesc &desc)
   rowkey_column_count_ = desc.rowkey_column_count_;
   row_store_type_ = desc.row_store_type_;
   need_build_hash_index_for_micro_block_ = desc.need_build_hash_index_for_micro_block_;
+  need_build_skip_index_ = desc.need_build_skip_index_;
+  enable_float_xor_encoding_ = desc.enable_float_xor_encoding_;
+  enable_delta_of_delta_encoding_ = desc.enable_delta_of_delta_encoding_;
   schema_version_ = desc.schema_version_;
   schema_rowkey_col_cnt_ = desc.schema_rowkey_col_cnt_;
   encoder_opt_ = desc.encoder_opt_;
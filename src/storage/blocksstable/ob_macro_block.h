@@ -57,6 +57,9 @@ struct ObDataStoreDesc
   int64_t rowkey_column_count_;
   ObRowStoreType row_store_type_;
   bool need_build_hash_index_for_micro_block_;
+  bool need_build_skip_index_;
+  bool enable_float_xor_encoding_;
+  bool enable_delta_of_delta_encoding_;
   int64_t schema_version_;
   int64_t schema_rowkey_col_cnt_;
   ObMicroBlockEncoderOpt encoder_opt_;
@@ -125,6 +128,9 @@ struct ObDataStoreDesc
       K_(major_working_cluster_version),
       KP_(sstable_index_builder),
       K_(is_ddl),
+      K_(need_build_skip_index),
+      K_(enable_float_xor_encoding),
+      K_(enable_delta_of_delta_encoding),
       K_(col_desc_array));
 
 private:
@@ -50,7 +50,8 @@ ObDataBlockMetaVal::ObDataBlockMetaVal()
     macro_id_(),
     column_checksums_(sizeof(int64_t), ModulePageAllocator("MacroMetaChksum", MTL_ID())),
     has_string_out_row_(false),
-    all_lob_in_row_(false)
+    all_lob_in_row_(false),
+    skip_index_cols_(sizeof(ObSkipIndexColMeta), ModulePageAllocator("MacroMetaSkipIdx", MTL_ID()))
 {
   MEMSET(encrypt_key_, 0, share::OB_MAX_TABLESPACE_ENCRYPT_KEY_LENGTH);
 }
@@ -86,7 +87,8 @@ ObDataBlockMetaVal::ObDataBlockMetaVal(ObIAllocator &allocator)
     macro_id_(),
     column_checksums_(sizeof(int64_t), ModulePageAllocator(allocator, "MacroMetaChksum")),
     has_string_out_row_(false),
-    all_lob_in_row_(false)
+    all_lob_in_row_(false),
+    skip_index_cols_(sizeof(ObSkipIndexColMeta), ModulePageAllocator(allocator, "MacroMetaSkipIdx"))
 {
   MEMSET(encrypt_key_, 0, share::OB_MAX_TABLESPACE_ENCRYPT_KEY_LENGTH);
 }
@@ -128,6 +130,7 @@ void ObDataBlockMetaVal::reset()
   column_checksums_.reset();
   has_string_out_row_ = false;
   all_lob_in_row_ = false;
+  skip_index_cols_.reset();
 }
 
 bool ObDataBlockMetaVal::is_valid() const
@@ -160,6 +163,8 @@ int ObDataBlockMetaVal::assign(const ObDataBlockMetaVal &val)
     LOG_WARN("invalid argument", K(ret), K(val));
   } else if (OB_FAIL(column_checksums_.assign(val.column_checksums_))) {
     LOG_WARN("fail to assign column checksums", K(ret), K(val.column_checksums_));
+  } else if (OB_FAIL(skip_index_cols_.assign(val.skip_index_cols_))) {
+    LOG_WARN("fail to assign skip index cols", K(ret), K(val.skip_index_cols_));
   } else {
     version_ = val.version_;
     length_ = val.length_;
@@ -270,6 +275,9 @@ DEFINE_SERIALIZE(ObDataBlockMetaVal)
                   has_string_out_row_,
                   all_lob_in_row_,
                   is_last_row_last_flag_);
+      if (OB_SUCC(ret) && !skip_index_cols_.empty()) {
+        OB_UNIS_ENCODE(skip_index_cols_);
+      }
       if (OB_FAIL(ret)) {
       } else if (OB_UNLIKELY(length_ != pos - start_pos)) {
         ret = OB_ERR_UNEXPECTED;
@@ -331,6 +339,9 @@ DEFINE_DESERIALIZE(ObDataBlockMetaVal)
                   has_string_out_row_,
                   all_lob_in_row_,
                   is_last_row_last_flag_);
+      if (OB_SUCC(ret) && pos - start_pos < length_) {
+        OB_UNIS_DECODE(skip_index_cols_);
+      }
       if (OB_FAIL(ret)) {
       } else if (OB_UNLIKELY(length_ != pos - start_pos)) {
         ret = OB_ERR_UNEXPECTED;
@@ -346,6 +357,8 @@ int64_t ObDataBlockMetaVal::get_max_serialize_size() const
   len -= sizeof(column_checksums_);
   len += sizeof(int64_t); // serialize column count
   len += sizeof(int64_t) * column_count_; // serialize each checksum
+  len -= sizeof(skip_index_cols_);
+  len += skip_index_cols_.get_serialize_size();
   return len;
 }
 DEFINE_GET_SERIALIZE_SIZE(ObDataBlockMetaVal)
@@ -384,6 +397,9 @@ DEFINE_GET_SERIALIZE_SIZE(ObDataBlockMetaVal)
               has_string_out_row_,
               all_lob_in_row_,
               is_last_row_last_flag_);
+  if (!skip_index_cols_.empty()) {
+    OB_UNIS_ADD_LEN(skip_index_cols_);
+  }
   return len;
 }
 
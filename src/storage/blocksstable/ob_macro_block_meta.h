@@ -20,6 +20,7 @@
 #include "share/ob_encryption_util.h"
 #include "common/ob_store_format.h"
 #include "storage/blocksstable/ob_logic_macro_id.h"
+#include "storage/blocksstable/ob_skip_index.h"
 
 
 namespace oceanbase
@@ -55,7 +56,8 @@ public:
         K_(is_deleted), K_(contain_uncommitted_row), K_(compressor_type),
         K_(master_key_id), K_(encrypt_id), K_(encrypt_key), K_(row_store_type),
         K_(schema_version), K_(snapshot_version), K_(is_last_row_last_flag),
-        K_(logic_id), K_(macro_id), K_(column_checksums), K_(has_string_out_row), K_(all_lob_in_row));
+        K_(logic_id), K_(macro_id), K_(column_checksums), K_(has_string_out_row), K_(all_lob_in_row),
+        K_(skip_index_cols));
 public:
   int32_t version_;
   int32_t length_;
@@ -89,6 +91,8 @@ public:
   common::ObSEArray<int64_t, 4> column_checksums_;
   bool has_string_out_row_;
   bool all_lob_in_row_;
+  // only serialized when not empty, so that metas without skip index keep the old layout
+  common::ObSEArray<ObSkipIndexColMeta, 4> skip_index_cols_;
 
 private:
   DISALLOW_COPY_AND_ASSIGN(ObDataBlockMetaVal);
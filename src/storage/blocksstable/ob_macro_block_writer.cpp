@@ -356,6 +356,7 @@ ObMacroBlockWriter::ObMacroBlockWriter()
    micro_writer_(nullptr),
    reader_helper_(),
    hash_index_builder_(),
+   skip_index_aggregator_(),
    micro_helper_(),
    read_info_(),
    current_index_(0),
@@ -394,6 +395,7 @@ void ObMacroBlockWriter::reset()
   }
   reader_helper_.reset();
   hash_index_builder_.reset();
+  skip_index_aggregator_.reset();
   micro_helper_.reset();
   read_info_.reset();
   macro_blocks_[0].reset();
@@ -444,6 +446,9 @@ int ObMacroBlockWriter::open(
     current_macro_seq_ = start_seq.get_data_seq();
     if (OB_FAIL(init_hash_index_builder())) {
       STORAGE_LOG(WARN, "Failed to build hash_index builder", K(ret));
+    } else if (data_store_desc_->need_build_skip_index_
+        && OB_FAIL(skip_index_aggregator_.init(*data_store_desc_))) {
+      STORAGE_LOG(WARN, "Failed to init skip index aggregator", K(ret));
     } else if (OB_FAIL(build_micro_writer(data_store_desc_,
                                           allocator_,
                                           micro_writer_,
@@ -884,6 +889,10 @@ int ObMacroBlockWriter::append_row_and_hash_index(const ObDatumRow &row)
       }
     }
   }
+  if (OB_SUCC(ret) && data_store_desc_->need_build_skip_index_
+      && OB_FAIL(skip_index_aggregator_.eval(row))) {
+    STORAGE_LOG(WARN, "Failed to aggregate skip index", K(ret), K(row));
+  }
   return ret;
 }
 
@@ -922,6 +931,10 @@ int ObMacroBlockWriter::build_micro_block()
     STORAGE_LOG(WARN, "Failed to build hash index block", K(ret));
   } else {
     micro_block_desc.last_rowkey_ = last_key_;
+    if (data_store_desc_->need_build_skip_index_) {
+      skip_index_aggregator_.get_aggregated_cols(
+          micro_block_desc.skip_index_cols_, micro_block_desc.skip_index_col_cnt_);
+    }
     block_size = micro_block_desc.buf_size_;
     if (data_block_pre_warmer_.is_valid()
         && OB_TMP_FAIL(data_block_pre_warmer_.reserve_kvpair(micro_block_desc))) {
@@ -952,6 +965,9 @@ int ObMacroBlockWriter::build_micro_block()
     if (data_store_desc_->need_build_hash_index_for_micro_block_) {
       hash_index_builder_.reuse();
     }
+    if (data_store_desc_->need_build_skip_index_) {
+      skip_index_aggregator_.reuse();
+    }
     if (data_store_desc_->need_prebuild_bloomfilter_ && micro_rowkey_hashs_.count() > 0) {
       micro_rowkey_hashs_.reuse();
     }
@@ -1036,6 +1052,11 @@ int ObMacroBlockWriter::build_micro_block_desc_with_reuse(
     micro_block_desc.has_string_out_row_ = micro_block.micro_index_info_->has_string_out_row();
     micro_block_desc.has_lob_out_row_ = micro_block.micro_index_info_->has_lob_out_row();
     micro_block_desc.original_size_ = header.original_length_;
+    const ObSkipIndexRowHeader *skip_index = micro_block.micro_index_info_->get_skip_index();
+    if (data_store_desc_->need_build_skip_index_ && nullptr != skip_index) {
+      micro_block_desc.skip_index_cols_ = skip_index->get_cols();
+      micro_block_desc.skip_index_col_cnt_ = skip_index->col_cnt_;
+    }
   }
   STORAGE_LOG(DEBUG, "build micro block desc reuse", K(data_store_desc_->tablet_id_), K(micro_block_desc), "lbt", lbt(), K(ret));
   return ret;
@@ -1499,6 +1520,8 @@ int ObMacroBlockWriter::build_micro_writer(ObDataStoreDesc *data_store_desc,
     encoding_ctx.major_working_cluster_version_ = data_store_desc->major_working_cluster_version_;
     encoding_ctx.row_store_type_ = data_store_desc->row_store_type_;
     encoding_ctx.need_calc_column_chksum_ = need_calc_column_chksum;
+    encoding_ctx.enable_float_xor_encoding_ = data_store_desc->enable_float_xor_encoding_;
+    encoding_ctx.enable_delta_of_delta_encoding_ = data_store_desc->enable_delta_of_delta_encoding_;
     if (OB_ISNULL(buf = allocator.alloc(sizeof(ObMicroBlockEncoder)))) {
       ret = OB_ALLOCATE_MEMORY_FAILED;
       STORAGE_LOG(WARN, "fail to alloc memory", K(ret));
@@ -204,6 +204,7 @@ private:
   ObIMicroBlockWriter *micro_writer_;
   ObMicroBlockReaderHelper reader_helper_;
   ObMicroBlockHashIndexBuilder hash_index_builder_;
+  ObSkipIndexAggregator skip_index_aggregator_;
   ObMicroBlockBufferHelper micro_helper_;
   ObTableReadInfo read_info_;
   ObMacroBlock macro_blocks_[2];
@@ -0,0 +1,432 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX STORAGE
+
+#include "ob_skip_index.h"
+#include "common/object/ob_obj_compare.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
+#include "storage/access/ob_table_read_info.h"
+#include "ob_datum_row.h"
+#include "ob_index_block_row_struct.h"
+#include "ob_macro_block.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace storage;
+namespace blocksstable
+{
+
+OB_SERIALIZE_MEMBER(ObSkipIndexColMeta, col_idx_, flag_, null_count_, min_, max_);
+
+void ObSkipIndexColMeta::add_null_count(const uint64_t null_count)
+{
+  const uint64_t total = static_cast<uint64_t>(null_count_) + null_count;
+  null_count_ = total > UINT32_MAX ? UINT32_MAX : static_cast<uint32_t>(total);
+}
+
+void ObSkipIndexColMeta::add_value(const int64_t value)
+{
+  if (!has_value()) {
+    min_ = value;
+    max_ = value;
+    has_value_ = 1;
+  } else {
+    if (less_than(value, min_)) {
+      min_ = value;
+    }
+    if (less_than(max_, value)) {
+      max_ = value;
+    }
+  }
+}
+
+void ObSkipIndexColMeta::merge(const ObSkipIndexColMeta &other)
+{
+  add_null_count(other.null_count_);
+  if (other.has_value()) {
+    add_value(other.min_);
+    add_value(other.max_);
+  }
+}
+
+ObSkipIndexAggregator::ObSkipIndexAggregator()
+  : col_cnt_(0), evaluated_cnt_(0), is_inited_(false)
+{
+}
+
+void ObSkipIndexAggregator::reset()
+{
+  col_cnt_ = 0;
+  evaluated_cnt_ = 0;
+  is_inited_ = false;
+}
+
+void ObSkipIndexAggregator::reuse()
+{
+  if (is_inited_) {
+    for (int64_t i = 0; i < col_cnt_; ++i) {
+      const int16_t col_idx = cols_[i].col_idx_;
+      const bool is_unsigned = cols_[i].is_unsigned();
+      cols_[i].reset();
+      cols_[i].col_idx_ = col_idx;
+      cols_[i].is_unsigned_ = is_unsigned;
+      col_valid_[i] = true;
+    }
+  } else {
+    col_cnt_ = 0;
+  }
+  evaluated_cnt_ = 0;
+}
+
+bool ObSkipIndexAggregator::is_type_supported(const ObObjTypeClass type_class)
+{
+  return ObIntTC == type_class
+      || ObUIntTC == type_class
+      || ObDateTimeTC == type_class
+      || ObDateTC == type_class
+      || ObTimeTC == type_class
+      || ObYearTC == type_class;
+}
+
+int ObSkipIndexAggregator::init(const ObDataStoreDesc &desc)
+{
+  int ret = OB_SUCCESS;
+  if (OB_UNLIKELY(is_inited_)) {
+    ret = OB_INIT_TWICE;
+    LOG_WARN("Skip index aggregator init twice", K(ret));
+  } else if (OB_UNLIKELY(!desc.is_valid())) {
+    ret = OB_INVALID_ARGUMENT;
+    LOG_WARN("Invalid data store desc", K(ret), K(desc));
+  } else {
+    reset();
+    // rowkey columns are already pruned by the query range
+    const int64_t col_desc_cnt = desc.col_desc_array_.count();
+    for (int64_t i = desc.rowkey_column_count_;
+         i < col_desc_cnt && col_cnt_ < MAX_SKIP_INDEX_COL_CNT; ++i) {
+      const ObObjTypeClass type_class = desc.col_desc_array_.at(i).col_type_.get_type_class();
+      if (is_type_supported(type_class)) {
+        cols_[col_cnt_].reset();
+        cols_[col_cnt_].col_idx_ = static_cast<int16_t>(i);
+        cols_[col_cnt_].is_unsigned_ = ObUIntTC == type_class;
+        col_tcs_[col_cnt_] = type_class;
+        col_valid_[col_cnt_] = true;
+        ++col_cnt_;
+      }
+    }
+    is_inited_ = true;
+  }
+  return ret;
+}
+
+int64_t ObSkipIndexAggregator::get_value(const ObStorageDatum &datum, const ObObjTypeClass type_class)
+{
+  int64_t value = 0;
+  switch (type_class) {
+    case ObIntTC:
+      value = datum.get_int();
+      break;
+    case ObUIntTC:
+      value = static_cast<int64_t>(datum.get_uint64());
+      break;
+    case ObDateTimeTC:
+      value = datum.get_datetime();
+      break;
+    case ObDateTC:
+      value = datum.get_date();
+      break;
+    case ObTimeTC:
+      value = datum.get_time();
+      break;
+    case ObYearTC:
+      value = datum.get_year();
+      break;
+    default:
+      break;
+  }
+  return value;
+}
+
+int ObSkipIndexAggregator::eval(const ObDatumRow &row)
+{
+  int ret = OB_SUCCESS;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    LOG_WARN("Skip index aggregator not inited", K(ret));
+  } else {
+    for (int64_t i = 0; i < col_cnt_; ++i) {
+      if (!col_valid_[i]) {
+      } else if (cols_[i].col_idx_ >= row.count_) {
+        col_valid_[i] = false;
+      } else {
+        const ObStorageDatum &datum = row.storage_datums_[cols_[i].col_idx_];
+        if (datum.is_null()) {
+          cols_[i].add_null_count(1);
+        } else if (datum.is_ext()) {
+          // nop column can not be summarized
+          col_valid_[i] = false;
+        } else {
+          cols_[i].add_value(get_value(datum, col_tcs_[i]));
+        }
+      }
+    }
+    ++evaluated_cnt_;
+  }
+  return ret;
+}
+
+void ObSkipIndexAggregator::eval(const ObSkipIndexColMeta *cols, const int64_t col_cnt)
+{
+  if (0 == evaluated_cnt_ && !is_inited_) {
+    col_cnt_ = nullptr == cols ? 0 : MIN(col_cnt, MAX_SKIP_INDEX_COL_CNT);
+    for (int64_t i = 0; i < col_cnt_; ++i) {
+      cols_[i] = cols[i];
+      col_valid_[i] = true;
+    }
+  } else {
+    for (int64_t i = 0; i < col_cnt_; ++i) {
+      if (col_valid_[i]) {
+        const ObSkipIndexColMeta *other = nullptr;
+        for (int64_t j = 0; nullptr == other && nullptr != cols && j < col_cnt; ++j) {
+          if (cols[j].col_idx_ == cols_[i].col_idx_) {
+            other = &cols[j];
+          }
+        }
+        if (nullptr == other || other->is_unsigned() != cols_[i].is_unsigned()) {
+          col_valid_[i] = false;
+        } else {
+          cols_[i].merge(*other);
+        }
+      }
+    }
+  }
+  ++evaluated_cnt_;
+}
+
+void ObSkipIndexAggregator::get_aggregated_cols(const ObSkipIndexColMeta *&cols, int64_t &col_cnt)
+{
+  col_cnt = 0;
+  if (evaluated_cnt_ > 0) {
+    for (int64_t i = 0; i < col_cnt_; ++i) {
+      if (col_valid_[i]) {
+        result_cols_[col_cnt++] = cols_[i];
+      }
+    }
+  }
+  cols = col_cnt > 0 ? result_cols_ : nullptr;
+}
+
+int ObSkipIndexFilter::check_skip(
+    const ObTableReadInfo &read_info,
+    sql::ObPushdownFilterExecutor &filter,
+    const ObMicroIndexInfo &index_info,
+    bool &can_skip)
+{
+  int ret = OB_SUCCESS;
+  can_skip = false;
+  if (filter.is_logic_and_node()) {
+    // any child filtering out all rows is enough
+    sql::ObPushdownFilterExecutor **childs = filter.get_childs();
+    for (uint32_t i = 0; OB_SUCC(ret) && !can_skip && i < filter.get_child_count(); ++i) {
+      if (OB_ISNULL(childs[i])) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("Unexpected null child filter", K(ret), K(i));
+      } else if (OB_FAIL(check_skip(read_info, *childs[i], index_info, can_skip))) {
+        LOG_WARN("Fail to check skip of child filter", K(ret), K(i));
+      }
+    }
+  } else if (filter.is_logic_or_node()) {
+    // all children should filter out all rows
+    sql::ObPushdownFilterExecutor **childs = filter.get_childs();
+    can_skip = filter.get_child_count() > 0;
+    for (uint32_t i = 0; OB_SUCC(ret) && can_skip && i < filter.get_child_count(); ++i) {
+      if (OB_ISNULL(childs[i])) {
+        ret = OB_ERR_UNEXPECTED;
+        LOG_WARN("Unexpected null child filter", K(ret), K(i));
+      } else if (OB_FAIL(check_skip(read_info, *childs[i], index_info, can_skip))) {
+        LOG_WARN("Fail to check skip of child filter", K(ret), K(i));
+      }
+    }
+  } else if (filter.is_filter_white_node()) {
+    if (OB_FAIL(check_white_filter_skip(
+                read_info, static_cast<sql::ObWhiteFilterExecutor &>(filter), index_info, can_skip))) {
+      LOG_WARN("Fail to check skip of white filter", K(ret));
+    }
+  }
+  if (OB_FAIL(ret)) {
+    can_skip = false;
+  }
+  return ret;
+}
+
+int ObSkipIndexFilter::check_white_filter_skip(
+    const ObTableReadInfo &read_info,
+    sql::ObWhiteFilterExecutor &filter,
+    const ObMicroIndexInfo &index_info,
+    bool &can_skip)
+{
+  int ret = OB_SUCCESS;
+  can_skip = false;
+  const ObSkipIndexRowHeader *skip_index = index_info.get_skip_index();
+  const ObIArray<int32_t> &cols_index = read_info.get_columns_index();
+  if (nullptr == skip_index || 1 != filter.get_col_count()) {
+  } else {
+    const int32_t col_offset = filter.get_col_offsets().at(0);
+    const int32_t col_idx = (col_offset >= 0 && col_offset < cols_index.count())
+        ? cols_index.at(col_offset) : -1;
+    const ObSkipIndexColMeta *col_meta = nullptr;
+    for (int64_t i = 0; col_idx >= 0 && nullptr == col_meta && i < skip_index->col_cnt_; ++i) {
+      if (skip_index->get_cols()[i].col_idx_ == col_idx) {
+        col_meta = &skip_index->get_cols()[i];
+      }
+    }
+    if (nullptr == col_meta) {
+    } else if (sql::WHITE_OP_NU == filter.get_op_type()) {
+      can_skip = 0 == col_meta->null_count_;
+    } else if (sql::WHITE_OP_NN == filter.get_op_type()) {
+      can_skip = !col_meta->has_value();
+    } else if (!col_meta->has_value()) {
+      // compare with null is never true
+      can_skip = true;
+    } else {
+      const ObObjMeta &col_type = read_info.get_columns_desc().at(col_offset).col_type_;
+      const ObObjTypeClass type_class = col_type.get_type_class();
+      ObObj min_obj;
+      ObObj max_obj;
+      if (!ObSkipIndexAggregator::is_type_supported(type_class)
+          || col_meta->is_unsigned() != (ObUIntTC == type_class)) {
+        // column type changed since the skip index was built
+      } else if (OB_FAIL(build_obj(col_meta->min_, col_type, min_obj))) {
+        LOG_WARN("Fail to build min obj", K(ret), KPC(col_meta), K(col_type));
+      } else if (OB_FAIL(build_obj(col_meta->max_, col_type, max_obj))) {
+        LOG_WARN("Fail to build max obj", K(ret), KPC(col_meta), K(col_type));
+      } else if (OB_FAIL(check_range_skip(filter, min_obj, max_obj, can_skip))) {
+        LOG_WARN("Fail to check range skip", K(ret), K(min_obj), K(max_obj));
+      }
+    }
+    LOG_DEBUG("check white filter skip", K(ret), K(can_skip), K(col_idx), KPC(col_meta), K(filter));
+  }
+  return ret;
+}
+
+int ObSkipIndexFilter::check_range_skip(
+    const sql::ObWhiteFilterExecutor &filter,
+    const ObObj &min_obj,
+    const ObObj &max_obj,
+    bool &can_skip)
+{
+#define SKIP_INDEX_CMP(left, right, op) \
+  ObObjCmpFuncs::compare_oper_nullsafe(left, right, left.get_collation_type(), op)
+#define SKIP_INDEX_IS_NULL(obj) \
+  ((lib::is_mysql_mode() && obj.is_null()) || (lib::is_oracle_mode() && obj.is_null_oracle()))
+  int ret = OB_SUCCESS;
+  can_skip = false;
+  const ObIArray<ObObj> &ref_objs = filter.get_objs();
+  const sql::ObWhiteFilterOperatorType op_type = filter.get_op_type();
+  switch (op_type) {
+    case sql::WHITE_OP_EQ:
+    case sql::WHITE_OP_NE:
+    case sql::WHITE_OP_GT:
+    case sql::WHITE_OP_GE:
+    case sql::WHITE_OP_LT:
+    case sql::WHITE_OP_LE: {
+      if (1 != ref_objs.count()) {
+      } else if (SKIP_INDEX_IS_NULL(ref_objs.at(0))) {
+        can_skip = true;
+      } else {
+        const ObObj &ref = ref_objs.at(0);
+        if (sql::WHITE_OP_EQ == op_type) {
+          can_skip = SKIP_INDEX_CMP(min_obj, ref, CO_GT) || SKIP_INDEX_CMP(max_obj, ref, CO_LT);
+        } else if (sql::WHITE_OP_NE == op_type) {
+          can_skip = SKIP_INDEX_CMP(min_obj, ref, CO_EQ) && SKIP_INDEX_CMP(max_obj, ref, CO_EQ);
+        } else if (sql::WHITE_OP_GT == op_type) {
+          can_skip = SKIP_INDEX_CMP(max_obj, ref, CO_LE);
+        } else if (sql::WHITE_OP_GE == op_type) {
+          can_skip = SKIP_INDEX_CMP(max_obj, ref, CO_LT);
+        } else if (sql::WHITE_OP_LT == op_type) {
+          can_skip = SKIP_INDEX_CMP(min_obj, ref, CO_GE);
+        } else {
+          can_skip = SKIP_INDEX_CMP(min_obj, ref, CO_GT);
+        }
+      }
+      break;
+    }
+    case sql::WHITE_OP_BT: {
+      if (2 != ref_objs.count()
+          || SKIP_INDEX_IS_NULL(ref_objs.at(0))
+          || SKIP_INDEX_IS_NULL(ref_objs.at(1))) {
+      } else {
+        can_skip = SKIP_INDEX_CMP(max_obj, ref_objs.at(0), CO_LT)
+            || SKIP_INDEX_CMP(min_obj, ref_objs.at(1), CO_GT);
+      }
+      break;
+    }
+    case sql::WHITE_OP_IN: {
+      if (0 == ref_objs.count() || filter.null_param_contained()) {
+      } else {
+        can_skip = true;
+        for (int64_t i = 0; can_skip && i < ref_objs.count(); ++i) {
+          can_skip = SKIP_INDEX_CMP(min_obj, ref_objs.at(i), CO_GT)
+              || SKIP_INDEX_CMP(max_obj, ref_objs.at(i), CO_LT);
+        }
+      }
+      break;
+    }
+    default: {
+      break;
+    }
+  }
+#undef SKIP_INDEX_IS_NULL
+#undef SKIP_INDEX_CMP
+  return ret;
+}
+
+int ObSkipIndexFilter::build_obj(
+    const int64_t value,
+    const ObObjMeta &col_type,
+    ObObj &obj)
+{
+  int ret = OB_SUCCESS;
+  ObStorageDatum datum;
+  switch (col_type.get_type_class()) {
+    case ObIntTC:
+      datum.set_int(value);
+      break;
+    case ObUIntTC:
+      datum.set_uint(static_cast<uint64_t>(value));
+      break;
+    case ObDateTimeTC:
+      datum.set_datetime(value);
+      break;
+    case ObDateTC:
+      datum.set_date(static_cast<int32_t>(value));
+      break;
+    case ObTimeTC:
+      datum.set_time(value);
+      break;
+    case ObYearTC:
+      datum.set_year(static_cast<int8_t>(value));
+      break;
+    default:
+      ret = OB_NOT_SUPPORTED;
+      LOG_WARN("Unsupported skip index column type", K(ret), K(col_type));
+  }
+  if (OB_FAIL(ret)) {
+  } else if (OB_FAIL(datum.to_obj_enhance(obj, col_type))) {
+    LOG_WARN("Fail to convert datum to obj", K(ret), K(datum), K(col_type));
+  }
+  return ret;
+}
+
+} // namespace blocksstable
+} // namespace oceanbase
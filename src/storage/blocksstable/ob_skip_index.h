@@ -0,0 +1,156 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#ifndef OCEANBASE_STORAGE_BLOCKSSTABLE_OB_SKIP_INDEX_H_
+#define OCEANBASE_STORAGE_BLOCKSSTABLE_OB_SKIP_INDEX_H_
+
+#include "lib/utility/ob_print_utils.h"
+#include "lib/utility/ob_unify_serialize.h"
+#include "lib/container/ob_array_wrap.h"
+#include "common/object/ob_object.h"
+
+namespace oceanbase
+{
+namespace sql
+{
+class ObPushdownFilterExecutor;
+class ObWhiteFilterExecutor;
+}
+namespace storage
+{
+class ObTableReadInfo;
+}
+namespace blocksstable
+{
+struct ObDataStoreDesc;
+struct ObDatumRow;
+struct ObStorageDatum;
+struct ObMicroIndexInfo;
+
+// min/max/null-count sketch of one column over the rows covered by an index row,
+// min_ and max_ hold the raw 64-bit value, compared as unsigned when is_unsigned_ is set
+struct ObSkipIndexColMeta
+{
+  OB_UNIS_VERSION(1);
+public:
+  ObSkipIndexColMeta() { reset(); }
+  void reset() { MEMSET(this, 0, sizeof(*this)); }
+  OB_INLINE bool has_value() const { return 1 == has_value_; }
+  OB_INLINE bool is_unsigned() const { return 1 == is_unsigned_; }
+  OB_INLINE bool is_all_null() const { return !has_value() && null_count_ > 0; }
+  OB_INLINE bool less_than(const int64_t left, const int64_t right) const
+  {
+    return is_unsigned() ? static_cast<uint64_t>(left) < static_cast<uint64_t>(right) : left < right;
+  }
+  void add_null_count(const uint64_t null_count);
+  void add_value(const int64_t value);
+  void merge(const ObSkipIndexColMeta &other);
+  TO_STRING_KV(K_(col_idx), K_(has_value), K_(is_unsigned), K_(null_count), K_(min), K_(max));
+
+  int16_t col_idx_;             // stored column index in the data row
+  union
+  {
+    uint16_t flag_;
+    struct
+    {
+      uint16_t has_value_:1;    // whether any non-null value was seen
+      uint16_t is_unsigned_:1;  // whether min_/max_ compare as uint64
+      uint16_t reserved_:14;
+    };
+  };
+  uint32_t null_count_;         // saturated at UINT32_MAX
+  int64_t min_;
+  int64_t max_;
+};
+
+// layout: ObIndexBlockRowHeader | ObSkipIndexRowHeader | ObSkipIndexColMeta * col_cnt_
+struct ObSkipIndexRowHeader
+{
+  static const uint16_t SKIP_INDEX_VERSION_V1 = 1;
+  OB_INLINE bool is_valid() const { return SKIP_INDEX_VERSION_V1 == version_; }
+  OB_INLINE const ObSkipIndexColMeta *get_cols() const
+  {
+    return reinterpret_cast<const ObSkipIndexColMeta *>(this + 1);
+  }
+  OB_INLINE int64_t get_size() const { return calc_size(col_cnt_); }
+  static OB_INLINE int64_t calc_size(const int64_t col_cnt)
+  {
+    return sizeof(ObSkipIndexRowHeader) + col_cnt * sizeof(ObSkipIndexColMeta);
+  }
+  TO_STRING_KV(K_(version), K_(col_cnt));
+
+  uint16_t version_;
+  uint16_t col_cnt_;
+  uint32_t reserved_;
+};
+
+// build skip index on rows of a micro block, or merge skip index of child index rows.
+// columns missing in any input are dropped from the result.
+class ObSkipIndexAggregator
+{
+public:
+  static const int64_t MAX_SKIP_INDEX_COL_CNT = 16;
+  ObSkipIndexAggregator();
+  ~ObSkipIndexAggregator() = default;
+  void reset();
+  void reuse();
+  // choose columns to aggregate, only required by eval on data rows
+  int init(const ObDataStoreDesc &desc);
+  int eval(const ObDatumRow &row);
+  void eval(const ObSkipIndexColMeta *cols, const int64_t col_cnt);
+  void get_aggregated_cols(const ObSkipIndexColMeta *&cols, int64_t &col_cnt);
+  static bool is_type_supported(const common::ObObjTypeClass type_class);
+  TO_STRING_KV(K_(is_inited), K_(col_cnt), K_(evaluated_cnt),
+               "cols", common::ObArrayWrap<ObSkipIndexColMeta>(cols_, col_cnt_));
+private:
+  static int64_t get_value(const ObStorageDatum &datum, const common::ObObjTypeClass type_class);
+private:
+  ObSkipIndexColMeta cols_[MAX_SKIP_INDEX_COL_CNT];
+  ObSkipIndexColMeta result_cols_[MAX_SKIP_INDEX_COL_CNT];
+  common::ObObjTypeClass col_tcs_[MAX_SKIP_INDEX_COL_CNT];
+  bool col_valid_[MAX_SKIP_INDEX_COL_CNT];
+  int64_t col_cnt_;
+  int64_t evaluated_cnt_;
+  bool is_inited_;
+  DISALLOW_COPY_AND_ASSIGN(ObSkipIndexAggregator);
+};
+
+// check whether no row under an index row can pass the pushdown filter
+class ObSkipIndexFilter
+{
+public:
+  static int check_skip(
+      const storage::ObTableReadInfo &read_info,
+      sql::ObPushdownFilterExecutor &filter,
+      const ObMicroIndexInfo &index_info,
+      bool &can_skip);
+private:
+  static int check_white_filter_skip(
+      const storage::ObTableReadInfo &read_info,
+      sql::ObWhiteFilterExecutor &filter,
+      const ObMicroIndexInfo &index_info,
+      bool &can_skip);
+  static int check_range_skip(
+      const sql::ObWhiteFilterExecutor &filter,
+      const common::ObObj &min_obj,
+      const common::ObObj &max_obj,
+      bool &can_skip);
+  static int build_obj(
+      const int64_t value,
+      const common::ObObjMeta &col_type,
+      common::ObObj &obj);
+};
+
+} // namespace blocksstable
+} // namespace oceanbase
+
+#endif // OCEANBASE_STORAGE_BLOCKSSTABLE_OB_SKIP_INDEX_H_
@@ -1233,6 +1233,18 @@ int BtreeIterator<BtreeKey, BtreeVal>::KVQueue::pop(BtreeKV &data)
   return ret;
 }
 
+template<typename BtreeKey, typename BtreeVal>
+int BtreeIterator<BtreeKey, BtreeVal>::KVQueue::peek(const int64_t offset, BtreeKV &data) const
+{
+  int ret = 0;
+  if (offset < 0 || pop_ + offset >= push_) {
+    ret = OB_EAGAIN;
+  } else {
+    data = items_[idx(pop_ + offset)];
+  }
+  return ret;
+}
+
 template<typename BtreeKey, typename BtreeVal>
 int BtreeIterator<BtreeKey, BtreeVal>::init(ObKeyBtree &btree)
 {
@@ -1303,6 +1315,19 @@ int BtreeIterator<BtreeKey, BtreeVal>::get_next(BtreeKey &key, BtreeVal &value)
   return ret;
 }
 
+template<typename BtreeKey, typename BtreeVal>
+int BtreeIterator<BtreeKey, BtreeVal>::peek_value(const int64_t offset, BtreeVal &value) const
+{
+  int ret = OB_SUCCESS;
+  BtreeKV item;
+  if (OB_FAIL(kv_queue_.peek(offset, item))) {
+    // not scanned yet
+  } else {
+    value = item.val_;
+  }
+  return ret;
+}
+
 template<typename BtreeKey, typename BtreeVal>
 int BtreeIterator<BtreeKey, BtreeVal>::scan_batch()
 {
@@ -1401,7 +1426,7 @@ template<typename BtreeKey, typename BtreeVal>
 int BtreeNodeAllocator<BtreeKey, BtreeVal>::pop(BtreeNode*& p)
 {
   int64_t pop_list_idx = pop_idx();
-  const int64_t NODE_SIZE = sizeof(BtreeNode);
+  const int64_t NODE_SIZE = get_node_size();
   if (OB_ISNULL(p = free_list_array_[pop_list_idx].pop())) {
     // queue is empty, fill nodes.
     char *block = nullptr;
@@ -1573,7 +1598,7 @@ template<typename BtreeKey, typename BtreeVal>
 void ObKeyBtree<BtreeKey, BtreeVal>::print(FILE *file) const
 {
   if (OB_NOT_NULL(file)) {
-    fprintf(file, "\n|root=%p node_size=%lu node_key_count=%d total_size=%ld\n", root_, sizeof(BtreeNode),
+    fprintf(file, "\n|root=%p node_size=%ld node_key_count=%d total_size=%ld\n", root_, node_allocator_.get_node_size(),
             NODE_KEY_COUNT, size());
     if (OB_NOT_NULL(root_)) {
       root_->print(file, 0);
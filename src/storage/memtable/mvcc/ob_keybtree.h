@@ -73,9 +73,20 @@ private:
     MAX_LIST_COUNT = MAX_CPU_NUM
   };
 public:
-  BtreeNodeAllocator(common::ObIAllocator &allocator) : allocator_(allocator), alloc_memory_(0) {}
+  BtreeNodeAllocator(common::ObIAllocator &allocator)
+    : allocator_(allocator), alloc_memory_(0), enable_key_prefix_(false) {}
   virtual ~BtreeNodeAllocator() {}
   int64_t get_allocated() const { return ATOMIC_LOAD(&alloc_memory_) + sizeof(*this); }
+  // must be set before any node is allocated, the key prefixes take extra space of each node.
+  void set_enable_key_prefix(const bool enable)
+  {
+    enable_key_prefix_ = KeyPrefixHelper<BtreeKey>::ENABLED && enable;
+  }
+  OB_INLINE bool is_key_prefix_enabled() const { return enable_key_prefix_; }
+  int64_t get_node_size() const
+  {
+    return sizeof(BtreeNode) + (enable_key_prefix_ ? sizeof(NodeKeyPrefix<BtreeKey>) : 0);
+  }
   BtreeNode *alloc_node(const bool is_emergency);
   void free_node(BtreeNode *p)
   {
@@ -87,6 +98,7 @@ public:
   {
     memset(free_list_array_, 0, sizeof(free_list_array_));
     alloc_memory_ = 0;
+    enable_key_prefix_ = false;
   }
 private:
   int64_t push_idx();
@@ -96,6 +108,7 @@ private:
 private:
   common::ObIAllocator &allocator_;
   int64_t alloc_memory_;
+  bool enable_key_prefix_;
   BtreeNodeList free_list_array_[MAX_LIST_COUNT] CACHE_ALIGNED;
 };
 
@@ -120,9 +133,10 @@ private:
       void reset();
       int push(const BtreeKV &data);
       int pop(BtreeKV &data);
+      int peek(const int64_t offset, BtreeKV &data) const;
       int64_t size() const { return push_ - pop_; }
     private:
-      int64_t idx(const int64_t x) { return x % capacity; }
+      int64_t idx(const int64_t x) const { return x % capacity; }
     private:
       int64_t push_;
       int64_t pop_;
@@ -145,6 +159,8 @@ public:
   int set_key_range(const BtreeKey min_key, const bool start_exclude,
                     const BtreeKey max_key, const bool end_exclude, int64_t version);
   int get_next(BtreeKey &key, BtreeVal &val);
+  // peek the value @offset items after the next one in the scanned batch, without moving
+  int peek_value(const int64_t offset, BtreeVal &val) const;
   bool is_reverse_scan() const { return scan_backward_; }
   bool is_iter_end() const { return is_iter_end_; }
 private:
@@ -184,6 +200,12 @@ public:
   int split_range(int64_t top_level, int64_t branch_count, int64_t part_count, BtreeKey* key_array);
   int estimate_element_count(int64_t &physical_row_count, int64_t &element_count, const double ratio);
   bool is_reverse_scan() const;
+  // no scanned batch is kept, nothing to peek
+  int peek_value(const int64_t offset, BtreeVal &val) const
+  {
+    UNUSEDx(offset, val);
+    return OB_NOT_SUPPORTED;
+  }
 private:
   Iterator *iter_; // 8byte
   char buf_[sizeof(Iterator)]; // 376 when sizeof(BtreeKV) is 16
@@ -217,6 +239,7 @@ public:
   void dump(FILE *file) { print(file); }
   void print(FILE *file) const;
   int destroy();
+  OB_INLINE bool is_key_prefix_enabled() const { return node_allocator_.is_key_prefix_enabled(); }
   int del(const BtreeKey key, BtreeVal &value, int64_t version);
   int re_insert(const BtreeKey key, BtreeVal value);
   int insert(const BtreeKey key, BtreeVal &value);
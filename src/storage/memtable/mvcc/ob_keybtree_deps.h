@@ -15,6 +15,9 @@
 
 #include "lib/ob_abort.h"
 #include "lib/allocator/ob_retire_station.h"
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
 
 #define BTREE_ASSERT(x) if (OB_UNLIKELY(!(x))) { ob_abort(); }
 
@@ -49,6 +52,77 @@ struct CompHelper
   }
 };
 
+// Optional fixed width prefix of BtreeKey which is stored inline in nodes.
+// For two keys of the same non-NONE kind, prefix(a) < prefix(b) must imply a < b.
+// Keys of different kinds or with equal prefixes are compared with full key.
+// A key type supports it by specializing KeyPrefixHelper, and a btree stores the
+// prefixes only if it is turned on by BtreeNodeAllocator::set_enable_key_prefix.
+enum
+{
+  KEY_PREFIX_NONE = 0,
+  MAX_PREFIX_TIE_COUNT = 3
+};
+
+template<typename BtreeKey>
+struct KeyPrefixHelper
+{
+  static const bool ENABLED = false;
+  OB_INLINE static void get_prefix(const BtreeKey &key, uint8_t &kind, uint64_t &prefix)
+  {
+    UNUSED(key);
+    kind = KEY_PREFIX_NONE;
+    prefix = 0;
+  }
+};
+
+// stored right after BtreeNode when the btree enables key prefix.
+template<typename BtreeKey>
+struct NodeKeyPrefix
+{
+  OB_INLINE void set(const int pos, const BtreeKey &key)
+  {
+    KeyPrefixHelper<BtreeKey>::get_prefix(key, kinds_[pos], prefixes_[pos]);
+  }
+  // classify slots in [0, cnt) against the search prefix:
+  // less_mask: keys which are surely less than the search key
+  // tie_mask: keys which need full key compare
+  OB_INLINE void compare(const int cnt, const uint8_t kind, const uint64_t prefix,
+                         uint32_t &less_mask, uint32_t &tie_mask) const
+  {
+    uint32_t less = 0;
+    uint32_t equal = 0;
+    uint32_t same_kind = 0;
+    const uint32_t valid = (1U << cnt) - 1;
+#if defined(__AVX2__)
+    const __m256i sign = _mm256_set1_epi64x(INT64_MIN);
+    const __m256i search = _mm256_xor_si256(_mm256_set1_epi64x(prefix), sign);
+    for (int i = 0; i < PREFIX_SLOT_COUNT; i += 4) {
+      const __m256i p = _mm256_xor_si256(
+          _mm256_loadu_si256(reinterpret_cast<const __m256i *>(prefixes_ + i)), sign);
+      less |= static_cast<uint32_t>(_mm256_movemask_pd(
+          _mm256_castsi256_pd(_mm256_cmpgt_epi64(search, p)))) << i;
+      equal |= static_cast<uint32_t>(_mm256_movemask_pd(
+          _mm256_castsi256_pd(_mm256_cmpeq_epi64(search, p)))) << i;
+    }
+    same_kind = static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(kinds_)), _mm_set1_epi8(kind))));
+#else
+    for (int i = 0; i < cnt; ++i) {
+      less |= static_cast<uint32_t>(prefixes_[i] < prefix) << i;
+      equal |= static_cast<uint32_t>(prefixes_[i] == prefix) << i;
+      same_kind |= static_cast<uint32_t>(kinds_[i] == kind) << i;
+    }
+#endif
+    same_kind &= valid;
+    less_mask = less & same_kind;
+    tie_mask = valid & (~same_kind | equal);
+  }
+  enum { PREFIX_SLOT_COUNT = NODE_KEY_COUNT + 1 };
+  // the last slot is padding for vector compare
+  uint64_t prefixes_[PREFIX_SLOT_COUNT]; // 8 * 16 = 128byte
+  uint8_t kinds_[PREFIX_SLOT_COUNT]; // 16byte
+};
+
 class RWLock
 {
 public:
@@ -177,6 +251,8 @@ private:
   typedef BtreeKV<BtreeKey, BtreeVal> BtreeKV;
   typedef ObKeyBtree<BtreeKey, BtreeVal> ObKeyBtree;
   typedef CompHelper<BtreeKey, BtreeVal> CompHelper;
+  typedef KeyPrefixHelper<BtreeKey> KeyPrefixHelper;
+  typedef NodeKeyPrefix<BtreeKey> NodeKeyPrefix;
 private:
   enum {
     MAGIC_NUM = 0xb7ee //47086
@@ -246,6 +322,11 @@ public:
   int get_prev_active_child(int pos, int64_t version, int64_t* cnt, MultibitSet *index = nullptr);
   OB_INLINE void set_key_value(int pos, BtreeKey key, BtreeVal val)
   {
+    // prefix must be ready before the slot is published by val or index
+    NodeKeyPrefix *key_prefix = get_key_prefix();
+    if (OB_NOT_NULL(key_prefix)) {
+      key_prefix->set(pos, key);
+    }
     kvs_[pos].key_ = key;
     ATOMIC_STORE(&kvs_[pos].val_, val);
   }
@@ -274,6 +355,8 @@ protected:
     int start = 0;
     int end = 0;
     int ret = OB_SUCCESS;
+    bool searched = false;
+    const NodeKeyPrefix *key_prefix = get_key_prefix();
     // Only leaf node try append directly, other scence do nothign with index.
     if (is_leaf()) {
       index->load(index_);
@@ -282,7 +365,10 @@ protected:
       end = size();
     }
     is_equal = false;
-    while (OB_SUCC(ret) && start < end && !is_equal) {
+    if (OB_NOT_NULL(key_prefix)) {
+      ret = prefix_search_upper_bound(*key_prefix, nh, key, end, is_equal, end, searched);
+    }
+    while (OB_SUCC(ret) && !searched && start < end && !is_equal) {
       int mid = start + (end - start) / 2;
       int cmp_ret = 0;
       if (OB_FAIL(nh.compare(key, get_key(mid, index), cmp_ret))) {
@@ -299,6 +385,55 @@ protected:
     pos = end;
     return ret;
   }
+  // Live slots of a node are physically within [0, cnt) (leaf slots are appended and
+  // published by index), so upper bound is the number of keys <= search key. Keys are
+  // counted by prefix compare and only ties are compared with full key. Give up and
+  // leave it to binary search if there are too many ties.
+  OB_INLINE int prefix_search_upper_bound(const NodeKeyPrefix &key_prefix, CompHelper &nh,
+                                          BtreeKey key, const int cnt,
+                                          bool &is_equal, int &pos, bool &searched)
+  {
+    int ret = OB_SUCCESS;
+    uint8_t kind = KEY_PREFIX_NONE;
+    uint64_t prefix = 0;
+    uint32_t less_mask = 0;
+    uint32_t tie_mask = 0;
+    searched = false;
+    KeyPrefixHelper::get_prefix(key, kind, prefix);
+    if (KEY_PREFIX_NONE != kind) {
+      key_prefix.compare(cnt, kind, prefix, less_mask, tie_mask);
+      if (__builtin_popcount(tie_mask) <= MAX_PREFIX_TIE_COUNT) {
+        int le_cnt = __builtin_popcount(less_mask);
+        while (OB_SUCC(ret) && 0 != tie_mask) {
+          const int slot = __builtin_ctz(tie_mask);
+          int cmp_ret = 0;
+          tie_mask &= tie_mask - 1;
+          if (OB_FAIL(nh.compare(key, kvs_[slot].key_, cmp_ret))) {
+            OB_LOG(ERROR, "failed to compare", K(key), K(kvs_[slot].key_));
+          } else if (cmp_ret >= 0) {
+            is_equal = is_equal || 0 == cmp_ret;
+            ++le_cnt;
+          }
+        }
+        if (OB_SUCC(ret)) {
+          pos = le_cnt;
+          searched = true;
+        }
+      }
+    }
+    return ret;
+  }
+  // the key prefixes are allocated right after the node only if the host btree enables it.
+  OB_INLINE NodeKeyPrefix *get_key_prefix()
+  {
+    NodeKeyPrefix *key_prefix = nullptr;
+    if (KeyPrefixHelper::ENABLED
+        && OB_NOT_NULL(host_)
+        && static_cast<ObKeyBtree *>(host_)->is_key_prefix_enabled()) {
+      key_prefix = reinterpret_cast<NodeKeyPrefix *>(this + 1);
+    }
+    return key_prefix;
+  }
   void copy(BtreeNode &dest, const int dest_start, const int start, const int end);
   void copy_and_insert(BtreeNode &dest_node, const int start, const int end, int pos,
                        BtreeKey key_1, BtreeVal val_1, BtreeKey key_2, BtreeVal val_2);
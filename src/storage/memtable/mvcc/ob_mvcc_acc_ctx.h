@@ -50,6 +50,7 @@ public:
       mem_ctx_(NULL),
       tx_scn_(-1),
       write_flag_(),
+      is_read_ts_registered_(false),
       handle_start_time_(OB_INVALID_TIMESTAMP),
       lock_wait_start_ts_(0)
   {}
@@ -63,6 +64,7 @@ public:
     mem_ctx_ = NULL;
     tx_scn_ = -1;
     write_flag_.reset();
+    is_read_ts_registered_ = false;
     handle_start_time_ = OB_INVALID_TIMESTAMP;
   }
   void reset() {
@@ -80,6 +82,7 @@ public:
     mem_ctx_ = NULL;
     tx_scn_ = -1;
     write_flag_.reset();
+    is_read_ts_registered_ = false;
     handle_start_time_ = OB_INVALID_TIMESTAMP;
   }
   bool is_valid() const {
@@ -197,6 +200,10 @@ public:
   bool is_weak_read() const { return type_ == T::WEAK_READ; }
   bool is_write() const { return type_ == T::WRITE; }
   bool is_replay() const { return type_ == T::REPLAY; }
+  // the snapshot has been pushed into the max read ts, so the txns which
+  // begin to commit later will commit above it
+  void set_read_ts_registered() { is_read_ts_registered_ = true; }
+  bool is_read_ts_registered() const { return is_read_ts_registered_; }
   int64_t eval_lock_expire_ts(int64_t lock_wait_start_ts = 0) const {
     int64_t expire_ts = OB_INVALID_TIMESTAMP;
     if (tx_lock_timeout_ >= 0) {
@@ -227,6 +234,7 @@ public:
                KP_(mem_ctx),
                K_(tx_scn),
                K_(write_flag),
+               K_(is_read_ts_registered),
                K_(handle_start_time),
                K_(lock_wait_start_ts));
 private:
@@ -256,6 +264,7 @@ public: // NOTE: those field should only be accessed by txn relative routine
   ObMemtableCtx *mem_ctx_;                     // memtable-ctx
   int64_t tx_scn_;                             // the change's number of this modify
   concurrent_control::ObWriteFlag write_flag_; // the write flag of the write process
+  bool is_read_ts_registered_;                 // the snapshot is pushed into max read ts
 
   // this was used for runtime mertic
   int64_t handle_start_time_;
@@ -38,6 +38,12 @@ void ObIMvccCtx::before_prepare(const SCN version)
   set_trans_version(version);
 }
 
+void ObIMvccCtx::add_written_memtable(ObMemtable *memtable)
+{
+  // the txn can not publish its version, so disable the summary
+  memtable->get_decided_summary().disable();
+}
+
 bool ObIMvccCtx::is_prepared() const
 {
   const SCN prepare_version = trans_version_.atomic_get();
@@ -85,6 +91,8 @@ int ObIMvccCtx::register_row_commit_cb(
 
     if (OB_FAIL(append_callback(cb))) {
       TRANS_LOG(ERROR, "register callback failed", K(*this), K(ret));
+    } else {
+      add_written_memtable(memtable);
     }
 
     if (OB_FAIL(ret)) {
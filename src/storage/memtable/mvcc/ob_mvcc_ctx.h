@@ -82,6 +82,18 @@ public: // for mvcc engine invoke
   virtual void old_row_free(void *row) = 0;
   virtual void *callback_alloc(const int64_t size) = 0;
   virtual void callback_free(ObITransCallback *cb) = 0;
+  // alloc tx node from the memtable allocator identified by owner_id
+  virtual void *tx_node_alloc(common::ObIAllocator &allocator,
+                              const int64_t owner_id,
+                              const int64_t size)
+  {
+    UNUSED(owner_id);
+    return allocator.alloc(size);
+  }
+  // the memtable is written by the txn, see ObMvccDecidedSummary
+  virtual void add_written_memtable(ObMemtable *memtable);
+  // the lower bound of the commit version is decided
+  virtual void publish_trans_version(const share::SCN trans_version) { UNUSED(trans_version); }
   virtual common::ObIAllocator &get_query_allocator() = 0;
   virtual void set_conflict_trans_id(const uint32_t descriptor)
   { UNUSED(descriptor); }
@@ -117,7 +129,11 @@ public:
   void before_prepare(const share::SCN version = share::SCN::min_scn());
   bool is_prepared() const;
   inline void set_prepare_version(const share::SCN version) { set_trans_version(version); }
-  inline void set_trans_version(const share::SCN trans_version) { trans_version_.atomic_set(trans_version); }
+  inline void set_trans_version(const share::SCN trans_version)
+  {
+    trans_version_.atomic_set(trans_version);
+    publish_trans_version(trans_version);
+  }
   inline void set_commit_version(const share::SCN trans_version) { commit_version_.atomic_set(trans_version); }
   inline void set_table_version(const int64_t table_version)
   {
@@ -155,6 +155,85 @@ public:
   }
 };
 
+// ObMvccDecidedSummary summarizes the undecided tx nodes of a memtable for
+// lock for read.
+//
+// Each txn writing on the leader publishes the lower bound of its commit
+// version into a slot before it fetches the max read ts, and revokes the slot
+// only after all its tx nodes are decided. So if the snapshot is smaller than
+// all published versions, an undecided tx node(which is not delayed cleanout)
+// must belong to a txn which either has not begun to commit(its commit version
+// will be bigger than the max read ts pushed by the reader) or will commit
+// above the snapshot, and the reader can skip it without resolving the txn
+// state from tx table.
+//
+// NB: the tx nodes written by replay are never summarized because their commit
+// version is decided on another replica, so the summary is disabled on them.
+class ObMvccDecidedSummary
+{
+public:
+  static const int64_t MAX_SLOT_CNT = 16;
+  ObMvccDecidedSummary() { reset(); }
+  void reset()
+  {
+    is_disabled_ = false;
+    overflow_cnt_ = 0;
+    for (int64_t i = 0; i < MAX_SLOT_CNT; ++i) {
+      versions_[i] = share::SCN::max_scn();
+    }
+  }
+  // return the acquired slot, or -1 if all slots are used
+  int64_t publish(const share::SCN version)
+  {
+    int64_t slot = -1;
+    const share::SCN lower = version.is_valid() ? version : share::SCN::min_scn();
+    for (int64_t i = 0; -1 == slot && i < MAX_SLOT_CNT; ++i) {
+      if (versions_[i].atomic_load().is_max()
+          && versions_[i].atomic_bcas(share::SCN::max_scn(), lower)) {
+        slot = i;
+      }
+    }
+    if (-1 == slot) {
+      ATOMIC_INC(&overflow_cnt_);
+    }
+    return slot;
+  }
+  // the commit version may be regenerated, keep the minimum one
+  void lower(const int64_t slot, const share::SCN version)
+  {
+    if (slot >= 0 && slot < MAX_SLOT_CNT) {
+      versions_[slot].dec_update(version.is_valid() ? version : share::SCN::min_scn());
+    }
+  }
+  void revoke(const int64_t slot)
+  {
+    if (slot >= 0 && slot < MAX_SLOT_CNT) {
+      versions_[slot].atomic_store(share::SCN::max_scn());
+    } else {
+      ATOMIC_DEC(&overflow_cnt_);
+    }
+  }
+  void disable()
+  {
+    if (!ATOMIC_LOAD(&is_disabled_)) {
+      ATOMIC_STORE(&is_disabled_, true);
+    }
+  }
+  bool can_skip_undecided(const share::SCN snapshot_version) const
+  {
+    bool bool_ret = !ATOMIC_LOAD(&is_disabled_) && 0 == ATOMIC_LOAD(&overflow_cnt_);
+    for (int64_t i = 0; bool_ret && i < MAX_SLOT_CNT; ++i) {
+      bool_ret = snapshot_version < versions_[i].atomic_load();
+    }
+    return bool_ret;
+  }
+  TO_STRING_KV(K_(is_disabled), K_(overflow_cnt));
+private:
+  bool is_disabled_;
+  int64_t overflow_cnt_;
+  share::SCN versions_[MAX_SLOT_CNT];
+};
+
 
 } // namespace memtable
 } // namespace oceanbase
@@ -103,6 +103,38 @@ int ObMvccEngine::try_compact_row_when_mvcc_read_(const SCN &snapshot_version,
   return ret;
 }
 
+// No more writes come after the memtable is ready for flush, so the first read
+// rewrites the long version chain of a hotspot row into a compact node once,
+// which is read by later queries until the memtable is released.
+bool ObMvccEngine::need_compact_hotspot_row_(ObMvccRow &row) const
+{
+  const int64_t freeze_state = (NULL == memtable_ ? ObMemtableFreezeState::INVALID
+                                                   : memtable_->get_freeze_state());
+  return row.is_hotspot()
+    && (ObMemtableFreezeState::READY_FOR_FLUSH == freeze_state
+        || ObMemtableFreezeState::FLUSHED == freeze_state)
+    && row.try_clear_hotspot();
+}
+
+int ObMvccEngine::compact_hotspot_row_when_mvcc_read_(ObMvccRow &row)
+{
+  int ret = OB_SUCCESS;
+  const SCN snapshot_version = SCN::minus(SCN::max_scn(), 100);
+  ObRowLatchGuard guard(row.latch_);
+  if (OB_FAIL(row.row_compact(memtable_,
+                              false/*for_replay*/,
+                              snapshot_version,
+                              engine_allocator_))) {
+    TRANS_LOG(WARN, "compact hotspot row failed", K(ret), K(row));
+  }
+  return ret;
+}
+
+const ObMvccDecidedSummary *ObMvccEngine::get_decided_summary_() const
+{
+  return NULL == memtable_ ? NULL : &memtable_->get_decided_summary();
+}
+
 int ObMvccEngine::get(ObMvccAccessCtx &ctx,
                       const ObQueryFlag &query_flag,
                       const bool skip_compact,
@@ -130,11 +162,17 @@ int ObMvccEngine::get(ObMvccAccessCtx &ctx,
     if (OB_SUCCESS != (tmp_ret = try_compact_row_when_mvcc_read_(ctx.get_snapshot_version(), *value))) {
       TRANS_LOG(WARN, "fail to try to compact row", K(tmp_ret));
     }
+  } else if (!query_flag.is_prewarm() && need_compact_hotspot_row_(*value)) {
+    int tmp_ret = OB_SUCCESS;
+    if (OB_SUCCESS != (tmp_ret = compact_hotspot_row_when_mvcc_read_(*value))) {
+      TRANS_LOG(WARN, "fail to compact hotspot row", K(tmp_ret));
+    }
   } else {
     // do nothing
   }
   if (OB_SUCC(ret)) {
     if (OB_FAIL(value_iter.init(ctx,
+                                get_decided_summary_(),
                                 returned_key,
                                 value,
                                 query_flag,
@@ -163,6 +201,7 @@ int ObMvccEngine::scan(
     ret = OB_INVALID_ARGUMENT;
   } else if (OB_FAIL(row_iter.init(*query_engine_,
                                    ctx,
+                                   get_decided_summary_(),
                                    range,
                                    query_flag))) {
     TRANS_LOG(WARN, "row_iter init fail", K(ret));
@@ -358,7 +397,8 @@ int ObMvccEngine::build_tx_node_(ObIMemtableCtx &ctx,
 {
   int ret = OB_SUCCESS;
 
-  if (OB_FAIL(kv_builder_->dup_data(node, *engine_allocator_, arg.data_))) {
+  const int64_t owner_id = (NULL == memtable_ ? -1 : memtable_->get_allocator_id());
+  if (OB_FAIL(kv_builder_->dup_data(node, ctx, *engine_allocator_, owner_id, arg.data_))) {
     TRANS_LOG(WARN, "MvccTranNode dup fail", K(ret), "node", node);
   } else {
     node->tx_id_ = ctx.get_tx_id();
@@ -118,10 +118,13 @@ public:
 private:
   int try_compact_row_when_mvcc_read_(const share::SCN &snapshot_version,
                                       ObMvccRow &row);
+  bool need_compact_hotspot_row_(ObMvccRow &row) const;
+  int compact_hotspot_row_when_mvcc_read_(ObMvccRow &row);
 
   int build_tx_node_(ObIMemtableCtx &ctx,
                      const ObTxNodeArg &arg,
                      ObMvccTransNode *&node);
+  const ObMvccDecidedSummary *get_decided_summary_() const;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObMvccEngine);
   bool is_inited_;
@@ -30,6 +30,7 @@ namespace memtable
 {
 
 int ObMvccValueIterator::init(ObMvccAccessCtx &ctx,
+                              const ObMvccDecidedSummary *decided_summary,
                               const ObMemtableKey *key,
                               ObMvccRow *value,
                               const ObQueryFlag &query_flag,
@@ -41,6 +42,7 @@ int ObMvccValueIterator::init(ObMvccAccessCtx &ctx,
   reset();
   int64_t lock_for_read_start = ObClockGenerator::getClock();
   ctx_ = &ctx;
+  decided_summary_ = decided_summary;
   if (OB_UNLIKELY(!ctx.get_snapshot_version().is_valid())) {
     ret = OB_ERR_UNEXPECTED;
   } else if (OB_ISNULL(value)) {
@@ -214,6 +216,12 @@ int ObMvccValueIterator::lock_for_read_inner_(const ObQueryFlag &flag,
         TRANS_LOG(ERROR, "lock for read never go here", KPC(iter), KPC(ctx_), K(flag));
       }
     }
+  } else if (!is_delayed_cleanout
+             // Opt4: data is undecided while its txn can not commit under the
+             //       snapshot, see ObMvccDecidedSummary, so we skip it without
+             //       resolving the txn state from tx table
+             && can_skip_undecided_(snapshot_version, *iter)) {
+    iter = iter->prev_;
   } else {
     // Case 5: data is undecided, and we need cleanout its state, then check
     //         whether we can read based on the result of the cleanout. We need
@@ -262,6 +270,20 @@ int ObMvccValueIterator::lock_for_read_inner_(const ObQueryFlag &flag,
   return ret;
 }
 
+bool ObMvccValueIterator::can_skip_undecided_(const SCN snapshot_version,
+                                              const ObMvccTransNode &node) const
+{
+  // NB: the state of the tx node must be rechecked after the summary, because
+  // the txn decides its tx nodes before it revokes its version from the summary
+  return NULL != decided_summary_
+    && ctx_->is_read_ts_registered()
+    && decided_summary_->can_skip_undecided(snapshot_version)
+    && !(node.is_committed()
+         || node.is_aborted()
+         || node.is_elr()
+         || node.is_delayed_cleanout());
+}
+
 int ObMvccValueIterator::try_cleanout_tx_node_(ObMvccTransNode *tnode)
 {
   int ret = OB_SUCCESS;
@@ -347,10 +369,13 @@ int ObMvccValueIterator::check_row_locked(ObStoreRowLockState &lock_state)
 ObMvccRowIterator::ObMvccRowIterator()
     : is_inited_(false),
       ctx_(NULL),
+      decided_summary_(NULL),
       query_flag_(),
       value_iter_(),
       query_engine_(NULL),
-      query_engine_iter_(NULL)
+      query_engine_iter_(NULL),
+      has_pending_row_(false),
+      pending_iter_flag_(0)
 {
 }
 
@@ -362,6 +387,7 @@ ObMvccRowIterator::~ObMvccRowIterator()
 int ObMvccRowIterator::init(
     ObQueryEngine &query_engine,
     ObMvccAccessCtx &ctx,
+    const ObMvccDecidedSummary *decided_summary,
     const ObMvccScanRange &range,
     const ObQueryFlag &query_flag)
 {
@@ -377,9 +403,12 @@ int ObMvccRowIterator::init(
     TRANS_LOG(WARN, "query engine scan fail", K(ret));
   } else {
     ctx_ = &ctx;
+    decided_summary_ = decided_summary;
     query_flag_ = query_flag;
     query_engine_ = &query_engine;
     query_engine_iter_->set_version(ctx.snapshot_.version_.get_val_for_tx());
+    has_pending_row_ = false;
+    pending_iter_flag_ = 0;
     is_inited_ = true;
   }
   return ret;
@@ -389,7 +418,8 @@ int ObMvccRowIterator::get_next_row(
     const ObMemtableKey *&key,
     ObMvccValueIterator *&value_iter,
     uint8_t& iter_flag,
-    const bool skip_compact)
+    const bool skip_compact,
+    const bool stop_at_undecided)
 {
   int ret = OB_SUCCESS;
   uint8_t read_partial_row = 0;
@@ -402,18 +432,30 @@ int ObMvccRowIterator::get_next_row(
   while (OB_SUCC(ret)) {
     const ObMemtableKey *tmp_key = NULL;
     ObMvccRow *value = NULL;
-    if (OB_FAIL(query_engine_iter_->next(skip_purge_memtable))) {
+    if (has_pending_row_) {
+      // resume from the row stopped at last time
+      has_pending_row_ = false;
+      read_partial_row = pending_iter_flag_;
+      pending_iter_flag_ = 0;
+    } else if (OB_FAIL(query_engine_iter_->next(skip_purge_memtable))) {
       if (OB_ITER_END != ret) {
         TRANS_LOG(WARN, "query engine iter next fail", K(ret), "ctx", *ctx_);
       }
       iter_flag = read_partial_row;
+    }
+    if (OB_FAIL(ret)) {
     } else if (NULL == (tmp_key = query_engine_iter_->get_key())) {
       TRANS_LOG(ERROR, "unexpected key null pointer", "ctx", *ctx_);
       ret = OB_ERR_UNEXPECTED;
     } else if (NULL == (value = query_engine_iter_->get_value())) {
       TRANS_LOG(ERROR, "unexpected value null pointer", "ctx", *ctx_);
       ret = OB_ERR_UNEXPECTED;
+    } else if (stop_at_undecided && is_undecided_by_others_(*value)) {
+      has_pending_row_ = true;
+      pending_iter_flag_ = read_partial_row;
+      ret = OB_EAGAIN;
     } else if (OB_FAIL(value_iter_.init(*ctx_,
+                                        decided_summary_,
                                         tmp_key,
                                         value,
                                         query_flag_,
@@ -433,10 +475,23 @@ int ObMvccRowIterator::get_next_row(
   return ret;
 }
 
+bool ObMvccRowIterator::is_undecided_by_others_(const ObMvccRow &row) const
+{
+  bool bret = false;
+  const ObMvccTransNode *head = row.get_list_head();
+  if (query_flag_.iter_uncommitted_row()) {
+    // no lock for read
+  } else if (NULL != head && !head->is_committed() && !head->is_aborted()) {
+    bret = (head->get_tx_id() != ctx_->tx_id_);
+  }
+  return bret;
+}
+
 void ObMvccRowIterator::reset()
 {
   is_inited_ = false;
   ctx_ = NULL;
+  decided_summary_ = NULL;
   query_flag_.reset();
   value_iter_.reset();
   if (NULL != query_engine_iter_) {
@@ -445,6 +500,8 @@ void ObMvccRowIterator::reset()
     query_engine_iter_ = NULL;
   }
   query_engine_ = NULL;
+  has_pending_row_ = false;
+  pending_iter_flag_ = 0;
 }
 
 int ObMvccRowIterator::get_key_val(const ObMemtableKey*& key, ObMvccRow*& row)
@@ -106,6 +106,7 @@ public:
   ObMvccValueIterator()
       : is_inited_(false),
         ctx_(NULL),
+        decided_summary_(NULL),
         value_(NULL),
         version_iter_(NULL),
         last_trans_version_(share::SCN::max_scn()),
@@ -115,6 +116,7 @@ public:
   virtual ~ObMvccValueIterator() {}
 public:
   int init(ObMvccAccessCtx &ctx,
+           const ObMvccDecidedSummary *decided_summary,
            const ObMemtableKey *key,
            ObMvccRow *value,
            const ObQueryFlag &query_flag,
@@ -128,6 +130,7 @@ public:
   {
     is_inited_ = false;
     ctx_ = NULL;
+    decided_summary_ = NULL;
     value_ = NULL;
     version_iter_ = NULL;
     last_trans_version_ = share::SCN::max_scn();
@@ -142,6 +145,8 @@ public:
 private:
   int lock_for_read_(const ObQueryFlag &flag);
   int lock_for_read_inner_(const ObQueryFlag &flag, ObMvccTransNode *&iter);
+  bool can_skip_undecided_(const share::SCN snapshot_version,
+                           const ObMvccTransNode &node) const;
   int try_cleanout_tx_node_(ObMvccTransNode *tnode);
   void move_to_next_node_();
   void lock_begin(int64_t &lock_start_time) const;
@@ -153,6 +158,7 @@ private:
 private:
   bool is_inited_;
   ObMvccAccessCtx *ctx_;
+  const ObMvccDecidedSummary *decided_summary_;
   ObMvccRow *value_;
   ObMvccTransNode *version_iter_;
   share::SCN last_trans_version_;
@@ -169,12 +175,16 @@ public:
 public:
   int init(ObQueryEngine &query_engine,
            ObMvccAccessCtx &ctx,
+           const ObMvccDecidedSummary *decided_summary,
            const ObMvccScanRange &range,
            const ObQueryFlag &query_flag);
+  // return OB_EAGAIN before reading a row written by another undecided tx if
+  // @stop_at_undecided, and the row is returned by the next call
   int get_next_row(const ObMemtableKey *&key,
                    ObMvccValueIterator *&value_iter,
                    uint8_t& iter_flag,
-                   const bool skip_compact = false);
+                   const bool skip_compact = false,
+                   const bool stop_at_undecided = false);
   void reset();
   int get_key_val(const ObMemtableKey*& key, ObMvccRow*& row);
   int try_purge(const transaction::ObTxSnapshot &snapshot_info,
@@ -185,15 +195,21 @@ public:
   }
 private:
   int check_and_purge_row_(const ObMemtableKey *key, ObMvccRow *row, bool &purged);
+  // the newest node is written by another running tx, reading the row may wait for it
+  bool is_undecided_by_others_(const ObMvccRow &row) const;
 private:
   DISALLOW_COPY_AND_ASSIGN(ObMvccRowIterator);
 private:
   bool is_inited_;
   ObMvccAccessCtx *ctx_;
+  const ObMvccDecidedSummary *decided_summary_;
   ObQueryFlag query_flag_;
   ObMvccValueIterator value_iter_;
   ObQueryEngine *query_engine_;
   ObIQueryEngineIterator *query_engine_iter_;
+  // the current row is left unread by stop_at_undecided, and returned by the next call
+  bool has_pending_row_;
+  uint8_t pending_iter_flag_;
 };
 
 }
@@ -639,11 +639,11 @@ bool ObMvccRow::is_transaction_set_violation(const SCN snapshot_version)
 
 int ObMvccRow::elr(const ObTransID &tx_id,
                    const SCN elr_commit_version,
-                   const ObTabletID &tablet_id,
-                   const ObMemtableKey* key)
+                   bool &need_wakeup)
 {
   int ret = OB_SUCCESS;
   ObMvccTransNode *iter = get_list_head();
+  need_wakeup = false;
   if (NULL != iter
       && !iter->is_elr()
       && !iter->is_committed()
@@ -662,17 +662,7 @@ int ObMvccRow::elr(const ObTransID &tx_id,
       }
     }
     max_elr_trans_version_.inc_update(elr_commit_version);
-    // TODO shanyan.g
-    if (NULL != key) {
-      wakeup_waiter(tablet_id, *key);
-    } else {
-      ObLockWaitMgr *lwm = NULL;
-      if (OB_ISNULL(lwm = MTL(ObLockWaitMgr*))) {
-        TRANS_LOG(WARN, "MTL(LockWaitMgr) is null", K(ret), KPC(this));
-      } else {
-        lwm->wakeup(tx_id);
-      }
-    }
+    need_wakeup = true;
   }
   return ret;
 }
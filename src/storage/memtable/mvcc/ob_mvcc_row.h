@@ -221,6 +221,7 @@ struct ObMvccRow
   static const uint8_t F_BTREE_TAG_DEL = 0x4;
   static const uint8_t F_LOWER_LOCK_SCANED = 0x8;
   static const uint8_t F_LOCK_DELAYED_CLEANOUT = 0x10;
+  static const uint8_t F_HOTSPOT = 0x20;
 
   static const int64_t NODE_SIZE_UNIT = 1024;
   static const int64_t WARN_WAIT_LOCK_TIME = 1 *1000 * 1000;
@@ -307,10 +308,12 @@ struct ObMvccRow
                   const share::SCN snapshot_version,
                   common::ObIAllocator *node_alloc);
 
+  // elr releases the row lock of the txn in advance, need_wakeup is set if the
+  // row is released by this call, and the caller should wakeup the waiter
+  // after the row latch is released
   int elr(const transaction::ObTransID &tx_id,
           const share::SCN elr_commit_version,
-          const ObTabletID &tablet_id,
-          const ObMemtableKey* key);
+          bool &need_wakeup);
 
   // commit the tx node and update the row meta.
   // the meta neccessary for update is
@@ -400,6 +403,24 @@ struct ObMvccRow
   {
     ATOMIC_ADD_TAG(F_LOWER_LOCK_SCANED);
   }
+  OB_INLINE bool is_hotspot() const
+  {
+    return ATOMIC_LOAD(&flag_) & F_HOTSPOT;
+  }
+  OB_INLINE void set_hotspot()
+  {
+    ATOMIC_ADD_TAG(F_HOTSPOT);
+  }
+  // return true only for the caller which clears the hotspot tag
+  OB_INLINE bool try_clear_hotspot()
+  {
+    bool bool_ret = false;
+    uint8_t old = ATOMIC_LOAD(&flag_);
+    while ((old & F_HOTSPOT) && !(bool_ret = ATOMIC_BCAS(&flag_, old, old & ~F_HOTSPOT))) {
+      old = ATOMIC_LOAD(&flag_);
+    }
+    return bool_ret;
+  }
   // ===================== ObMvccRow Helper Function =====================
   int64_t to_string(char *buf, const int64_t buf_len) const;
   int64_t to_string(char *buf, const int64_t buf_len, const bool verbose) const;
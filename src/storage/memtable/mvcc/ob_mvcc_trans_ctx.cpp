@@ -829,14 +829,21 @@ int ObMvccRowCallback::merge_memtable_key(ObMemtableKeyArray &memtable_key_arr)
 
 int ObMvccRowCallback::elr_trans_preparing()
 {
-  ObRowLatchGuard guard(value_.latch_);
-
-  ObMemtableCtx *mem_ctx = static_cast<ObMemtableCtx*>(&ctx_);
-  if (NULL != tnode_) {
-    value_.elr(mem_ctx->get_trans_ctx()->get_trans_id(),
-               ctx_.get_commit_version(),
-               get_tablet_id(),
-               (ObMemtableKey*)&key_);
+  bool need_wakeup = false;
+  {
+    ObRowLatchGuard guard(value_.latch_);
+
+    ObMemtableCtx *mem_ctx = static_cast<ObMemtableCtx*>(&ctx_);
+    if (NULL != tnode_) {
+      (void)value_.elr(mem_ctx->get_trans_ctx()->get_trans_id(),
+                       ctx_.get_commit_version(),
+                       need_wakeup);
+    }
+  }
+  // wakeup out of the row latch, so the waiter of the hot row can write on it
+  // without waiting for the wakeup of lock wait mgr
+  if (need_wakeup) {
+    (void)value_.wakeup_waiter(get_tablet_id(), key_);
   }
   return OB_SUCCESS;
 }
@@ -944,6 +951,22 @@ blocksstable::ObDmlFlag ObMvccRowCallback::get_dml_flag() const
 }
 
 int ObMvccRowCallback::trans_commit()
+{
+  int ret = OB_SUCCESS;
+  bool need_wakeup = false;
+  if (OB_FAIL(trans_commit_(need_wakeup))) {
+    TRANS_LOG(WARN, "trans commit failed", K(ret), K(*this));
+  }
+  // the waiters of the row are woken up after the row latch is released, the
+  // row released by elr is woken up again, in case its waiter missed the first
+  // wakeup and would wait until timeout
+  if (need_wakeup) {
+    wakeup_row_waiter_();
+  }
+  return ret;
+}
+
+int ObMvccRowCallback::trans_commit_(bool &need_wakeup)
 {
   int ret = OB_SUCCESS;
   ObMvccTransNode *prev = NULL;
@@ -1003,16 +1026,18 @@ int ObMvccRowCallback::trans_commit()
         if (OB_FAIL(value_.trans_commit(ctx_.get_commit_version(), *tnode_))) {
           TRANS_LOG(WARN, "mvcc trans ctx trans commit error", K(ret), K_(ctx), K_(value));
         } else if (FALSE_IT(tnode_->trans_commit(ctx_.get_commit_version(), ctx_.get_tx_end_scn()))) {
-        } else if (!ctx_.is_for_replay() && FALSE_IT(wakeup_row_waiter_if_need_())) {
+        } else if (!ctx_.is_for_replay()
+                   && FALSE_IT(need_wakeup = need_wakeup_row_waiter_())) {
         } else if (blocksstable::ObDmlFlag::DF_LOCK == get_dml_flag()) {
           unlink_trans_node();
         } else {
           const int64_t MAX_TRANS_NODE_CNT = 2 * GCONF._ob_elr_fast_freeze_threshold;
-          if (value_.total_trans_node_cnt_ > MAX_TRANS_NODE_CNT
-              && NULL != memtable_
-              && !memtable_->has_hotspot_row()) {
-            memtable_->set_contain_hotspot_row();
-            TRANS_LOG(INFO, "[FF] trans commit and set hotspot row success", K_(*memtable), K_(value), K_(ctx), K(*this));
+          if (value_.total_trans_node_cnt_ > MAX_TRANS_NODE_CNT && NULL != memtable_) {
+            if (!memtable_->has_hotspot_row()) {
+              memtable_->set_contain_hotspot_row();
+              TRANS_LOG(INFO, "[FF] trans commit and set hotspot row success", K_(*memtable), K_(value), K_(ctx), K(*this));
+            }
+            value_.set_hotspot();
           }
           (void)ATOMIC_FAA(&value_.update_since_compact_, 1);
           if (value_.need_compact(for_read, ctx_.is_for_replay())) {
@@ -1052,19 +1077,30 @@ int ObMvccRowCallback::trans_commit()
 int ObMvccRowCallback::wakeup_row_waiter_if_need_()
 {
   int ret = OB_SUCCESS;
-  if (NULL != tnode_ &&
-      (tnode_->is_committed() || tnode_->is_aborted()) &&
-      (tnode_->prev_ == NULL || tnode_->prev_->tx_id_ != tnode_->tx_id_)) {
-    ret = value_.wakeup_waiter(get_tablet_id(), key_);
-    /*****[for deadlock]*****/
-    ObLockWaitMgr *p_lwm = MTL(ObLockWaitMgr *);
-    if (OB_ISNULL(p_lwm)) {
-      TRANS_LOG(WARN, "lock wait mgr is nullptr", K(*this));
-    } else {
-      p_lwm->reset_hash_holder(get_tablet_id(), key_, ctx_.get_tx_id());
-    }
-    /************************/
+  if (need_wakeup_row_waiter_()) {
+    ret = wakeup_row_waiter_();
+  }
+  return ret;
+}
+
+bool ObMvccRowCallback::need_wakeup_row_waiter_() const
+{
+  return NULL != tnode_ &&
+    (tnode_->is_committed() || tnode_->is_aborted()) &&
+    (tnode_->prev_ == NULL || tnode_->prev_->tx_id_ != tnode_->tx_id_);
+}
+
+int ObMvccRowCallback::wakeup_row_waiter_()
+{
+  int ret = value_.wakeup_waiter(get_tablet_id(), key_);
+  /*****[for deadlock]*****/
+  ObLockWaitMgr *p_lwm = MTL(ObLockWaitMgr *);
+  if (OB_ISNULL(p_lwm)) {
+    TRANS_LOG(WARN, "lock wait mgr is nullptr", K(*this));
+  } else {
+    p_lwm->reset_hash_holder(get_tablet_id(), key_, ctx_.get_tx_id());
   }
+  /************************/
   return ret;
 }
 
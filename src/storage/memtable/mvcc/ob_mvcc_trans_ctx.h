@@ -433,6 +433,7 @@ private:
                             ObBatchChecksum *checksumer) override;
   virtual int elr_trans_preparing() override;
 private:
+  int trans_commit_(bool &need_wakeup);
   int link_and_get_next_node(ObMvccTransNode *&next);
   int row_delete();
   int merge_memtable_key(transaction::ObMemtableKeyArray &memtable_key_arr,
@@ -443,6 +444,8 @@ private:
   int dec_unsubmitted_cnt_();
   int dec_unsynced_cnt_();
   int wakeup_row_waiter_if_need_();
+  bool need_wakeup_row_waiter_() const;
+  int wakeup_row_waiter_();
 private:
   ObIMvccCtx &ctx_;
   ObMemtableKey key_;
@@ -14,6 +14,7 @@
 #include "storage/memtable/ob_memtable_data.h"
 #include "common/ob_store_range.h"
 #include "storage/blocksstable/ob_row_reader.h"
+#include "observer/omt/ob_tenant_config_mgr.h"
 
 namespace oceanbase
 {
@@ -201,6 +202,10 @@ int ObQueryEngine::init(const uint64_t tenant_id)
     TRANS_LOG(WARN, "init twice", K(this));
     ret = OB_INIT_TWICE;
   } else {
+    omt::ObTenantConfigGuard tenant_config(TENANT_CONF(tenant_id));
+    // no node has been allocated before init
+    btree_allocator_.set_enable_key_prefix(tenant_config.is_valid()
+                                           && tenant_config->_enable_memtable_key_prefix);
     tenant_id_ = tenant_id;
     is_inited_ = true;
   }
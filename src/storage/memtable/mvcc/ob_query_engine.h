@@ -27,6 +27,36 @@ namespace common
 {
 class ObIAllocator;
 }
+namespace keybtree
+{
+// prefix of memtable rowkey is the order preserving value of the first int/uint column.
+template<>
+struct KeyPrefixHelper<memtable::ObStoreRowkeyWrapper>
+{
+  enum
+  {
+    KEY_PREFIX_INT = KEY_PREFIX_NONE + 1,
+    KEY_PREFIX_UINT
+  };
+  static const bool ENABLED = true;
+  OB_INLINE static void get_prefix(const memtable::ObStoreRowkeyWrapper &key, uint8_t &kind, uint64_t &prefix)
+  {
+    kind = KEY_PREFIX_NONE;
+    prefix = 0;
+    if (OB_NOT_NULL(key.get_rowkey()) && key.get_rowkey()->get_obj_cnt() > 0) {
+      const common::ObObj &obj = key.get_ptr()[0];
+      const common::ObObjTypeClass tc = obj.get_type_class();
+      if (common::ObIntTC == tc) {
+        kind = KEY_PREFIX_INT;
+        prefix = static_cast<uint64_t>(obj.get_int()) ^ (1ULL << 63);
+      } else if (common::ObUIntTC == tc) {
+        kind = KEY_PREFIX_UINT;
+        prefix = obj.get_uint64();
+      }
+    }
+  }
+};
+}
 namespace memtable
 {
 class ObMvccRow;
@@ -98,6 +128,7 @@ public:
           if (skip_purge_memtable || value_->is_partial(version_)) {
             iter_flag_ |= STORE_ITER_ROW_PARTIAL;
           }
+          prefetch_ahead();
         }
       }
       if (common::OB_ITER_END == ret) {
@@ -119,6 +150,27 @@ public:
     BtreeIterator &get_read_handle() { return btree_iter_; }
     inline uint8_t get_iter_flag() const { return iter_flag_; }
   private:
+    // mvcc rows are prefetched farther ahead than their newest trans nodes, so that
+    // reading list_head_ of a row to prefetch its node does not stall the scan.
+    OB_INLINE void prefetch_ahead() const
+    {
+      ObMvccRow *row = nullptr;
+      if (common::OB_SUCCESS == btree_iter_.peek_value(PREFETCH_ROW_DISTANCE, row)
+          && OB_NOT_NULL(row)) {
+        __builtin_prefetch(row, 0 /* read */, 1);
+      }
+      row = nullptr;
+      if (common::OB_SUCCESS == btree_iter_.peek_value(PREFETCH_NODE_DISTANCE, row)
+          && OB_NOT_NULL(row)) {
+        const ObMvccTransNode *node = row->get_list_head();
+        if (OB_NOT_NULL(node)) {
+          __builtin_prefetch(node, 0 /* read */, 1);
+        }
+      }
+    }
+  private:
+    static const int64_t PREFETCH_ROW_DISTANCE = 8;
+    static const int64_t PREFETCH_NODE_DISTANCE = 4;
     DISALLOW_COPY_AND_ASSIGN(Iterator);
     BtreeIterator btree_iter_;
     ObMemtableKey key_;
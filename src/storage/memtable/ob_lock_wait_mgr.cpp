@@ -96,7 +96,6 @@ bool is_rowkey_hash(const uint64_t hash)
 
 ObLockWaitMgr::ObLockWaitMgr()
     : is_inited_(false),
-      hash_(hash_buf_, sizeof(hash_buf_)),
       deadlocked_sessions_lock_(common::ObLatchIds::DEADLOCK_DETECT_LOCK),
       deadlocked_sessions_index_(0)
 {
@@ -303,16 +302,17 @@ bool ObLockWaitMgr::wait(Node* node)
   uint64_t hash = node->hash();
   uint64_t last_lock_seq = node->lock_seq_;
   bool is_standalone_task = false;
+  LockShard &shard = get_shard(hash);
   if (has_set_stop()) {
     // wait fail if _stop
   } else if (check_wakeup_seq(hash, last_lock_seq, is_standalone_task)) {
     Node* tmp_node = NULL;
     {
-      CriticalGuard(get_qs());
+      CriticalGuard(shard.qsync_);
       // 1. set the task as standalone task which need to be forced to wake up
       node->try_lock_times_++;
       node->set_standalone_task(is_standalone_task);
-      while(-EAGAIN == (err = hash_.insert(node)))
+      while(-EAGAIN == (err = shard.hash_.insert(node)))
         ;
       assert(0 == err);
 
@@ -324,7 +324,7 @@ bool ObLockWaitMgr::wait(Node* node)
       }
       // 3. Exception operation
       if (has_set_stop()) {
-        while(-EAGAIN == (err = hash_.del(node, tmp_node)))
+        while(-EAGAIN == (err = shard.hash_.del(node, tmp_node)))
           ;
         if (0 != err) {
           wait_succ = true; // maybe repost by checktimeout
@@ -339,7 +339,7 @@ bool ObLockWaitMgr::wait(Node* node)
     // 4. it should be promised that no other threads is visting the request if
     // the wait sync is needed
     if (NULL != tmp_node) {
-      WaitQuiescent(get_qs());
+      WaitQuiescent(shard.qsync_);
     }
   }
   TRANS_LOG(TRACE, "LockWaitMgr.wait", K(is_standalone_task),
@@ -368,17 +368,24 @@ void ObLockWaitMgr::wakeup(uint64_t hash)
 
 ObLockWaitMgr::Node* ObLockWaitMgr::next(Node*& iter, Node* target)
 {
-  CriticalGuard(get_qs());
-  if (NULL != (iter = hash_.next(iter))) {
-    *target = *iter;
-    Node *node = hash_.get_next_internal(target->hash());
-    while(NULL != node && node->hash() < target->hash()) {
-      node = (Node*)link_next(node);
-    }
-    if (NULL != node && node->hash() == target->hash()) {
-      target->set_block_sessid(node->sessid_);
+  // the iter is always the copied target, so its shard is stable
+  int64_t shard_idx = (NULL == iter) ? 0 : get_shard_idx(iter->hash());
+  for (; shard_idx < LOCK_SHARD_COUNT; ++shard_idx) {
+    LockShard &shard = shards_[shard_idx];
+    CriticalGuard(shard.qsync_);
+    if (NULL != (iter = shard.hash_.next(iter))) {
+      *target = *iter;
+      Node *node = shard.hash_.get_next_internal(target->hash());
+      while(NULL != node && node->hash() < target->hash()) {
+        node = (Node*)link_next(node);
+      }
+      if (NULL != node && node->hash() == target->hash()) {
+        target->set_block_sessid(node->sessid_);
+      }
+      break;
     }
-  } else {
+  }
+  if (NULL == iter) {
     target = NULL;
   }
   return target;
@@ -388,10 +395,11 @@ ObLockWaitMgr::Node* ObLockWaitMgr::fetch_waiter(uint64_t hash)
 {
   Node* ret = NULL;
   Node* node = NULL;
+  LockShard &shard = get_shard(hash);
   {
-    CriticalGuard(get_qs());
+    CriticalGuard(shard.qsync_);
     ATOMIC_INC(&sequence_[(hash >> 1) % LOCK_BUCKET_COUNT]);
-    node = hash_.get_next_internal(hash);
+    node = shard.hash_.get_next_internal(hash);
     // we do not need to wake up if the request is not running
     while(NULL != node && node->hash() <= hash) {
       if (node->hash() == hash) {
@@ -400,7 +408,7 @@ ObLockWaitMgr::Node* ObLockWaitMgr::fetch_waiter(uint64_t hash)
           break;
         } else {
           int err = 0;
-          while(-EAGAIN == (err = hash_.del(node, ret)))
+          while(-EAGAIN == (err = shard.hash_.del(node, ret)))
             ;
           if (0 != err) {
             ret = NULL;
@@ -413,7 +421,7 @@ ObLockWaitMgr::Node* ObLockWaitMgr::fetch_waiter(uint64_t hash)
     }
   }
   if (NULL != ret) {
-    WaitQuiescent(get_qs());
+    WaitQuiescent(shard.qsync_);
   }
   return ret;
 }
@@ -435,100 +443,107 @@ ObLink* ObLockWaitMgr::check_timeout()
     need_check_session = true;
     last_check_session_idle_ts = curr_ts;
   }
-  {
-    CriticalGuard(get_qs());
-    while(NULL != (iter = hash_.quick_next(iter))) {
-      if (NULL != node2del) {
-        retire_node(tail, node2del);
-        node2del = NULL;
-      }
-      TRANS_LOG(TRACE, "LOCK_MGR: check", K(*iter));
-      uint64_t hash = iter->hash();
-      uint64_t last_lock_seq = iter->lock_seq_;
-      uint64_t curr_lock_seq = ATOMIC_LOAD(&sequence_[(hash >> 1)% LOCK_BUCKET_COUNT]);
-      if (iter->is_timeout() || has_set_stop()) {
-        TRANS_LOG_RET(WARN, OB_TIMEOUT, "LOCK_MGR: req wait lock timeout", K(curr_lock_seq), K(last_lock_seq), K(*iter));
-        need_check_session = true;
-        node2del = iter;
-        EVENT_INC(MEMSTORE_WRITE_LOCK_WAIT_TIMEOUT_COUNT);
-        // it needs to be placed before the judgment of session_id to prevent the
-        // abnormal case which session_id equals 0 from causing the problem of missing wakeup
-      } else if (iter->is_standalone_task() && iter->get_run_ts() == 0) {
-        node2del = iter;
-        need_check_session = true;
-        iter->on_retry_lock(hash);
-        TRANS_LOG(INFO, "standalone task should be waken up", K(*iter), K(curr_lock_seq));
-      } else if (iter->get_run_ts() > 0 && ObTimeUtility::current_time() > iter->get_run_ts()) {
-        node2del = iter;
-        need_check_session = true;
-        // it is desgined to fix the case once the mvcc_write does not try
-        // again, the reuqests waiting on the same row can also be wakup after
-        // the request ends
-        iter->on_retry_lock(hash);
-        TRANS_LOG(INFO, "current task should be waken up cause reaching run ts", K(*iter));
-      } else if (0 == iter->sessid_) {
-        //do nothing, may be rpc plan, sessionid is not setted
-      } else if (NULL != deadlocked_session
-                 && is_deadlocked_session_(deadlocked_session,
-                                           iter->sessid_)) {
-        node2del = iter;
-        TRANS_LOG(INFO, "session is deadlocked, pop the request",
-                  "sessid", iter->sessid_, K(*iter));
-      }
-      if (need_check_session) {
-        sql::ObSQLSessionInfo *session_info = NULL;
-        int ret = OB_SUCCESS;
-        int tmp_ret = OB_SUCCESS;
-        ObSessionGetterGuard guard(*GCTX.session_mgr_, iter->sessid_);
-        if (OB_FAIL(guard.get_session(session_info))) {
-          TRANS_LOG(ERROR, "failed to get session_info ", K(ret),  "sessid", iter->sessid_, K(*iter));
-        } else if (OB_ISNULL(session_info)) {
-          // when the request exist, the session should exist as well
-          ret = OB_ERR_UNEXPECTED;
-          TRANS_LOG(ERROR, "got session_info is NULL", K(ret),  "sessid", iter->sessid_, K(*iter));
-        } else if (OB_UNLIKELY(session_info->is_terminate(tmp_ret))) {
-          // session is killed, just pop the request
+  for (int64_t i = 0; i < LOCK_SHARD_COUNT; ++i) {
+    LockShard &shard = shards_[i];
+    iter = NULL;
+    node2del = NULL;
+    ObLink* shard_tail = tail;
+    {
+      CriticalGuard(shard.qsync_);
+      while(NULL != (iter = shard.hash_.quick_next(iter))) {
+        if (NULL != node2del) {
+          retire_node(shard, tail, node2del);
+          node2del = NULL;
+        }
+        TRANS_LOG(TRACE, "LOCK_MGR: check", K(*iter));
+        uint64_t hash = iter->hash();
+        uint64_t last_lock_seq = iter->lock_seq_;
+        uint64_t curr_lock_seq = ATOMIC_LOAD(&sequence_[(hash >> 1)% LOCK_BUCKET_COUNT]);
+        if (iter->is_timeout() || has_set_stop()) {
+          TRANS_LOG_RET(WARN, OB_TIMEOUT, "LOCK_MGR: req wait lock timeout", K(curr_lock_seq), K(last_lock_seq), K(*iter));
+          need_check_session = true;
           node2del = iter;
-          TRANS_LOG(INFO, "session is killed, pop the request",  "sessid", iter->sessid_, K(*iter), K(tmp_ret));
-        } else if (NULL == node2del && curr_ts - iter->lock_ts_ > MAX_WAIT_TIME_US/2) {
-          // in order to prevent missing to wakeup request, so we force to wakeup every 5s
+          EVENT_INC(MEMSTORE_WRITE_LOCK_WAIT_TIMEOUT_COUNT);
+          // it needs to be placed before the judgment of session_id to prevent the
+          // abnormal case which session_id equals 0 from causing the problem of missing wakeup
+        } else if (iter->is_standalone_task() && iter->get_run_ts() == 0) {
           node2del = iter;
+          need_check_session = true;
           iter->on_retry_lock(hash);
-          TRANS_LOG_RET(WARN, OB_ERR_TOO_MUCH_TIME, "LOCK_MGR: req wait lock cost too much time", K(curr_lock_seq), K(last_lock_seq), K(*iter));
-        } else {
-          auto tx_desc = session_info->get_tx_desc();
-          bool ac = false, has_explicit_start_tx = session_info->has_explicit_start_trans();
-          session_info->get_autocommit(ac);
-          if (OB_ISNULL(tx_desc) && (!ac || has_explicit_start_tx)) {
-            auto session_id = session_info->get_sessid();
-            auto &trace_id = session_info->get_current_trace_id();
-            TRANS_LOG(WARN, "LOG_MGR: found session ac = 0 or has_explicit_start_trans but txDesc was released!",
-                      K(session_id), K(trace_id), K(ac), K(has_explicit_start_tx));
-          }
+          TRANS_LOG(INFO, "standalone task should be waken up", K(*iter), K(curr_lock_seq));
+        } else if (iter->get_run_ts() > 0 && ObTimeUtility::current_time() > iter->get_run_ts()) {
+          node2del = iter;
+          need_check_session = true;
+          // it is desgined to fix the case once the mvcc_write does not try
+          // again, the reuqests waiting on the same row can also be wakup after
+          // the request ends
+          iter->on_retry_lock(hash);
+          TRANS_LOG(INFO, "current task should be waken up cause reaching run ts", K(*iter));
+        } else if (0 == iter->sessid_) {
+          //do nothing, may be rpc plan, sessionid is not setted
+        } else if (NULL != deadlocked_session
+                   && is_deadlocked_session_(deadlocked_session,
+                                             iter->sessid_)) {
+          node2del = iter;
+          TRANS_LOG(INFO, "session is deadlocked, pop the request",
+                    "sessid", iter->sessid_, K(*iter));
         }
-        if (OB_NOT_NULL(session_info)) {
-          auto tx_desc = session_info->get_tx_desc();
-          TRANS_LOG(INFO, "check transaction state", KP(tx_desc));
+        if (need_check_session) {
+          sql::ObSQLSessionInfo *session_info = NULL;
+          int ret = OB_SUCCESS;
+          int tmp_ret = OB_SUCCESS;
+          ObSessionGetterGuard guard(*GCTX.session_mgr_, iter->sessid_);
+          if (OB_FAIL(guard.get_session(session_info))) {
+            TRANS_LOG(ERROR, "failed to get session_info ", K(ret),  "sessid", iter->sessid_, K(*iter));
+          } else if (OB_ISNULL(session_info)) {
+            // when the request exist, the session should exist as well
+            ret = OB_ERR_UNEXPECTED;
+            TRANS_LOG(ERROR, "got session_info is NULL", K(ret),  "sessid", iter->sessid_, K(*iter));
+          } else if (OB_UNLIKELY(session_info->is_terminate(tmp_ret))) {
+            // session is killed, just pop the request
+            node2del = iter;
+            TRANS_LOG(INFO, "session is killed, pop the request",  "sessid", iter->sessid_, K(*iter), K(tmp_ret));
+          } else if (NULL == node2del && curr_ts - iter->lock_ts_ > MAX_WAIT_TIME_US/2) {
+            // in order to prevent missing to wakeup request, so we force to wakeup every 5s
+            node2del = iter;
+            iter->on_retry_lock(hash);
+            TRANS_LOG_RET(WARN, OB_ERR_TOO_MUCH_TIME, "LOCK_MGR: req wait lock cost too much time", K(curr_lock_seq), K(last_lock_seq), K(*iter));
+          } else {
+            auto tx_desc = session_info->get_tx_desc();
+            bool ac = false, has_explicit_start_tx = session_info->has_explicit_start_trans();
+            session_info->get_autocommit(ac);
+            if (OB_ISNULL(tx_desc) && (!ac || has_explicit_start_tx)) {
+              auto session_id = session_info->get_sessid();
+              auto &trace_id = session_info->get_current_trace_id();
+              TRANS_LOG(WARN, "LOG_MGR: found session ac = 0 or has_explicit_start_trans but txDesc was released!",
+                        K(session_id), K(trace_id), K(ac), K(has_explicit_start_tx));
+            }
+          }
+          if (OB_NOT_NULL(session_info)) {
+            auto tx_desc = session_info->get_tx_desc();
+            TRANS_LOG(INFO, "check transaction state", KP(tx_desc));
+          }
         }
       }
+      if (NULL != node2del) {
+        retire_node(shard, tail, node2del);
+      }
     }
-    if (NULL != node2del) {
-      retire_node(tail, node2del);
+    // only the retired nodes of this shard need to be synced
+    if (tail != shard_tail) {
+      WaitQuiescent(shard.qsync_);
     }
   }
-  if (NULL != tail) {
-    WaitQuiescent(get_qs());
-  }
   return tail;
 }
 
-void ObLockWaitMgr::retire_node(ObLink*& tail, Node* node)
+void ObLockWaitMgr::retire_node(LockShard &shard, ObLink*& tail, Node* node)
 {
   int err = 0;
   Node* tmp_node = NULL;
   EVENT_INC(MEMSTORE_WRITE_LOCK_WAKENUP_COUNT);
   EVENT_ADD(MEMSTORE_WAIT_WRITE_LOCK_TIME, ObTimeUtility::current_time() - node->lock_ts_);
-  while (-EAGAIN == (err = hash_.del(node, tmp_node)))
+  while (-EAGAIN == (err = shard.hash_.del(node, tmp_node)))
     ;
   if (0 == err) {
     node->retire_link_.next_ = tail;
@@ -539,8 +554,9 @@ void ObLockWaitMgr::retire_node(ObLink*& tail, Node* node)
 void ObLockWaitMgr::delay_header_node_run_ts(const uint64_t hash)
 {
   Node* node = NULL;
-  CriticalGuard(get_qs());
-  node = hash_.get_next_internal(hash);
+  LockShard &shard = get_shard(hash);
+  CriticalGuard(shard.qsync_);
+  node = shard.hash_.get_next_internal(hash);
   if (NULL != node && !node->is_dummy()) {
     // delay the execution of the header node by 10ms to ensure that the remote
     // request can be executed successfully
@@ -728,10 +744,11 @@ void ObLockWaitMgr::wakeup(const ObLockID &lock_id)
 int ObLockWaitMgr::fullfill_row_key(uint64_t hash, char *row_key, int64_t length)
 {
   int ret = OB_SUCCESS;
-  CriticalGuard(get_qs());
+  LockShard &shard = get_shard(hash);
+  CriticalGuard(shard.qsync_);
   Node *node = NULL;
 
-  if (hash_.get(hash, node)) {
+  if (shard.hash_.get(hash, node)) {
     snprintf(row_key, std::min(length, static_cast<int64_t>(sizeof(node->key_)) + 1), "%s", node->key_);
   } else {
     const char *err = "can't found";
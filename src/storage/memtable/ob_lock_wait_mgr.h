@@ -185,10 +185,21 @@ public:
 
 public:
   enum { LOCK_BUCKET_COUNT = 16384};
+  // waiters are spread into shards by hash, each shard owns its hash list and
+  // quiescent sync, so the wakeup on one row only syncs with the readers of
+  // its own shard
+  enum { LOCK_SHARD_COUNT = 8 };
+  enum { LOCK_SHARD_BUCKET_COUNT = LOCK_BUCKET_COUNT / LOCK_SHARD_COUNT };
   static const int64_t OB_SESSPAIR_COUNT = 16;
   typedef ObMemtableKey Key;
   typedef rpc::ObLockWaitNode Node;
   typedef FixedHash2<Node> Hash;
+  struct LockShard {
+    LockShard() : hash_(hash_buf_, sizeof(hash_buf_)) {}
+    Hash hash_;
+    ObQSync qsync_;
+    char hash_buf_[sizeof(SpHashNode) * LOCK_SHARD_BUCKET_COUNT];
+  };
   struct SessPair {
     uint32_t sess_id_;
     TO_STRING_KV(K(sess_id_));
@@ -278,7 +289,7 @@ protected:
   // retried(session is killed, deadlocked or son on), and wakeup and retry them
   ObLink* check_timeout();
   // reclaim the chained reuqests
-  void retire_node(ObLink*& tail, Node* node);
+  void retire_node(LockShard &shard, ObLink*& tail, Node* node);
   // wakeup the request and put into the thread worker queue
   virtual int repost(Node* node);
 
@@ -295,18 +306,22 @@ private:
     return hold_key;
   }
 
-  ObQSync& get_qs()
+  static int64_t get_shard_idx(const uint64_t hash)
+  {
+    return (hash >> 1) % LOCK_SHARD_COUNT;
+  }
+
+  LockShard &get_shard(const uint64_t hash)
   {
-    static ObQSync qsync;
-    return qsync;
+    return shards_[get_shard_idx(hash)];
   }
 
   bool is_hash_empty()
   {
-    bool is_empty = false;
-    {
-      CriticalGuard(get_qs());
-      is_empty = hash_.is_empty();
+    bool is_empty = true;
+    for (int64_t i = 0; is_empty && i < LOCK_SHARD_COUNT; ++i) {
+      CriticalGuard(shards_[i].qsync_);
+      is_empty = shards_[i].hash_.is_empty();
     }
     return is_empty;
   }
@@ -329,9 +344,8 @@ private:
 
 private:
   bool is_inited_;
-  Hash hash_;
+  LockShard shards_[LOCK_SHARD_COUNT];
   int64_t sequence_[LOCK_BUCKET_COUNT];
-  char hash_buf_[sizeof(SpHashNode) * LOCK_BUCKET_COUNT];
 
 public:
   int fullfill_row_key(uint64_t hash, char *row_key, int64_t length);
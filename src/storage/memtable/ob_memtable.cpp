@@ -126,6 +126,7 @@ ObMemtable::ObMemtable()
       mode_(lib::Worker::CompatMode::INVALID),
       minor_merged_time_(0),
       contain_hotspot_row_(false),
+      decided_summary_(),
       multi_source_data_(local_allocator_),
       multi_source_data_lock_()
 {
@@ -187,6 +188,7 @@ int ObMemtable::init(const ObITable::TableKey &table_key,
     timestamp_ = ObTimeUtility::current_time();
     is_inited_ = true;
     contain_hotspot_row_ = false;
+    decided_summary_.reset();
     TRANS_LOG(DEBUG, "memtable init success", K(*this));
   }
 
@@ -272,6 +274,7 @@ void ObMemtable::destroy()
   is_flushed_ = false;
   is_inited_ = false;
   contain_hotspot_row_ = false;
+  decided_summary_.reset();
   snapshot_version_.set_max();
 }
 
@@ -2604,6 +2607,8 @@ int ObMemtable::mvcc_replay_(storage::ObStoreCtx &ctx,
   ObIMemtableCtx *mem_ctx = ctx.mvcc_acc_ctx_.get_mem_ctx();
   ObMvccReplayResult res;
   common::ObTimeGuard timeguard("ObMemtable::mvcc_replay_", 5 * 1000);
+  // the commit version of the replayed txn is decided by the leader
+  decided_summary_.disable();
 
   if (OB_FAIL(mvcc_engine_.create_kv(key,
                                      &stored_key,
@@ -106,15 +106,23 @@ public:
 
   // template parameter only supports ObMemtableData and ObMemtableDataHeader,
   // actual dup objetc is always ObMemtableDataHeader
+  // tx node is allocated through the transaction from the memtable allocator
+  // identified by owner_id, so nodes of a transaction are packed together
   template<class T>
-  int dup_data(ObMvccTransNode *&new_node, common::ObIAllocator &allocator, const T *data)
+  int dup_data(ObMvccTransNode *&new_node,
+               ObIMemtableCtx &ctx,
+               common::ObIAllocator &allocator,
+               const int64_t owner_id,
+               const T *data)
   {
     int ret = OB_SUCCESS;
     int64_t data_size = 0;
     new_node = nullptr;
     if (OB_FAIL(get_data_size(data, data_size))) {
       TRANS_LOG(WARN, "get_data_size failed", K(ret), KP(data), K(data_size));
-    } else if (OB_ISNULL(new_node = (ObMvccTransNode *)allocator.alloc(sizeof(ObMvccTransNode) + data_size))
+    } else if (OB_ISNULL(new_node = (ObMvccTransNode *)ctx.tx_node_alloc(allocator,
+                                                                         owner_id,
+                                                                         sizeof(ObMvccTransNode) + data_size))
                || OB_ISNULL(new(new_node) ObMvccTransNode())) {
       TRANS_LOG(WARN, "alloc ObMvccTransNode fail");
       ret = OB_ALLOCATE_MEMORY_FAILED;
@@ -364,8 +372,11 @@ public:
   void set_minor_merged();
   int64_t get_minor_merged_time() const { return minor_merged_time_; }
   common::ObIAllocator &get_allocator() {return local_allocator_;}
+  // identify the memory of this memtable, the id changes when the memtable is reused
+  int64_t get_allocator_id() const { return local_allocator_.get_id(); }
   bool has_hotspot_row() const { return ATOMIC_LOAD(&contain_hotspot_row_); }
   void set_contain_hotspot_row() { return ATOMIC_STORE(&contain_hotspot_row_, true); }
+  ObMvccDecidedSummary &get_decided_summary() { return decided_summary_; }
   virtual int64_t get_upper_trans_version() const override;
   virtual int estimate_phy_size(const ObStoreRowkey* start_key, const ObStoreRowkey* end_key, int64_t& total_bytes, int64_t& total_rows) override;
   virtual int get_split_ranges(const ObStoreRowkey* start_key, const ObStoreRowkey* end_key, const int64_t part_cnt, common::ObIArray<common::ObStoreRange> &range_array) override;
@@ -577,6 +588,7 @@ private:
   lib::Worker::CompatMode mode_;
   int64_t minor_merged_time_;
   bool contain_hotspot_row_;
+  ObMvccDecidedSummary decided_summary_;
   ObMultiSourceData multi_source_data_;
   mutable common::TCRWLock multi_source_data_lock_;
 };
@@ -39,6 +39,161 @@ using namespace transaction::tablelock;
 
 namespace memtable
 {
+void ObTxNodeArena::reset()
+{
+  owner_ = NULL;
+  owner_id_ = -1;
+  owner_used_ = 0;
+  waste_size_ = 0;
+  pos_ = NULL;
+  end_ = NULL;
+}
+
+void ObTxNodeArena::abandon_tail_()
+{
+  if (NULL != pos_) {
+    waste_size_ += end_ - pos_;
+  }
+  pos_ = NULL;
+  end_ = NULL;
+}
+
+void *ObTxNodeArena::alloc(ObIAllocator &allocator, const int64_t owner_id, const int64_t size)
+{
+  void *ptr = NULL;
+  const int64_t align_size = upper_align(size, sizeof(int64_t));
+  if (owner_id < 0 || align_size > MAX_NODE_SIZE) {
+    ptr = allocator.alloc(size);
+  } else {
+    ObByteLockGuard guard(lock_);
+    if (&allocator != owner_ || owner_id != owner_id_) {
+      // the transaction writes into another memtable, the rest of the chunk is left
+      abandon_tail_();
+      owner_ = &allocator;
+      owner_id_ = owner_id;
+      owner_used_ = 0;
+    }
+    if (NULL != pos_ && pos_ + align_size <= end_) {
+      ptr = pos_;
+      pos_ += align_size;
+    } else if (owner_used_ < MIN_USED_FOR_CHUNK || waste_size_ >= MAX_WASTE_SIZE) {
+      ptr = allocator.alloc(align_size);
+    } else {
+      const int64_t chunk_size = MIN(owner_used_ / 4, MAX_CHUNK_SIZE);
+      char *chunk = NULL;
+      if (OB_NOT_NULL(chunk = (char *)allocator.alloc(chunk_size))) {
+        abandon_tail_();
+        ptr = chunk;
+        pos_ = chunk + align_size;
+        end_ = chunk + chunk_size;
+      }
+    }
+    if (OB_NOT_NULL(ptr)) {
+      owner_used_ += align_size;
+    }
+  }
+  return ptr;
+}
+
+void ObTxDecidedPublisher::reset()
+{
+  cnt_ = 0;
+  is_published_ = false;
+  version_.set_max();
+  for (int64_t i = 0; i < MAX_MEMTABLE_CNT; ++i) {
+    memtables_[i] = NULL;
+    slots_[i] = -1;
+  }
+}
+
+void ObTxDecidedPublisher::add(ObMemtable *memtable)
+{
+  bool found = false;
+  const int64_t cnt = ATOMIC_LOAD(&cnt_);
+  for (int64_t i = 0; !found && i < cnt; ++i) {
+    found = (memtable == ATOMIC_LOAD(&memtables_[i]));
+  }
+  if (!found) {
+    ObByteLockGuard guard(lock_);
+    for (int64_t i = 0; !found && i < cnt_; ++i) {
+      found = (memtable == memtables_[i]);
+    }
+    if (found) {
+      // added by the concurrent write
+    } else if (cnt_ >= MAX_MEMTABLE_CNT) {
+      memtable->get_decided_summary().disable();
+    } else {
+      slots_[cnt_] = is_published_ ? memtable->get_decided_summary().publish(version_) : -1;
+      ATOMIC_STORE(&memtables_[cnt_], memtable);
+      ATOMIC_STORE(&cnt_, cnt_ + 1);
+    }
+  }
+}
+
+void ObTxDecidedPublisher::publish(const SCN version)
+{
+  ObByteLockGuard guard(lock_);
+  if (!is_published_) {
+    for (int64_t i = 0; i < cnt_; ++i) {
+      slots_[i] = memtables_[i]->get_decided_summary().publish(version);
+    }
+    version_ = version;
+    is_published_ = true;
+  } else if (version < version_) {
+    for (int64_t i = 0; i < cnt_; ++i) {
+      memtables_[i]->get_decided_summary().lower(slots_[i], version);
+    }
+    version_ = version;
+  }
+}
+
+void ObTxDecidedPublisher::disable()
+{
+  ObByteLockGuard guard(lock_);
+  for (int64_t i = 0; i < cnt_; ++i) {
+    memtables_[i]->get_decided_summary().disable();
+  }
+}
+
+void ObTxDecidedPublisher::revoke(const bool is_decided)
+{
+  ObByteLockGuard guard(lock_);
+  for (int64_t i = 0; i < cnt_; ++i) {
+    ObMvccDecidedSummary &summary = memtables_[i]->get_decided_summary();
+    if (!is_decided) {
+      // the slot is leaked on purpose, the summary is disabled anyway
+      summary.disable();
+    } else if (is_published_) {
+      summary.revoke(slots_[i]);
+    }
+    ATOMIC_STORE(&memtables_[i], NULL);
+  }
+  ATOMIC_STORE(&cnt_, 0);
+}
+
+void ObTxDecidedPublisher::remove(ObMemtable *memtable)
+{
+  ObByteLockGuard guard(lock_);
+  int64_t pos = -1;
+  for (int64_t i = 0; -1 == pos && i < cnt_; ++i) {
+    if (memtable == memtables_[i]) {
+      pos = i;
+    }
+  }
+  if (pos >= 0) {
+    // the removed callbacks leave their tx nodes delayed cleanout
+    if (is_published_) {
+      memtable->get_decided_summary().revoke(slots_[pos]);
+    }
+    for (int64_t i = pos; i < cnt_ - 1; ++i) {
+      ATOMIC_STORE(&memtables_[i], memtables_[i + 1]);
+      slots_[i] = slots_[i + 1];
+    }
+    ATOMIC_STORE(&memtables_[cnt_ - 1], NULL);
+    ATOMIC_STORE(&cnt_, cnt_ - 1);
+  }
+}
+
 ObMemtableCtx::ObMemtableCtx()
     : ObIMemtableCtx(ctx_cb_allocator_),
       rwlock_(),
@@ -48,6 +203,8 @@ ObMemtableCtx::ObMemtableCtx()
       ref_(0),
       query_allocator_(),
       ctx_cb_allocator_(),
+      tx_node_arena_(),
+      decided_publisher_(),
       log_conflict_interval_(LOG_CONFLICT_INTERVAL),
       ctx_(NULL),
       truncate_cnt_(0),
@@ -141,6 +298,8 @@ void ObMemtableCtx::reset()
     unsubmitted_cnt_ = 0;
     partition_audit_info_cache_.reset();
     lock_mem_ctx_.reset();
+    tx_node_arena_.reset();
+    decided_publisher_.reset();
     //FIXME: ctx_ is not reset
     log_conflict_interval_.reset();
     mtstat_.reset();
@@ -354,6 +513,23 @@ void *ObMemtableCtx::callback_alloc(const int64_t size)
   return ret;
 }
 
+void *ObMemtableCtx::tx_node_alloc(ObIAllocator &allocator,
+                                   const int64_t owner_id,
+                                   const int64_t size)
+{
+  return tx_node_arena_.alloc(allocator, owner_id, size);
+}
+
+void ObMemtableCtx::add_written_memtable(ObMemtable *memtable)
+{
+  decided_publisher_.add(memtable);
+}
+
+void ObMemtableCtx::publish_trans_version(const SCN trans_version)
+{
+  decided_publisher_.publish(trans_version);
+}
+
 void ObMemtableCtx::callback_free(ObITransCallback *cb)
 {
   if (OB_ISNULL(cb)) {
@@ -495,6 +671,8 @@ int ObMemtableCtx::do_trans_end(
     if (OB_FAIL(trans_mgr_.trans_end(commit))) {
       TRANS_LOG(WARN, "trans end error", K(ret), K(*this));
     }
+    // all tx nodes are decided by the callbacks
+    decided_publisher_.revoke(OB_SUCCESS == ret);
     // after a transaction finishes, callback memory should be released
     // and check memory leakage
     if (OB_UNLIKELY(ATOMIC_LOAD(&callback_alloc_count_) != ATOMIC_LOAD(&callback_free_count_))) {
@@ -607,6 +785,7 @@ int ObMemtableCtx::commit_to_replay()
   WRLockGuard wrguard(rwlock_);
   trans_mgr_.set_for_replay(true);
   trans_mgr_.merge_multi_callback_lists();
+  decided_publisher_.disable();
   return OB_SUCCESS;
 }
 
@@ -934,6 +1113,9 @@ int ObMemtableCtx::remove_callback_for_uncommited_txn(ObMemtable *mt, const shar
   } else if (OB_FAIL(trans_mgr_.remove_callback_for_uncommited_txn(mt, max_applied_scn))) {
     TRANS_LOG(WARN, "fail to remove callback for uncommitted txn", K(ret), K(mt));
   }
+  if (OB_NOT_NULL(mt)) {
+    decided_publisher_.remove(mt);
+  }
 
   return ret;
 }
@@ -301,7 +301,73 @@ private:
   bool is_inited_;
 };
 
+// Carves the tx nodes of one transaction out of chunks allocated from the memtable,
+// so the version nodes written by a transaction are packed together instead of
+// interleaving with concurrent transactions. Tx nodes are never freed one by one,
+// the chunk is released with the memtable.
+//
+// The memstore can not take back part of a chunk, so the unused tails are bounded:
+// a chunk is at most a quarter of the bytes the transaction has written into the
+// memtable, and chunks are no longer used once the abandoned tails of the
+// transaction reach MAX_WASTE_SIZE.
+class ObTxNodeArena
+{
+public:
+  // chunk size grows with the data written by the transaction into the memtable,
+  // small transactions allocate from the memtable directly and waste nothing.
+  static const int64_t MAX_NODE_SIZE = 512;
+  static const int64_t MIN_USED_FOR_CHUNK = 2048;
+  static const int64_t MAX_CHUNK_SIZE = 4096;
+  static const int64_t MAX_WASTE_SIZE = 16384;
+  ObTxNodeArena() { reset(); }
+  ~ObTxNodeArena() {}
+  void reset();
+  void *alloc(common::ObIAllocator &allocator, const int64_t owner_id, const int64_t size);
+  int64_t get_waste_size() const { return waste_size_; }
+  TO_STRING_KV(KP_(owner), K_(owner_id), K_(owner_used), K_(waste_size), KP_(pos), KP_(end));
+private:
+  void abandon_tail_();
+private:
+  common::ObByteLock lock_;
+  common::ObIAllocator *owner_;
+  int64_t owner_id_;
+  // bytes of tx nodes allocated from the owner
+  int64_t owner_used_;
+  // bytes of chunk tails left in the memtables
+  int64_t waste_size_;
+  char *pos_;
+  char *end_;
+};
+
 class ObMemtable;
+// memtables written by the txn on the leader, the txn publishes the lower bound
+// of its commit version into their decided summaries before its commit version
+// is decided, and revokes it after all its tx nodes are decided.
+class ObTxDecidedPublisher
+{
+public:
+  static const int64_t MAX_MEMTABLE_CNT = 8;
+  ObTxDecidedPublisher() { reset(); }
+  ~ObTxDecidedPublisher() {}
+  void reset();
+  void add(ObMemtable *memtable);
+  void publish(const share::SCN version);
+  // the txn will be decided by replay
+  void disable();
+  // all tx nodes are decided, or the summaries are disabled if not
+  void revoke(const bool is_decided);
+  // the memtable is released and its callbacks are removed
+  void remove(ObMemtable *memtable);
+  TO_STRING_KV(K_(cnt), K_(is_published), K_(version));
+private:
+  common::ObByteLock lock_;
+  int64_t cnt_;
+  bool is_published_;
+  share::SCN version_;
+  ObMemtable *memtables_[MAX_MEMTABLE_CNT];
+  int64_t slots_[MAX_MEMTABLE_CNT];
+};
+
 typedef common::ObIDMap<ObIMemtableCtx, uint32_t> MemtableIDMap;
 class ObMemtableCtx final : public ObIMemtableCtx
 {
@@ -321,6 +387,11 @@ public:
   virtual void old_row_free(void *row) override;
   virtual void *callback_alloc(const int64_t size) override;
   virtual void callback_free(ObITransCallback *cb) override;
+  virtual void *tx_node_alloc(common::ObIAllocator &allocator,
+                              const int64_t owner_id,
+                              const int64_t size) override;
+  virtual void add_written_memtable(ObMemtable *memtable) override;
+  virtual void publish_trans_version(const share::SCN trans_version) override;
   virtual ObOBJLockCallback *alloc_table_lock_callback(ObIMvccCtx &ctx,
                                                        ObLockMemtable *memtable) override;
   virtual void free_table_lock_callback(ObITransCallback *cb) override;
@@ -516,6 +587,8 @@ private:
   // allocate memory for callback when query executing
   ObQueryAllocator query_allocator_;
   ObMemtableCtxCbAllocator ctx_cb_allocator_;
+  ObTxNodeArena tx_node_arena_;
+  ObTxDecidedPublisher decided_publisher_;
   ObRedoLogGenerator log_gen_;
   MemtableCtxStat mtstat_;
   ObTimeInterval log_conflict_interval_;
@@ -164,7 +164,13 @@ ObMemtableScanIterator::ObMemtableScanIterator()
       cur_range_(),
       row_iter_(),
       row_(),
-      iter_flag_(0)
+      iter_flag_(0),
+      batch_allocator_(NULL),
+      batch_rows_(NULL),
+      batch_row_cnt_(0),
+      batch_row_idx_(0),
+      batch_size_(1),
+      batch_ret_(OB_SUCCESS)
 {
   GARL_ADD(&active_resource_, "scan_iter");
 }
@@ -198,6 +204,10 @@ int ObMemtableScanIterator::init(
     TRANS_LOG(WARN, "Unexpected null read info", K(ret), K(param));
   } else if (OB_FAIL(row_.init(*context.stmt_allocator_, read_info_->get_request_count()))) {
     TRANS_LOG(WARN, "Failed to init datum row", K(ret));
+  } else if (param.vectorized_enabled_
+             && !param.is_for_foreign_check_
+             && OB_FAIL(init_batch_rows(*context.stmt_allocator_, read_info_->get_request_count()))) {
+    TRANS_LOG(WARN, "Failed to init batch rows", K(ret));
   } else {
     TRANS_LOG(DEBUG, "scan iterator init succ", K(param.table_id_));
     param_ = &param;
@@ -266,6 +276,7 @@ int ObMemtableScanIterator::prepare_scan()
       TRANS_LOG(WARN, "Failed to init bitmap ", K(ret));
     } else {
       iter_flag_ = 0;
+      reuse_batch();
       is_scan_start_ = true;
       TRANS_LOG(DEBUG, "mvcc engine scan success",
                 K_(memtable), K(mvcc_scan_range), KPC(context_->store_ctx_),
@@ -328,22 +339,89 @@ int ObMemtableScanIterator::get_real_range(const ObDatumRange &range, ObDatumRan
 int ObMemtableScanIterator::inner_get_next_row(const ObDatumRow *&row)
 {
   int ret = OB_SUCCESS;
-  const ObMemtableKey *key = NULL;
-  ObMvccValueIterator *value_iter = NULL;
-  const bool skip_compact = false;
   if (IS_NOT_INIT) {
     TRANS_LOG(WARN, "not init", KP(this));
     ret = OB_NOT_INIT;
   } else if (OB_FAIL(prepare_scan())) {
     TRANS_LOG(WARN, "prepare scan fail", K(ret));
-  } else if (OB_FAIL(row_iter_.get_next_row(key, value_iter, iter_flag_, skip_compact))
-      || NULL == key || NULL == value_iter) {
+  } else if (NULL == batch_rows_) {
+    if (OB_SUCC(fetch_next_row(row_, iter_flag_))) {
+      row = &row_;
+    }
+  } else if (batch_row_idx_ >= batch_row_cnt_ && OB_FAIL(fetch_next_batch())) {
     if (OB_ITER_END != ret) {
+      TRANS_LOG(WARN, "fail to fetch next batch", K(ret));
+    }
+  } else {
+    iter_flag_ = batch_iter_flags_[batch_row_idx_];
+    row = &batch_rows_[batch_row_idx_++];
+  }
+  if (OB_FAIL(ret)) {
+    iter_flag_ = 0;
+  }
+  return ret;
+}
+
+int ObMemtableScanIterator::fetch_next_batch()
+{
+  int ret = batch_ret_;
+  if (OB_SUCC(ret)) {
+    const int64_t batch_size = get_batch_size();
+    batch_row_cnt_ = 0;
+    batch_row_idx_ = 0;
+    while (OB_SUCC(ret) && batch_row_cnt_ < batch_size) {
+      // only the first row of a batch may wait for the lock, the rows
+      // resolved before are returned first
+      const bool stop_at_undecided = batch_row_cnt_ > 0;
+      if (OB_FAIL(fetch_next_row(batch_rows_[batch_row_cnt_], batch_iter_flags_[batch_row_cnt_], stop_at_undecided))) {
+        if (OB_EAGAIN == ret) {
+          ret = OB_SUCCESS;
+          break;
+        } else if (OB_ITER_END != ret) {
+          TRANS_LOG(WARN, "fail to fetch next row", K(ret), K_(batch_row_cnt));
+        }
+      } else {
+        ++batch_row_cnt_;
+      }
+    }
+    if (OB_FAIL(ret) && batch_row_cnt_ > 0) {
+      // return the resolved rows first
+      batch_ret_ = ret;
+      ret = OB_SUCCESS;
+    }
+    if (OB_SUCC(ret)) {
+      batch_size_ = MIN(batch_size_ * 2, MAX_BATCH_ROW_CNT);
+    }
+  }
+  return ret;
+}
+
+int64_t ObMemtableScanIterator::get_batch_size() const
+{
+  int64_t batch_size = batch_size_;
+  const common::ObLimitParam *limit_param = context_->limit_param_;
+  if (NULL != limit_param && limit_param->limit_ >= 0) {
+    // no need to resolve the rows beyond the limit
+    const int64_t remain_cnt = limit_param->offset_ + limit_param->limit_ - context_->out_cnt_;
+    batch_size = MAX(1, MIN(batch_size, remain_cnt));
+  }
+  return batch_size;
+}
+
+int ObMemtableScanIterator::fetch_next_row(ObDatumRow &row, uint8_t &iter_flag, const bool stop_at_undecided)
+{
+  int ret = OB_SUCCESS;
+  const ObMemtableKey *key = NULL;
+  ObMvccValueIterator *value_iter = NULL;
+  const bool skip_compact = false;
+  if (OB_FAIL(row_iter_.get_next_row(key, value_iter, iter_flag, skip_compact, stop_at_undecided))
+      || NULL == key || NULL == value_iter) {
+    if (OB_ITER_END != ret && OB_EAGAIN != ret) {
       TRANS_LOG(WARN, "row_iter_ get_next_row fail", K(ret), KP(key), KP(value_iter));
     }
     ret = (OB_SUCCESS == ret) ? OB_ERR_UNEXPECTED : ret;
   } else {
-    TRANS_LOG(DEBUG, "chaser debug memtable next row", KPC(key), K(iter_flag_), K(bitmap_.get_nop_cnt()));
+    TRANS_LOG(DEBUG, "chaser debug memtable next row", KPC(key), K(iter_flag), K(bitmap_.get_nop_cnt()));
     const ObStoreRowkey *rowkey = NULL;
     int64_t row_scn = 0;
     key->get_rowkey(rowkey);
@@ -368,10 +446,10 @@ int ObMemtableScanIterator::inner_get_next_row(const ObDatumRow *&row)
                       value_iter->get_mvcc_row()->get_last_compact_cnt(),
                       value_iter->get_mvcc_row()->get_total_trans_node_cnt());
       }
-    } else if (OB_FAIL(ObReadRow::iterate_row(*read_info_, *rowkey, *(context_->allocator_), *value_iter, row_, bitmap_, row_scn))) {
+    } else if (OB_FAIL(ObReadRow::iterate_row(*read_info_, *rowkey, *(context_->allocator_), *value_iter, row, bitmap_, row_scn))) {
       TRANS_LOG(WARN, "iterate_row fail", K(ret), K(*rowkey), KP(value_iter));
     } else {
-      STORAGE_LOG(DEBUG, "chaser debug memtable next row", K(row_));
+      STORAGE_LOG(DEBUG, "chaser debug memtable next row", K(row));
       if (param_->need_scn_) {
         const ObColDescIArray *out_cols = nullptr;
         if (OB_ISNULL(out_cols = param_->get_out_col_descs())) {
@@ -380,26 +458,59 @@ int ObMemtableScanIterator::inner_get_next_row(const ObDatumRow *&row)
         } else {
           for (int64_t i = 0; i < out_cols->count(); i++) {
             if (out_cols->at(i).col_id_ == OB_HIDDEN_TRANS_VERSION_COLUMN_ID) {
-              row_.storage_datums_[i].reuse();
-              row_.storage_datums_[i].set_int(row_scn);
-              TRANS_LOG(DEBUG, "set row scn is", K(i), K(row_scn), K_(row));
+              row.storage_datums_[i].reuse();
+              row.storage_datums_[i].set_int(row_scn);
+              TRANS_LOG(DEBUG, "set row scn is", K(i), K(row_scn), K(row));
             }
           }
         }
       }
 
-      row_.scan_index_ = 0;
-      row = &row_;
+      row.scan_index_ = 0;
       if (context_->query_flag_.iter_uncommitted_row() && !is_committed) { // set for mark deletion
-        row_.row_flag_.set_flag(ObDmlFlag::DF_UPDATE);
+        row.row_flag_.set_flag(ObDmlFlag::DF_UPDATE);
       }
     }
   }
-  if (OB_FAIL(ret)) {
-    iter_flag_ = 0;
+  return ret;
+}
+
+int ObMemtableScanIterator::init_batch_rows(ObIAllocator &allocator, const int64_t col_cnt)
+{
+  int ret = OB_SUCCESS;
+  void *buf = NULL;
+  if (OB_ISNULL(buf = allocator.alloc(sizeof(ObDatumRow) * MAX_BATCH_ROW_CNT))) {
+    ret = OB_ALLOCATE_MEMORY_FAILED;
+    TRANS_LOG(WARN, "Failed to alloc batch rows", K(ret));
+  } else {
+    batch_allocator_ = &allocator;
+    batch_rows_ = static_cast<ObDatumRow *>(buf);
+    for (int64_t i = 0; i < MAX_BATCH_ROW_CNT; ++i) {
+      new (batch_rows_ + i) ObDatumRow();
+    }
+    for (int64_t i = 0; OB_SUCC(ret) && i < MAX_BATCH_ROW_CNT; ++i) {
+      if (OB_FAIL(batch_rows_[i].init(allocator, col_cnt))) {
+        TRANS_LOG(WARN, "Failed to init batch row", K(ret), K(i), K(col_cnt));
+      }
+    }
+    reuse_batch();
   }
   return ret;
+}
 
+void ObMemtableScanIterator::reset_batch_rows()
+{
+  if (NULL != batch_rows_) {
+    for (int64_t i = 0; i < MAX_BATCH_ROW_CNT; ++i) {
+      batch_rows_[i].~ObDatumRow();
+    }
+    if (NULL != batch_allocator_) {
+      batch_allocator_->free(batch_rows_);
+    }
+    batch_rows_ = NULL;
+  }
+  batch_allocator_ = NULL;
+  reuse_batch();
 }
 
 void ObMemtableScanIterator::reset()
@@ -414,6 +525,7 @@ void ObMemtableScanIterator::reset()
   row_.reset();
   bitmap_.reuse();
   iter_flag_ = 0;
+  reset_batch_rows();
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
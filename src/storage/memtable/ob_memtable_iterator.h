@@ -147,9 +147,24 @@ public:
 protected:
   int get_real_range(const blocksstable::ObDatumRange &range, blocksstable::ObDatumRange &real_range);
   int prepare_scan();
+  int init_batch_rows(common::ObIAllocator &allocator, const int64_t col_cnt);
+  void reset_batch_rows();
+  OB_INLINE void reuse_batch()
+  {
+    batch_row_cnt_ = 0;
+    batch_row_idx_ = 0;
+    batch_size_ = 1;
+    batch_ret_ = common::OB_SUCCESS;
+  }
+  // resolve rows from consecutive btree entries, the batch grows from 1 to
+  // MAX_BATCH_ROW_CNT and stops before a row undecided by other txs
+  int fetch_next_batch();
+  int64_t get_batch_size() const;
+  int fetch_next_row(blocksstable::ObDatumRow &row, uint8_t &iter_flag, const bool stop_at_undecided = false);
 public:
   static const int64_t ROW_ALLOCATOR_PAGE_SIZE = common::OB_MALLOC_NORMAL_BLOCK_SIZE;
   static const int64_t CELL_ALLOCATOR_PAGE_SIZE = common::OB_MALLOC_NORMAL_BLOCK_SIZE;
+  static const int64_t MAX_BATCH_ROW_CNT = 32;
 private:
   // means SCANITER
   static const uint64_t VALID_MAGIC_NUM = 0x524554494e414353;
@@ -168,6 +183,15 @@ protected:
   blocksstable::ObDatumRow row_;
   ObNopBitMap bitmap_;
   uint8_t iter_flag_;
+  // rows resolved ahead of the consumer, null if not scanned by a vectorized consumer
+  common::ObIAllocator *batch_allocator_;
+  blocksstable::ObDatumRow *batch_rows_;
+  uint8_t batch_iter_flags_[MAX_BATCH_ROW_CNT];
+  int64_t batch_row_cnt_;
+  int64_t batch_row_idx_;
+  int64_t batch_size_;
+  // error met when resolving the batch, returned after the resolved rows
+  int batch_ret_;
 };
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
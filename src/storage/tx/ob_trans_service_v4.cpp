@@ -1013,7 +1013,10 @@ int ObTransService::get_read_store_ctx(const ObTxReadSnapshot &snapshot,
      lock_timeout,
      snapshot.is_weak_read()
     );
-    update_max_read_ts_(tenant_id_, ls_id, snapshot.core_.version_);
+    // the result is ignored as before, the snapshot is registered only on success
+    if (OB_SUCCESS == update_max_read_ts_(tenant_id_, ls_id, snapshot.core_.version_)) {
+      store_ctx.mvcc_acc_ctx_.set_read_ts_registered();
+    }
   }
 
   TRANS_LOG(TRACE, "get-read-store-ctx", K(ret), K(store_ctx), K(read_latest), K(snapshot));
@@ -1106,7 +1109,10 @@ int ObTransService::get_write_store_ctx(ObTxDesc &tx,
      *
      * so it's required to update `max_read_ts` for these write
      */
-    update_max_read_ts_(tenant_id_, ls_id, snap.version_);
+    // the result is ignored as before, the snapshot is registered only on success
+    if (OB_SUCCESS == update_max_read_ts_(tenant_id_, ls_id, snap.version_)) {
+      store_ctx.mvcc_acc_ctx_.set_read_ts_registered();
+    }
   }
   TRANS_LOG(TRACE, "get-write-store-ctx", K(ret),
             K(store_ctx), KPC(this), K(tx), K(snapshot), K(lbt()));
@@ -195,6 +195,9 @@ int ObTxLoopWorker::scan_all_ls_(bool can_tx_gc, bool can_gc_retain_ctx)
       if (can_gc_retain_ctx) {
         do_retain_ctx_gc_(cur_ls_ptr);
       }
+
+      // grow tx data map, interval = 100ms
+      do_grow_tx_data_map_(cur_ls_ptr);
     }
   }
 
@@ -258,6 +261,18 @@ void ObTxLoopWorker::update_max_commit_ts_()
   } while (OB_EAGAIN == ret);
 }
 
+void ObTxLoopWorker::do_grow_tx_data_map_(ObLS *ls_ptr)
+{
+  int ret = OB_SUCCESS;
+
+  if (OB_FAIL(ls_ptr->get_tx_table()->get_tx_data_table()->grow_tx_data_map_if_need())) {
+    TRANS_LOG(WARN, "[Tx Loop Worker] grow tx data map failed", K(ret), K(MTL_ID()),
+              K(ls_ptr->get_ls_id()));
+  }
+
+  UNUSED(ret);
+}
+
 void ObTxLoopWorker::do_retain_ctx_gc_(ObLS *ls_ptr)
 {
   int ret = OB_SUCCESS;
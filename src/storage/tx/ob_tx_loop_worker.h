@@ -60,6 +60,7 @@ private:
   void do_tx_gc_(ObLS *ls, share::SCN &min_start_scn, MinStartScnStatus &status);     // 15s
   void update_max_commit_ts_();
   void do_retain_ctx_gc_(ObLS * ls);  // 15s
+  void do_grow_tx_data_map_(ObLS *ls); // 100ms
 
 private:
   int64_t last_tx_gc_ts_;
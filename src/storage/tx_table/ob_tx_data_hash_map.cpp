@@ -13,43 +13,134 @@
 #include "storage/tx_table/ob_tx_data_hash_map.h"
 #include "storage/tx/ob_tx_data_define.h"
 #include "lib/utility/ob_macro_utils.h"
+#include "share/rc/ob_tenant_base.h"
 
 namespace oceanbase {
 namespace storage {
 
 void ObTxDataHashMap::destroy()
 {
-  if (OB_NOT_NULL(buckets_)) {
+  const int64_t table_cnt = table_cnt_;
+  for (int64_t t = 0; t < table_cnt; ++t) {
+    BucketTable &table = tables_[t];
     ObTxData *curr = nullptr;
     ObTxData *next = nullptr;
-    for (int64_t i = 0; i < BUCKETS_CNT; ++i) {
-      curr = buckets_[i].next_;
-      buckets_[i].next_ = nullptr;
+    for (int64_t i = 0; i <= table.mod_mask_; ++i) {
+      curr = table.buckets_[i].next_;
+      table.buckets_[i].next_ = nullptr;
       while (OB_NOT_NULL(curr)) {
         next = curr->hash_node_.next_;
         curr->dec_ref();
         curr = next;
       }
     }
-    allocator_.free(buckets_);
-    total_cnt_ = 0;
+    free_table_(t);
   }
+  reset_tables_();
 }
 
-int ObTxDataHashMap::init()
+void ObTxDataHashMap::reset_tables_()
+{
+  for (int64_t i = 0; i < MAX_TABLE_CNT; ++i) {
+    tables_[i].buckets_ = nullptr;
+    tables_[i].mod_mask_ = -1;
+    tables_[i].base_cnt_ = 0;
+  }
+  for (int64_t i = 0; i < MAX_CONCURRENCY; ++i) {
+    cnt_slots_[i].cnt_ = 0;
+  }
+  table_cnt_ = 0;
+  total_buckets_cnt_ = 0;
+}
+
+// the first table is allocated by allocator_ in init, the appended ones are
+// allocated in background concurrently with inserters, so they are allocated
+// by ob_malloc which is thread safe.
+int ObTxDataHashMap::alloc_table_(const int64_t table_idx, const int64_t buckets_cnt)
 {
   int ret = OB_SUCCESS;
-  const int64_t alloc_size = BUCKETS_CNT * sizeof(ObTxDataHashHeader);
-  void *ptr = allocator_.alloc(alloc_size);
+  BucketTable &table = tables_[table_idx];
+  const int64_t alloc_size = buckets_cnt * sizeof(ObTxDataHashHeader);
+  void *ptr = nullptr;
+  if (0 == table_idx) {
+    ptr = allocator_.alloc(alloc_size);
+  } else {
+    ptr = ob_malloc(alloc_size, ObMemAttr(MTL_ID(), "TxDataHashGrow"));
+  }
   if (OB_ISNULL(ptr)) {
     ret = OB_ALLOCATE_MEMORY_FAILED;
-    STORAGE_LOG(WARN, "allocate memory failed when init tx data hash map", KR(ret), K(alloc_size), K(BUCKETS_CNT));
+    STORAGE_LOG(WARN, "allocate memory failed when init tx data hash map", KR(ret), K(alloc_size), K(buckets_cnt));
+  } else {
+    table.buckets_ = new (ptr) ObTxDataHashHeader[buckets_cnt];
+    for (int64_t i = 0; i < buckets_cnt; i++) {
+      table.buckets_[i].reset();
+    }
+    table.mod_mask_ = buckets_cnt - 1;
+    table.base_cnt_ = count();
+  }
+  return ret;
+}
+
+int ObTxDataHashMap::init()
+{
+  int ret = OB_SUCCESS;
+  reset_tables_();
+  if (OB_FAIL(alloc_table_(0, BUCKETS_CNT))) {
+    STORAGE_LOG(WARN, "alloc first bucket table failed", KR(ret), K(BUCKETS_CNT));
+  } else {
+    total_buckets_cnt_ = BUCKETS_CNT;
+    table_cnt_ = 1;
+  }
+  return ret;
+}
+
+void ObTxDataHashMap::free_table_(const int64_t table_idx)
+{
+  if (OB_NOT_NULL(tables_[table_idx].buckets_)) {
+    if (0 == table_idx) {
+      allocator_.free(tables_[table_idx].buckets_);
+    } else {
+      ob_free(tables_[table_idx].buckets_);
+    }
+    tables_[table_idx].buckets_ = nullptr;
+  }
+}
+
+bool ObTxDataHashMap::need_grow_(const int64_t table_idx) const
+{
+  const BucketTable &table = tables_[table_idx];
+  const int64_t buckets_cnt = table.mod_mask_ + 1;
+  return table_idx + 1 < MAX_TABLE_CNT
+         && get_buckets_cnt() + (buckets_cnt << 1) <= MAX_BUCKETS_CNT
+         && double(count() - table.base_cnt_) > double(buckets_cnt) * LOAD_FACTORY_MAX_LIMIT;
+}
+
+int ObTxDataHashMap::grow_if_need()
+{
+  int ret = OB_SUCCESS;
+  const int64_t table_cnt = ATOMIC_LOAD(&table_cnt_);
+  if (table_cnt <= 0) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "tx data hash map is not inited", KR(ret));
+  } else if (!need_grow_(table_cnt - 1)) {
+    // no need or no room to grow
+  } else if (OB_SUCCESS != grow_lock_.trylock()) {
+    // growing by others
   } else {
-    buckets_ = new (ptr) ObTxDataHashHeader[BUCKETS_CNT];
-    for (int i = 0; i < BUCKETS_CNT; i++) {
-      buckets_[i].reset();
+    const int64_t table_idx = table_cnt - 1;
+    const int64_t new_buckets_cnt = (tables_[table_idx].mod_mask_ + 1) << 1;
+    if (table_cnt != ATOMIC_LOAD(&table_cnt_)) {
+      // grown by others
+    } else if (OB_FAIL(alloc_table_(table_cnt, new_buckets_cnt))) {
+      STORAGE_LOG(WARN, "grow tx data hash map failed", KR(ret), K(table_idx), K(new_buckets_cnt));
+    } else {
+      ATOMIC_STORE(&total_buckets_cnt_, total_buckets_cnt_ + new_buckets_cnt);
+      // publish the table after it is ready
+      ATOMIC_STORE(&table_cnt_, table_cnt + 1);
+      STORAGE_LOG(INFO, "grow tx data hash map", K(table_idx), K(new_buckets_cnt),
+                  "total_buckets_cnt", get_buckets_cnt(), "count", count());
     }
-    total_cnt_ = 0;
+    (void)grow_lock_.unlock();
   }
   return ret;
 }
@@ -62,22 +153,24 @@ int ObTxDataHashMap::insert(const transaction::ObTransID &key, ObTxData *value)
     ret = OB_INVALID_ARGUMENT;
     STORAGE_LOG(WARN, "invalid argument", K(key), KP(value));
   } else {
-    int64_t pos = get_pos(key);
+    const int64_t table_idx = ATOMIC_LOAD(&table_cnt_) - 1;
+    ObTxDataHashHeader &bucket = get_bucket_(tables_[table_idx], key);
 
     // atomic insert this value
     while (true) {
-      ObTxData *next_value = ATOMIC_LOAD(&buckets_[pos].next_);
+      ObTxData *next_value = ATOMIC_LOAD(&bucket.next_);
       value->hash_node_.next_ = next_value;
-      if (next_value == ATOMIC_CAS(&buckets_[pos].next_, next_value, value)) {
+      if (next_value == ATOMIC_CAS(&bucket.next_, next_value, value)) {
         if (value->inc_ref() <= 0) {
           ret = OB_ERR_UNEXPECTED;
           STORAGE_LOG(ERROR, "unexpected ref cnt on tx data", KR(ret), KPC(value));
           ob_abort();
         }
-        ATOMIC_INC(&total_cnt_);
         break;
       }
     }
+
+    (void)ATOMIC_AAF(&cnt_slots_[get_itid() & MAX_CONCURRENCY_MASK].cnt_, 1);
   }
   return ret;
 }
@@ -91,20 +184,23 @@ int ObTxDataHashMap::get(const transaction::ObTransID &key, ObTxDataGuard &guard
     ret = OB_INVALID_ARGUMENT;
     STORAGE_LOG(WARN, "invalid argument", K(key));
   } else {
-    const int64_t pos = get_pos(key);
-    ObTxData *cache_val = buckets_[pos].hot_cache_val_;
-    if (OB_NOT_NULL(cache_val) && cache_val->contain(key)) {
-      value = cache_val;
-    } else {
-      ObTxData *tmp_value = nullptr;
-      tmp_value = buckets_[pos].next_;
-      while (OB_NOT_NULL(tmp_value)) {
-        if (tmp_value->contain(key)) {
-          value = tmp_value;
-          buckets_[pos].hot_cache_val_ = value;
-          break;
-        } else {
-          tmp_value = tmp_value->hash_node_.next_;
+    // the newer table holds the later inserted tx data
+    for (int64_t t = ATOMIC_LOAD(&table_cnt_) - 1; t >= 0 && OB_ISNULL(value); --t) {
+      ObTxDataHashHeader &bucket = get_bucket_(tables_[t], key);
+      ObTxData *cache_val = bucket.hot_cache_val_;
+      if (OB_NOT_NULL(cache_val) && cache_val->contain(key)) {
+        value = cache_val;
+      } else {
+        ObTxData *tmp_value = nullptr;
+        tmp_value = bucket.next_;
+        while (OB_NOT_NULL(tmp_value)) {
+          if (tmp_value->contain(key)) {
+            value = tmp_value;
+            bucket.hot_cache_val_ = value;
+            break;
+          } else {
+            tmp_value = tmp_value->hash_node_.next_;
+          }
         }
       }
     }
@@ -122,21 +218,27 @@ int ObTxDataHashMap::Iterator::get_next(ObTxDataGuard &guard)
 {
   int ret = OB_SUCCESS;
   ObTxData *next_val = nullptr;
+  const int64_t table_cnt = ATOMIC_LOAD(&tx_data_map_.table_cnt_);
 
   while (OB_SUCC(ret) && OB_ISNULL(next_val)) {
     if (OB_NOT_NULL(val_)) {
       next_val = val_;
       val_ = val_->hash_node_.next_;
-    } else if (bucket_idx_ >= tx_data_map_.BUCKETS_CNT) {
+    } else if (table_idx_ >= table_cnt) {
       ret = OB_ITER_END;
     } else {
-      while (++bucket_idx_ < tx_data_map_.BUCKETS_CNT) {
-        val_ = tx_data_map_.buckets_[bucket_idx_].next_;
+      const BucketTable &table = tx_data_map_.tables_[table_idx_];
+      while (++bucket_idx_ <= table.mod_mask_) {
+        val_ = table.buckets_[bucket_idx_].next_;
 
         if (OB_NOT_NULL(val_)) {
           break;
         }
       }
+      if (bucket_idx_ > table.mod_mask_) {
+        ++table_idx_;
+        bucket_idx_ = -1;
+      }
     }
   }
 
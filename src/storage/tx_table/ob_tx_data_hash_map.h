@@ -18,6 +18,7 @@
 #include "lib/utility/ob_print_utils.h"
 #include "lib/container/ob_se_array.h"
 #include "lib/allocator/ob_slice_alloc.h"
+#include "lib/lock/ob_spin_lock.h"
 #include "storage/tx/ob_trans_define.h"
 
 namespace oceanbase {
@@ -30,6 +31,15 @@ namespace storage {
 class ObTxData;
 class ObTxDataGuard;
 
+// Insert-only hash map of tx data. The map starts with the given buckets and
+// grows by appending a bucket table with double buckets once the newest table
+// is over loaded. Nodes never move between tables, so insert and get stay
+// lock free during growth: new nodes go to the newest table and get searches
+// tables from the newest to the oldest.
+//
+// NB: the growth is not done by inserters, it is driven by grow_if_need() in
+// background, and the appended tables are allocated out of the given allocator
+// which may be not thread safe.
 class ObTxDataHashMap {
 private:
   static const int64_t MAX_CONCURRENCY = 32;
@@ -38,6 +48,8 @@ public:
   static const int64_t MIN_BUCKETS_CNT = 65536; /* 1 << 16 (MOD_MASK = 0xFFFF) 1MB */
   static const int64_t DEFAULT_BUCKETS_CNT = 1048576; /* 1 << 20 (MOD_MASK = 0xFFFFF) 16MB */
   static const int64_t MAX_BUCKETS_CNT = 16777216; /* 1 << 24 (MOD_MASK = 0xFFFFFF) 256MB */
+  // MIN_BUCKETS_CNT * (2^8 - 1) <= MAX_BUCKETS_CNT
+  static const int64_t MAX_TABLE_CNT = 8;
   static constexpr double LOAD_FACTORY_MAX_LIMIT = 0.7;
   static constexpr double LOAD_FACTORY_MIN_LIMIT = 0.2;
 
@@ -45,9 +57,12 @@ public:
   ObTxDataHashMap(ObIAllocator &allocator, const uint64_t buckets_cnt)
       : allocator_(allocator),
         BUCKETS_CNT(buckets_cnt),
-        BUCKETS_MOD_MASK(buckets_cnt - 1),
-        buckets_(nullptr),
-        total_cnt_(0) {}
+        grow_lock_(),
+        table_cnt_(0),
+        total_buckets_cnt_(0)
+  {
+    reset_tables_();
+  }
   ~ObTxDataHashMap()
   {
     destroy();
@@ -58,28 +73,32 @@ public:
 
   int insert(const transaction::ObTransID &key, ObTxData *value);
   int get(const transaction::ObTransID &key, ObTxDataGuard &guard);
+  // append a bucket table if the newest one is over loaded
+  int grow_if_need();
+  OB_INLINE int64_t get_table_cnt() const { return ATOMIC_LOAD(&table_cnt_); }
 
-  OB_INLINE int64_t get_pos(const transaction::ObTransID key)
-  {
-    return key.hash() & BUCKETS_MOD_MASK;
-  }
-
-  OB_INLINE int64_t get_buckets_cnt()
+  // total buckets of all tables
+  OB_INLINE int64_t get_buckets_cnt() const
   {
-    return BUCKETS_CNT;
+    return ATOMIC_LOAD(&total_buckets_cnt_);
   }
 
   OB_INLINE int64_t count() const
   {
-    return ATOMIC_LOAD(&total_cnt_);
+    int64_t total_cnt = 0;
+    for (int64_t i = 0; i < MAX_CONCURRENCY; ++i) {
+      total_cnt += ATOMIC_LOAD(&cnt_slots_[i].cnt_);
+    }
+    return total_cnt;
   }
 
   OB_INLINE double load_factory() const
   {
-    if (BUCKETS_CNT <= 0) {
+    const int64_t buckets_cnt = get_buckets_cnt();
+    if (buckets_cnt <= 0) {
       return 0;
     } else {
-      return double(total_cnt_) / double(BUCKETS_CNT);
+      return double(count()) / double(buckets_cnt);
     }
   }
 
@@ -101,23 +120,48 @@ public:
     void destroy() { reset(); }
   };
 
+private:
+  struct BucketTable {
+    ObTxDataHashHeader *buckets_;
+    int64_t mod_mask_;
+    // count of the map when the table is appended, later insertions go to this table
+    int64_t base_cnt_;
+  };
+  struct CountSlot {
+    int64_t cnt_;
+  } CACHE_ALIGNED;
+
+  OB_INLINE ObTxDataHashHeader &get_bucket_(const BucketTable &table,
+                                            const transaction::ObTransID &key)
+  {
+    return table.buckets_[key.hash() & table.mod_mask_];
+  }
+  void reset_tables_();
+  int alloc_table_(const int64_t table_idx, const int64_t buckets_cnt);
+  void free_table_(const int64_t table_idx);
+  bool need_grow_(const int64_t table_idx) const;
+
 private:
   ObIAllocator &allocator_;
+  // buckets count of the first table
   const int64_t BUCKETS_CNT;
-  const int64_t BUCKETS_MOD_MASK;
-  ObTxDataHashHeader *buckets_;
-  int64_t total_cnt_;
+  common::ObSpinLock grow_lock_;
+  int64_t table_cnt_;
+  int64_t total_buckets_cnt_;
+  BucketTable tables_[MAX_TABLE_CNT];
+  CountSlot cnt_slots_[MAX_CONCURRENCY];
 
 public:
   class Iterator {
   public:
     Iterator(ObTxDataHashMap &tx_data_map)
-        : bucket_idx_(-1), val_(nullptr), tx_data_map_(tx_data_map)
+        : table_idx_(0), bucket_idx_(-1), val_(nullptr), tx_data_map_(tx_data_map)
     {}
 
     int get_next(ObTxDataGuard &next_val);
 
   public:
+    int64_t table_idx_;
     int64_t bucket_idx_;
     ObTxData *val_;
     ObTxDataHashMap &tx_data_map_;
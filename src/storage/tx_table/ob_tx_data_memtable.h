@@ -373,6 +373,7 @@ public:  // getter && setter
   share::SCN get_end_scn() { return key_.scn_range_.end_scn_;}
 
   double load_factory() { return OB_ISNULL(tx_data_map_) ? 0 : tx_data_map_->load_factory(); }
+  int grow_tx_data_map_if_need() { return OB_ISNULL(tx_data_map_) ? OB_NOT_INIT : tx_data_map_->grow_if_need(); }
 
 private:  // ObTxDataMemtable
   void atomic_update_(ObTxData *tx_data);
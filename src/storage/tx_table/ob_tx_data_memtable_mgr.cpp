@@ -303,13 +303,13 @@ int ObTxDataMemtableMgr::calc_new_memtable_buckets_cnt_(const double load_factor
   int64_t remain_memory = lib::get_tenant_memory_remain(MTL_ID());
   int64_t buckets_size_limit = remain_memory >> 4; /* remain_memory * (1/16) */
 
-  int64_t expect_buckets_cnt = old_buckets_cnt;
-  if (load_factory > ObTxDataHashMap::LOAD_FACTORY_MAX_LIMIT &&
-      expect_buckets_cnt < ObTxDataHashMap::MAX_BUCKETS_CNT) {
+  // the hash map grows by itself, so start the new memtable with the buckets which
+  // hold the tx data count of the old one within load limit
+  const double tx_data_cnt = load_factory * old_buckets_cnt;
+  int64_t expect_buckets_cnt = ObTxDataHashMap::MIN_BUCKETS_CNT;
+  while (expect_buckets_cnt * ObTxDataHashMap::LOAD_FACTORY_MAX_LIMIT < tx_data_cnt &&
+         expect_buckets_cnt < ObTxDataHashMap::MAX_BUCKETS_CNT) {
     expect_buckets_cnt <<= 1;
-  } else if (load_factory < ObTxDataHashMap::LOAD_FACTORY_MIN_LIMIT &&
-             expect_buckets_cnt > ObTxDataHashMap::MIN_BUCKETS_CNT) {
-    expect_buckets_cnt >>= 1;
   }
 
   int64_t expect_buckets_size = expect_buckets_cnt * sizeof(ObTxDataHashMap::ObTxDataHashHeader);
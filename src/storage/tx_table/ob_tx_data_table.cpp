@@ -835,6 +835,29 @@ int ObTxDataTable::self_freeze_task()
   return ret;
 }
 
+int ObTxDataTable::grow_tx_data_map_if_need()
+{
+  int ret = OB_SUCCESS;
+  ObTableHandleV2 handle;
+  ObTxDataMemtable *tx_data_memtable = nullptr;
+  if (IS_NOT_INIT) {
+    ret = OB_NOT_INIT;
+    STORAGE_LOG(WARN, "The tx data table is not inited.", KR(ret));
+  } else if (OB_FAIL(memtable_mgr_->get_active_memtable(handle))) {
+    if (OB_EAGAIN == ret || OB_ENTRY_NOT_EXIST == ret) {
+      // no active memtable now
+      ret = OB_SUCCESS;
+    } else {
+      STORAGE_LOG(WARN, "get active memtable failed", KR(ret), K(get_ls_id()));
+    }
+  } else if (OB_FAIL(handle.get_tx_data_memtable(tx_data_memtable))) {
+    STORAGE_LOG(WARN, "get tx data memtable from handle failed", KR(ret), K(handle));
+  } else if (OB_FAIL(tx_data_memtable->grow_tx_data_map_if_need())) {
+    STORAGE_LOG(WARN, "grow tx data map failed", KR(ret), K(get_ls_id()));
+  }
+  return ret;
+}
+
 // The main steps in calculating upper_trans_version. For more details, see :
 //
 int ObTxDataTable::get_upper_trans_version_before_given_scn(const SCN sstable_end_scn, SCN &upper_trans_version)
@@ -212,6 +212,12 @@ public:  // ObTxDataTable
 
   int self_freeze_task();
 
+  /**
+   * @brief Grow the hash map of the active tx data memtable if it is over loaded. It is called in
+   * background, so the inserters never allocate buckets.
+   */
+  int grow_tx_data_map_if_need();
+
   int update_memtables_cache();
 
 
@@ -0,0 +1,311 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include <vector>
+
+#define private public
+#include "logservice/palf/log_cache.h"
+#include "logservice/palf/log_writer_utils.h"
+#undef private
+#include "share/rc/ob_tenant_base.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace share;
+using namespace palf;
+
+namespace unittest
+{
+
+class TestLogCache : public ::testing::Test
+{
+public:
+  static const int64_t CACHE_SIZE = 4 * 1024;
+  static const int64_t DATA_SIZE = 64 * 1024;
+  TestLogCache();
+  virtual ~TestLogCache();
+  virtual void SetUp();
+  virtual void TearDown();
+protected:
+  // the content of each byte is decided by its lsn only, so the data read
+  // from cache can be verified without knowing when it was filled.
+  static char get_byte(const int64_t lsn) { return static_cast<char>(lsn % 251); }
+  void fill(const int64_t lsn, const int64_t size);
+  void fill(const int64_t lsn, const int64_t first_size, const int64_t second_size);
+  bool check(const int64_t lsn, const int64_t size, const char *buf) const;
+protected:
+  int64_t palf_id_;
+  ObTenantBase tbase_;
+  char data_[DATA_SIZE];
+  LogCache log_cache_;
+};
+
+TestLogCache::TestLogCache()
+    : palf_id_(1),
+      tbase_(1001)
+{
+  for (int64_t i = 0; i < DATA_SIZE; i++) {
+    data_[i] = get_byte(i);
+  }
+}
+
+TestLogCache::~TestLogCache()
+{
+}
+
+void TestLogCache::SetUp()
+{
+  ObMallocAllocator::get_instance()->create_and_add_tenant_allocator(1001);
+  ObTenantEnv::set_tenant(&tbase_);
+}
+
+void TestLogCache::TearDown()
+{
+  log_cache_.destroy();
+  ObMallocAllocator::get_instance()->recycle_tenant_allocator(1001);
+}
+
+void TestLogCache::fill(const int64_t lsn, const int64_t size)
+{
+  LogWriteBuf write_buf;
+  ASSERT_EQ(OB_SUCCESS, write_buf.push_back(data_ + lsn, size));
+  log_cache_.fill(LSN(lsn), write_buf);
+}
+
+void TestLogCache::fill(const int64_t lsn, const int64_t first_size, const int64_t second_size)
+{
+  LogWriteBuf write_buf;
+  ASSERT_EQ(OB_SUCCESS, write_buf.push_back(data_ + lsn, first_size));
+  ASSERT_EQ(OB_SUCCESS, write_buf.push_back(data_ + lsn + first_size, second_size));
+  log_cache_.fill(LSN(lsn), write_buf);
+}
+
+bool TestLogCache::check(const int64_t lsn, const int64_t size, const char *buf) const
+{
+  bool bool_ret = true;
+  for (int64_t i = 0; bool_ret && i < size; i++) {
+    bool_ret = (get_byte(lsn + i) == buf[i]);
+  }
+  return bool_ret;
+}
+
+TEST_F(TestLogCache, test_init)
+{
+  char buf[16];
+  EXPECT_EQ(OB_NOT_INIT, log_cache_.read(LSN(0), 16, buf));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, log_cache_.init(palf_id_, 0));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, log_cache_.init(-1, CACHE_SIZE));
+  EXPECT_EQ(OB_SUCCESS, log_cache_.init(palf_id_, CACHE_SIZE));
+  EXPECT_EQ(OB_INIT_TWICE, log_cache_.init(palf_id_, CACHE_SIZE));
+  EXPECT_EQ(CACHE_SIZE, log_cache_.capacity_);
+  EXPECT_EQ(OB_INVALID_ARGUMENT, log_cache_.read(LSN(0), 0, buf));
+  EXPECT_EQ(OB_INVALID_ARGUMENT, log_cache_.read(LSN(0), 16, NULL));
+  // nothing has been cached
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, log_cache_.read(LSN(0), 16, buf));
+  log_cache_.destroy();
+  EXPECT_EQ(OB_NOT_INIT, log_cache_.read(LSN(0), 16, buf));
+}
+
+TEST_F(TestLogCache, test_turned_off)
+{
+  // the cache is not inited when it is turned off, fill and reset do nothing.
+  char buf[16];
+  fill(0, 1024);
+  log_cache_.reset(LSN(0));
+  EXPECT_EQ(OB_NOT_INIT, log_cache_.read(LSN(0), 16, buf));
+  EXPECT_TRUE(NULL == log_cache_.data_buf_);
+}
+
+TEST_F(TestLogCache, test_budget)
+{
+  const int64_t cache_size = CACHE_SIZE;
+  LogCacheBudget budget;
+  LogCache other_cache;
+  budget.set_limit(cache_size + cache_size / 2);
+  EXPECT_EQ(OB_SUCCESS, log_cache_.init(palf_id_, cache_size, &budget));
+  EXPECT_EQ(cache_size, budget.get_used());
+  // the budget left is not enough for another cache, and nothing is charged
+  EXPECT_EQ(OB_EXCEED_MEM_LIMIT, other_cache.init(palf_id_ + 1, cache_size, &budget));
+  EXPECT_EQ(cache_size, budget.get_used());
+  EXPECT_EQ(OB_SUCCESS, other_cache.init(palf_id_ + 1, cache_size / 2, &budget));
+  EXPECT_EQ(budget.get_limit(), budget.get_used());
+  // the capacity is given back on destroy
+  log_cache_.destroy();
+  EXPECT_EQ(cache_size / 2, budget.get_used());
+  EXPECT_EQ(OB_SUCCESS, log_cache_.init(palf_id_, cache_size, &budget));
+  other_cache.destroy();
+  log_cache_.destroy();
+  EXPECT_EQ(0, budget.get_used());
+  // a shrunk limit only affects the caches inited later
+  EXPECT_EQ(OB_SUCCESS, log_cache_.init(palf_id_, cache_size, &budget));
+  budget.set_limit(cache_size / 2);
+  EXPECT_EQ(OB_EXCEED_MEM_LIMIT, other_cache.init(palf_id_ + 1, cache_size / 2, &budget));
+  log_cache_.destroy();
+  EXPECT_EQ(0, budget.get_used());
+}
+
+TEST_F(TestLogCache, test_fill_and_read)
+{
+  char buf[DATA_SIZE];
+  EXPECT_EQ(OB_SUCCESS, log_cache_.init(palf_id_, CACHE_SIZE));
+  log_cache_.reset(LSN(100));
+  fill(100, 1000);
+  fill(1100, 500, 400);
+  EXPECT_EQ(LSN(100), log_cache_.begin_lsn_);
+  EXPECT_EQ(LSN(2000), log_cache_.end_lsn_);
+  EXPECT_EQ(OB_SUCCESS, log_cache_.read(LSN(100), 1900, buf));
+  EXPECT_TRUE(check(100, 1900, buf));
+  EXPECT_EQ(OB_SUCCESS, log_cache_.read(LSN(1000), 500, buf));
+  EXPECT_TRUE(check(1000, 500, buf));
+  // out of the cached range
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, log_cache_.read(LSN(99), 10, buf));
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, log_cache_.read(LSN(1990), 11, buf));
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, log_cache_.read(LSN(2000), 1, buf));
+}
+
+TEST_F(TestLogCache, test_wrap_and_evict)
+{
+  char buf[DATA_SIZE];
+  EXPECT_EQ(OB_SUCCESS, log_cache_.init(palf_id_, CACHE_SIZE));
+  log_cache_.reset(LSN(0));
+  int64_t lsn = 0;
+  for (int64_t i = 0; i < 10; i++) {
+    fill(lsn, 1000);
+    lsn += 1000;
+  }
+  // only the tail of CACHE_SIZE is kept, and it wraps around the ring buffer
+  EXPECT_EQ(LSN(lsn - CACHE_SIZE), log_cache_.begin_lsn_);
+  EXPECT_EQ(LSN(lsn), log_cache_.end_lsn_);
+  EXPECT_EQ(OB_SUCCESS, log_cache_.read(LSN(lsn - CACHE_SIZE), CACHE_SIZE, buf));
+  EXPECT_TRUE(check(lsn - CACHE_SIZE, CACHE_SIZE, buf));
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, log_cache_.read(LSN(lsn - CACHE_SIZE - 1), 10, buf));
+
+  // the log larger than the cache is not cached
+  fill(lsn, CACHE_SIZE + 1);
+  lsn += CACHE_SIZE + 1;
+  EXPECT_EQ(LSN(lsn), log_cache_.begin_lsn_);
+  EXPECT_EQ(LSN(lsn), log_cache_.end_lsn_);
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, log_cache_.read(LSN(lsn - 10), 10, buf));
+  fill(lsn, 100);
+  EXPECT_EQ(OB_SUCCESS, log_cache_.read(LSN(lsn), 100, buf));
+  EXPECT_TRUE(check(lsn, 100, buf));
+}
+
+TEST_F(TestLogCache, test_discontinuous_fill)
+{
+  char buf[DATA_SIZE];
+  EXPECT_EQ(OB_SUCCESS, log_cache_.init(palf_id_, CACHE_SIZE));
+  log_cache_.reset(LSN(0));
+  fill(0, 1000);
+  // the cache is reset when the log is not continuous with the cached log
+  fill(2000, 1000);
+  EXPECT_EQ(LSN(2000), log_cache_.begin_lsn_);
+  EXPECT_EQ(LSN(3000), log_cache_.end_lsn_);
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, log_cache_.read(LSN(0), 100, buf));
+  EXPECT_EQ(OB_SUCCESS, log_cache_.read(LSN(2000), 1000, buf));
+  EXPECT_TRUE(check(2000, 1000, buf));
+  // the seq is even after reset
+  EXPECT_EQ(0, log_cache_.seq_ & 1);
+}
+
+TEST_F(TestLogCache, test_reset_on_truncate)
+{
+  char buf[DATA_SIZE];
+  EXPECT_EQ(OB_SUCCESS, log_cache_.init(palf_id_, CACHE_SIZE));
+  log_cache_.reset(LSN(0));
+  fill(0, 3000);
+  const int64_t seq = log_cache_.seq_;
+  // truncate to 1000, the log after 1000 will be rewritten
+  log_cache_.reset(LSN(1000));
+  EXPECT_EQ(seq + 2, log_cache_.seq_);
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, log_cache_.read(LSN(0), 100, buf));
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, log_cache_.read(LSN(1000), 100, buf));
+  fill(1000, 500);
+  EXPECT_EQ(OB_SUCCESS, log_cache_.read(LSN(1000), 500, buf));
+  EXPECT_TRUE(check(1000, 500, buf));
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, log_cache_.read(LSN(1000), 501, buf));
+
+  // the reader sees an odd seq during reset
+  log_cache_.seq_++;
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, log_cache_.read(LSN(1000), 500, buf));
+  log_cache_.seq_++;
+  EXPECT_EQ(OB_SUCCESS, log_cache_.read(LSN(1000), 500, buf));
+}
+
+TEST_F(TestLogCache, test_concurrent_fill_and_read)
+{
+  const int64_t READER_CNT = 4;
+  const int64_t ROUND_CNT = 200;
+  EXPECT_EQ(OB_SUCCESS, log_cache_.init(palf_id_, CACHE_SIZE));
+  log_cache_.reset(LSN(0));
+  bool stop = false;
+  int64_t hit_cnt = 0;
+  int64_t fail_cnt = 0;
+  std::vector<std::thread> readers;
+  for (int64_t i = 0; i < READER_CNT; i++) {
+    readers.push_back(std::thread([&, i]() {
+      ObTenantEnv::set_tenant(&tbase_);
+      std::mt19937 gen(i);
+      char buf[CACHE_SIZE];
+      while (!ATOMIC_LOAD(&stop)) {
+        const int64_t end_lsn = ATOMIC_LOAD(&log_cache_.end_lsn_.val_);
+        const int64_t size = 1 + gen() % 512;
+        const int64_t lsn = MAX(0, end_lsn - static_cast<int64_t>(gen() % (CACHE_SIZE + 1024)));
+        if (OB_SUCCESS == log_cache_.read(LSN(lsn), size, buf)) {
+          ATOMIC_INC(&hit_cnt);
+          if (!check(lsn, size, buf)) {
+            ATOMIC_INC(&fail_cnt);
+          }
+        }
+      }
+    }));
+  }
+  std::mt19937 gen(READER_CNT);
+  for (int64_t round = 0; round < ROUND_CNT; round++) {
+    int64_t lsn = 0;
+    log_cache_.reset(LSN(0));
+    while (lsn < DATA_SIZE - 1024) {
+      const int64_t size = 1 + gen() % 1024;
+      if (0 == gen() % 2) {
+        fill(lsn, size);
+      } else {
+        fill(lsn, size / 2, size - size / 2);
+      }
+      lsn += size;
+    }
+    // truncate and rewrite, the content of each lsn never changes
+    log_cache_.reset(LSN(lsn / 2));
+  }
+  ATOMIC_STORE(&stop, true);
+  for (auto &reader : readers) {
+    reader.join();
+  }
+  PALF_LOG(INFO, "concurrent fill and read finished", K(hit_cnt), K(fail_cnt));
+  EXPECT_EQ(0, fail_cnt);
+}
+
+} // END of unittest
+} // end of oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -rf ./test_log_cache.log*");
+  OB_LOGGER.set_file_name("test_log_cache.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  PALF_LOG(INFO, "begin unittest::test_log_cache");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,161 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+
+#include "logservice/palf/log_net_service.h"
+#include "logservice/palf/log_writer_utils.h"
+
+namespace oceanbase
+{
+namespace unittest
+{
+using namespace common;
+using namespace palf;
+
+class TestLogCompressSampler : public ::testing::Test
+{
+public:
+  static const int64_t DATA_SIZE = 64 * 1024;
+  static const int64_t PALF_ID = 1;
+  TestLogCompressSampler()
+  {
+    // bytes of a linear congruential generator, which lz4 can not compress
+    uint64_t seed = 1;
+    for (int64_t i = 0; i < DATA_SIZE; i++) {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      random_data_[i] = static_cast<char>(seed >> 56);
+    }
+    MEMSET(zero_data_, 0, sizeof(zero_data_));
+    options_.enable_transport_compress_ = true;
+    options_.transport_compress_func_ = ObCompressorType::LZ4_COMPRESSOR;
+  }
+  // the next call of need_compress samples again
+  void expire_sample(LogCompressSampler &sampler)
+  {
+    sampler.last_sample_time_us_ -= LogCompressSampler::SAMPLE_INTERVAL_US;
+  }
+protected:
+  char random_data_[DATA_SIZE];
+  char zero_data_[DATA_SIZE];
+  PalfTransportCompressOptions options_;
+};
+
+TEST_F(TestLogCompressSampler, disabled)
+{
+  LogCompressSampler sampler;
+  LogWriteBuf write_buf;
+  ASSERT_EQ(OB_SUCCESS, write_buf.push_back(zero_data_, DATA_SIZE));
+  options_.enable_transport_compress_ = false;
+  ASSERT_FALSE(sampler.need_compress(PALF_ID, options_, write_buf));
+  ASSERT_EQ(OB_INVALID_TIMESTAMP, sampler.last_sample_time_us_);
+  ASSERT_EQ(0, sampler.compressed_cnt_);
+  ASSERT_EQ(0, sampler.uncompressed_cnt_);
+}
+
+TEST_F(TestLogCompressSampler, on_off)
+{
+  const int64_t threshold = LogCompressSampler::COMPRESSIBLE_RATIO_THRESHOLD;
+  LogCompressSampler sampler;
+  LogWriteBuf zero_buf;
+  LogWriteBuf random_buf;
+  ASSERT_EQ(OB_SUCCESS, zero_buf.push_back(zero_data_, DATA_SIZE));
+  ASSERT_EQ(OB_SUCCESS, random_buf.push_back(random_data_, DATA_SIZE));
+
+  ASSERT_TRUE(sampler.need_compress(PALF_ID, options_, zero_buf));
+  ASSERT_NE(OB_INVALID_TIMESTAMP, sampler.last_sample_time_us_);
+  ASSERT_GT(threshold, sampler.compress_ratio_);
+
+  // the last result is used until the sample expires
+  ASSERT_TRUE(sampler.need_compress(PALF_ID, options_, random_buf));
+  ASSERT_EQ(2, sampler.compressed_cnt_);
+
+  // poorly compressible logs turn compression off
+  int64_t sample_cnt = 0;
+  do {
+    expire_sample(sampler);
+    ++sample_cnt;
+  } while (sampler.need_compress(PALF_ID, options_, random_buf) && sample_cnt < 10);
+  ASSERT_LT(sample_cnt, 10);
+  ASSERT_LE(threshold, sampler.compress_ratio_);
+  ASSERT_FALSE(sampler.need_compress(PALF_ID, options_, zero_buf));
+  ASSERT_LT(0, sampler.uncompressed_cnt_);
+
+  // and compressible logs turn it on again
+  sample_cnt = 0;
+  do {
+    expire_sample(sampler);
+    ++sample_cnt;
+  } while (!sampler.need_compress(PALF_ID, options_, zero_buf) && sample_cnt < 10);
+  ASSERT_LT(sample_cnt, 10);
+  ASSERT_GT(threshold, sampler.compress_ratio_);
+}
+
+TEST_F(TestLogCompressSampler, sample_size)
+{
+  const int64_t min_sample_size = LogCompressSampler::MIN_SAMPLE_SIZE;
+  const int64_t max_sample_size = LogCompressSampler::MAX_SAMPLE_SIZE;
+  LogCompressSampler sampler;
+  // small logs are not sampled
+  LogWriteBuf small_buf;
+  ASSERT_EQ(OB_SUCCESS, small_buf.push_back(random_data_, min_sample_size - 1));
+  ASSERT_TRUE(sampler.need_compress(PALF_ID, options_, small_buf));
+  ASSERT_EQ(OB_INVALID_TIMESTAMP, sampler.last_sample_time_us_);
+  ASSERT_EQ(0, sampler.compress_ratio_);
+
+  // only the head of the log is compressed
+  MEMCPY(zero_data_, random_data_, max_sample_size);
+  LogWriteBuf write_buf;
+  ASSERT_EQ(OB_SUCCESS, write_buf.push_back(zero_data_, DATA_SIZE));
+  ASSERT_FALSE(sampler.need_compress(PALF_ID, options_, write_buf));
+  ASSERT_NE(OB_INVALID_TIMESTAMP, sampler.last_sample_time_us_);
+}
+
+TEST_F(TestLogCompressSampler, threshold)
+{
+  const int64_t threshold = LogCompressSampler::COMPRESSIBLE_RATIO_THRESHOLD;
+  LogCompressSampler sampler;
+  sampler.update_compress_ratio_(threshold - 1);
+  ASSERT_TRUE(sampler.is_compressible_);
+  sampler.reset();
+  sampler.update_compress_ratio_(threshold);
+  ASSERT_FALSE(sampler.is_compressible_);
+
+  // the ratio is smoothed, a few good samples are needed to turn compression on
+  sampler.reset();
+  sampler.update_compress_ratio_(100);
+  ASSERT_FALSE(sampler.is_compressible_);
+  sampler.update_compress_ratio_(80);
+  ASSERT_EQ(95, sampler.compress_ratio_);
+  ASSERT_FALSE(sampler.is_compressible_);
+  sampler.update_compress_ratio_(80);
+  ASSERT_EQ(91, sampler.compress_ratio_);
+  ASSERT_FALSE(sampler.is_compressible_);
+  sampler.update_compress_ratio_(80);
+  ASSERT_EQ(88, sampler.compress_ratio_);
+  ASSERT_TRUE(sampler.is_compressible_);
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_log_compress_sampler.log*");
+  OB_LOGGER.set_file_name("test_log_compress_sampler.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
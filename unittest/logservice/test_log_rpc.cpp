@@ -0,0 +1,144 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#include "lib/ob_define.h"
+#include "common/ob_member_list.h"
+#include "logservice/palf/log_rpc.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace palf;
+
+namespace unittest
+{
+const ObAddr addr1(ObAddr::IPV4, "127.0.0.1", 1000);
+const ObAddr addr2(ObAddr::IPV4, "127.0.0.2", 1000);
+const ObAddr addr3(ObAddr::IPV4, "127.0.0.3", 1000);
+const int64_t TENANT_ID = 1001;
+
+struct MockPacket
+{
+  int64_t palf_id_;
+};
+
+// records the posted packets, posting to fail_addr_ fails with fail_ret_
+class MockRpcProxy
+{
+public:
+  MockRpcProxy() : fail_addr_(), fail_ret_(OB_SUCCESS), post_cnt_(0) {}
+  int post_packet(const ObAddr &dst,
+                  const MockPacket &pkt,
+                  const int64_t tenant_id,
+                  const PalfTransportCompressOptions &options)
+  {
+    UNUSED(options);
+    int ret = OB_SUCCESS;
+    EXPECT_EQ(TENANT_ID, tenant_id);
+    if (dst == fail_addr_) {
+      ret = fail_ret_;
+    } else {
+      dsts_[post_cnt_] = dst;
+      pkts_[post_cnt_] = &pkt;
+      post_cnt_++;
+    }
+    return ret;
+  }
+  ObAddr fail_addr_;
+  int fail_ret_;
+  int64_t post_cnt_;
+  ObAddr dsts_[OB_MAX_MEMBER_NUMBER];
+  const MockPacket *pkts_[OB_MAX_MEMBER_NUMBER];
+};
+
+// a member list whose fail_idx_-th member can not be fetched
+class MockMemberList
+{
+public:
+  MockMemberList() : list_(), fail_idx_(-1) {}
+  int64_t get_member_number() const { return list_.get_member_number(); }
+  int get_server_by_index(const int64_t idx, ObAddr &server) const
+  {
+    return idx == fail_idx_ ? OB_ENTRY_NOT_EXIST : list_.get_server_by_index(idx, server);
+  }
+  ObMemberList list_;
+  int64_t fail_idx_;
+};
+
+TEST(TestLogRpc, post_one_packet_to_all_members)
+{
+  MockRpcProxy proxy;
+  ObMemberList member_list;
+  PalfTransportCompressOptions options;
+  ObSEArray<ObAddr, OB_MAX_MEMBER_NUMBER> failed_servers;
+  const MockPacket packet = {1};
+  EXPECT_EQ(OB_SUCCESS, member_list.add_server(addr1));
+  EXPECT_EQ(OB_SUCCESS, member_list.add_server(addr2));
+  EXPECT_EQ(OB_SUCCESS, member_list.add_server(addr3));
+  EXPECT_EQ(OB_SUCCESS, LogRpc::post_packet_to_member_list(proxy, member_list, packet,
+      TENANT_ID, options, failed_servers));
+  EXPECT_EQ(3, proxy.post_cnt_);
+  EXPECT_EQ(0, failed_servers.count());
+  for (int64_t i = 0; i < proxy.post_cnt_; i++) {
+    EXPECT_EQ(&packet, proxy.pkts_[i]);
+    EXPECT_TRUE(member_list.contains(proxy.dsts_[i]));
+  }
+  EXPECT_NE(proxy.dsts_[0], proxy.dsts_[1]);
+  EXPECT_NE(proxy.dsts_[1], proxy.dsts_[2]);
+  EXPECT_NE(proxy.dsts_[0], proxy.dsts_[2]);
+}
+
+TEST(TestLogRpc, report_failure_per_destination)
+{
+  MockRpcProxy proxy;
+  MockMemberList member_list;
+  PalfTransportCompressOptions options;
+  ObSEArray<ObAddr, OB_MAX_MEMBER_NUMBER> failed_servers;
+  const MockPacket packet = {1};
+  EXPECT_EQ(OB_SUCCESS, member_list.list_.add_server(addr1));
+  EXPECT_EQ(OB_SUCCESS, member_list.list_.add_server(addr2));
+  EXPECT_EQ(OB_SUCCESS, member_list.list_.add_server(addr3));
+
+  // the failed destination does not stop the others
+  proxy.fail_addr_ = addr2;
+  proxy.fail_ret_ = OB_RPC_POST_ERROR;
+  EXPECT_EQ(OB_RPC_POST_ERROR, LogRpc::post_packet_to_member_list(proxy, member_list, packet,
+      TENANT_ID, options, failed_servers));
+  EXPECT_EQ(2, proxy.post_cnt_);
+  ASSERT_EQ(1, failed_servers.count());
+  EXPECT_EQ(addr2, failed_servers.at(0));
+
+  // the first failure is returned, every failed member is reported
+  proxy.post_cnt_ = 0;
+  failed_servers.reset();
+  member_list.fail_idx_ = 0;
+  EXPECT_EQ(OB_ENTRY_NOT_EXIST, LogRpc::post_packet_to_member_list(proxy, member_list, packet,
+      TENANT_ID, options, failed_servers));
+  EXPECT_EQ(1, proxy.post_cnt_);
+  EXPECT_EQ(&packet, proxy.pkts_[0]);
+  ASSERT_EQ(2, failed_servers.count());
+  EXPECT_FALSE(failed_servers.at(0).is_valid());
+  EXPECT_EQ(addr2, failed_servers.at(1));
+}
+
+} // end namespace unittest
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_file_name("test_log_rpc.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  PALF_LOG(INFO, "begin unittest::test_log_rpc");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,72 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+
+#include "logservice/replayservice/ob_replay_status.h"
+#include "logservice/replayservice/ob_log_replay_service.h"
+
+namespace oceanbase
+{
+namespace unittest
+{
+using namespace common;
+using namespace logservice;
+
+TEST(TestReplayStatus, release_lease_on_submit_failure)
+{
+  // the replay service is not inited, so every submission fails
+  ObLogReplayService replay_service;
+  ObReplayStatus replay_status;
+  replay_status.is_inited_ = true;
+  replay_status.rp_sv_ = &replay_service;
+  for (int64_t i = 0; i < REPLAY_TASK_QUEUE_SIZE; ++i) {
+    ASSERT_EQ(OB_SUCCESS, replay_status.task_queues_[i].init(&replay_status, i));
+  }
+  ObLogReplayTask task;
+  task.replay_hint_ = 3;
+  ObReplayServiceReplayTask &task_queue =
+      replay_status.task_queues_[replay_status.calc_replay_queue_idx(task.replay_hint_)];
+
+  // the idle queue fails to be dispatched at once and is left for the batch push
+  ASSERT_TRUE(task_queue.is_lease_idle());
+  ASSERT_EQ(OB_SUCCESS, replay_status.push_log_replay_task(task));
+  ASSERT_TRUE(task_queue.is_lease_idle());
+  ASSERT_TRUE(task_queue.need_batch_push());
+  ASSERT_EQ(0, replay_status.ref_cnt_);
+
+  // the failed batch push can be retried
+  for (int64_t i = 0; i < 2; ++i) {
+    ASSERT_EQ(OB_NOT_INIT, replay_status.batch_push_all_task_queue());
+    ASSERT_TRUE(task_queue.is_lease_idle());
+    ASSERT_TRUE(task_queue.need_batch_push());
+    ASSERT_EQ(0, replay_status.ref_cnt_);
+  }
+
+  ASSERT_EQ(&task, task_queue.pop());
+  ASSERT_EQ(nullptr, task_queue.pop());
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_replay_status.log*");
+  OB_LOGGER.set_file_name("test_replay_status.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -840,6 +840,42 @@ TEST_F(TestChunkDatumStore, disk_with_chunk)
   rs.reset();
 }
 
+TEST_F(TestChunkDatumStore, disk_compress)
+{
+  int64_t round = 4;
+  int64_t cnt = 10000;
+  int64_t rows = round * cnt;
+  LOG_INFO("starting write compressed disk test: append rows", K(rows));
+  ObChunkDatumStore rs;
+  ObChunkDatumStore::Iterator it;
+  ASSERT_EQ(OB_SUCCESS, rs.init(0, tenant_id_, ctx_id_, label_));
+  ASSERT_EQ(OB_SUCCESS, rs.alloc_dir_id());
+  rs.set_dump_compress(true);
+  rs.set_mem_limit(1L << 20);
+  for (int64_t i = 0; i < round; i++) {
+    if (i == round / 2) {
+      enable_big_row_ = true;
+    }
+    CALL(append_rows, rs, cnt);
+  }
+  ASSERT_EQ(OB_SUCCESS, rs.finish_add_row());
+  ASSERT_TRUE(rs.is_dump_compress());
+  ASSERT_GT(rs.n_block_in_file_, 0);
+  LOG_INFO("mem and disk after finish", K(rows), K(rs.get_mem_hold()),
+    K(rs.get_mem_used()), K(rs.get_file_size()), K(rs.n_block_in_file_),
+    K(rs.dump_compressor_type_));
+  // file size is smaller than blocks dumped
+  ASSERT_LT(rs.get_file_size(), rs.n_block_in_file_ * rs.default_block_size_);
+
+  CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true);
+  it.reset();
+  // chunk read size is ignored for compressed dump
+  CALL(verify_n_rows, rs, it, rs.get_row_cnt(), true, 2L << 20);
+  it.reset();
+  rs.reset();
+  enable_big_row_ = false;
+}
+
 TEST_F(TestChunkDatumStore, test_add_block)
 {
   int ret = OB_SUCCESS;
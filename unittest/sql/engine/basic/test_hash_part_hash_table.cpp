@@ -0,0 +1,315 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "sql/engine/basic/ob_hash_partitioning_infrastructure_op.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/engine/ob_sql_mem_mgr_processor.h"
+#include "lib/allocator/page_arena.h"
+#undef private
+#undef protected
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+// item compared by key, the hash value is given by the test
+struct TestItem
+{
+  TestItem() : hash_value_(0), key_(0), store_row_(nullptr), use_expr_(false) {}
+  TestItem(const uint64_t hash_value, const int64_t key)
+    : hash_value_(hash_value), key_(key), store_row_(nullptr), use_expr_(false) {}
+  uint64_t hash() const { return hash_value_; }
+  int equal_distinct(const ObIArray<ObExpr *> *exprs,
+                     const TestItem &other,
+                     const ObIArray<ObSortFieldCollation> *sort_collations,
+                     const ObIArray<ObCmpFunc> *cmp_funcs,
+                     ObEvalCtx *eval_ctx,
+                     bool &result,
+                     ObEvalCtx::BatchInfoScopeGuard &batch_info_guard) const
+  {
+    UNUSEDx(exprs, sort_collations, cmp_funcs, eval_ctx, batch_info_guard);
+    ++cmp_cnt_;
+    result = (key_ == other.key_);
+    return OB_SUCCESS;
+  }
+  uint64_t hash_value_;
+  int64_t key_;
+  void *store_row_;
+  bool use_expr_;
+  static int64_t cmp_cnt_;
+  TO_STRING_KV(K_(hash_value), K_(key));
+};
+int64_t TestItem::cmp_cnt_ = 0;
+
+typedef ObHashPartitionExtendHashTable<TestItem> TestHashTable;
+
+class TestHashPartHashTable : public ::testing::Test
+{
+public:
+  TestHashPartHashTable()
+    : alloc_(ObModIds::TEST),
+      exec_ctx_(alloc_),
+      eval_ctx_(exec_ctx_),
+      profile_(ObSqlWorkAreaType::HASH_WORK_AREA),
+      sql_mem_processor_(profile_, op_monitor_info_)
+  {}
+  virtual void SetUp() override
+  {
+    TestItem::cmp_cnt_ = 0;
+    sql_mem_processor_.set_default_usable_mem_size(1L << 30);
+  }
+  void init_table(TestHashTable &table, const int64_t mem_bound)
+  {
+    sql_mem_processor_.set_default_usable_mem_size(mem_bound);
+    ASSERT_EQ(OB_SUCCESS, table.init(&alloc_, 2, &sql_mem_processor_,
+                                     TestHashTable::INITIAL_SIZE, INT64_MAX));
+    table.set_funcs(nullptr, nullptr, nullptr, &eval_ctx_);
+  }
+  void check_get(const TestHashTable &table, const TestItem &item, const TestItem *expect)
+  {
+    const TestItem *res = nullptr;
+    ASSERT_EQ(OB_SUCCESS, table.get(item.hash_value_, item, res));
+    ASSERT_EQ(expect, res);
+  }
+  // hash values of the same home group in a table of %group_num groups
+  static uint64_t same_group_hash(const int64_t group_num, const int64_t i)
+  {
+    return (static_cast<uint64_t>(i + 1) * group_num + 3) & ObHashPartCols::HASH_VAL_MASK;
+  }
+protected:
+  ObArenaAllocator alloc_;
+  ObExecContext exec_ctx_;
+  ObEvalCtx eval_ctx_;
+  ObSqlWorkAreaProfile profile_;
+  ObMonitorNode op_monitor_info_;
+  ObSqlMemMgrProcessor sql_mem_processor_;
+};
+
+TEST_F(TestHashPartHashTable, insert_and_probe)
+{
+  TestHashTable table;
+  init_table(table, 1L << 30);
+  const int64_t cnt = 100;
+  TestItem items[cnt];
+  for (int64_t i = 0; i < cnt; ++i) {
+    items[i] = TestItem(murmurhash(&i, sizeof(i), 0) & ObHashPartCols::HASH_VAL_MASK, i);
+    ASSERT_EQ(OB_SUCCESS, table.set(items[i]));
+  }
+  ASSERT_EQ(cnt, table.size());
+  for (int64_t i = 0; i < cnt; ++i) {
+    check_get(table, TestItem(items[i].hash_value_, i), &items[i]);
+  }
+  // same hash value with another key, or another hash value
+  check_get(table, TestItem(items[0].hash_value_, cnt), nullptr);
+  check_get(table, TestItem(items[0].hash_value_ + 1, 0), nullptr);
+
+  // distinct insert reports the existing key
+  TestItem dup(items[1].hash_value_, 1);
+  ASSERT_EQ(OB_HASH_EXIST, table.set_distinct(dup, dup.hash_value_));
+  ASSERT_EQ(cnt, table.size());
+  TestItem new_item(items[1].hash_value_ + 1, cnt);
+  ASSERT_EQ(OB_SUCCESS, table.set_distinct(new_item, new_item.hash_value_));
+  check_get(table, new_item, &new_item);
+
+  // reuse drops all items and keeps the buckets
+  const int64_t bucket_num = table.get_bucket_num();
+  table.reuse();
+  ASSERT_EQ(0, table.size());
+  ASSERT_EQ(bucket_num, table.get_bucket_num());
+  check_get(table, TestItem(items[0].hash_value_, 0), nullptr);
+}
+
+TEST_F(TestHashPartHashTable, collision)
+{
+  TestHashTable table;
+  init_table(table, 1L << 30);
+  const int64_t group_num = table.get_group_num();
+  // more items than one group of the same home group, they overflow to the probe sequence
+  const int64_t cnt = TestHashTable::GROUP_SIZE * 3;
+  TestItem items[cnt];
+  for (int64_t i = 0; i < cnt; ++i) {
+    items[i] = TestItem(same_group_hash(group_num, i), i);
+    ASSERT_EQ(OB_SUCCESS, table.set_distinct(items[i], items[i].hash_value_));
+  }
+  ASSERT_EQ(group_num, table.get_group_num());
+  for (int64_t i = 0; i < cnt; ++i) {
+    check_get(table, items[i], &items[i]);
+  }
+  check_get(table, TestItem(same_group_hash(group_num, cnt), cnt), nullptr);
+
+  // full hash collision, only key comparison tells them apart
+  TestItem same_hash1(items[0].hash_value_, cnt + 1);
+  TestItem same_hash2(items[0].hash_value_, cnt + 2);
+  ASSERT_EQ(OB_SUCCESS, table.set_distinct(same_hash1, same_hash1.hash_value_));
+  ASSERT_EQ(OB_SUCCESS, table.set_distinct(same_hash2, same_hash2.hash_value_));
+  TestItem::cmp_cnt_ = 0;
+  check_get(table, TestItem(items[0].hash_value_, cnt + 2), &same_hash2);
+  ASSERT_EQ(3, TestItem::cmp_cnt_);
+  TestItem dup(items[0].hash_value_, cnt + 1);
+  ASSERT_EQ(OB_HASH_EXIST, table.set_distinct(dup, dup.hash_value_));
+}
+
+TEST_F(TestHashPartHashTable, tag_mismatch)
+{
+  TestHashTable table;
+  init_table(table, 1L << 30);
+  const int64_t group_num = table.get_group_num();
+  // find two hash values of the same home group with different tags
+  const uint64_t hash1 = same_group_hash(group_num, 0);
+  uint64_t hash2 = 0;
+  for (int64_t i = 1; 0 == hash2; ++i) {
+    if (TestHashTable::get_tag(same_group_hash(group_num, i)) != TestHashTable::get_tag(hash1)) {
+      hash2 = same_group_hash(group_num, i);
+    }
+  }
+  const uint8_t empty_tag = TestHashTable::EMPTY_TAG;
+  ASSERT_NE(empty_tag, TestHashTable::get_tag(hash1));
+  ASSERT_NE(empty_tag, TestHashTable::get_tag(hash2));
+  TestItem item1(hash1, 1);
+  TestItem item2(hash2, 2);
+  ASSERT_EQ(OB_SUCCESS, table.set(item1));
+  ASSERT_EQ(OB_SUCCESS, table.set(item2));
+
+  // only the slot with the probe tag matches in the home group
+  const TestHashTable::BucketGroup &group = table.buckets_->at(hash1 & (group_num - 1));
+  ASSERT_EQ(1U, TestHashTable::match_tag(group.tags_, TestHashTable::get_tag(hash1)));
+  ASSERT_EQ(2U, TestHashTable::match_tag(group.tags_, TestHashTable::get_tag(hash2)));
+  const uint32_t empty_mask = TestHashTable::match_tag(group.tags_, empty_tag);
+  ASSERT_EQ(((1U << TestHashTable::GROUP_SIZE) - 1) & ~3U, empty_mask);
+
+  // the item of the other tag is never compared
+  TestItem::cmp_cnt_ = 0;
+  check_get(table, TestItem(hash2, 2), &item2);
+  check_get(table, TestItem(hash2, 3), nullptr);
+  ASSERT_EQ(2, TestItem::cmp_cnt_);
+}
+
+TEST_F(TestHashPartHashTable, extend)
+{
+  TestHashTable table;
+  init_table(table, 1L << 30);
+  const int64_t initial_size = TestHashTable::INITIAL_SIZE;
+  ASSERT_EQ(initial_size, table.get_bucket_num());
+  const int64_t cnt = 10000;
+  TestItem *items = static_cast<TestItem *>(alloc_.alloc(sizeof(TestItem) * cnt));
+  ASSERT_NE(nullptr, items);
+  for (int64_t i = 0; i < cnt; ++i) {
+    new (&items[i]) TestItem(murmurhash(&i, sizeof(i), 0) & ObHashPartCols::HASH_VAL_MASK, i);
+    if (0 == i % 2) {
+      ASSERT_EQ(OB_SUCCESS, table.set(items[i]));
+    } else {
+      ASSERT_EQ(OB_SUCCESS, table.set_distinct(items[i], items[i].hash_value_));
+    }
+    ASSERT_LE(table.size() * 100, table.get_bucket_num() * TestHashTable::MAX_LOAD_PERCENT);
+  }
+  ASSERT_EQ(cnt, table.size());
+  ASSERT_LE(cnt, table.get_bucket_num());
+  ASSERT_FALSE(table.is_full());
+  for (int64_t i = 0; i < cnt; ++i) {
+    check_get(table, TestItem(items[i].hash_value_, i), &items[i]);
+  }
+  // explicit extend keeps all items
+  ASSERT_EQ(OB_SUCCESS, table.extend(table.get_bucket_num() * 4));
+  for (int64_t i = 0; i < cnt; ++i) {
+    check_get(table, TestItem(items[i].hash_value_, i), &items[i]);
+  }
+}
+
+TEST_F(TestHashPartHashTable, extend_within_mem_bound)
+{
+  TestHashTable table;
+  // 256 buckets fit in MAX_MEM_PERCENT of the bound, 512 buckets don't
+  const int64_t max_bucket_num = 256;
+  const int64_t mem_bound = max_bucket_num * 2 * TestHashTable::BUCKET_SLOT_SIZE
+                            * 100 / TestHashTable::MAX_MEM_PERCENT - 1;
+  init_table(table, mem_bound);
+  const int64_t initial_size = TestHashTable::INITIAL_SIZE;
+  ASSERT_EQ(initial_size, table.get_bucket_num());
+  TestItem items[max_bucket_num];
+  for (int64_t i = 0; i < max_bucket_num - 1; ++i) {
+    items[i] = TestItem(murmurhash(&i, sizeof(i), 0) & ObHashPartCols::HASH_VAL_MASK, i);
+    ASSERT_EQ(OB_SUCCESS, table.set_distinct(items[i], items[i].hash_value_));
+    ASSERT_LE(table.get_bucket_num(), max_bucket_num);
+    ASSERT_EQ(table.size() * 100 >= max_bucket_num * TestHashTable::MAX_LOAD_PERCENT,
+              table.is_full());
+  }
+  // the loaded table is full but still has one empty slot and probes correctly
+  ASSERT_EQ(max_bucket_num, table.get_bucket_num());
+  ASSERT_TRUE(table.is_full());
+  for (int64_t i = 0; i < max_bucket_num - 1; ++i) {
+    check_get(table, TestItem(items[i].hash_value_, i), &items[i]);
+  }
+  check_get(table, TestItem(items[0].hash_value_ + 1, max_bucket_num), nullptr);
+
+  // the last slot is never used, extend beyond the bound instead
+  const int64_t i = max_bucket_num - 1;
+  items[i] = TestItem(murmurhash(&i, sizeof(i), 0) & ObHashPartCols::HASH_VAL_MASK, i);
+  ASSERT_EQ(OB_SUCCESS, table.set_distinct(items[i], items[i].hash_value_));
+  ASSERT_EQ(max_bucket_num * 2, table.get_bucket_num());
+  for (int64_t j = 0; j < max_bucket_num; ++j) {
+    check_get(table, TestItem(items[j].hash_value_, j), &items[j]);
+  }
+
+  // a larger bound allows extending again
+  sql_mem_processor_.set_default_usable_mem_size(1L << 30);
+  ASSERT_FALSE(table.is_full());
+}
+
+TEST_F(TestHashPartHashTable, est_bucket_count)
+{
+  typedef ObHashPartInfrastructure<ObHashPartCols, ObHashPartStoredRow> HashPartInfras;
+  const int64_t slot_size = ObHashPartitionExtendHashTable<ObHashPartCols>::BUCKET_SLOT_SIZE;
+  const int64_t ratio = ObHashPartitionExtendHashTable<ObHashPartCols>::EXTENDED_RATIO;
+  const int64_t width = 64;
+  const int64_t min_bucket_num = HashPartInfras::MIN_BUCKET_NUM;
+  {
+    // all rows fit
+    HashPartInfras infras;
+    infras.sql_mem_processor_ = &sql_mem_processor_;
+    sql_mem_processor_.set_default_usable_mem_size(1L << 30);
+    ASSERT_EQ(10000, infras.est_bucket_count(10000, width));
+  }
+  {
+    // the buckets and rows of the estimation fit in the memory bound left by partitions
+    HashPartInfras infras;
+    infras.sql_mem_processor_ = &sql_mem_processor_;
+    const int64_t mem_bound = 8L << 20;
+    sql_mem_processor_.set_default_usable_mem_size(mem_bound);
+    const int64_t bucket_num = infras.est_bucket_count(1000000, width);
+    ASSERT_LT(bucket_num, 1000000);
+    ASSERT_GE(bucket_num, min_bucket_num);
+    ASSERT_LE(next_pow2(bucket_num * ratio) * slot_size + bucket_num * width,
+              mem_bound - infras.est_part_cnt_ * HashPartInfras::BLOCK_SIZE);
+    // the next larger estimation doesn't fit
+    ASSERT_GT(next_pow2(bucket_num * 2 * ratio) * slot_size + bucket_num * 2 * width,
+              mem_bound - infras.est_part_cnt_ * HashPartInfras::BLOCK_SIZE);
+  }
+}
+
+} // end namespace sql
+} // end namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_hash_part_hash_table.log*");
+  OB_LOGGER.set_file_name("test_hash_part_hash_table.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
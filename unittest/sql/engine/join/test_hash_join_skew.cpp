@@ -0,0 +1,138 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define USING_LOG_PREFIX SQL
+
+#include <gtest/gtest.h>
+#define private public
+#define protected public
+#include "sql/engine/join/ob_hash_join_op.h"
+#undef private
+#undef protected
+
+namespace oceanbase
+{
+namespace sql
+{
+using namespace common;
+
+class TestHashJoinSkew : public ::testing::Test
+{
+public:
+  static const int64_t SAMPLE_CNT = 256;
+  // multiplicative hash keeps the values distinct and spread over the low bits
+  static uint64_t uniform_hash(const int64_t i) { return (i + 1) * 0x9E3779B97F4A7C15ULL; }
+  void fill_uniform(const int64_t cnt)
+  {
+    for (int64_t i = 0; i < cnt; ++i) {
+      sample_vals_[i] = uniform_hash(i);
+    }
+  }
+  int64_t find(const int64_t cnt)
+  {
+    return ObHashJoinOp::find_skew_hash_values(sample_vals_, cnt, skew_hash_vals_, skew_hash_filter_);
+  }
+  // the lookup used by partition routing, on the values found by find()
+  bool is_skew(const uint64_t hash_value, const int64_t skew_hash_cnt)
+  {
+    return 0 != (skew_hash_filter_ & (1ULL << (hash_value & 63)))
+        && std::binary_search(skew_hash_vals_, skew_hash_vals_ + skew_hash_cnt, hash_value);
+  }
+protected:
+  uint64_t sample_vals_[SAMPLE_CNT];
+  uint64_t skew_hash_vals_[ObHashJoinOp::MAX_SKEW_HASH_CNT];
+  uint64_t skew_hash_filter_;
+};
+
+TEST_F(TestHashJoinSkew, no_skew)
+{
+  const int64_t cnt = SAMPLE_CNT;
+  fill_uniform(cnt);
+  ASSERT_EQ(0, find(cnt));
+  ASSERT_EQ(0, skew_hash_filter_);
+  for (int64_t i = 0; i < cnt; ++i) {
+    ASSERT_FALSE(is_skew(uniform_hash(i), 0));
+  }
+
+  // every value repeats, but none reaches 1/SKEW_HASH_RATIO of the sample
+  for (int64_t i = 0; i < cnt; ++i) {
+    sample_vals_[i] = uniform_hash(i % (ObHashJoinOp::SKEW_HASH_RATIO * 2));
+  }
+  ASSERT_EQ(0, find(cnt));
+}
+
+TEST_F(TestHashJoinSkew, too_few_samples)
+{
+  const int64_t cnt = ObHashJoinOp::SKEW_MIN_SAMPLE_ROWS - 1;
+  for (int64_t i = 0; i < cnt; ++i) {
+    sample_vals_[i] = uniform_hash(0);
+  }
+  ASSERT_EQ(0, find(cnt));
+}
+
+TEST_F(TestHashJoinSkew, heavy_hitters)
+{
+  const int64_t cnt = SAMPLE_CNT;
+  const int64_t hot_cnt = cnt / ObHashJoinOp::SKEW_HASH_RATIO;
+  fill_uniform(cnt);
+  // hash value 7 takes a half, 3 takes exactly 1/SKEW_HASH_RATIO, 5 takes one row less
+  int64_t pos = 0;
+  for (int64_t i = 0; i < cnt / 2; ++i) {
+    sample_vals_[pos++] = uniform_hash(7000);
+  }
+  for (int64_t i = 0; i < hot_cnt; ++i) {
+    sample_vals_[pos++] = uniform_hash(3000);
+  }
+  for (int64_t i = 0; i < hot_cnt - 1; ++i) {
+    sample_vals_[pos++] = uniform_hash(5000);
+  }
+  const int64_t skew_hash_cnt = find(cnt);
+  ASSERT_EQ(2, skew_hash_cnt);
+  ASSERT_LT(skew_hash_vals_[0], skew_hash_vals_[1]);
+  ASSERT_TRUE(is_skew(uniform_hash(7000), skew_hash_cnt));
+  ASSERT_TRUE(is_skew(uniform_hash(3000), skew_hash_cnt));
+  ASSERT_FALSE(is_skew(uniform_hash(5000), skew_hash_cnt));
+  for (int64_t i = 0; i < cnt; ++i) {
+    ASSERT_FALSE(is_skew(uniform_hash(i), skew_hash_cnt));
+  }
+}
+
+TEST_F(TestHashJoinSkew, max_skew_hash_cnt)
+{
+  // all the sample is made of heavy hitters, only MAX_SKEW_HASH_CNT of them are kept
+  const int64_t cnt = SAMPLE_CNT;
+  const int64_t hot_cnt = cnt / ObHashJoinOp::SKEW_HASH_RATIO;
+  for (int64_t i = 0; i < cnt; ++i) {
+    sample_vals_[i] = uniform_hash(i / hot_cnt);
+  }
+  const int64_t max_skew_hash_cnt = ObHashJoinOp::MAX_SKEW_HASH_CNT;
+  const int64_t skew_hash_cnt = find(cnt);
+  ASSERT_EQ(max_skew_hash_cnt, skew_hash_cnt);
+  for (int64_t i = 1; i < skew_hash_cnt; ++i) {
+    ASSERT_LT(skew_hash_vals_[i - 1], skew_hash_vals_[i]);
+  }
+  int64_t found_cnt = 0;
+  for (int64_t i = 0; i < ObHashJoinOp::SKEW_HASH_RATIO; ++i) {
+    found_cnt += is_skew(uniform_hash(i), skew_hash_cnt) ? 1 : 0;
+  }
+  ASSERT_EQ(skew_hash_cnt, found_cnt);
+}
+
+} // namespace sql
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
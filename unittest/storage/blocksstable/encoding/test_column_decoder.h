@@ -90,6 +90,12 @@ public:
 
   void batch_get_row_perf_test();
 
+  void delta_of_delta_decode_test(const bool is_neg_step, const bool is_bit_packing);
+
+  void delta_of_delta_filter_pushdown_test(const bool is_neg_step);
+
+  void delta_of_delta_disabled_test();
+
   void set_encoding_type(ObColumnHeader::Type type);
 
   void set_column_type_default();
@@ -98,6 +104,29 @@ public:
 
   void set_column_type_string();
 
+  void set_column_type_float();
+
+  void set_column_type_delta_of_delta();
+
+  // rows in [DOD_NULL_BEGIN, DOD_NULL_END) are null, rows in [DOD_NOP_BEGIN, DOD_NOP_END) are nop
+  static const int64_t DOD_NULL_BEGIN = 10;
+  static const int64_t DOD_NULL_END = 20;
+  static const int64_t DOD_NOP_BEGIN = 30;
+  static const int64_t DOD_NOP_END = 35;
+
+  bool is_delta_of_delta_null_row(const int64_t col_idx, const int64_t row_id) const;
+
+  int64_t get_delta_of_delta_value(const int64_t col_idx, const int64_t row_id, const bool is_neg_step) const;
+
+  void append_delta_of_delta_rows(const bool is_neg_step, const bool with_nop);
+
+  int64_t count_delta_of_delta_rows(
+      const int64_t col_idx,
+      const bool is_neg_step,
+      const sql::ObWhiteFilterOperatorType op_type,
+      const int64_t left,
+      const int64_t right) const;
+
 protected:
   ObRowGenerate row_generate_;
   ObMicroBlockEncodingCtx ctx_;
@@ -179,10 +208,46 @@ void TestColumnDecoder::set_column_type_string()
   col_obj_types_[3] = ObHexStringType;
 }
 
+void TestColumnDecoder::set_column_type_float()
+{
+  if (OB_NOT_NULL(col_obj_types_)) {
+    allocator_.free(col_obj_types_);
+  }
+  column_cnt_ = 5;
+  rowkey_cnt_ = 1;
+  col_obj_types_ = reinterpret_cast<ObObjType *>(allocator_.alloc(sizeof(ObObjType) * column_cnt_));
+  col_obj_types_[0] = ObIntType;
+  col_obj_types_[1] = ObFloatType;
+  col_obj_types_[2] = ObDoubleType;
+  col_obj_types_[3] = ObUFloatType;
+  col_obj_types_[4] = ObUDoubleType;
+}
+
+void TestColumnDecoder::set_column_type_delta_of_delta()
+{
+  if (OB_NOT_NULL(col_obj_types_)) {
+    allocator_.free(col_obj_types_);
+  }
+  // one byte types are left out, byte aligned residuals can not be narrower than them
+  column_cnt_ = 6;
+  rowkey_cnt_ = 1;
+  col_obj_types_ = reinterpret_cast<ObObjType *>(allocator_.alloc(sizeof(ObObjType) * column_cnt_));
+  col_obj_types_[0] = ObIntType;
+  col_obj_types_[1] = ObSmallIntType;
+  col_obj_types_[2] = ObInt32Type;
+  col_obj_types_[3] = ObUSmallIntType;
+  col_obj_types_[4] = ObUInt32Type;
+  col_obj_types_[5] = ObDateTimeType;
+}
+
 void TestColumnDecoder::SetUp()
 {
   if (column_encoding_type_ == ObColumnHeader::Type::INTEGER_BASE_DIFF) {
     set_column_type_integer();
+  } else if (column_encoding_type_ == ObColumnHeader::Type::FLOAT_XOR) {
+    set_column_type_float();
+  } else if (column_encoding_type_ == ObColumnHeader::Type::DELTA_OF_DELTA) {
+    set_column_type_delta_of_delta();
   } else if (column_encoding_type_ == ObColumnHeader::Type::HEX_PACKING
       || column_encoding_type_ == ObColumnHeader::Type::STRING_DIFF
       || column_encoding_type_ == ObColumnHeader::Type::STRING_PREFIX) {
@@ -265,8 +330,14 @@ void TestColumnDecoder::SetUp()
         ctx_.column_encodings_[i] = ObColumnHeader::Type::RAW;
         continue;
       }
-      if (ObColumnHeader::Type::INTEGER_BASE_DIFF == column_encoding_type_) {
+      if (ObColumnHeader::Type::INTEGER_BASE_DIFF == column_encoding_type_
+          || ObColumnHeader::Type::DELTA_OF_DELTA == column_encoding_type_) {
         ctx_.column_encodings_[i] = column_encoding_type_;
+      } else if (ObColumnHeader::Type::FLOAT_XOR == column_encoding_type_) {
+        const int64_t schema_idx = i < rowkey_cnt_ ? i : i - extra_rowkey_cnt_;
+        const ObObjTypeClass tc = ob_obj_type_class(col_obj_types_[schema_idx]);
+        ctx_.column_encodings_[i] = (ObFloatTC == tc || ObDoubleTC == tc)
+            ? column_encoding_type_ : ObColumnHeader::Type::DICT;
       } else if (col_obj_types_[i] == ObIntType) {
         ctx_.column_encodings_[i] = ObColumnHeader::Type::DICT;
       } else {
@@ -937,6 +1008,225 @@ void TestColumnDecoder::batch_decode_to_datum_test(bool is_condensed)
   }
 }
 
+bool TestColumnDecoder::is_delta_of_delta_null_row(const int64_t col_idx, const int64_t row_id) const
+{
+  return col_idx >= rowkey_cnt_ && row_id >= DOD_NULL_BEGIN && row_id < DOD_NULL_END;
+}
+
+int64_t TestColumnDecoder::get_delta_of_delta_value(
+    const int64_t col_idx,
+    const int64_t row_id,
+    const bool is_neg_step) const
+{
+  // values lie on a line with small residuals, the first and last row are on the line exactly
+  const ObObjType type = col_descs_.at(col_idx).col_type_.get_type();
+  const bool is_signed = ObIntSC == get_store_class_map()[ob_obj_type_class(type)];
+  int64_t start = is_signed ? (is_neg_step ? 100 : -100) : (is_neg_step ? 200 : 10);
+  if (ObDateTimeType == type) {
+    start += 1700000000000000L;
+  }
+  const int64_t step = is_neg_step ? -3 : 3;
+  return start + row_id * step + row_id % 3;
+}
+
+void TestColumnDecoder::append_delta_of_delta_rows(const bool is_neg_step, const bool with_nop)
+{
+  ObDatumRow row;
+  ASSERT_EQ(OB_SUCCESS, row.init(allocator_, full_column_cnt_));
+  row.row_flag_.set_flag(ObDmlFlag::DF_INSERT);
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    for (int64_t j = 0; j < full_column_cnt_; ++j) {
+      ObStorageDatum &datum = row.storage_datums_[j];
+      const ObObjTypeClass tc = col_descs_.at(j).col_type_.get_type_class();
+      if (j >= rowkey_cnt_ && j < read_info_.get_rowkey_count()) {
+        datum.set_int(0);
+      } else if (is_delta_of_delta_null_row(j, i)) {
+        datum.set_null();
+      } else if (with_nop && j >= rowkey_cnt_ && i >= DOD_NOP_BEGIN && i < DOD_NOP_END) {
+        datum.set_nop();
+      } else if (ObUIntSC == get_store_class_map()[tc]) {
+        datum.set_uint(static_cast<uint64_t>(get_delta_of_delta_value(j, i, is_neg_step)));
+      } else {
+        datum.set_int(get_delta_of_delta_value(j, i, is_neg_step));
+      }
+    }
+    ASSERT_EQ(OB_SUCCESS, encoder_.append_row(row)) << "i: " << i << std::endl;
+  }
+}
+
+int64_t TestColumnDecoder::count_delta_of_delta_rows(
+    const int64_t col_idx,
+    const bool is_neg_step,
+    const sql::ObWhiteFilterOperatorType op_type,
+    const int64_t left,
+    const int64_t right) const
+{
+  int64_t cnt = 0;
+  for (int64_t i = 0; i < ROW_CNT; ++i) {
+    const int64_t v = get_delta_of_delta_value(col_idx, i, is_neg_step);
+    bool hit = false;
+    if (is_delta_of_delta_null_row(col_idx, i)) {
+      hit = sql::WHITE_OP_NU == op_type;
+    } else {
+      switch (op_type) {
+        case sql::WHITE_OP_EQ: hit = v == left; break;
+        case sql::WHITE_OP_NE: hit = v != left; break;
+        case sql::WHITE_OP_GT: hit = v > left; break;
+        case sql::WHITE_OP_GE: hit = v >= left; break;
+        case sql::WHITE_OP_LT: hit = v < left; break;
+        case sql::WHITE_OP_LE: hit = v <= left; break;
+        case sql::WHITE_OP_BT: hit = v >= left && v <= right; break;
+        case sql::WHITE_OP_IN: hit = v == left || v == right; break;
+        case sql::WHITE_OP_NN: hit = true; break;
+        default: break;
+      }
+    }
+    cnt += hit ? 1 : 0;
+  }
+  return cnt;
+}
+
+void TestColumnDecoder::delta_of_delta_decode_test(const bool is_neg_step, const bool is_bit_packing)
+{
+  append_delta_of_delta_rows(is_neg_step, true /*with_nop*/);
+  if (!is_bit_packing) {
+    const_cast<bool &>(encoder_.ctx_.encoder_opt_.enable_bit_packing_) = false;
+  }
+
+  char *buf = NULL;
+  int64_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, encoder_.build_block(buf, size));
+  ObMicroBlockDecoder decoder;
+  ObMicroBlockData data(encoder_.get_data().data(), encoder_.get_data().pos());
+  ASSERT_EQ(OB_SUCCESS, decoder.init(data, read_info_));
+  int64_t row_len = 0;
+  const char *row_data = nullptr;
+  const char *cell_datas[ROW_CNT];
+  void *datum_buf = allocator_.alloc(sizeof(int8_t) * 128 * ROW_CNT);
+
+  for (int64_t i = 0; i < full_column_cnt_; ++i) {
+    if (i >= rowkey_cnt_ && i < read_info_.get_rowkey_count()) {
+      continue;
+    }
+    const ObColumnDecoderCtx &col_ctx = *decoder.decoders_[i].ctx_;
+    ASSERT_EQ(ObColumnHeader::DELTA_OF_DELTA, col_ctx.col_header_->type_) << "col: " << i;
+    ASSERT_EQ(is_bit_packing, col_ctx.is_bit_packing()) << "col: " << i;
+
+    ObDatum datums[ROW_CNT];
+    int64_t row_ids[ROW_CNT];
+    for (int64_t j = 0; j < ROW_CNT; ++j) {
+      datums[j].ptr_ = reinterpret_cast<char *>(datum_buf) + j * 128;
+      row_ids[j] = j;
+    }
+    ASSERT_EQ(OB_SUCCESS, decoder.decoders_[i].batch_decode(
+        decoder.row_index_, row_ids, cell_datas, ROW_CNT, datums));
+    for (int64_t j = 0; j < ROW_CNT; ++j) {
+      ObObj obj;
+      ASSERT_EQ(OB_SUCCESS, decoder.row_index_->get(row_ids[j], row_data, row_len));
+      ObBitStream bs(reinterpret_cast<unsigned char *>(const_cast<char *>(row_data)), row_len);
+      ASSERT_EQ(OB_SUCCESS, decoder.decoders_[i].decode(obj, row_ids[j], bs, row_data, row_len));
+      if (is_delta_of_delta_null_row(i, j)) {
+        ASSERT_TRUE(obj.is_null()) << "col: " << i << " row: " << j;
+        ASSERT_TRUE(datums[j].is_null()) << "col: " << i << " row: " << j;
+      } else if (i >= rowkey_cnt_ && j >= DOD_NOP_BEGIN && j < DOD_NOP_END) {
+        ASSERT_TRUE(obj.is_nop_value()) << "col: " << i << " row: " << j;
+        ASSERT_TRUE(datums[j].is_null()) << "col: " << i << " row: " << j;
+      } else {
+        const int64_t expect = get_delta_of_delta_value(i, j, is_neg_step);
+        ASSERT_EQ(expect, obj.v_.int64_) << "col: " << i << " row: " << j;
+        ASSERT_EQ(expect, datums[j].get_int()) << "col: " << i << " row: " << j;
+      }
+    }
+
+    // random access goes through the single row path
+    int64_t reverse_row_ids[ROW_CNT];
+    for (int64_t j = 0; j < ROW_CNT; ++j) {
+      reverse_row_ids[j] = ROW_CNT - 1 - j;
+    }
+    ASSERT_EQ(OB_SUCCESS, decoder.decoders_[i].batch_decode(
+        decoder.row_index_, reverse_row_ids, cell_datas, ROW_CNT, datums));
+    for (int64_t j = 0; j < ROW_CNT; ++j) {
+      const int64_t row_id = reverse_row_ids[j];
+      if (is_delta_of_delta_null_row(i, row_id)
+          || (i >= rowkey_cnt_ && row_id >= DOD_NOP_BEGIN && row_id < DOD_NOP_END)) {
+        ASSERT_TRUE(datums[j].is_null()) << "col: " << i << " row: " << row_id;
+      } else {
+        ASSERT_EQ(get_delta_of_delta_value(i, row_id, is_neg_step), datums[j].get_int())
+            << "col: " << i << " row: " << row_id;
+      }
+    }
+  }
+}
+
+void TestColumnDecoder::delta_of_delta_filter_pushdown_test(const bool is_neg_step)
+{
+  append_delta_of_delta_rows(is_neg_step, false /*with_nop*/);
+
+  char *buf = NULL;
+  int64_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, encoder_.build_block(buf, size));
+  ObMicroBlockDecoder decoder;
+  ObMicroBlockData data(encoder_.get_data().data(), encoder_.get_data().pos());
+  ASSERT_EQ(OB_SUCCESS, decoder.init(data, read_info_));
+
+  const sql::ObWhiteFilterOperatorType ops[] = {
+      sql::WHITE_OP_EQ, sql::WHITE_OP_NE, sql::WHITE_OP_GT, sql::WHITE_OP_GE, sql::WHITE_OP_LT,
+      sql::WHITE_OP_LE, sql::WHITE_OP_BT, sql::WHITE_OP_IN, sql::WHITE_OP_NU, sql::WHITE_OP_NN};
+  for (int64_t i = 0; i < full_column_cnt_; ++i) {
+    if (i >= rowkey_cnt_ && i < read_info_.get_rowkey_count()) {
+      continue;
+    }
+    ASSERT_EQ(ObColumnHeader::DELTA_OF_DELTA, decoder.decoders_[i].ctx_->col_header_->type_);
+    const int64_t v1 = get_delta_of_delta_value(i, 25, is_neg_step);
+    const int64_t v2 = get_delta_of_delta_value(i, 50, is_neg_step);
+    const int64_t left = MIN(v1, v2);
+    const int64_t right = MAX(v1, v2);
+    for (int64_t k = 0; k < ARRAYSIZEOF(ops); ++k) {
+      sql::ObPushdownWhiteFilterNode white_filter(allocator_);
+      white_filter.op_type_ = ops[k];
+      ObMalloc mallocer;
+      mallocer.set_label("ColumnDecoder");
+      ObFixedArray<ObObj, ObIAllocator> objs(mallocer, 2);
+      objs.init(2);
+      if (sql::WHITE_OP_NU != ops[k] && sql::WHITE_OP_NN != ops[k]) {
+        ObObj ref_obj;
+        ref_obj.set_meta_type(col_descs_.at(i).col_type_);
+        ref_obj.v_.int64_ = left;
+        objs.push_back(ref_obj);
+        if (sql::WHITE_OP_BT == ops[k] || sql::WHITE_OP_IN == ops[k]) {
+          ref_obj.v_.int64_ = right;
+          objs.push_back(ref_obj);
+        }
+      }
+      ObBitmap result_bitmap(allocator_);
+      result_bitmap.init(ROW_CNT);
+      ASSERT_EQ(OB_SUCCESS, test_filter_pushdown(i, is_retro_, decoder, white_filter, result_bitmap, objs));
+      ASSERT_EQ(count_delta_of_delta_rows(i, is_neg_step, ops[k], left, right), result_bitmap.popcnt())
+          << "col: " << i << " op: " << ops[k];
+    }
+  }
+}
+
+void TestColumnDecoder::delta_of_delta_disabled_test()
+{
+  // without specified encodings, delta of delta is not chosen unless turned on
+  allocator_.free(ctx_.column_encodings_);
+  ctx_.column_encodings_ = nullptr;
+  ctx_.enable_delta_of_delta_encoding_ = false;
+  ASSERT_EQ(OB_SUCCESS, encoder_.init(ctx_));
+  append_delta_of_delta_rows(false /*is_neg_step*/, false /*with_nop*/);
+
+  char *buf = NULL;
+  int64_t size = 0;
+  ASSERT_EQ(OB_SUCCESS, encoder_.build_block(buf, size));
+  ObMicroBlockDecoder decoder;
+  ObMicroBlockData data(encoder_.get_data().data(), encoder_.get_data().pos());
+  ASSERT_EQ(OB_SUCCESS, decoder.init(data, read_info_));
+  for (int64_t i = 0; i < full_column_cnt_; ++i) {
+    ASSERT_NE(ObColumnHeader::DELTA_OF_DELTA, decoder.decoders_[i].ctx_->col_header_->type_);
+  }
+}
+
 // void TestColumnDecoder::batch_get_row_perf_test()
 // {
 //   ObDatumRow row;
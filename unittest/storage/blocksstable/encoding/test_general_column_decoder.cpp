@@ -53,6 +53,20 @@ public:
   virtual ~TestIntBaseDiffDecoder() {}
 };
 
+class TestFloatXorDecoder : public TestColumnDecoder
+{
+public:
+  TestFloatXorDecoder() : TestColumnDecoder(ObColumnHeader::Type::FLOAT_XOR) {}
+  virtual ~TestFloatXorDecoder() {}
+};
+
+class TestDeltaOfDeltaDecoder : public TestColumnDecoder
+{
+public:
+  TestDeltaOfDeltaDecoder() : TestColumnDecoder(ObColumnHeader::Type::DELTA_OF_DELTA) {}
+  virtual ~TestDeltaOfDeltaDecoder() {}
+};
+
 class TestRetroPDDecoder : public TestColumnDecoder
 {
 public:
@@ -90,6 +104,7 @@ PUSHDOWN_GENERAL_TEST(TestRetroPDDecoder);
 PUSHDOWN_GENERAL_TEST(TestDictDecoder);
 PUSHDOWN_GENERAL_TEST(TestRLEDecoder);
 PUSHDOWN_GENERAL_TEST(TestIntBaseDiffDecoder);
+PUSHDOWN_GENERAL_TEST(TestFloatXorDecoder);
 
 TEST_F(TestHexDecoder, basic_filter_pushdown_op_test_eq_ne_nu_nn)
 {
@@ -116,6 +131,51 @@ TEST_F(TestIntBaseDiffDecoder, batch_decode_to_datum_test)
   batch_decode_to_datum_test();
 }
 
+TEST_F(TestFloatXorDecoder, batch_decode_to_datum_test)
+{
+  batch_decode_to_datum_test();
+}
+
+TEST_F(TestFloatXorDecoder, batch_decode_to_datum_condense_test)
+{
+  batch_decode_to_datum_test(true);
+}
+
+TEST_F(TestDeltaOfDeltaDecoder, decode_bit_packing_test)
+{
+  delta_of_delta_decode_test(false /*is_neg_step*/, true /*is_bit_packing*/);
+}
+
+TEST_F(TestDeltaOfDeltaDecoder, decode_neg_step_bit_packing_test)
+{
+  delta_of_delta_decode_test(true /*is_neg_step*/, true /*is_bit_packing*/);
+}
+
+TEST_F(TestDeltaOfDeltaDecoder, decode_byte_aligned_test)
+{
+  delta_of_delta_decode_test(false /*is_neg_step*/, false /*is_bit_packing*/);
+}
+
+TEST_F(TestDeltaOfDeltaDecoder, decode_neg_step_byte_aligned_test)
+{
+  delta_of_delta_decode_test(true /*is_neg_step*/, false /*is_bit_packing*/);
+}
+
+TEST_F(TestDeltaOfDeltaDecoder, filter_pushdown_test)
+{
+  delta_of_delta_filter_pushdown_test(false /*is_neg_step*/);
+}
+
+TEST_F(TestDeltaOfDeltaDecoder, filter_pushdown_neg_step_test)
+{
+  delta_of_delta_filter_pushdown_test(true /*is_neg_step*/);
+}
+
+TEST_F(TestDeltaOfDeltaDecoder, disabled_by_default_test)
+{
+  delta_of_delta_disabled_test();
+}
+
 TEST_F(TestHexDecoder, batch_decode_to_datum_test)
 {
   batch_decode_to_datum_test();
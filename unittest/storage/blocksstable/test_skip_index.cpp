@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+#define protected public
+#define private public
+#include "storage/blocksstable/ob_skip_index.h"
+
+namespace oceanbase
+{
+using namespace common;
+using namespace blocksstable;
+
+namespace unittest
+{
+class TestSkipIndex : public ::testing::Test
+{
+public:
+  TestSkipIndex() = default;
+  void SetUp() {}
+  void TearDown() {}
+  static void SetUpTestCase() {}
+  static void TearDownTestCase() {}
+};
+
+TEST_F(TestSkipIndex, col_meta)
+{
+  ObSkipIndexColMeta col_meta;
+  col_meta.col_idx_ = 3;
+  ASSERT_FALSE(col_meta.has_value());
+  col_meta.add_null_count(2);
+  ASSERT_TRUE(col_meta.is_all_null());
+  col_meta.add_value(10);
+  col_meta.add_value(-5);
+  col_meta.add_value(7);
+  ASSERT_TRUE(col_meta.has_value());
+  ASSERT_EQ(-5, col_meta.min_);
+  ASSERT_EQ(10, col_meta.max_);
+  col_meta.add_null_count(UINT64_MAX);
+  ASSERT_EQ(UINT32_MAX, col_meta.null_count_);
+
+  ObSkipIndexColMeta unsigned_meta;
+  unsigned_meta.is_unsigned_ = 1;
+  unsigned_meta.add_value(1);
+  unsigned_meta.add_value(-1); // UINT64_MAX
+  ASSERT_EQ(1, unsigned_meta.min_);
+  ASSERT_EQ(-1, unsigned_meta.max_);
+
+  const int64_t buf_len = 128;
+  char buf[buf_len] = {0};
+  int64_t pos = 0;
+  ASSERT_EQ(OB_SUCCESS, col_meta.serialize(buf, buf_len, pos));
+  ASSERT_EQ(col_meta.get_serialize_size(), pos);
+  ObSkipIndexColMeta des_meta;
+  pos = 0;
+  ASSERT_EQ(OB_SUCCESS, des_meta.deserialize(buf, buf_len, pos));
+  ASSERT_EQ(0, MEMCMP(&col_meta, &des_meta, sizeof(col_meta)));
+}
+
+TEST_F(TestSkipIndex, merge)
+{
+  ObSkipIndexColMeta left[2];
+  left[0].col_idx_ = 3;
+  left[0].add_value(1);
+  left[0].add_value(5);
+  left[1].col_idx_ = 4;
+  left[1].add_null_count(1);
+  ObSkipIndexColMeta right[2];
+  right[0].col_idx_ = 4;
+  right[0].add_value(100);
+  right[1].col_idx_ = 3;
+  right[1].add_value(-3);
+  right[1].add_null_count(1);
+
+  ObSkipIndexAggregator aggregator;
+  const ObSkipIndexColMeta *cols = nullptr;
+  int64_t col_cnt = 0;
+  aggregator.get_aggregated_cols(cols, col_cnt);
+  ASSERT_EQ(0, col_cnt);
+
+  aggregator.eval(left, 2);
+  aggregator.eval(right, 2);
+  aggregator.get_aggregated_cols(cols, col_cnt);
+  ASSERT_EQ(2, col_cnt);
+  ASSERT_EQ(3, cols[0].col_idx_);
+  ASSERT_EQ(-3, cols[0].min_);
+  ASSERT_EQ(5, cols[0].max_);
+  ASSERT_EQ(1, cols[0].null_count_);
+  ASSERT_EQ(4, cols[1].col_idx_);
+  ASSERT_EQ(100, cols[1].min_);
+  ASSERT_EQ(100, cols[1].max_);
+  ASSERT_EQ(1, cols[1].null_count_);
+
+  // column missing in one child is dropped
+  aggregator.eval(right, 1);
+  aggregator.get_aggregated_cols(cols, col_cnt);
+  ASSERT_EQ(1, col_cnt);
+  ASSERT_EQ(4, cols[0].col_idx_);
+
+  // child without skip index invalidates all
+  aggregator.eval(nullptr, 0);
+  aggregator.get_aggregated_cols(cols, col_cnt);
+  ASSERT_EQ(0, col_cnt);
+
+  aggregator.reuse();
+  aggregator.eval(left, 2);
+  aggregator.get_aggregated_cols(cols, col_cnt);
+  ASSERT_EQ(2, col_cnt);
+}
+
+TEST_F(TestSkipIndex, row_header)
+{
+  char buf[ObSkipIndexRowHeader::calc_size(2)];
+  ObSkipIndexRowHeader *header = reinterpret_cast<ObSkipIndexRowHeader *>(buf);
+  header->version_ = ObSkipIndexRowHeader::SKIP_INDEX_VERSION_V1;
+  header->col_cnt_ = 2;
+  ASSERT_TRUE(header->is_valid());
+  ASSERT_EQ(sizeof(buf), header->get_size());
+  ASSERT_EQ(buf + sizeof(ObSkipIndexRowHeader), reinterpret_cast<const char *>(header->get_cols()));
+}
+}
+}
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_skip_index.log*");
+  OB_LOGGER.set_log_level("INFO");
+  STORAGE_LOG(INFO, "begin unittest: test_skip_index");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
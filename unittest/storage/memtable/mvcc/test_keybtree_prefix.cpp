@@ -0,0 +1,300 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#define private public
+#include "storage/memtable/mvcc/ob_query_engine.h"
+#undef private
+
+#include "storage/memtable/ob_memtable_key.h"
+
+#include "../utils_mod_allocator.h"
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace oceanbase
+{
+namespace unittest
+{
+using namespace oceanbase::common;
+using namespace oceanbase::keybtree;
+using namespace oceanbase::memtable;
+
+typedef ObQueryEngine::KeyBtree KeyBtree;
+typedef ObQueryEngine::BtreeIterator BtreeIterator;
+typedef ObQueryEngine::BtreeNodeAllocator BtreeNodeAllocator;
+typedef KeyPrefixHelper<ObStoreRowkeyWrapper> KeyPrefixHelper;
+typedef NodeKeyPrefix<ObStoreRowkeyWrapper> NodeKeyPrefix;
+
+// keys of one btree, the objs are owned by the test.
+class TestKeys
+{
+public:
+  static const int64_t MAX_COL_CNT = 2;
+  explicit TestKeys(const int64_t cnt) : cnt_(cnt), objs_(cnt * MAX_COL_CNT), rowkeys_(cnt), keys_(cnt) {}
+  ObObj *get_objs(const int64_t idx) { return &objs_[idx * MAX_COL_CNT]; }
+  void build(const int64_t idx, const int64_t col_cnt)
+  {
+    rowkeys_[idx].assign(get_objs(idx), col_cnt);
+    keys_[idx] = ObStoreRowkeyWrapper(&rowkeys_[idx]);
+  }
+  const ObStoreRowkeyWrapper &get_key(const int64_t idx) const { return keys_[idx]; }
+  int64_t count() const { return cnt_; }
+private:
+  int64_t cnt_;
+  std::vector<ObObj> objs_;
+  std::vector<ObStoreRowkey> rowkeys_;
+  std::vector<ObStoreRowkeyWrapper> keys_;
+};
+
+ObMvccRow *get_value(const int64_t idx)
+{
+  return reinterpret_cast<ObMvccRow *>((idx + 1) << 3);
+}
+
+// insert keys in random order, then check get and the order of full scan.
+void check_btree(TestKeys &keys, TestKeys *missing_keys, const bool enable_key_prefix)
+{
+  ObModAllocator allocator;
+  BtreeNodeAllocator node_allocator(allocator);
+  node_allocator.set_enable_key_prefix(enable_key_prefix);
+  ASSERT_EQ(enable_key_prefix, node_allocator.is_key_prefix_enabled());
+  ASSERT_EQ(sizeof(BtreeNode<ObStoreRowkeyWrapper, ObMvccRow *>)
+            + (enable_key_prefix ? sizeof(NodeKeyPrefix) : 0),
+            node_allocator.get_node_size());
+  KeyBtree btree(node_allocator);
+  ASSERT_EQ(OB_SUCCESS, btree.init());
+
+  std::vector<int64_t> order(keys.count());
+  for (int64_t i = 0; i < keys.count(); i++) {
+    order[i] = i;
+  }
+  std::shuffle(order.begin(), order.end(), std::mt19937(keys.count()));
+  for (int64_t i = 0; i < keys.count(); i++) {
+    ObMvccRow *value = get_value(order[i]);
+    ASSERT_EQ(OB_SUCCESS, btree.insert(keys.get_key(order[i]), value));
+  }
+  ASSERT_EQ(keys.count(), btree.size());
+
+  for (int64_t i = 0; i < keys.count(); i++) {
+    ObMvccRow *value = nullptr;
+    ASSERT_EQ(OB_SUCCESS, btree.get(keys.get_key(i), value));
+    ASSERT_EQ(get_value(i), value);
+  }
+
+  // the expected order is decided by full key compare
+  std::sort(order.begin(), order.end(), [&](const int64_t l, const int64_t r) {
+    int cmp = 0;
+    EXPECT_EQ(OB_SUCCESS, keys.get_key(l).compare(keys.get_key(r), cmp));
+    return cmp < 0;
+  });
+  BtreeIterator iter;
+  ObStoreRowkeyWrapper min_key(&ObStoreRowkey::MIN_STORE_ROWKEY);
+  ObStoreRowkeyWrapper max_key(&ObStoreRowkey::MAX_STORE_ROWKEY);
+  ASSERT_EQ(OB_SUCCESS, btree.set_key_range(iter, min_key, false, max_key, false, INT64_MAX));
+  ObStoreRowkeyWrapper key;
+  ObMvccRow *value = nullptr;
+  for (int64_t i = 0; i < keys.count(); i++) {
+    ASSERT_EQ(OB_SUCCESS, iter.get_next(key, value));
+    ASSERT_EQ(get_value(order[i]), value);
+  }
+  ASSERT_EQ(OB_ITER_END, iter.get_next(key, value));
+
+  // range scan starts from the upper bound found by node search
+  const int64_t start = keys.count() / 3;
+  const int64_t end = keys.count() * 2 / 3;
+  BtreeIterator range_iter;
+  ASSERT_EQ(OB_SUCCESS, btree.set_key_range(range_iter, keys.get_key(order[start]), true,
+                                            keys.get_key(order[end]), false, INT64_MAX));
+  for (int64_t i = start + 1; i <= end; i++) {
+    ASSERT_EQ(OB_SUCCESS, range_iter.get_next(key, value));
+    ASSERT_EQ(get_value(order[i]), value);
+  }
+  ASSERT_EQ(OB_ITER_END, range_iter.get_next(key, value));
+
+  // the keys which are not inserted are not found
+  for (int64_t i = 0; OB_NOT_NULL(missing_keys) && i < missing_keys->count(); i++) {
+    ASSERT_EQ(OB_ENTRY_NOT_EXIST, btree.get(missing_keys->get_key(i), value));
+  }
+  btree.destroy();
+}
+
+TEST(TestKeyBtreePrefix, get_prefix)
+{
+  ObObj objs[2];
+  ObStoreRowkey rowkey(objs, 1);
+  ObStoreRowkeyWrapper key(&rowkey);
+  uint8_t kind = KEY_PREFIX_NONE;
+  uint64_t prefix = 0;
+  uint64_t last_prefix = 0;
+
+  // the order of int is kept by prefix
+  const int64_t ints[] = {INT64_MIN, -100, -1, 0, 1, 100, INT64_MAX};
+  for (int64_t i = 0; i < ARRAYSIZEOF(ints); i++) {
+    objs[0].set_int(ints[i]);
+    KeyPrefixHelper::get_prefix(key, kind, prefix);
+    ASSERT_EQ(KeyPrefixHelper::KEY_PREFIX_INT, kind);
+    if (i > 0) {
+      ASSERT_LT(last_prefix, prefix);
+    }
+    last_prefix = prefix;
+  }
+  objs[0].set_int32(-5);
+  KeyPrefixHelper::get_prefix(key, kind, prefix);
+  ASSERT_EQ(KeyPrefixHelper::KEY_PREFIX_INT, kind);
+
+  objs[0].set_uint64(UINT64_MAX);
+  KeyPrefixHelper::get_prefix(key, kind, prefix);
+  ASSERT_EQ(KeyPrefixHelper::KEY_PREFIX_UINT, kind);
+  ASSERT_EQ(UINT64_MAX, prefix);
+
+  // other types are compared by full key
+  objs[0].set_varchar("abc");
+  KeyPrefixHelper::get_prefix(key, kind, prefix);
+  ASSERT_EQ(KEY_PREFIX_NONE, kind);
+  objs[0].set_null();
+  KeyPrefixHelper::get_prefix(key, kind, prefix);
+  ASSERT_EQ(KEY_PREFIX_NONE, kind);
+  ObStoreRowkeyWrapper min_key(&ObStoreRowkey::MIN_STORE_ROWKEY);
+  KeyPrefixHelper::get_prefix(min_key, kind, prefix);
+  ASSERT_EQ(KEY_PREFIX_NONE, kind);
+  ObStoreRowkeyWrapper null_key;
+  KeyPrefixHelper::get_prefix(null_key, kind, prefix);
+  ASSERT_EQ(KEY_PREFIX_NONE, kind);
+}
+
+TEST(TestKeyBtreePrefix, node_compare)
+{
+  const int64_t cnt = NODE_KEY_COUNT;
+  std::vector<ObObj> objs(cnt);
+  std::vector<ObStoreRowkey> rowkeys(cnt);
+  NodeKeyPrefix key_prefix;
+  for (int64_t i = 0; i < cnt; i++) {
+    if (3 == i) {
+      objs[i].set_varchar("abc");
+    } else if (5 == i) {
+      objs[i].set_uint64(10);
+    } else {
+      objs[i].set_int(i * 10 - 50);
+    }
+    rowkeys[i].assign(&objs[i], 1);
+    key_prefix.set(i, ObStoreRowkeyWrapper(&rowkeys[i]));
+  }
+  ObObj search_obj;
+  search_obj.set_int(20);
+  ObStoreRowkey search_rowkey(&search_obj, 1);
+  uint8_t kind = KEY_PREFIX_NONE;
+  uint64_t prefix = 0;
+  KeyPrefixHelper::get_prefix(ObStoreRowkeyWrapper(&search_rowkey), kind, prefix);
+
+  for (int valid_cnt = 0; valid_cnt <= cnt; valid_cnt++) {
+    uint32_t less_mask = 0;
+    uint32_t tie_mask = 0;
+    key_prefix.compare(valid_cnt, kind, prefix, less_mask, tie_mask);
+    for (int64_t i = 0; i < cnt; i++) {
+      const bool is_valid = i < valid_cnt;
+      const bool is_other_kind = (3 == i || 5 == i);
+      const bool is_less = is_valid && !is_other_kind && i * 10 - 50 < 20;
+      const bool is_tie = is_valid && (is_other_kind || i * 10 - 50 == 20);
+      ASSERT_EQ(is_less, 0 != (less_mask & (1U << i))) << "slot=" << i << " cnt=" << valid_cnt;
+      ASSERT_EQ(is_tie, 0 != (tie_mask & (1U << i))) << "slot=" << i << " cnt=" << valid_cnt;
+    }
+  }
+}
+
+TEST(TestKeyBtreePrefix, int_keys)
+{
+  const int64_t cnt = 20000;
+  TestKeys keys(cnt);
+  TestKeys missing_keys(cnt);
+  for (int64_t i = 0; i < cnt; i++) {
+    keys.get_objs(i)[0].set_int((i - cnt / 2) * 3);
+    keys.build(i, 1);
+    missing_keys.get_objs(i)[0].set_int((i - cnt / 2) * 3 + 1);
+    missing_keys.build(i, 1);
+  }
+  check_btree(keys, &missing_keys, false);
+  check_btree(keys, &missing_keys, true);
+}
+
+TEST(TestKeyBtreePrefix, uint_keys)
+{
+  const int64_t cnt = 5000;
+  TestKeys keys(cnt);
+  TestKeys missing_keys(cnt);
+  for (int64_t i = 0; i < cnt; i++) {
+    // the values larger than INT64_MAX are ordered after the smaller ones
+    keys.get_objs(i)[0].set_uint64(0 == i % 2 ? i : UINT64_MAX - i);
+    keys.build(i, 1);
+    missing_keys.get_objs(i)[0].set_uint64(0 == i % 2 ? UINT64_MAX - i : i);
+    missing_keys.build(i, 1);
+  }
+  check_btree(keys, &missing_keys, false);
+  check_btree(keys, &missing_keys, true);
+}
+
+TEST(TestKeyBtreePrefix, prefix_ties)
+{
+  // many keys share the first column, the search falls back to binary search
+  const int64_t cnt = 5000;
+  TestKeys keys(cnt);
+  TestKeys missing_keys(cnt);
+  for (int64_t i = 0; i < cnt; i++) {
+    keys.get_objs(i)[0].set_int(i / 100);
+    keys.get_objs(i)[1].set_int(cnt - i);
+    keys.build(i, 2);
+    missing_keys.get_objs(i)[0].set_int(i / 100);
+    missing_keys.get_objs(i)[1].set_int(-i);
+    missing_keys.build(i, 2);
+  }
+  check_btree(keys, &missing_keys, false);
+  check_btree(keys, &missing_keys, true);
+}
+
+TEST(TestKeyBtreePrefix, no_prefix_keys)
+{
+  const int64_t cnt = 3000;
+  TestKeys keys(cnt);
+  std::vector<std::string> strs(cnt);
+  for (int64_t i = 0; i < cnt; i++) {
+    strs[i] = std::to_string(i * 7);
+    keys.get_objs(i)[0].set_varchar(strs[i].c_str(), static_cast<int32_t>(strs[i].length()));
+    keys.get_objs(i)[0].set_collation_type(CS_TYPE_UTF8MB4_BIN);
+    keys.build(i, 1);
+  }
+  check_btree(keys, nullptr, false);
+  check_btree(keys, nullptr, true);
+}
+
+TEST(TestKeyBtreePrefix, query_engine_gate)
+{
+  // the parameter is off by default, the tenant config is not valid in unittest
+  ObModAllocator allocator;
+  ObQueryEngine qe(allocator);
+  ASSERT_EQ(OB_SUCCESS, qe.init(1));
+  ASSERT_FALSE(qe.btree_allocator_.is_key_prefix_enabled());
+  ASSERT_EQ(sizeof(BtreeNode<ObStoreRowkeyWrapper, ObMvccRow *>), qe.btree_allocator_.get_node_size());
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+  oceanbase::common::ObLogger::get_logger().set_file_name("test_keybtree_prefix.log", true);
+  oceanbase::common::ObLogger::get_logger().set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
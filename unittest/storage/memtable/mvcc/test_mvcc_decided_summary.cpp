@@ -0,0 +1,339 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+
+#include <thread>
+#include <vector>
+#include "share/rc/ob_tenant_base.h"
+#include "storage/memtable/ob_memtable.h"
+#include "storage/memtable/ob_memtable_context.h"
+#include "storage/memtable/mvcc/ob_mvcc_define.h"
+#include "storage/memtable/mvcc/ob_mvcc_iterator.h"
+
+namespace oceanbase
+{
+
+namespace unittest
+{
+using namespace oceanbase::common;
+using namespace oceanbase::memtable;
+using namespace oceanbase::share;
+
+SCN mock_scn(const int64_t val)
+{
+  SCN scn;
+  scn.convert_for_tx(val);
+  return scn;
+}
+
+class TestMvccDecidedSummary : public ::testing::Test
+{
+public:
+  TestMvccDecidedSummary() : tenant_base_(OB_SYS_TENANT_ID) {}
+  virtual void SetUp() override
+  {
+    ObTenantEnv::set_tenant(&tenant_base_);
+  }
+  virtual void TearDown() override
+  {
+    ObTenantEnv::set_tenant(nullptr);
+  }
+  bool can_skip(ObMemtable &mt, const int64_t snapshot)
+  {
+    return mt.get_decided_summary().can_skip_undecided(mock_scn(snapshot));
+  }
+protected:
+  ObTenantBase tenant_base_;
+};
+
+TEST_F(TestMvccDecidedSummary, summary_publish_revoke)
+{
+  ObMvccDecidedSummary summary;
+  ASSERT_TRUE(summary.can_skip_undecided(mock_scn(100)));
+
+  const int64_t slot = summary.publish(mock_scn(200));
+  ASSERT_LE(0, slot);
+  ASSERT_TRUE(summary.can_skip_undecided(mock_scn(100)));
+  ASSERT_FALSE(summary.can_skip_undecided(mock_scn(200)));
+  ASSERT_FALSE(summary.can_skip_undecided(mock_scn(300)));
+
+  // the regenerated commit version only lowers the published one
+  summary.lower(slot, mock_scn(150));
+  ASSERT_FALSE(summary.can_skip_undecided(mock_scn(160)));
+  summary.lower(slot, mock_scn(180));
+  ASSERT_TRUE(summary.can_skip_undecided(mock_scn(149)));
+  ASSERT_FALSE(summary.can_skip_undecided(mock_scn(160)));
+
+  summary.revoke(slot);
+  ASSERT_TRUE(summary.can_skip_undecided(mock_scn(300)));
+
+  // the txn without a valid version blocks all snapshots
+  const int64_t invalid_slot = summary.publish(SCN::invalid_scn());
+  ASSERT_LE(0, invalid_slot);
+  ASSERT_FALSE(summary.can_skip_undecided(mock_scn(1)));
+  summary.revoke(invalid_slot);
+  ASSERT_TRUE(summary.can_skip_undecided(mock_scn(1)));
+}
+
+TEST_F(TestMvccDecidedSummary, summary_slot_overflow)
+{
+  ObMvccDecidedSummary summary;
+  int64_t slots[ObMvccDecidedSummary::MAX_SLOT_CNT];
+  for (int64_t i = 0; i < ObMvccDecidedSummary::MAX_SLOT_CNT; ++i) {
+    slots[i] = summary.publish(mock_scn(1000 + i));
+    ASSERT_EQ(i, slots[i]);
+  }
+  ASSERT_TRUE(summary.can_skip_undecided(mock_scn(999)));
+
+  // the txn out of slots makes the summary unusable until it revokes
+  ASSERT_EQ(-1, summary.publish(mock_scn(2000)));
+  ASSERT_EQ(1, summary.overflow_cnt_);
+  ASSERT_FALSE(summary.can_skip_undecided(mock_scn(999)));
+  summary.revoke(-1);
+  ASSERT_EQ(0, summary.overflow_cnt_);
+  ASSERT_TRUE(summary.can_skip_undecided(mock_scn(999)));
+
+  // the revoked slot is reused
+  summary.revoke(slots[3]);
+  ASSERT_EQ(3, summary.publish(mock_scn(500)));
+  ASSERT_FALSE(summary.can_skip_undecided(mock_scn(999)));
+  ASSERT_TRUE(summary.can_skip_undecided(mock_scn(499)));
+}
+
+TEST_F(TestMvccDecidedSummary, summary_disable)
+{
+  ObMvccDecidedSummary summary;
+  summary.disable();
+  ASSERT_FALSE(summary.can_skip_undecided(mock_scn(1)));
+  const int64_t slot = summary.publish(mock_scn(100));
+  summary.revoke(slot);
+  ASSERT_FALSE(summary.can_skip_undecided(mock_scn(1)));
+  summary.reset();
+  ASSERT_TRUE(summary.can_skip_undecided(mock_scn(1)));
+}
+
+TEST_F(TestMvccDecidedSummary, publisher_publish_revoke)
+{
+  ObMemtable mt1;
+  ObMemtable mt2;
+  ObTxDecidedPublisher publisher;
+
+  // nothing is published before the commit version is known
+  publisher.add(&mt1);
+  ASSERT_EQ(1, publisher.cnt_);
+  ASSERT_EQ(-1, publisher.slots_[0]);
+  ASSERT_TRUE(can_skip(mt1, 1000));
+
+  publisher.publish(mock_scn(100));
+  ASSERT_TRUE(can_skip(mt1, 50));
+  ASSERT_FALSE(can_skip(mt1, 100));
+
+  // the memtable written after publish is published at once
+  publisher.add(&mt2);
+  publisher.add(&mt2);
+  ASSERT_EQ(2, publisher.cnt_);
+  ASSERT_TRUE(can_skip(mt2, 50));
+  ASSERT_FALSE(can_skip(mt2, 100));
+
+  publisher.publish(mock_scn(80));
+  ASSERT_FALSE(can_skip(mt1, 90));
+  ASSERT_FALSE(can_skip(mt2, 90));
+  publisher.publish(mock_scn(120));
+  ASSERT_TRUE(can_skip(mt1, 79));
+  ASSERT_FALSE(can_skip(mt1, 90));
+
+  publisher.revoke(true /*is_decided*/);
+  ASSERT_EQ(0, publisher.cnt_);
+  ASSERT_TRUE(can_skip(mt1, 1000));
+  ASSERT_TRUE(can_skip(mt2, 1000));
+}
+
+TEST_F(TestMvccDecidedSummary, publisher_revoke_undecided)
+{
+  ObMemtable mt;
+  ObTxDecidedPublisher publisher;
+  publisher.add(&mt);
+  publisher.publish(mock_scn(100));
+  publisher.revoke(false /*is_decided*/);
+  ASSERT_EQ(0, publisher.cnt_);
+  ASSERT_FALSE(can_skip(mt, 50));
+}
+
+TEST_F(TestMvccDecidedSummary, publisher_remove)
+{
+  ObMemtable mt1;
+  ObMemtable mt2;
+  ObTxDecidedPublisher publisher;
+  publisher.add(&mt1);
+  publisher.add(&mt2);
+  publisher.publish(mock_scn(100));
+  publisher.remove(&mt1);
+  ASSERT_EQ(1, publisher.cnt_);
+  ASSERT_EQ(&mt2, publisher.memtables_[0]);
+  ASSERT_TRUE(can_skip(mt1, 1000));
+  ASSERT_FALSE(can_skip(mt2, 1000));
+  publisher.revoke(true /*is_decided*/);
+  ASSERT_TRUE(can_skip(mt2, 1000));
+}
+
+TEST_F(TestMvccDecidedSummary, publisher_memtable_overflow)
+{
+  ObMemtable mts[ObTxDecidedPublisher::MAX_MEMTABLE_CNT + 1];
+  ObTxDecidedPublisher publisher;
+  for (int64_t i = 0; i <= ObTxDecidedPublisher::MAX_MEMTABLE_CNT; ++i) {
+    publisher.add(&mts[i]);
+  }
+  ASSERT_EQ(ObTxDecidedPublisher::MAX_MEMTABLE_CNT, publisher.cnt_);
+  // the memtable out of the publisher can not be summarized
+  ASSERT_FALSE(can_skip(mts[ObTxDecidedPublisher::MAX_MEMTABLE_CNT], 1));
+  publisher.publish(mock_scn(100));
+  publisher.revoke(true /*is_decided*/);
+  for (int64_t i = 0; i < ObTxDecidedPublisher::MAX_MEMTABLE_CNT; ++i) {
+    ASSERT_TRUE(can_skip(mts[i], 1000));
+  }
+  ASSERT_FALSE(can_skip(mts[ObTxDecidedPublisher::MAX_MEMTABLE_CNT], 1));
+}
+
+TEST_F(TestMvccDecidedSummary, replay_disabled)
+{
+  ObMemtable mt1;
+  ObMemtable mt2;
+  ObMemtableCtx mem_ctx;
+  // the leader txn publishes with its trans version
+  mem_ctx.add_written_memtable(&mt1);
+  mem_ctx.set_trans_version(mock_scn(100));
+  ASSERT_TRUE(can_skip(mt1, 50));
+  ASSERT_FALSE(can_skip(mt1, 100));
+
+  // the txn switched to follower is decided by replay
+  ASSERT_EQ(OB_SUCCESS, mem_ctx.commit_to_replay());
+  ASSERT_FALSE(can_skip(mt1, 50));
+
+  // the memtable written by the ctx without publisher is disabled
+  ObIMvccCtx &base_ctx = mem_ctx;
+  base_ctx.ObIMvccCtx::add_written_memtable(&mt2);
+  ASSERT_FALSE(can_skip(mt2, 1));
+}
+
+TEST_F(TestMvccDecidedSummary, can_skip_undecided)
+{
+  ObMvccDecidedSummary summary;
+  ObMvccAccessCtx ctx;
+  ObMvccValueIterator iter;
+  ObMvccTransNode node;
+  iter.ctx_ = &ctx;
+  const SCN snapshot = mock_scn(100);
+
+  // no summary, or the snapshot is not in the max read ts
+  ASSERT_FALSE(iter.can_skip_undecided_(snapshot, node));
+  iter.decided_summary_ = &summary;
+  ASSERT_FALSE(iter.can_skip_undecided_(snapshot, node));
+  ctx.set_read_ts_registered();
+  ASSERT_TRUE(iter.can_skip_undecided_(snapshot, node));
+
+  // the txn is committing under the snapshot
+  const int64_t slot = summary.publish(mock_scn(90));
+  ASSERT_FALSE(iter.can_skip_undecided_(snapshot, node));
+  summary.revoke(slot);
+  ASSERT_TRUE(iter.can_skip_undecided_(snapshot, node));
+
+  // the decided tx node is never skipped
+  ObMvccTransNode committed_node;
+  committed_node.set_committed();
+  ASSERT_FALSE(iter.can_skip_undecided_(snapshot, committed_node));
+  ObMvccTransNode aborted_node;
+  aborted_node.set_aborted();
+  ASSERT_FALSE(iter.can_skip_undecided_(snapshot, aborted_node));
+  ObMvccTransNode elr_node;
+  elr_node.set_elr();
+  ASSERT_FALSE(iter.can_skip_undecided_(snapshot, elr_node));
+  ObMvccTransNode delayed_node;
+  delayed_node.set_delayed_cleanout(true);
+  ASSERT_FALSE(iter.can_skip_undecided_(snapshot, delayed_node));
+}
+
+TEST_F(TestMvccDecidedSummary, commit_concurrent_with_read)
+{
+  const int64_t SNAPSHOT = 1000;
+  const int64_t ROUND_CNT = 2000;
+  const int64_t READER_CNT = 4;
+  const int64_t WRITER_CNT = ObMvccDecidedSummary::MAX_SLOT_CNT + 4;
+  ObMemtable mt;
+  bool stop = false;
+  // odd while the committer holds a version under the snapshot
+  int64_t hold_seq = 0;
+  int64_t wrong_skip_cnt = 0;
+
+  // txns committing above the snapshot, more than slots
+  std::vector<std::thread> writers;
+  for (int64_t t = 0; t < WRITER_CNT; ++t) {
+    writers.push_back(std::thread([&, t]() {
+      ObTenantEnv::set_tenant(&tenant_base_);
+      while (!ATOMIC_LOAD(&stop)) {
+        ObTxDecidedPublisher publisher;
+        publisher.add(&mt);
+        publisher.publish(mock_scn(SNAPSHOT + 1 + t));
+        publisher.revoke(true /*is_decided*/);
+      }
+    }));
+  }
+  std::vector<std::thread> readers;
+  for (int64_t t = 0; t < READER_CNT; ++t) {
+    readers.push_back(std::thread([&]() {
+      ObTenantEnv::set_tenant(&tenant_base_);
+      while (!ATOMIC_LOAD(&stop)) {
+        const int64_t seq_before = ATOMIC_LOAD(&hold_seq);
+        const bool skip = can_skip(mt, SNAPSHOT);
+        const int64_t seq_after = ATOMIC_LOAD(&hold_seq);
+        if (skip && seq_before == seq_after && 1 == (seq_before & 1)) {
+          ATOMIC_INC(&wrong_skip_cnt);
+        }
+      }
+    }));
+  }
+  // the txn committing under the snapshot must be seen by all readers
+  for (int64_t i = 0; i < ROUND_CNT; ++i) {
+    ObTxDecidedPublisher publisher;
+    publisher.add(&mt);
+    publisher.publish(mock_scn(SNAPSHOT - 1));
+    ATOMIC_INC(&hold_seq);
+    std::this_thread::yield();
+    ATOMIC_INC(&hold_seq);
+    publisher.revoke(true /*is_decided*/);
+  }
+  ATOMIC_STORE(&stop, true);
+  for (auto &th : writers) {
+    th.join();
+  }
+  for (auto &th : readers) {
+    th.join();
+  }
+  ASSERT_EQ(0, ATOMIC_LOAD(&wrong_skip_cnt));
+  ASSERT_EQ(0, mt.get_decided_summary().overflow_cnt_);
+  ASSERT_TRUE(can_skip(mt, SNAPSHOT));
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -rf test_mvcc_decided_summary.log*");
+  OB_LOGGER.set_file_name("test_mvcc_decided_summary.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,247 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+
+#include "lib/allocator/page_arena.h"
+#include "share/rc/ob_tenant_base.h"
+#include "storage/memtable/ob_memtable.h"
+#include "storage/memtable/ob_memtable_context.h"
+#include "storage/memtable/mvcc/ob_mvcc_engine.h"
+#include "storage/memtable/mvcc/ob_mvcc_row.h"
+
+namespace oceanbase
+{
+
+namespace unittest
+{
+using namespace oceanbase::common;
+using namespace oceanbase::memtable;
+using namespace oceanbase::share;
+
+// memstore like allocator which never frees, and counts the allocations
+class ObMockMemstoreAllocator : public ObIAllocator
+{
+public:
+  ObMockMemstoreAllocator() : arena_(), alloc_cnt_(0), alloc_size_(0) {}
+  virtual void *alloc(const int64_t size) override
+  {
+    alloc_cnt_++;
+    alloc_size_ += size;
+    return arena_.alloc(size);
+  }
+  virtual void *alloc(const int64_t size, const ObMemAttr &attr) override
+  {
+    UNUSED(attr);
+    return alloc(size);
+  }
+  virtual void free(void *ptr) override { UNUSED(ptr); }
+  ObArenaAllocator arena_;
+  int64_t alloc_cnt_;
+  int64_t alloc_size_;
+};
+
+class TestTxNodeArena : public ::testing::Test
+{
+public:
+  static const int64_t NODE_SIZE = 64;
+  TestTxNodeArena() : tenant_base_(OB_SYS_TENANT_ID) {}
+  virtual void SetUp() override
+  {
+    ObTenantEnv::set_tenant(&tenant_base_);
+  }
+  virtual void TearDown() override
+  {
+    ObTenantEnv::set_tenant(nullptr);
+  }
+  // write nodes until the chunk is needed
+  void write_to_chunk(ObTxNodeArena &arena, ObMockMemstoreAllocator &allocator, const int64_t owner_id)
+  {
+    do {
+      ASSERT_NE(nullptr, arena.alloc(allocator, owner_id, NODE_SIZE));
+    } while (arena.owner_used_ <= ObTxNodeArena::MIN_USED_FOR_CHUNK);
+  }
+protected:
+  ObTenantBase tenant_base_;
+};
+
+TEST_F(TestTxNodeArena, small_txn_alloc_directly)
+{
+  ObMockMemstoreAllocator allocator;
+  ObTxNodeArena arena;
+  const int64_t node_cnt = ObTxNodeArena::MIN_USED_FOR_CHUNK / NODE_SIZE;
+  for (int64_t i = 0; i < node_cnt; ++i) {
+    ASSERT_NE(nullptr, arena.alloc(allocator, 1, NODE_SIZE));
+  }
+  ASSERT_EQ(node_cnt, allocator.alloc_cnt_);
+  ASSERT_EQ(node_cnt * NODE_SIZE, allocator.alloc_size_);
+  ASSERT_EQ(nullptr, arena.pos_);
+  ASSERT_EQ(0, arena.get_waste_size());
+
+  // the memtable without id and the large node never use chunks
+  ASSERT_NE(nullptr, arena.alloc(allocator, -1, NODE_SIZE));
+  ASSERT_NE(nullptr, arena.alloc(allocator, 1, ObTxNodeArena::MAX_NODE_SIZE + 1));
+  ASSERT_EQ(node_cnt + 2, allocator.alloc_cnt_);
+  ASSERT_EQ(nullptr, arena.pos_);
+}
+
+TEST_F(TestTxNodeArena, pack_nodes_in_chunk)
+{
+  ObMockMemstoreAllocator allocator;
+  ObTxNodeArena arena;
+  write_to_chunk(arena, allocator, 1);
+  ASSERT_NE(nullptr, arena.pos_);
+  const int64_t alloc_cnt = allocator.alloc_cnt_;
+  const int64_t chunk_size = arena.end_ - arena.pos_ + NODE_SIZE;
+  ASSERT_EQ(ObTxNodeArena::MIN_USED_FOR_CHUNK / 4, chunk_size);
+
+  // the following nodes are laid out together
+  char *prev = arena.pos_ - NODE_SIZE;
+  for (int64_t i = 1; i < chunk_size / NODE_SIZE; ++i) {
+    char *ptr = (char *)arena.alloc(allocator, 1, NODE_SIZE - 1);
+    ASSERT_EQ(prev + NODE_SIZE, ptr);
+    prev = ptr;
+  }
+  ASSERT_EQ(alloc_cnt, allocator.alloc_cnt_);
+  ASSERT_EQ(arena.end_, arena.pos_);
+
+  // the chunk grows with the written bytes and is limited
+  for (int64_t i = 0; i < 1000; ++i) {
+    ASSERT_NE(nullptr, arena.alloc(allocator, 1, NODE_SIZE));
+    ASSERT_LE(arena.end_ - arena.pos_, ObTxNodeArena::MAX_CHUNK_SIZE);
+    ASSERT_LE(arena.end_ - arena.pos_, arena.owner_used_ / 4);
+  }
+  // each chunk leaves less than one node
+  const int64_t chunk_cnt = allocator.alloc_cnt_ - alloc_cnt;
+  ASSERT_LT(0, chunk_cnt);
+  ASSERT_LT(arena.get_waste_size(), chunk_cnt * NODE_SIZE);
+}
+
+TEST_F(TestTxNodeArena, switch_memtable)
+{
+  ObMockMemstoreAllocator allocator1;
+  ObMockMemstoreAllocator allocator2;
+  ObTxNodeArena arena;
+  write_to_chunk(arena, allocator1, 1);
+  ASSERT_NE(nullptr, arena.pos_);
+  const int64_t tail = arena.end_ - arena.pos_;
+  ASSERT_LT(0, tail);
+
+  // the tail is left in the memtable written before
+  ASSERT_NE(nullptr, arena.alloc(allocator2, 2, NODE_SIZE));
+  ASSERT_EQ(tail, arena.get_waste_size());
+  ASSERT_EQ(&allocator2, arena.owner_);
+  ASSERT_EQ(NODE_SIZE, arena.owner_used_);
+  ASSERT_EQ(nullptr, arena.pos_);
+  ASSERT_EQ(1, allocator2.alloc_cnt_);
+
+  // the reused memtable with the same allocator gets a new id
+  write_to_chunk(arena, allocator2, 2);
+  ASSERT_NE(nullptr, arena.pos_);
+  const int64_t tail2 = arena.end_ - arena.pos_;
+  ASSERT_NE(nullptr, arena.alloc(allocator2, 3, NODE_SIZE));
+  ASSERT_EQ(tail + tail2, arena.get_waste_size());
+  ASSERT_EQ(NODE_SIZE, arena.owner_used_);
+
+  arena.reset();
+  ASSERT_EQ(0, arena.get_waste_size());
+  ASSERT_EQ(nullptr, arena.owner_);
+}
+
+TEST_F(TestTxNodeArena, bound_waste)
+{
+  ObMockMemstoreAllocator allocator1;
+  ObMockMemstoreAllocator allocator2;
+  ObTxNodeArena arena;
+  // the transaction writes into two memtables by turns, each turn leaves a tail
+  int64_t turn = 0;
+  while (arena.get_waste_size() < ObTxNodeArena::MAX_WASTE_SIZE) {
+    ObMockMemstoreAllocator &allocator = (0 == turn % 2) ? allocator1 : allocator2;
+    write_to_chunk(arena, allocator, turn % 2);
+    ++turn;
+  }
+  ASSERT_LE(arena.get_waste_size(), ObTxNodeArena::MAX_WASTE_SIZE + ObTxNodeArena::MAX_CHUNK_SIZE);
+
+  // no more chunks once the tails reach the limit
+  const int64_t waste_size = arena.get_waste_size();
+  for (int64_t round = 0; round < 4; ++round) {
+    ObMockMemstoreAllocator &allocator = (0 == turn % 2) ? allocator1 : allocator2;
+    const int64_t alloc_cnt = allocator.alloc_cnt_;
+    const int64_t node_cnt = 2 * ObTxNodeArena::MIN_USED_FOR_CHUNK / NODE_SIZE;
+    for (int64_t i = 0; i < node_cnt; ++i) {
+      ASSERT_NE(nullptr, arena.alloc(allocator, turn % 2, NODE_SIZE));
+    }
+    ASSERT_EQ(alloc_cnt + node_cnt, allocator.alloc_cnt_);
+    ASSERT_EQ(nullptr, arena.pos_);
+    ++turn;
+  }
+  ASSERT_EQ(waste_size, arena.get_waste_size());
+}
+
+TEST_F(TestTxNodeArena, memtable_ctx_alloc)
+{
+  ObMockMemstoreAllocator allocator;
+  ObMemtableCtx mem_ctx;
+  ObIMemtableCtx &ctx = mem_ctx;
+  for (int64_t i = 0; i < 2 * ObTxNodeArena::MIN_USED_FOR_CHUNK / NODE_SIZE; ++i) {
+    ASSERT_NE(nullptr, ctx.tx_node_alloc(allocator, 1, NODE_SIZE));
+  }
+  ASSERT_GT(2 * ObTxNodeArena::MIN_USED_FOR_CHUNK / NODE_SIZE, allocator.alloc_cnt_);
+  mem_ctx.tx_node_arena_.reset();
+  ASSERT_EQ(nullptr, mem_ctx.tx_node_arena_.pos_);
+}
+
+TEST_F(TestTxNodeArena, hotspot_row_compacted_by_read)
+{
+  ObMemtable mt;
+  ObMvccEngine engine;
+  ObMvccRow row;
+  engine.memtable_ = &mt;
+
+  ASSERT_FALSE(row.is_hotspot());
+  row.set_hotspot();
+  ASSERT_TRUE(row.is_hotspot());
+
+  // the active memtable is still written, and the frozen one is not synced yet
+  mt.freeze_state_ = ObMemtableFreezeState::INVALID;
+  ASSERT_FALSE(engine.need_compact_hotspot_row_(row));
+  mt.freeze_state_ = ObMemtableFreezeState::NOT_READY_FOR_FLUSH;
+  ASSERT_FALSE(engine.need_compact_hotspot_row_(row));
+  ASSERT_TRUE(row.is_hotspot());
+
+  // only the first read compacts the row
+  mt.freeze_state_ = ObMemtableFreezeState::READY_FOR_FLUSH;
+  ASSERT_TRUE(engine.need_compact_hotspot_row_(row));
+  ASSERT_FALSE(row.is_hotspot());
+  ASSERT_FALSE(engine.need_compact_hotspot_row_(row));
+
+  row.set_hotspot();
+  mt.freeze_state_ = ObMemtableFreezeState::FLUSHED;
+  ASSERT_TRUE(engine.need_compact_hotspot_row_(row));
+  ASSERT_FALSE(row.try_clear_hotspot());
+  engine.memtable_ = NULL;
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -rf test_tx_node_arena.log*");
+  OB_LOGGER.set_file_name("test_tx_node_arena.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -28,6 +28,8 @@
 #include "storage/tx/ob_multi_data_source.h"
 #include "storage/tx/ob_trans_define_v4.h"
 #include "storage/memtable/mvcc/ob_mvcc_row.h"
+#include "storage/memtable/mvcc/ob_mvcc_iterator.h"
+#include "storage/memtable/ob_memtable_iterator.h"
 #include "share/scn.h"
 #include "storage/ls/ob_ls.h"
 #include "storage/tx_storage/ob_ls_map.h"
@@ -313,6 +315,70 @@ public:
   ObTxDesc tx_desc_;
 };
 
+class ScanGuard
+{
+public:
+  ScanGuard(TestMemtable *tm) : tm_(tm), allocator_() {}
+  // scan the keys in [@start, @end] by a reader without tx at @snapshot
+  int scan(ObMemtable &mt, const int64_t start, const int64_t end,
+           const bool inclusive_start, const bool inclusive_end, int64_t snapshot = 1000)
+  {
+    int ret = OB_SUCCESS;
+    ObObj start_obj;
+    ObObj end_obj;
+    start_obj.set_int(start);
+    end_obj.set_int(end);
+    ObStoreRowkey start_rowkey(&start_obj, 1);
+    ObStoreRowkey end_rowkey(&end_obj, 1);
+    ObMvccScanRange range;
+    ObTxTableGuard tx_table_guard;
+    ObTxSnapshot tx_snapshot;
+    tx_table_guard.init((ObTxTable*)0x100);
+    tx_snapshot.version_.convert_for_gts(snapshot);
+    acc_ctx_.init_read(NULL, NULL, tx_table_guard, tx_snapshot, INT64_MAX, INT64_MAX, false);
+    if (inclusive_start) {
+      range.border_flag_.set_inclusive_start();
+    }
+    if (inclusive_end) {
+      range.border_flag_.set_inclusive_end();
+    }
+    if (OB_FAIL(ObMemtableKey::build(range.start_key_, tm_->columns_, &start_rowkey, allocator_))) {
+    } else if (OB_FAIL(ObMemtableKey::build(range.end_key_, tm_->columns_, &end_rowkey, allocator_))) {
+    } else {
+      ret = mt.get_mvcc_engine().scan(acc_ctx_, query_flag_, range, row_iter_);
+    }
+    return ret;
+  }
+  int next(int64_t &key, const bool stop_at_undecided = false)
+  {
+    int ret = OB_SUCCESS;
+    const ObMemtableKey *mtk = NULL;
+    ObMvccValueIterator *value_iter = NULL;
+    const ObStoreRowkey *rowkey = NULL;
+    uint8_t iter_flag = 0;
+    if (OB_SUCC(row_iter_.get_next_row(mtk, value_iter, iter_flag, false, stop_at_undecided))) {
+      mtk->get_rowkey(rowkey);
+      key = rowkey->get_obj_ptr()[0].get_int();
+    }
+    return ret;
+  }
+  int64_t cur_key()
+  {
+    const ObMemtableKey *mtk = NULL;
+    ObMvccRow *row = NULL;
+    const ObStoreRowkey *rowkey = NULL;
+    row_iter_.get_key_val(mtk, row);
+    mtk->get_rowkey(rowkey);
+    return rowkey->get_obj_ptr()[0].get_int();
+  }
+
+  TestMemtable *tm_;
+  ObArenaAllocator allocator_;
+  ObMvccAccessCtx acc_ctx_;
+  ObQueryFlag query_flag_;
+  ObMvccRowIterator row_iter_;
+};
+
 void print(ObMvccRow *mvcc_row)
 {
   printf("-----------mvcc row %p------------------\n", mvcc_row);
@@ -450,6 +516,129 @@ TEST_F(TestMemtable, multi_key)
 }
 
 
+TEST_F(TestMemtable, scan_stop_at_undecided)
+{
+  ObMemtable mt;
+  EXPECT_EQ(OB_SUCCESS, init_memtable(mt));
+
+  share::SCN val_900;
+  val_900.convert_for_logservice(900);
+  RunCtxGuard rg;
+  EXPECT_EQ(OB_SUCCESS, rg.init(1, this));
+  for (int64_t i = 1; i <= 4; ++i) {
+    EXPECT_EQ(OB_SUCCESS, rg.write(i, i * 10, mt));
+  }
+  EXPECT_EQ(OB_SUCCESS, rg.mem_ctx_.do_trans_end(true, val_900, val_900, 0));
+
+  // key 3 is locked by a running tx
+  RunCtxGuard rg2;
+  EXPECT_EQ(OB_SUCCESS, rg2.init(2, this));
+  EXPECT_EQ(OB_SUCCESS, rg2.write(3, 300, mt, 1000));
+
+  ScanGuard sg(this);
+  int64_t key = 0;
+  EXPECT_EQ(OB_SUCCESS, sg.scan(mt, 1, 4, true, true));
+  EXPECT_EQ(OB_SUCCESS, sg.next(key, true));
+  EXPECT_EQ(1, key);
+  EXPECT_EQ(OB_SUCCESS, sg.next(key, true));
+  EXPECT_EQ(2, key);
+  // the batch stops before the locked row, and keeps it for the next read
+  EXPECT_EQ(OB_EAGAIN, sg.next(key, true));
+  EXPECT_TRUE(sg.row_iter_.has_pending_row_);
+  EXPECT_EQ(3, sg.cur_key());
+  EXPECT_EQ(OB_EAGAIN, sg.next(key, true));
+  EXPECT_EQ(3, sg.cur_key());
+
+  // the aborted row is readable without waiting, and no row is skipped
+  share::SCN val_1000;
+  val_1000.convert_for_logservice(1000);
+  EXPECT_EQ(OB_SUCCESS, rg2.mem_ctx_.do_trans_end(false, val_1000, val_1000, 0));
+  EXPECT_EQ(OB_SUCCESS, sg.next(key, true));
+  EXPECT_EQ(3, key);
+  EXPECT_FALSE(sg.row_iter_.has_pending_row_);
+  EXPECT_EQ(OB_SUCCESS, sg.next(key, true));
+  EXPECT_EQ(4, key);
+  EXPECT_EQ(OB_ITER_END, sg.next(key, true));
+}
+
+TEST_F(TestMemtable, scan_range_border)
+{
+  ObMemtable mt;
+  EXPECT_EQ(OB_SUCCESS, init_memtable(mt));
+
+  share::SCN val_900;
+  val_900.convert_for_logservice(900);
+  RunCtxGuard rg;
+  EXPECT_EQ(OB_SUCCESS, rg.init(1, this));
+  for (int64_t i = 1; i <= 8; ++i) {
+    EXPECT_EQ(OB_SUCCESS, rg.write(i, i * 10, mt));
+  }
+  EXPECT_EQ(OB_SUCCESS, rg.mem_ctx_.do_trans_end(true, val_900, val_900, 0));
+
+  // the border keys are returned only if included
+  const bool borders[4][2] = {{true, true}, {false, true}, {true, false}, {false, false}};
+  for (int64_t i = 0; i < 4; ++i) {
+    ScanGuard sg(this);
+    int64_t key = 0;
+    const int64_t start = borders[i][0] ? 3 : 4;
+    const int64_t end = borders[i][1] ? 6 : 5;
+    EXPECT_EQ(OB_SUCCESS, sg.scan(mt, 3, 6, borders[i][0], borders[i][1]));
+    for (int64_t expect = start; expect <= end; ++expect) {
+      EXPECT_EQ(OB_SUCCESS, sg.next(key, true));
+      EXPECT_EQ(expect, key);
+    }
+    EXPECT_EQ(OB_ITER_END, sg.next(key, true));
+  }
+
+  // the rows committed after the snapshot are skipped
+  ScanGuard sg(this);
+  int64_t key = 0;
+  EXPECT_EQ(OB_SUCCESS, sg.scan(mt, 1, 8, true, true, 800));
+  EXPECT_EQ(OB_ITER_END, sg.next(key, true));
+}
+
+TEST_F(TestMemtable, scan_batch_size)
+{
+  ObArenaAllocator allocator;
+  ObTableAccessContext context;
+  context.stmt_allocator_ = &allocator;
+
+  // no batch rows for the row by row consumers
+  ObMemtableScanIterator iter;
+  iter_param_.vectorized_enabled_ = false;
+  EXPECT_EQ(OB_SUCCESS, iter.init(NULL, iter_param_, context));
+  EXPECT_EQ(nullptr, iter.batch_rows_);
+  iter_param_.vectorized_enabled_ = true;
+  iter_param_.is_for_foreign_check_ = true;
+  EXPECT_EQ(OB_SUCCESS, iter.init(NULL, iter_param_, context));
+  EXPECT_EQ(nullptr, iter.batch_rows_);
+  iter_param_.is_for_foreign_check_ = false;
+  EXPECT_EQ(OB_SUCCESS, iter.init(NULL, iter_param_, context));
+  EXPECT_NE(nullptr, iter.batch_rows_);
+
+  // the batch grows from one row
+  const int64_t max_batch_row_cnt = ObMemtableScanIterator::MAX_BATCH_ROW_CNT;
+  EXPECT_EQ(1, iter.get_batch_size());
+  iter.batch_size_ = max_batch_row_cnt;
+  EXPECT_EQ(max_batch_row_cnt, iter.get_batch_size());
+  iter.reuse_batch();
+  EXPECT_EQ(1, iter.get_batch_size());
+
+  // no more rows than the limit are resolved
+  ObLimitParam limit_param;
+  limit_param.offset_ = 2;
+  limit_param.limit_ = 3;
+  context.limit_param_ = &limit_param;
+  context.out_cnt_ = 1;
+  iter.batch_size_ = max_batch_row_cnt;
+  EXPECT_EQ(4, iter.get_batch_size());
+  context.out_cnt_ = 5;
+  EXPECT_EQ(1, iter.get_batch_size());
+  limit_param.limit_ = -1;
+  EXPECT_EQ(max_batch_row_cnt, iter.get_batch_size());
+  iter.reset();
+}
+
 }// end of oceanbase
 
 
@@ -0,0 +1,254 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define private public
+#define protected public
+
+#include "lib/container/ob_bitmap.h"
+#include "sql/engine/ob_exec_context.h"
+#include "sql/engine/basic/ob_pushdown_filter.h"
+#include "storage/access/ob_block_batched_row_store.h"
+#include "storage/access/ob_table_access_context.h"
+#include "storage/blocksstable/encoding/ob_micro_block_decoder.h"
+
+namespace oceanbase
+{
+namespace unittest
+{
+using namespace common;
+using namespace storage;
+using namespace blocksstable;
+
+class ObMockBatchedRowStore : public ObBlockBatchedRowStore
+{
+public:
+  ObMockBatchedRowStore(const int64_t batch_size, sql::ObEvalCtx &eval_ctx, ObTableAccessContext &context)
+      : ObBlockBatchedRowStore(batch_size, eval_ctx, context)
+  {}
+  virtual int fill_row(ObDatumRow &out_row) override
+  {
+    UNUSED(out_row);
+    return OB_NOT_SUPPORTED;
+  }
+  virtual int fill_rows(
+      const int64_t group_idx,
+      ObIMicroBlockReader *reader,
+      int64_t &begin_index,
+      const int64_t end_index,
+      const ObBitmap *bitmap) override
+  {
+    UNUSEDx(group_idx, reader, begin_index, end_index, bitmap);
+    return OB_NOT_SUPPORTED;
+  }
+};
+
+// The black filter has no filter expr and passes every row it evaluates, so the result
+// bitmap shows exactly which rows are handed to the filter.
+class TestBlockBatchedRowStore : public ::testing::Test
+{
+public:
+  static const int64_t BATCH_SIZE = 8;
+  static const int64_t ROW_COUNT = 200;
+  TestBlockBatchedRowStore()
+    : allocator_(),
+      exec_ctx_(allocator_),
+      eval_ctx_(exec_ctx_),
+      expr_spec_(allocator_),
+      op_(eval_ctx_, expr_spec_),
+      black_node_(allocator_),
+      and_node_(allocator_),
+      black_filter_(allocator_, black_node_, op_),
+      and_filter_(allocator_, and_node_, op_),
+      access_ctx_(),
+      store_(BATCH_SIZE, eval_ctx_, access_ctx_),
+      decoder_(),
+      result_(allocator_)
+  {}
+  virtual void SetUp() override
+  {
+    expr_spec_.max_batch_size_ = BATCH_SIZE;
+    black_filter_.n_cols_ = 1;
+    store_.is_inited_ = true;
+    store_.row_ids_ = row_ids_;
+    store_.cell_data_ptrs_ = cell_datas_;
+    decoder_.row_count_ = ROW_COUNT;
+    decoder_.is_inited_ = true;
+    ASSERT_EQ(OB_SUCCESS, result_.init(ROW_COUNT));
+  }
+  virtual void TearDown() override
+  {
+    decoder_.is_inited_ = false;
+    store_.row_ids_ = nullptr;
+    store_.cell_data_ptrs_ = nullptr;
+  }
+  // returns the parent bitmap of the AND node with no row set
+  ObBitmap *init_parent_bitmap()
+  {
+    ObBitmap *bitmap = nullptr;
+    EXPECT_EQ(OB_SUCCESS, and_filter_.init_bitmap(ROW_COUNT, bitmap));
+    EXPECT_NE(nullptr, bitmap);
+    bitmap->reuse(false);
+    return bitmap;
+  }
+  int filter(const int64_t start, const int64_t end)
+  {
+    store_.pd_filter_info_.start_ = start;
+    store_.pd_filter_info_.end_ = end;
+    return store_.filter_micro_block_batch(decoder_, &and_filter_, black_filter_, result_);
+  }
+  // result must be the parent bitmap limited to [start, end)
+  void check_result(const ObBitmap &parent, const int64_t start, const int64_t end)
+  {
+    const int64_t batch_size = BATCH_SIZE;
+    for (int64_t i = 0; i < ROW_COUNT; ++i) {
+      ASSERT_EQ(i >= start && i < end && parent.test(i), result_.test(i)) << "row: " << i;
+    }
+    ASSERT_EQ(batch_size, store_.row_capacity_);
+  }
+  int64_t result_cnt() const { return result_.popcnt(); }
+protected:
+  ObArenaAllocator allocator_;
+  sql::ObExecContext exec_ctx_;
+  sql::ObEvalCtx eval_ctx_;
+  sql::ObPushdownExprSpec expr_spec_;
+  sql::ObPushdownOperator op_;
+  sql::ObPushdownBlackFilterNode black_node_;
+  sql::ObPushdownAndFilterNode and_node_;
+  sql::ObBlackFilterExecutor black_filter_;
+  sql::ObAndFilterExecutor and_filter_;
+  ObTableAccessContext access_ctx_;
+  ObMockBatchedRowStore store_;
+  ObMicroBlockDecoder decoder_;
+  ObBitmap result_;
+  int64_t row_ids_[BATCH_SIZE];
+  const char *cell_datas_[BATCH_SIZE];
+};
+
+TEST_F(TestBlockBatchedRowStore, sparse_parent_bitmap)
+{
+  ObBitmap *parent = init_parent_bitmap();
+  ASSERT_NE(nullptr, parent);
+  int64_t set_cnt = 0;
+  for (int64_t i = 0; i < ROW_COUNT; i += 7) {
+    ASSERT_EQ(OB_SUCCESS, parent->set(i));
+    ++set_cnt;
+  }
+  // far more rows than one batch are left after the former children
+  ASSERT_LT(3 * BATCH_SIZE, set_cnt);
+  ASSERT_EQ(OB_SUCCESS, filter(0, ROW_COUNT));
+  check_result(*parent, 0, ROW_COUNT);
+  ASSERT_EQ(set_cnt, result_cnt());
+}
+
+TEST_F(TestBlockBatchedRowStore, dense_parent_bitmap)
+{
+  ObBitmap *parent = init_parent_bitmap();
+  ASSERT_NE(nullptr, parent);
+  for (int64_t i = 0; i < ROW_COUNT; ++i) {
+    if (i != 100) {
+      ASSERT_EQ(OB_SUCCESS, parent->set(i));
+    }
+  }
+  // full batches, the last one ends exactly at the range end
+  ASSERT_EQ(OB_SUCCESS, filter(64, 64 + 4 * BATCH_SIZE));
+  check_result(*parent, 64, 64 + 4 * BATCH_SIZE);
+  ASSERT_EQ(4 * BATCH_SIZE, result_cnt());
+}
+
+TEST_F(TestBlockBatchedRowStore, range_boundary)
+{
+  ObBitmap *parent = init_parent_bitmap();
+  ASSERT_NE(nullptr, parent);
+  const int64_t start = 3;
+  const int64_t end = 130;
+  const int64_t rows[] = {0, 2, 3, 63, 64, 65, 101, 102, 103, 104, 105, 106, 107, 108, 109, 129, 130, 199};
+  const int64_t row_cnt = ARRAYSIZEOF(rows);
+  for (int64_t i = 0; i < row_cnt; ++i) {
+    ASSERT_EQ(OB_SUCCESS, parent->set(rows[i]));
+  }
+  // unaligned start, the first and last rows of the range are kept
+  ASSERT_EQ(OB_SUCCESS, filter(start, end));
+  check_result(*parent, start, end);
+  ASSERT_TRUE(result_.test(start));
+  ASSERT_TRUE(result_.test(end - 1));
+  ASSERT_FALSE(result_.test(start - 1));
+  ASSERT_FALSE(result_.test(end));
+  ASSERT_EQ(row_cnt - 4, result_cnt());
+
+  // aligned start and the range ends at the last row of the block
+  result_.reuse();
+  ASSERT_EQ(OB_SUCCESS, filter(64, ROW_COUNT));
+  check_result(*parent, 64, ROW_COUNT);
+  ASSERT_TRUE(result_.test(ROW_COUNT - 1));
+  ASSERT_EQ(row_cnt - 4, result_cnt());
+}
+
+TEST_F(TestBlockBatchedRowStore, empty_parent_bitmap)
+{
+  ObBitmap *parent = init_parent_bitmap();
+  ASSERT_NE(nullptr, parent);
+  ASSERT_TRUE(parent->is_all_false());
+  ASSERT_EQ(OB_SUCCESS, filter(0, ROW_COUNT));
+  ASSERT_EQ(0, result_cnt());
+  check_result(*parent, 0, ROW_COUNT);
+
+  // rows are left only outside of the range
+  ASSERT_EQ(OB_SUCCESS, parent->set(0));
+  ASSERT_EQ(OB_SUCCESS, parent->set(ROW_COUNT - 1));
+  ASSERT_EQ(OB_SUCCESS, filter(1, ROW_COUNT - 1));
+  ASSERT_EQ(0, result_cnt());
+  check_result(*parent, 1, ROW_COUNT - 1);
+}
+
+TEST_F(TestBlockBatchedRowStore, all_true_parent_bitmap)
+{
+  ObBitmap *parent = nullptr;
+  ASSERT_EQ(OB_SUCCESS, and_filter_.init_bitmap(ROW_COUNT, parent));
+  ASSERT_TRUE(parent->is_all_true());
+  // all the rows are decoded by range
+  ASSERT_EQ(OB_SUCCESS, filter(5, ROW_COUNT - 5));
+  check_result(*parent, 5, ROW_COUNT - 5);
+  ASSERT_EQ(ROW_COUNT - 10, result_cnt());
+}
+
+TEST_F(TestBlockBatchedRowStore, filter_batch_by_row_ids)
+{
+  const int64_t batch_size = BATCH_SIZE;
+  const int64_t row_ids[BATCH_SIZE + 1] = {1, 5, 63, 64, 127, 128, 198, 199, 0};
+  ASSERT_EQ(OB_INVALID_ARGUMENT, black_filter_.filter_batch(nullptr, 1, result_));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, black_filter_.filter_batch(row_ids, 0, result_));
+  ASSERT_EQ(OB_INVALID_ARGUMENT, black_filter_.filter_batch(row_ids, BATCH_SIZE + 1, result_));
+  ASSERT_EQ(0, result_cnt());
+
+  ASSERT_EQ(OB_SUCCESS, black_filter_.filter_batch(row_ids, 3, result_));
+  ASSERT_EQ(3, result_cnt());
+  ASSERT_EQ(OB_SUCCESS, black_filter_.filter_batch(row_ids + 3, BATCH_SIZE - 3, result_));
+  ASSERT_EQ(batch_size, result_cnt());
+  for (int64_t i = 0; i < BATCH_SIZE; ++i) {
+    ASSERT_TRUE(result_.test(row_ids[i]));
+  }
+  ASSERT_FALSE(result_.test(0));
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_block_batched_row_store.log*");
+  OB_LOGGER.set_file_name("test_block_batched_row_store.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -820,6 +820,61 @@ TEST_F(TestIOManager, simple)
 }
 
 
+TEST_F(TestIOManager, io_uring)
+{
+  // replace libaio channels with io_uring channels, which fall back to libaio if kernel not support
+  ObIOManager &io_mgr = ObIOManager::get_instance();
+  ASSERT_SUCC(io_mgr.remove_device_channel(THE_IO_DEVICE));
+  ASSERT_SUCC(io_mgr.add_device_channel(THE_IO_DEVICE, 4, 2, 1024, true/*enable_io_uring*/));
+
+  ObIOFd fd;
+  ASSERT_SUCC(THE_IO_DEVICE->open(TEST_ROOT_DIR "/test_io_uring_file", O_CREAT | O_DIRECT | O_TRUNC | O_RDWR, 0644, fd));
+  ASSERT_TRUE(fd.is_valid());
+  const int64_t FILE_SIZE = 4 * 1024 * 1024;
+  ASSERT_SUCC(THE_IO_DEVICE->fallocate(fd, 0, 0, FILE_SIZE));
+
+  // register a user buffer as fixed buffer, best effort
+  const int64_t io_timeout_ms = 1000L * 5L;
+  const int64_t io_size = DIO_READ_ALIGN_SIZE * 4;
+  char *buf = static_cast<char *>(ob_malloc_align(DIO_READ_ALIGN_SIZE, io_size, "TestIOUring"));
+  ASSERT_NE(nullptr, buf);
+  ASSERT_SUCC(io_mgr.register_io_buffer(buf, io_size));
+
+  // write several blocks, then read them back asynchronously
+  const int64_t io_count = 8;
+  ObIOInfo io_info;
+  io_info.tenant_id_ = 500;
+  io_info.fd_ = fd;
+  io_info.flag_.set_group_id(0);
+  io_info.flag_.set_wait_event(100);
+  io_info.size_ = io_size;
+  io_info.buf_ = buf;
+  for (int64_t i = 0; i < io_count; ++i) {
+    memset(buf, 'a' + i, io_size);
+    io_info.flag_.set_write();
+    io_info.offset_ = i * io_size;
+    ASSERT_SUCC(io_mgr.write(io_info, io_timeout_ms));
+  }
+  ObIOHandle handles[io_count];
+  for (int64_t i = 0; i < io_count; ++i) {
+    io_info.flag_.set_read();
+    io_info.offset_ = i * io_size;
+    ASSERT_SUCC(io_mgr.aio_read(io_info, handles[i]));
+  }
+  for (int64_t i = 0; i < io_count; ++i) {
+    ASSERT_SUCC(handles[i].wait(io_timeout_ms));
+    ASSERT_EQ(io_size, handles[i].get_data_size());
+    memset(buf, 'a' + i, io_size);
+    ASSERT_EQ(0, memcmp(buf, handles[i].get_buffer(), io_size));
+    handles[i].reset();
+  }
+
+  ASSERT_SUCC(io_mgr.unregister_io_buffer(buf));
+  ob_free_align(buf);
+  ASSERT_SUCC(THE_IO_DEVICE->close(fd));
+}
+
+
 struct IOPerfDevice
 {
   IOPerfDevice() : device_id_(0), media_id_(0), async_channel_count_(0), sync_channel_count_(0), max_io_depth_(0),
@@ -0,0 +1,225 @@
+/**
+ * Copyright (c) 2021 OceanBase
+ * OceanBase CE is licensed under Mulan PubL v2.
+ * You can use this software according to the terms and conditions of the Mulan PubL v2.
+ * You may obtain a copy of Mulan PubL v2 at:
+ *          http://license.coscl.org.cn/MulanPubL-2.0
+ * THIS SOFTWARE IS PROVIDED ON AN "AS IS" BASIS, WITHOUT WARRANTIES OF ANY KIND,
+ * EITHER EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO NON-INFRINGEMENT,
+ * MERCHANTABILITY OR FIT FOR A PARTICULAR PURPOSE.
+ * See the Mulan PubL v2 for more details.
+ */
+
+#include <gtest/gtest.h>
+
+#define protected public
+#define private public
+#define UNITTEST
+
+#include <thread>
+#include <vector>
+#include "lib/allocator/page_arena.h"
+#include "lib/hash/ob_hashset.h"
+#include "share/rc/ob_tenant_base.h"
+#include "storage/tx/ob_tx_data_define.h"
+#include "storage/tx_table/ob_tx_data_hash_map.h"
+
+namespace oceanbase
+{
+using namespace ::testing;
+using namespace transaction;
+using namespace storage;
+using namespace share;
+
+namespace unittest
+{
+
+class TestTxDataHashMap : public ::testing::Test
+{
+public:
+  static const int64_t BUCKETS_CNT = 1024;
+  static const int64_t TX_DATA_CNT = 16 * BUCKETS_CNT;
+
+  TestTxDataHashMap()
+    : tenant_base_(OB_SYS_TENANT_ID), allocator_(), slice_allocator_(), map_(nullptr), tx_datas_(nullptr) {}
+  virtual void SetUp() override
+  {
+    ObTenantEnv::set_tenant(&tenant_base_);
+    map_ = new ObTxDataHashMap(allocator_, BUCKETS_CNT);
+    ASSERT_EQ(OB_SUCCESS, map_->init());
+    tx_datas_ = new ObTxData[TX_DATA_CNT];
+    for (int64_t i = 0; i < TX_DATA_CNT; i++) {
+      tx_datas_[i].tx_id_ = ObTransID(i + 1);
+      // the tx datas are owned by the test, they are never freed by the map
+      tx_datas_[i].slice_allocator_ = &slice_allocator_;
+      tx_datas_[i].ref_cnt_ = 1;
+    }
+  }
+  virtual void TearDown() override
+  {
+    delete map_;
+    map_ = nullptr;
+    delete [] tx_datas_;
+    tx_datas_ = nullptr;
+    allocator_.reset();
+  }
+
+  void insert_range(const int64_t begin, const int64_t end)
+  {
+    for (int64_t i = begin; i < end; i++) {
+      ASSERT_EQ(OB_SUCCESS, map_->insert(tx_datas_[i].tx_id_, &tx_datas_[i]));
+    }
+  }
+
+  void check_range(const int64_t begin, const int64_t end)
+  {
+    for (int64_t i = begin; i < end; i++) {
+      ObTxDataGuard guard;
+      ASSERT_EQ(OB_SUCCESS, map_->get(tx_datas_[i].tx_id_, guard));
+      ASSERT_EQ(&tx_datas_[i], guard.tx_data());
+    }
+  }
+
+protected:
+  ObTenantBase tenant_base_;
+  ObArenaAllocator allocator_;
+  ObSliceAlloc slice_allocator_;
+  ObTxDataHashMap *map_;
+  ObTxData *tx_datas_;
+};
+
+TEST_F(TestTxDataHashMap, grow)
+{
+  const int64_t load_limit_cnt = BUCKETS_CNT * ObTxDataHashMap::LOAD_FACTORY_MAX_LIMIT;
+
+  // not over loaded, no need grow
+  insert_range(0, load_limit_cnt);
+  ASSERT_EQ(OB_SUCCESS, map_->grow_if_need());
+  ASSERT_EQ(1, map_->get_table_cnt());
+  ASSERT_EQ(BUCKETS_CNT, map_->get_buckets_cnt());
+
+  // insert never grows the map by itself
+  insert_range(load_limit_cnt, 2 * BUCKETS_CNT);
+  ASSERT_EQ(1, map_->get_table_cnt());
+
+  // the appended table has double buckets
+  ASSERT_EQ(OB_SUCCESS, map_->grow_if_need());
+  ASSERT_EQ(2, map_->get_table_cnt());
+  ASSERT_EQ(3 * BUCKETS_CNT, map_->get_buckets_cnt());
+  ASSERT_EQ(2 * BUCKETS_CNT - 1, map_->tables_[1].mod_mask_);
+  ASSERT_EQ(2 * BUCKETS_CNT, map_->tables_[1].base_cnt_);
+
+  // only the load of the newest table is counted
+  ASSERT_EQ(OB_SUCCESS, map_->grow_if_need());
+  ASSERT_EQ(2, map_->get_table_cnt());
+
+  insert_range(2 * BUCKETS_CNT, 4 * BUCKETS_CNT);
+  ASSERT_EQ(OB_SUCCESS, map_->grow_if_need());
+  ASSERT_EQ(3, map_->get_table_cnt());
+  ASSERT_EQ(7 * BUCKETS_CNT, map_->get_buckets_cnt());
+  ASSERT_EQ(4 * BUCKETS_CNT, map_->count());
+
+  // later insertions go to the newest table
+  ObTxDataGuard guard;
+  ASSERT_EQ(OB_ENTRY_NOT_EXIST, map_->get(tx_datas_[4 * BUCKETS_CNT].tx_id_, guard));
+  insert_range(4 * BUCKETS_CNT, 4 * BUCKETS_CNT + 1);
+  ObTxDataHashMap::ObTxDataHashHeader &bucket =
+      map_->get_bucket_(map_->tables_[2], tx_datas_[4 * BUCKETS_CNT].tx_id_);
+  ASSERT_EQ(&tx_datas_[4 * BUCKETS_CNT], bucket.next_);
+
+  // tx datas in all tables can be found
+  check_range(0, 4 * BUCKETS_CNT + 1);
+}
+
+TEST_F(TestTxDataHashMap, no_room_to_grow)
+{
+  insert_range(0, TX_DATA_CNT);
+  int64_t table_cnt = 0;
+  do {
+    table_cnt = map_->get_table_cnt();
+    // make the newest table over loaded
+    map_->tables_[table_cnt - 1].base_cnt_ = -ObTxDataHashMap::MAX_BUCKETS_CNT;
+    ASSERT_EQ(OB_SUCCESS, map_->grow_if_need());
+  } while (table_cnt != map_->get_table_cnt());
+  ASSERT_EQ(ObTxDataHashMap::MAX_TABLE_CNT, map_->get_table_cnt());
+  ASSERT_LE(map_->get_buckets_cnt(), ObTxDataHashMap::MAX_BUCKETS_CNT);
+  check_range(0, TX_DATA_CNT);
+}
+
+TEST_F(TestTxDataHashMap, iterate_tables)
+{
+  int64_t end = 0;
+  for (int64_t round = 0; round < 4; round++) {
+    const int64_t begin = end;
+    end = (round + 1) * 4 * BUCKETS_CNT;
+    insert_range(begin, end);
+    ASSERT_EQ(OB_SUCCESS, map_->grow_if_need());
+  }
+  ASSERT_EQ(4, map_->get_table_cnt());
+
+  common::hash::ObHashSet<int64_t> tx_ids;
+  ASSERT_EQ(OB_SUCCESS, tx_ids.create(TX_DATA_CNT));
+  ObTxDataHashMap::Iterator iter(*map_);
+  ObTxDataGuard guard;
+  int ret = OB_SUCCESS;
+  int64_t iter_cnt = 0;
+  while (OB_SUCC(iter.get_next(guard))) {
+    ASSERT_EQ(OB_SUCCESS, tx_ids.set_refactored(guard.tx_data()->tx_id_.get_id()));
+    iter_cnt++;
+  }
+  ASSERT_EQ(OB_ITER_END, ret);
+  ASSERT_EQ(end, iter_cnt);
+  ASSERT_EQ(end, tx_ids.size());
+
+  // the empty table at the tail is skipped
+  map_->tables_[3].base_cnt_ = -ObTxDataHashMap::MAX_BUCKETS_CNT;
+  ASSERT_EQ(OB_SUCCESS, map_->grow_if_need());
+  ASSERT_EQ(5, map_->get_table_cnt());
+  ObTxDataHashMap::Iterator iter2(*map_);
+  iter_cnt = 0;
+  while (OB_SUCC(iter2.get_next(guard))) {
+    iter_cnt++;
+  }
+  ASSERT_EQ(end, iter_cnt);
+}
+
+TEST_F(TestTxDataHashMap, concurrent_insert_and_grow)
+{
+  const int64_t THREAD_CNT = 8;
+  const int64_t CNT_PER_THREAD = TX_DATA_CNT / THREAD_CNT;
+  bool stop = false;
+  std::thread grow_thread([&]() {
+    ObTenantEnv::set_tenant(&tenant_base_);
+    while (!ATOMIC_LOAD(&stop)) {
+      EXPECT_EQ(OB_SUCCESS, map_->grow_if_need());
+    }
+  });
+  std::vector<std::thread> insert_threads;
+  for (int64_t t = 0; t < THREAD_CNT; t++) {
+    insert_threads.push_back(std::thread([&, t]() {
+      insert_range(t * CNT_PER_THREAD, (t + 1) * CNT_PER_THREAD);
+      check_range(t * CNT_PER_THREAD, (t + 1) * CNT_PER_THREAD);
+    }));
+  }
+  for (auto &th : insert_threads) {
+    th.join();
+  }
+  ATOMIC_STORE(&stop, true);
+  grow_thread.join();
+
+  ASSERT_LT(1, map_->get_table_cnt());
+  ASSERT_EQ(TX_DATA_CNT, map_->count());
+  check_range(0, TX_DATA_CNT);
+}
+
+} // namespace unittest
+} // namespace oceanbase
+
+int main(int argc, char **argv)
+{
+  system("rm -f test_tx_data_hash_map.log*");
+  OB_LOGGER.set_file_name("test_tx_data_hash_map.log", true);
+  OB_LOGGER.set_log_level("INFO");
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}